@@ -36,7 +36,28 @@ extern "C" {
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
-
+// --- Telemetry Data Structure ---
+typedef struct {
+    float altitude;
+    float speed;
+    float voltage;
+
+    uint32_t timestamp_ms;   // From log (milliseconds from flight start)
+    uint32_t hours;          // From log
+    uint32_t minutes;
+    uint32_t seconds;
+
+    // Previous (for rate calculation)
+    float altitude_prev;
+    float speed_prev;
+    float voltage_prev;
+    uint32_t timestamp_prev;
+
+    // Calculated rates
+    float altitude_rate;
+    float speed_rate;
+    float voltage_rate;
+} TelemetryData_t;
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
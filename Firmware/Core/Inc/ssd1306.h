@@ -120,10 +120,25 @@ extern SPI_HandleTypeDef SSD1306_SPI_PORT;
 #define SSD1306_WIDTH           128
 #endif
 
+#ifndef SSD1306_DMA_TIMEOUT
+#define SSD1306_DMA_TIMEOUT     100     // ms to wait for a previous frame transfer
+#endif
+
 #ifndef SSD1306_BUFFER_SIZE
 #define SSD1306_BUFFER_SIZE   SSD1306_WIDTH * SSD1306_HEIGHT / 8
 #endif
 
+#ifdef SSD1306_USE_PACKED_FONTS
+// Number of decoded glyphs kept in RAM
+#ifndef SSD1306_GLYPH_CACHE_SIZE
+#define SSD1306_GLYPH_CACHE_SIZE    32
+#endif
+// Tallest packed font that can be decoded (Font_16x26)
+#ifndef SSD1306_GLYPH_MAX_HEIGHT
+#define SSD1306_GLYPH_MAX_HEIGHT    26
+#endif
+#endif
+
 // Enumeration for screen colors
 typedef enum {
     Black = 0x00, // Black color, no pixel
@@ -154,6 +169,7 @@ typedef struct {
 	const uint8_t height;               /**< Font height in pixels */
 	const uint16_t *const data;         /**< Pointer to font data array */
     const uint8_t *const char_width;    /**< Proportional character width in pixels (NULL for monospaced) */
+    const uint8_t *const packed;        /**< Bit-packed glyphs when data is NULL (see Tools/ssd1306_font_pack.py) */
 } SSD1306_Font_t;
 
 // Procedure definitions
@@ -186,6 +202,21 @@ SSD1306_Error_t ssd1306_InvertRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint
 
 void ssd1306_DrawBitmap(uint8_t x, uint8_t y, const unsigned char* bitmap, uint8_t w, uint8_t h, SSD1306_COLOR color);
 
+/**
+ * @brief Draw a bitmap stored in page-major (GDDRAM) layout
+ *
+ * @param pages ceil(h/8) bands of w bytes each, bit 0 = top pixel of the byte
+ * @note Set bits are drawn in color, clear bits leave the buffer untouched.
+ */
+void ssd1306_DrawBitmapPaged(uint8_t x, uint8_t y, const uint8_t* pages, uint8_t w, uint8_t h, SSD1306_COLOR color);
+
+/**
+ * @brief Convert a row-major bitmap into page-major layout
+ *
+ * @param pages Output buffer of w * ceil(h/8) bytes
+ */
+void ssd1306_BitmapToPages(const unsigned char* bitmap, uint8_t w, uint8_t h, uint8_t* pages);
+
 /**
  * @brief Sets the contrast of the display.
  * @param[in] value contrast to set.
@@ -207,6 +238,19 @@ void ssd1306_SetDisplayOn(const uint8_t on);
  */
 uint8_t ssd1306_GetDisplayOn();
 
+#if defined(SSD1306_USE_SPI) && defined(SSD1306_USE_DMA)
+/**
+ * @brief Must be called from HAL_SPI_TxCpltCallback; ends the frame transfer.
+ */
+void ssd1306_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief Reads whether a frame transfer is still in progress.
+ * @return  0: idle, 1: DMA running.
+ */
+uint8_t ssd1306_IsBusy(void);
+#endif
+
 // Low-level procedures
 void ssd1306_Reset(void);
 void ssd1306_WriteCommand(uint8_t byte);
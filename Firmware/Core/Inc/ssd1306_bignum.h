@@ -0,0 +1,65 @@
+/**
+ * Large numeric renderer for the SSD1306 driver.
+ *
+ * Digits are composed from seven-segment style spans drawn with
+ * ssd1306_FillRectangle, so any size costs no font flash. Each field
+ * remembers which segments it has drawn and only redraws the difference.
+ */
+
+#ifndef __SSD1306_BIGNUM_H__
+#define __SSD1306_BIGNUM_H__
+
+#include <_ansi.h>
+
+_BEGIN_STD_C
+
+#include "ssd1306.h"
+
+// Maximum number of character cells in one field
+#ifndef SSD1306_BIGNUM_MAX_CELLS
+#define SSD1306_BIGNUM_MAX_CELLS    8
+#endif
+
+/** Numeric display field */
+typedef struct {
+    uint8_t x;                  /**< Top left corner of the first cell */
+    uint8_t y;
+    uint8_t digit_w;            /**< Cell width in pixels */
+    uint8_t digit_h;            /**< Cell height in pixels */
+    uint8_t thickness;          /**< Segment thickness in pixels */
+    uint8_t gap;                /**< Space between cells, holds the decimal point */
+    uint8_t cells;              /**< Number of cells in use */
+    uint16_t drawn[SSD1306_BIGNUM_MAX_CELLS]; /**< Segments currently in the screenbuffer */
+} SSD1306_BigNum_t;
+
+/**
+ * @brief Set up a field; nothing is drawn until the first write
+ *
+ * @param digit_w,digit_h Size of one digit cell (the scale)
+ * @param thickness Segment thickness, at most a third of digit_w
+ * @param cells Number of cells, up to SSD1306_BIGNUM_MAX_CELLS
+ */
+void ssd1306_BigNumInit(SSD1306_BigNum_t *field, uint8_t x, uint8_t y, uint8_t digit_w, uint8_t digit_h,
+                        uint8_t thickness, uint8_t cells);
+
+/**
+ * @brief Show a string of '0'-'9', '-', '+', ' ' and '.'
+ *
+ * A '.' is drawn as the decimal point of the preceding cell. Cells past the
+ * end of the string are blanked. Only changed segments are redrawn.
+ */
+void ssd1306_BigNumWriteString(SSD1306_BigNum_t *field, const char *str, SSD1306_COLOR color);
+
+/**
+ * @brief Show a number with a fixed number of decimals, right aligned
+ */
+void ssd1306_BigNumWriteFloat(SSD1306_BigNum_t *field, float value, uint8_t decimals, SSD1306_COLOR color);
+
+/**
+ * @brief Forget what is on screen, e.g. after ssd1306_Fill(); the next write redraws everything
+ */
+void ssd1306_BigNumInvalidate(SSD1306_BigNum_t *field);
+
+_END_STD_C
+
+#endif // __SSD1306_BIGNUM_H__
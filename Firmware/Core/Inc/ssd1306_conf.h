@@ -20,11 +20,16 @@
 //#define STM32C0
 //#define STM32U5
 
-// Choose a bus
-#ifndef SSD1306_USE_I2C
+// Choose a bus: I2C unless the build passes -DSSD1306_USE_SPI
+#if !defined(SSD1306_USE_I2C) && !defined(SSD1306_USE_SPI)
 #define SSD1306_USE_I2C
 #endif
-//#define SSD1306_USE_SPI
+
+// SPI only: send each frame as one DMA transfer (one CS assertion, DC
+// toggled once). Needs a DMA TX stream linked to SSD1306_SPI_PORT and
+// HAL_SPI_TxCpltCallback forwarding to ssd1306_SPI_TxCpltCallback.
+// Not for SH1106 panels, which lack the column/page window commands.
+//#define SSD1306_USE_DMA
 
 // I2C Configuration
 #define SSD1306_I2C_PORT        hi2c1
@@ -56,6 +61,12 @@
 
 #define SSD1306_INCLUDE_FONT_16x15
 
+// Store fonts bit-packed (ssd1306_fonts_packed.c, generated from
+// ssd1306_fonts.c by Tools/ssd1306_font_pack.py) and decode glyphs
+// on demand into a small RAM cache
+#define SSD1306_USE_PACKED_FONTS
+// #define SSD1306_GLYPH_CACHE_SIZE    32
+
 // The width of the screen can be set using this
 // define. The default value is 128.
 // #define SSD1306_WIDTH           64
@@ -8,6 +8,7 @@ _BEGIN_STD_C
 void ssd1306_TestBorder(void);
 void ssd1306_TestFonts1(void);
 void ssd1306_TestFonts2(void);
+void ssd1306_TestFonts3(void);
 void ssd1306_TestFPS(void);
 void ssd1306_TestAll(void);
 void ssd1306_TestLine(void);
@@ -18,6 +19,7 @@ void ssd1306_TestCircle(void);
 void ssd1306_TestArc(void);
 void ssd1306_TestPolyline(void);
 void ssd1306_TestDrawBitmap(void);
+void ssd1306_TestBigNum(void);
 
 _END_STD_C
 
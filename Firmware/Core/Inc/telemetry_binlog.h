@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry_binlog.h
+  * @brief          : Binary telemetry log format, shared with the host decoder.
+  *
+  *                   A log is a sequence of 512-byte sectors, each framed and
+  *                   checked on its own:
+  *
+  *                     0    magic   u16   TELEMETRY_BINLOG_MAGIC
+  *                     2    seq     u32   sector number within the file
+  *                     6    payload       file header or packed records
+  *                     506  count   u16   records in the sector
+  *                     508  crc     u32   CRC-32 of bytes 0..507, seeded
+  *                                          with the file ID
+  *
+  *                   Sector 0 is the file header. It carries the format
+  *                   version, the record size and one descriptor per field
+  *                   (name, type, offset, decimal places), so a decoder can
+  *                   read the records without built-in knowledge of them.
+  *                   All values are little-endian.
+  *
+  *                   The header also holds the file ID (version 4), picked
+  *                   anew for every log. Seeding every sector's CRC with it
+  *                   ties the sectors to their file: one left on the card by
+  *                   an earlier log at the same place fails its check even
+  *                   with the right magic and seq. Older logs have 0 there,
+  *                   which leaves the CRC as it was.
+  *
+  *                   Records are in TimeMS order, except that history a
+  *                   black box event logs late may follow records up to
+  *                   the header's history window newer (version 5, 0 when
+  *                   records are never logged late). A decoder merges it
+  *                   back by TimeMS.
+  *
+  *                   A plain record sector holds up to
+  *                   TELEMETRY_BINLOG_RECORDS_PER_SECTOR fixed-size records.
+  *                   A packed sector (TELEMETRY_BINLOG_PACKED_MAGIC, version
+  *                   3) holds its first record as is, then each record as
+  *                   the changes from the one before:
+  *
+  *                     mask    varint  bit i set if field (count - 1 - i)
+  *                                     changed, so the clock fields at the
+  *                                     front of the record take the high bits
+  *                     deltas  varint  per changed field in field order,
+  *                                     zigzag coded, modulo 2^32
+  *
+  *                   Values are taken as 32 bits, signed types sign-extended.
+  *                   Field 0, TimeMS, is coded as the change in its step
+  *                   from the record before (the step being 0 at the start
+  *                   of the sector), so a steady rate costs nothing. Each
+  *                   sector decodes on its own.
+  *
+  *                   A sector still filling is written with the records it
+  *                   has so far, sealed with their count, and written again
+  *                   as it fills. Logs from version 1 firmware may instead
+  *                   end in a short, unsealed sector.
+  *
+  *                   A closed log (version 2) ends in an index trailer: one
+  *                   or more sectors with TELEMETRY_BINLOG_INDEX_MAGIC,
+  *                   numbered on from the record sectors. Each holds the seq
+  *                   of the first index sector, so reading the last sector of
+  *                   the file finds them all, and (time, byte offset) pairs
+  *                   giving the TimeMS of the first record of every few
+  *                   sectors, for seeking by time.
+  *
+  *                   This header and telemetry_binlog.c do not depend on the
+  *                   HAL and build on the host as they are.
+  ******************************************************************************
+  */
+
+#ifndef __TELEMETRY_BINLOG_H
+#define __TELEMETRY_BINLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define TELEMETRY_BINLOG_SECTOR               512U
+#define TELEMETRY_BINLOG_MAGIC                0x4C54U   // "TL"
+#define TELEMETRY_BINLOG_VERSION              5U
+
+/* Sector frame */
+#define TELEMETRY_BINLOG_SEQ_OFFSET           2U
+#define TELEMETRY_BINLOG_PAYLOAD_OFFSET       6U
+#define TELEMETRY_BINLOG_COUNT_OFFSET         506U
+#define TELEMETRY_BINLOG_CRC_OFFSET           508U
+#define TELEMETRY_BINLOG_PAYLOAD              (TELEMETRY_BINLOG_COUNT_OFFSET - TELEMETRY_BINLOG_PAYLOAD_OFFSET)
+
+/* Packed record sector; every packed record takes at least one byte */
+#define TELEMETRY_BINLOG_PACKED_MAGIC         0x5A54U   // "TZ"
+#define TELEMETRY_BINLOG_PACKED_PER_SECTOR    (TELEMETRY_BINLOG_PAYLOAD - TELEMETRY_BINLOG_RECORD_SIZE + 1U)
+
+/* File header payload, in sector 0 */
+#define TELEMETRY_BINLOG_HDR_ID               "TLMB"
+#define TELEMETRY_BINLOG_HDR_VERSION          4U    // u16
+#define TELEMETRY_BINLOG_HDR_RECORD_SIZE      6U    // u16
+#define TELEMETRY_BINLOG_HDR_PER_SECTOR       8U    // u16
+#define TELEMETRY_BINLOG_HDR_FIELD_COUNT      10U   // u16
+#define TELEMETRY_BINLOG_HDR_FIELDS           12U   // Field descriptors
+#define TELEMETRY_BINLOG_HDR_FILE_ID          (TELEMETRY_BINLOG_PAYLOAD - 4U)   // u32, after the descriptors
+#define TELEMETRY_BINLOG_HDR_HISTORY_MS       (TELEMETRY_BINLOG_PAYLOAD - 8U)   // u32, history window
+
+/* Index trailer payload: seq of the first index sector, then entries */
+#define TELEMETRY_BINLOG_INDEX_MAGIC          0x5849U   // "IX"
+#define TELEMETRY_BINLOG_INDEX_FIRST          0U    // u32
+#define TELEMETRY_BINLOG_INDEX_ENTRIES        4U    // Entries: u32 TimeMS, u32 byte offset
+#define TELEMETRY_BINLOG_INDEX_ENTRY_SIZE     8U
+#define TELEMETRY_BINLOG_INDEX_PER_SECTOR     ((TELEMETRY_BINLOG_PAYLOAD - TELEMETRY_BINLOG_INDEX_ENTRIES) / TELEMETRY_BINLOG_INDEX_ENTRY_SIZE)
+
+/* Field descriptor: name (NUL padded), type, offset, decimal places, reserved */
+#define TELEMETRY_BINLOG_NAME_LEN             12U
+#define TELEMETRY_BINLOG_DESC_SIZE            (TELEMETRY_BINLOG_NAME_LEN + 4U)
+
+/* Record layout */
+#define TELEMETRY_BINLOG_RECORD_SIZE          20U
+#define TELEMETRY_BINLOG_RECORDS_PER_SECTOR   (TELEMETRY_BINLOG_PAYLOAD / TELEMETRY_BINLOG_RECORD_SIZE)
+
+/* Longest packed record: a 2-byte mask and every field changing by its
+   full range (TimeMS 5 bytes, Altitude 4, the 16-bit fields 3, the 8-bit 2) */
+#define TELEMETRY_BINLOG_PACKED_MAX           32U
+
+/** Field storage types; values are integers scaled by 10^decimals */
+typedef enum {
+    TELEMETRY_BINLOG_U8 = 1,
+    TELEMETRY_BINLOG_U16,
+    TELEMETRY_BINLOG_I16,
+    TELEMETRY_BINLOG_I24,
+    TELEMETRY_BINLOG_U32
+} TelemetryBinlog_Type_t;
+
+/** Fields of the version 1 record, in TelemetryBinlog_Fields order */
+typedef enum {
+    TELEMETRY_BINLOG_TIME_MS = 0,
+    TELEMETRY_BINLOG_HOURS,
+    TELEMETRY_BINLOG_MINUTES,
+    TELEMETRY_BINLOG_SECONDS,
+    TELEMETRY_BINLOG_ALTITUDE,
+    TELEMETRY_BINLOG_SPEED,
+    TELEMETRY_BINLOG_VOLTAGE,
+    TELEMETRY_BINLOG_ALTITUDE_RATE,
+    TELEMETRY_BINLOG_SPEED_RATE,
+    TELEMETRY_BINLOG_VOLTAGE_RATE,
+    TELEMETRY_BINLOG_FIELD_COUNT
+} TelemetryBinlog_FieldId_t;
+
+typedef struct {
+    const char *name;
+    uint8_t type;
+    uint8_t offset;
+    uint8_t decimals;
+} TelemetryBinlog_Field_t;
+
+/** State carried through a packed sector: the last record and its TimeMS step */
+typedef struct {
+    uint32_t value[TELEMETRY_BINLOG_FIELD_COUNT];
+    uint32_t interval;
+} TelemetryBinlog_Packer_t;
+
+extern const TelemetryBinlog_Field_t TelemetryBinlog_Fields[TELEMETRY_BINLOG_FIELD_COUNT];
+
+uint32_t TelemetryBinlog_Crc32(const uint8_t *data, uint32_t len);
+uint32_t TelemetryBinlog_Crc32Update(uint32_t crc, const uint8_t *data, uint32_t len);
+void TelemetryBinlog_BuildHeader(uint8_t *sector, uint32_t file_id, uint32_t history_ms);
+uint32_t TelemetryBinlog_FileId(const uint8_t *header);
+void TelemetryBinlog_BeginSector(uint8_t *sector, uint32_t seq);
+void TelemetryBinlog_BeginPacked(uint8_t *sector, uint32_t seq);
+void TelemetryBinlog_SealSector(uint8_t *sector, uint16_t count, uint32_t file_id);
+int32_t TelemetryBinlog_CheckSector(const uint8_t *sector, uint32_t seq, uint32_t file_id);
+void TelemetryBinlog_BeginIndex(uint8_t *sector, uint32_t seq, uint32_t first);
+void TelemetryBinlog_PutIndex(uint8_t *sector, uint32_t slot, uint32_t time_ms, uint32_t offset);
+int32_t TelemetryBinlog_CheckIndex(const uint8_t *sector, uint32_t seq, uint32_t file_id);
+
+void TelemetryBinlog_PackFirst(TelemetryBinlog_Packer_t *packer, const uint8_t *record);
+uint32_t TelemetryBinlog_Pack(TelemetryBinlog_Packer_t *packer, const uint8_t *record, uint8_t *out);
+int32_t TelemetryBinlog_Unpack(TelemetryBinlog_Packer_t *packer, const uint8_t *in, uint32_t avail);
+int32_t TelemetryBinlog_PackedEnd(const uint8_t *sector, uint32_t count, TelemetryBinlog_Packer_t *packer);
+
+void TelemetryBinlog_Put(uint8_t *record, const TelemetryBinlog_Field_t *field, int64_t value);
+void TelemetryBinlog_PutFixed(uint8_t *record, const TelemetryBinlog_Field_t *field, float value);
+int64_t TelemetryBinlog_Get(const uint8_t *record, uint8_t type, uint8_t offset);
+uint32_t TelemetryBinlog_Get16(const uint8_t *p);
+uint32_t TelemetryBinlog_Get32(const uint8_t *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_BINLOG_H */
@@ -0,0 +1,86 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry_download.h
+  * @brief          : Log file download over USART1, shared with the host
+  *                   client (Host_Tools/telemetry_fetch).
+  *
+  *                   The host asks with a line at the telemetry baud rate:
+  *
+  *                     GET <file> [<offset> [<length> [<baud>]]]
+  *
+  *                   for log file number <file> (LOG00012.BIN for 12) from
+  *                   byte offset, length bytes (0: to the end), sent at
+  *                   baud (0: the current rate). The reply is a line at the
+  *                   current rate:
+  *
+  *                     OK <size> <offset> <length> <baud>
+  *                     ERR <reason>
+  *
+  *                   after which the UART switches to baud, waits
+  *                   TELEMETRY_DOWNLOAD_SETTLE_MS for the host to follow,
+  *                   and sends the range as frames:
+  *
+  *                     0    magic   u16   TELEMETRY_DOWNLOAD_MAGIC
+  *                     2    type    u8    TELEMETRY_DOWNLOAD_DATA/END/FAIL
+  *                     3    0       u8
+  *                     4    offset  u32   file position of the payload
+  *                     8    length  u16   payload bytes
+  *                     10   payload
+  *                     10+length    u32   CRC-32 of the bytes before it
+  *
+  *                   Data frames hold up to TELEMETRY_DOWNLOAD_CHUNK bytes,
+  *                   cut at chunk boundaries of the file so the card reads
+  *                   whole sectors. The last frame is END, at the end of the
+  *                   range, with the CRC-32 of all data sent as its payload;
+  *                   or FAIL, where a card read failed. "STOP" at the
+  *                   transfer rate ends it after the frame on the wire. The
+  *                   UART then returns to the telemetry rate. A transfer
+  *                   that broke off is resumed with a GET from the last good
+  *                   offset. All values are little-endian, CRC-32 as
+  *                   TelemetryBinlog_Crc32.
+  *
+  *                   The log being written is not offered: its size is only
+  *                   known once it is closed.
+  ******************************************************************************
+  */
+
+#ifndef __TELEMETRY_DOWNLOAD_H
+#define __TELEMETRY_DOWNLOAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Payload of a data frame; whole sectors, so FatFs reads them with CMD18
+ * straight into the frame */
+#define TELEMETRY_DOWNLOAD_CHUNK          4096U
+
+/* Between the OK line and the first frame, for the host to change rate */
+#ifndef TELEMETRY_DOWNLOAD_SETTLE_MS
+#define TELEMETRY_DOWNLOAD_SETTLE_MS      50U
+#endif
+
+#define TELEMETRY_DOWNLOAD_MAGIC          0x4644U   // "DF"
+#define TELEMETRY_DOWNLOAD_DATA           0U
+#define TELEMETRY_DOWNLOAD_END            1U
+#define TELEMETRY_DOWNLOAD_FAIL           2U
+#define TELEMETRY_DOWNLOAD_HEADER         10U
+#define TELEMETRY_DOWNLOAD_TRAILER        4U
+#define TELEMETRY_DOWNLOAD_FRAME_MAX      (TELEMETRY_DOWNLOAD_HEADER + TELEMETRY_DOWNLOAD_CHUNK + TELEMETRY_DOWNLOAD_TRAILER)
+
+#if (TELEMETRY_DOWNLOAD_CHUNK % 512U) != 0 || TELEMETRY_DOWNLOAD_CHUNK > 0xFFFFU
+#error "TELEMETRY_DOWNLOAD_CHUNK must be whole sectors and fit the u16 length"
+#endif
+
+void TelemetryDownload_Start(uint32_t number, uint32_t offset, uint32_t length, uint32_t baud);
+void TelemetryDownload_Stop(void);
+void TelemetryDownload_Poll(void);
+uint8_t TelemetryDownload_IsActive(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_DOWNLOAD_H */
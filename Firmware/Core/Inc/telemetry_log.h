@@ -0,0 +1,269 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry_log.h
+  * @brief          : Buffered telemetry logging to the SD card.
+  *
+  *                   The log file stays open for the whole session. Records
+  *                   fill a ring of 512-byte sector buffers that mirrors the
+  *                   file layout; while one sector fills, full ones drain to
+  *                   the card by DMA as soon as it is idle, so card busy time
+  *                   does not hold up the superloop. Buffered data is
+  *                   committed (written and synced) by the sync policy: once
+  *                   it has waited a set time, every so many records, or
+  *                   only at TelemetryLog_Mark. What a power cut can lose is
+  *                   what was not yet committed: a partly filled sector
+  *                   committed again goes to the place after the copy
+  *                   before, so a torn write never takes committed records
+  *                   with it. On the next mount the log is scanned back to
+  *                   its last sector with a valid CRC, the newest copy kept
+  *                   and anything torn after it cut off
+  *                   (Host_Tools powercut_test checks this).
+  *
+  *                   Records are logged as 20-byte binary records in
+  *                   CRC-checked sectors (telemetry_binlog.h), decoded on
+  *                   the host by Host_Tools/telemetry_decode. Each sector
+  *                   packs its records as changes from the one before, which
+  *                   takes flight data to about 3 bytes a record; sectors
+  *                   still decode on their own. Values round as printf
+  *                   rounds them, so telemetry_decode --legacy rebuilds the
+  *                   CSV log byte for byte; build with
+  *                   TELEMETRY_LOG_BINARY=0 to log the CSV itself.
+  *
+  *                   A new binary log is preallocated as one contiguous run
+  *                   of TELEMETRY_LOG_PREALLOC bytes and its sectors streamed
+  *                   to the card with a single open multi-block write, so
+  *                   FatFs and the FAT are left alone until the file is
+  *                   closed. If the card cannot give a contiguous run, or the
+  *                   run fills, logging carries on through FatFs.
+  *
+  *                   Each boot logs to a new numbered file, LOG00001.BIN and
+  *                   on; the previous file is finished first if power was
+  *                   lost before it was closed. A file is closed and the next
+  *                   one started once it reaches TELEMETRY_LOG_ROTATE_BYTES
+  *                   or has been open TELEMETRY_LOG_ROTATE_MS. Closing a
+  *                   binary log appends its index trailer (telemetry_binlog.h)
+  *                   so the host can seek to a time without scanning.
+  *
+  *                   Between events the log holds one record in
+  *                   TELEMETRY_LOG_DECIMATE. Records reach the log through
+  *                   a ring that holds back the last few seconds at the full
+  *                   rate; an event (a fast voltage sag or altitude drop, or
+  *                   TelemetryLog_Trigger) logs all of it and every record
+  *                   for a while after, so the log has the full-rate history
+  *                   on both sides of the event and stays in time order.
+  ******************************************************************************
+  */
+
+#ifndef __TELEMETRY_LOG_H
+#define __TELEMETRY_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+/* Sector size of the card and of the log buffer layout */
+#define TELEMETRY_LOG_SECTOR          512U
+
+/* Sector buffers in the ring; covers this many sectors of card busy time */
+#ifndef TELEMETRY_LOG_SECTORS
+#define TELEMETRY_LOG_SECTORS         8U
+#endif
+
+/* Full sectors start draining once this many bytes are queued */
+#ifndef TELEMETRY_LOG_FLUSH_BYTES
+#define TELEMETRY_LOG_FLUSH_BYTES     (2U * TELEMETRY_LOG_SECTOR)
+#endif
+
+/* Oldest unsynced data is committed after this long, bounding loss on power cut */
+#ifndef TELEMETRY_LOG_FLUSH_MS
+#define TELEMETRY_LOG_FLUSH_MS        1000U
+#endif
+
+/** When buffered data is committed */
+typedef enum {
+    TELEMETRY_LOG_SYNC_TIME = 0,      // Once the oldest data has waited 'every' ms
+    TELEMETRY_LOG_SYNC_RECORDS,       // Every 'every' records
+    TELEMETRY_LOG_SYNC_MARKER         // Only at TelemetryLog_Mark (and when closing)
+} TelemetryLog_SyncPolicy_t;
+
+/* Policy in force after boot; TelemetryLog_SetSyncPolicy changes it */
+#ifndef TELEMETRY_LOG_SYNC_POLICY
+#define TELEMETRY_LOG_SYNC_POLICY     TELEMETRY_LOG_SYNC_TIME
+#endif
+
+#ifndef TELEMETRY_LOG_SYNC_EVERY
+#define TELEMETRY_LOG_SYNC_EVERY      TELEMETRY_LOG_FLUSH_MS
+#endif
+
+/* Log packed binary records rather than CSV text */
+#ifndef TELEMETRY_LOG_BINARY
+#define TELEMETRY_LOG_BINARY          1
+#endif
+
+/* Pack binary records as changes from the previous one */
+#ifndef TELEMETRY_LOG_PACKED
+#define TELEMETRY_LOG_PACKED          TELEMETRY_LOG_BINARY
+#endif
+
+/* Bytes preallocated for a new binary log; 0 writes through FatFs */
+#ifndef TELEMETRY_LOG_PREALLOC
+#define TELEMETRY_LOG_PREALLOC        (TELEMETRY_LOG_BINARY ? (16UL * 1024UL * 1024UL) : 0UL)
+#endif
+
+/* Erase a new preallocated log (CTRL_TRIM) before streaming into it, so the
+ * card programs it without erasing as it goes; the mount step that
+ * preallocates blocks while the card erases */
+#ifndef TELEMETRY_LOG_PRE_ERASE
+#define TELEMETRY_LOG_PRE_ERASE       1
+#endif
+
+/* Records held in RAM while no card is mounted, and written once one is;
+ * a write error puts the records it had not committed back here. The
+ * oldest go first when it fills (0: records are dropped) */
+#ifndef TELEMETRY_LOG_BACKLOG_RECORDS
+#define TELEMETRY_LOG_BACKLOG_RECORDS 64U
+#endif
+
+/* Mount retries from TelemetryLog_Poll: the wait starts at MIN and doubles
+ * after each failed attempt up to MAX, since every attempt on a missing or
+ * dead card is a blocking init. A session that fails before its first
+ * commit counts as a failed attempt; after one that committed, the card is
+ * retried at once */
+#ifndef TELEMETRY_LOG_MOUNT_RETRY_MIN_MS
+#define TELEMETRY_LOG_MOUNT_RETRY_MIN_MS  250U
+#endif
+#ifndef TELEMETRY_LOG_MOUNT_RETRY_MAX_MS
+#define TELEMETRY_LOG_MOUNT_RETRY_MAX_MS  8000U
+#endif
+
+/* Black box: outside an event only every DECIMATE'th record is logged, as
+ * it arrives, while the others from the last TELEMETRY_LOG_BLACKBOX_MS wait
+ * in a RAM ring of TELEMETRY_LOG_BLACKBOX_RECORDS. An event logs that
+ * history, then every record for TELEMETRY_LOG_EVENT_MS. 1 logs every record
+ * and leaves the ring out */
+#ifndef TELEMETRY_LOG_DECIMATE
+#define TELEMETRY_LOG_DECIMATE        5U
+#endif
+#ifndef TELEMETRY_LOG_BLACKBOX_MS
+#define TELEMETRY_LOG_BLACKBOX_MS     10000U
+#endif
+#ifndef TELEMETRY_LOG_BLACKBOX_RECORDS
+#define TELEMETRY_LOG_BLACKBOX_RECORDS 64U     // 16 s of the 4 in 5 held at 5 Hz
+#endif
+#ifndef TELEMETRY_LOG_EVENT_MS
+#define TELEMETRY_LOG_EVENT_MS        10000U
+#endif
+
+/* Records that fire an event by themselves: a voltage sag or an altitude
+ * drop faster than these rates (V/s, m/s; 0 turns the check off). The host
+ * fires one with TelemetryLog_Trigger */
+#ifndef TELEMETRY_LOG_EVENT_VOLTAGE_RATE
+#define TELEMETRY_LOG_EVENT_VOLTAGE_RATE  (-0.6f)
+#endif
+#ifndef TELEMETRY_LOG_EVENT_ALTITUDE_RATE
+#define TELEMETRY_LOG_EVENT_ALTITUDE_RATE (-15.0f)
+#endif
+
+/* Log files are PREFIX + 5 digit number + EXT, an 8.3 name. Numbering
+ * stops at NUMBER_MAX; from there each new file replaces that one */
+#define TELEMETRY_LOG_PREFIX          "LOG"
+#define TELEMETRY_LOG_NUMBER_MAX      99999UL
+#if TELEMETRY_LOG_BINARY
+#define TELEMETRY_LOG_EXT             ".BIN"
+#else
+#define TELEMETRY_LOG_EXT             ".CSV"
+#endif
+
+/* Start the next file at this size; sized to the preallocation so a file
+ * stays contiguous */
+#ifndef TELEMETRY_LOG_ROTATE_BYTES
+#define TELEMETRY_LOG_ROTATE_BYTES    (TELEMETRY_LOG_PREALLOC ? TELEMETRY_LOG_PREALLOC : (16UL * 1024UL * 1024UL))
+#endif
+
+/* Start the next file after this long; 0 rotates by size only */
+#ifndef TELEMETRY_LOG_ROTATE_MS
+#define TELEMETRY_LOG_ROTATE_MS       (30UL * 60UL * 1000UL)
+#endif
+
+/* Index entry every this many records (whole sectors of records); packed,
+ * the same number of sectors holds several times as many */
+#ifndef TELEMETRY_LOG_INDEX_RECORDS
+#define TELEMETRY_LOG_INDEX_RECORDS   250U
+#endif
+
+/* Index entries kept per file; once full, every other one is dropped and
+ * the spacing doubles */
+#ifndef TELEMETRY_LOG_INDEX_MAX
+#define TELEMETRY_LOG_INDEX_MAX       124U
+#endif
+
+#if (TELEMETRY_LOG_FLUSH_BYTES % TELEMETRY_LOG_SECTOR) != 0 || \
+    TELEMETRY_LOG_FLUSH_BYTES > (TELEMETRY_LOG_SECTORS - 1U) * TELEMETRY_LOG_SECTOR
+#error "TELEMETRY_LOG_FLUSH_BYTES must be whole sectors, leaving one sector of headroom"
+#endif
+
+#if TELEMETRY_LOG_PREALLOC && !TELEMETRY_LOG_BINARY
+#error "TELEMETRY_LOG_PREALLOC needs the binary log, which writes whole sectors"
+#endif
+
+#if TELEMETRY_LOG_PACKED && !TELEMETRY_LOG_BINARY
+#error "TELEMETRY_LOG_PACKED needs the binary log"
+#endif
+
+#if (TELEMETRY_LOG_PREALLOC % TELEMETRY_LOG_SECTOR) != 0
+#error "TELEMETRY_LOG_PREALLOC must be whole sectors"
+#endif
+
+#if TELEMETRY_LOG_DECIMATE == 0 || (TELEMETRY_LOG_DECIMATE > 1U && TELEMETRY_LOG_BLACKBOX_RECORDS == 0)
+#error "TELEMETRY_LOG_DECIMATE must be non-zero, and needs the black box ring above 1"
+#endif
+
+#if TELEMETRY_LOG_INDEX_MAX == 0 || (TELEMETRY_LOG_INDEX_MAX % 2U) != 0
+#error "TELEMETRY_LOG_INDEX_MAX must be even and non-zero"
+#endif
+
+/** Logging counters, reset on each mount */
+typedef struct {
+    uint32_t records;        // Records accepted into the buffer
+    uint32_t errors;         // Write errors, each ending the session
+    uint32_t sectors;        // Full sectors written
+    uint32_t commits;        // Partial sector commits (f_sync, or a stream sync)
+    uint32_t overflows;      // Ring full, a sector was written synchronously
+    uint32_t files;          // Files rotated to
+    uint32_t max_queued;     // Most full sectors waiting at once
+    uint32_t max_stall_ms;   // Longest time a logging call held the superloop
+    uint32_t first_tick;     // HAL tick of the first and latest record
+    uint32_t last_tick;
+    uint32_t disk_ops;       // diskio read/write/sync calls since mount
+    uint32_t mount_ms;       // Time the mount steps took, card initialisation included
+    uint32_t ready_tick;     // HAL tick when the log was ready for records; after
+                             // boot, the time from power-on to the first write
+    uint32_t backlog;        // Records in RAM waiting for a card
+    uint32_t dropped;        // Records lost with the RAM full, or CSV lines lost
+                             // to a write error, since boot
+    uint32_t mount_failures; // Mount attempts that failed, since boot
+    uint32_t events;         // Black box events fired, since boot
+    uint32_t decimated;      // Records left out between events, since boot
+} TelemetryLog_Stats_t;
+
+void Mount_SD_Card(void);
+void Telemetry_Log(const TelemetryData_t *data);
+void TelemetryLog_Poll(void);
+void TelemetryLog_Flush(void);
+void TelemetryLog_Mark(void);
+void TelemetryLog_SetSyncPolicy(TelemetryLog_SyncPolicy_t policy, uint32_t every);
+void TelemetryLog_Close(void);
+void TelemetryLog_Trigger(void);
+uint8_t TelemetryLog_IsMounted(void);
+uint32_t TelemetryLog_FileNumber(void);
+const TelemetryLog_Stats_t *TelemetryLog_GetStats(void);
+float TelemetryLog_RecordsPerSecond(void);
+float TelemetryLog_OpsPerRecord(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_LOG_H */
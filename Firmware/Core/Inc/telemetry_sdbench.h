@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry_sdbench.h
+  * @brief          : SD card throughput benchmark, run at boot with B1 held.
+  *
+  *                   A test file of TELEMETRY_SDBENCH_BYTES is preallocated
+  *                   contiguously with f_expand and its sectors written,
+  *                   then read back and checked, once per pattern and
+  *                   record size:
+  *
+  *                     single  one CMD24 per sector (CMD17 to read), as
+  *                             FatFs writes its FAT and directory sectors
+  *                     multi   one CMD25 per record (CMD18 to read), as
+  *                             FatFs writes whole sectors of a file
+  *                     stream  one open CMD25 over the whole file with an
+  *                             ACMD23 pre-erase hint (USER_StreamWrite), as
+  *                             the logger writes a preallocated log; read
+  *                             back as multi
+  *
+  *                   Each write or read call is timed with the cycle
+  *                   counter into the same log2 histogram as SD_Timing.
+  *                   Throughput counts the final sync or stream stop, which
+  *                   the per-call latencies leave out. The file is deleted
+  *                   at the end.
+  *
+  *                   The code runs on the host too, over the disk image
+  *                   backend (Host_Tools/sdbench_image), for comparison.
+  ******************************************************************************
+  */
+
+#ifndef __TELEMETRY_SDBENCH_H
+#define __TELEMETRY_SDBENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "fatfs.h"
+
+/* Test file, written and read back by every case */
+#define TELEMETRY_SDBENCH_FILE        "SDBENCH.BIN"
+#ifndef TELEMETRY_SDBENCH_BYTES
+#define TELEMETRY_SDBENCH_BYTES       (1024UL * 1024UL)
+#endif
+
+/* Record sizes, bytes per write or read call; the largest sets the buffer */
+#define TELEMETRY_SDBENCH_SIZES       3U
+#define TELEMETRY_SDBENCH_RECORD_MAX  8192U
+
+#if (TELEMETRY_SDBENCH_BYTES % TELEMETRY_SDBENCH_RECORD_MAX) != 0
+#error "TELEMETRY_SDBENCH_BYTES must be a whole number of the largest records"
+#endif
+
+typedef enum {
+    TELEMETRY_SDBENCH_SINGLE = 0,
+    TELEMETRY_SDBENCH_MULTI,
+    TELEMETRY_SDBENCH_STREAM,
+    TELEMETRY_SDBENCH_PATTERNS
+} TelemetrySdbench_Pattern_t;
+
+#define TELEMETRY_SDBENCH_CASES       (TELEMETRY_SDBENCH_PATTERNS * TELEMETRY_SDBENCH_SIZES)
+
+/** One pass over the file, writing or reading */
+typedef struct {
+    SD_Timing_t calls;       // Latency of each call
+    uint32_t sync_us;        // Final sync or stream stop
+} TelemetrySdbench_Pass_t;
+
+/** One pattern at one record size */
+typedef struct {
+    uint8_t pattern;         // TelemetrySdbench_Pattern_t
+    uint32_t record;         // Bytes per call
+    uint32_t bytes;          // Written, then read back
+    uint32_t errors;         // Failed calls and sectors read back wrong
+    TelemetrySdbench_Pass_t write;
+    TelemetrySdbench_Pass_t read;
+} TelemetrySdbench_Result_t;
+
+/* Called after each case, e.g. to show progress */
+typedef void (*TelemetrySdbench_Report_t)(const TelemetrySdbench_Result_t *result);
+
+extern const char *const TelemetrySdbench_PatternNames[TELEMETRY_SDBENCH_PATTERNS];
+extern const uint32_t TelemetrySdbench_RecordSizes[TELEMETRY_SDBENCH_SIZES];
+
+FRESULT TelemetrySdbench_Run(TelemetrySdbench_Result_t results[TELEMETRY_SDBENCH_CASES],
+                             TelemetrySdbench_Report_t report);
+float TelemetrySdbench_MBps(const TelemetrySdbench_Result_t *result, const TelemetrySdbench_Pass_t *pass);
+int TelemetrySdbench_Format(const TelemetrySdbench_Result_t *result, uint32_t line, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_SDBENCH_H */
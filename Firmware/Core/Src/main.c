@@ -16,33 +16,18 @@
 #include <stdlib.h>
 #include "ssd1306.h"
 #include "ssd1306_fonts.h"
+#include "telemetry_log.h"
+#include "telemetry_download.h"
+#include "telemetry_sdbench.h"
 
 /* Private typedef -----------------------------------------------------------*/
-// --- Telemetry Data Structure ---
-typedef struct {
-    float altitude;
-    float speed;
-    float voltage;
-
-    uint32_t timestamp_ms;   // From log (milliseconds from flight start)
-    uint32_t hours;          // From log
-    uint32_t minutes;
-    uint32_t seconds;
-
-    // Previous (for rate calculation)
-    float altitude_prev;
-    float speed_prev;
-    float voltage_prev;
-    uint32_t timestamp_prev;
-
-    // Calculated rates
-    float altitude_rate;
-    float speed_rate;
-    float voltage_rate;
-} TelemetryData_t;
 
 /* Private define ------------------------------------------------------------*/
 #define RX_BUFFER_SIZE 128
+#define RX_RING_SIZE   1024   // ~1 s of 9600 baud, rides out SD card busy periods
+#define DIAG_REFRESH_MS 500   // Diagnostics page redraw, with or without telemetry
+#define BENCH_BAR_TOP   18    // Benchmark histogram bars, between the text lines
+#define BENCH_BAR_BOTTOM 55
 #define SD_CS_PORT GPIOB
 #define SD_CS_PIN  GPIO_PIN_10
 
@@ -50,74 +35,62 @@ typedef struct {
 I2C_HandleTypeDef hi2c1;
 SPI_HandleTypeDef hspi1;
 UART_HandleTypeDef huart1;
+DMA_HandleTypeDef hdma_spi1_rx;
+DMA_HandleTypeDef hdma_spi1_tx;
+DMA_HandleTypeDef hdma_usart1_tx;
 
 /* USER CODE BEGIN PV */
 TelemetryData_t g_telemetry = {0};
 uint8_t rx_buffer[RX_BUFFER_SIZE];
 uint8_t rx_char;
-FATFS fs;
-FIL fil;
-FRESULT f_res;
-uint32_t bytes_written;
-uint8_t is_mounted = 0;
+
+// UART bytes land here from the RX interrupt, so ingest continues while
+// the superloop is held up
+static uint8_t rx_ring[RX_RING_SIZE];
+static volatile uint16_t rx_ring_head;
+static volatile uint16_t rx_ring_tail;
+static uint8_t rx_it_byte;
+volatile uint32_t rx_overruns;    // Bytes lost to a full ring
+
+// B1 switches the OLED between telemetry and SD card diagnostics
+static uint8_t display_diag;
+static const char *const sd_op_names[SD_OP_COUNT] = {
+    "read", "write", "strm", "ready", "rxblk", "prog"
+};
+
+// Benchmark results, B1 held through reset; OLED names of the patterns
+static TelemetrySdbench_Result_t bench_results[TELEMETRY_SDBENCH_CASES];
+static uint32_t bench_done;
+static const char *const bench_short[TELEMETRY_SDBENCH_PATTERNS] = { "sgl", "mul", "str" };
 extern Diskio_drvTypeDef  USER_Driver;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_I2C1_Init(void);
 static void MX_USART1_UART_Init(void);
 static void MX_SPI1_Init(void);
 /* USER CODE BEGIN PFP */
 void Telemetry_ReceiveAndParse(void);
 void Telemetry_Display(const TelemetryData_t *data);
-void Telemetry_Log(const TelemetryData_t *data);
-void Mount_SD_Card(void);
+void Telemetry_DisplayDiag(void);
+void Telemetry_PollDisplay(void);
+void Telemetry_DumpStats(uint8_t clear);
+void Telemetry_SdBench(void);
 /* USER CODE END PFP */
 /* USER CODE BEGIN 0 */
 
-/** Attempt to mount SD card and write CSV header if file is new */
-void Mount_SD_Card(void)
-{
-    if (!is_mounted) {
-        f_res = f_mount(&fs, "", 1);
-        if (f_res == FR_OK) {
-            is_mounted = 1;
-            f_res = f_open(&fil, "telemetry.csv", FA_OPEN_ALWAYS | FA_WRITE);
-            if (f_res == FR_OK) {
-                if (f_size(&fil) == 0) {
-                    f_puts("TimeMS,Hour,Min,Sec,Altitude,Speed,Voltage\n", &fil);
-                }
-                f_close(&fil);
-            }
-        }
-    }
-}
-
-void Telemetry_Log(const TelemetryData_t *data)
-{
-    if (!is_mounted) {
-        Mount_SD_Card();
-        return;
-    }
-    char logBuffer[100];
-    sprintf(logBuffer, "%lu,%lu,%lu,%lu,%.2f,%.2f,%.2f\n",
-        data->timestamp_ms, data->hours, data->minutes, data->seconds,
-        data->altitude, data->speed, data->voltage);
-    f_res = f_open(&fil, "telemetry.csv", FA_OPEN_APPEND | FA_WRITE);
-    if (f_res == FR_OK)
-    {
-        f_write(&fil, logBuffer, strlen(logBuffer), (void*)&bytes_written);
-        f_sync(&fil);
-        f_close(&fil);
-    }
-}
-
 void Telemetry_Display(const TelemetryData_t *data)
 {
     char lineBuffer[32];
 
+    if (display_diag) {
+        Telemetry_DisplayDiag();
+        return;
+    }
+
     ssd1306_Fill(Black);
 
     // Line 1: Time
@@ -140,24 +113,316 @@ void Telemetry_Display(const TelemetryData_t *data)
     sprintf(lineBuffer, "V:%.2f(%+.3f)", data->voltage, data->voltage_rate);
     ssd1306_WriteString(lineBuffer, Font_7x10, White);
 
+    // Line 5: Log state; without a card, the records waiting in RAM
     ssd1306_SetCursor(0, 48);
-    ssd1306_WriteString(is_mounted ? "LOGGING: OK" : "LOGGING: FAIL", Font_6x8, White);
+    if (TelemetryLog_IsMounted()) {
+        ssd1306_WriteString("LOGGING: OK", Font_6x8, White);
+    } else {
+        sprintf(lineBuffer, "LOGGING: NO CARD %lu", (unsigned long)TelemetryLog_GetStats()->backlog);
+        ssd1306_WriteString(lineBuffer, Font_6x8, White);
+    }
+
+    // Line 6: Sustained log rate and card operations per record
+    ssd1306_SetCursor(0, 56);
+    sprintf(lineBuffer, "%.1frec/s %.2fop/rec", TelemetryLog_RecordsPerSecond(), TelemetryLog_OpsPerRecord());
+    ssd1306_WriteString(lineBuffer, Font_6x8, White);
+
+    ssd1306_UpdateScreen();
+}
+
+/** Shows mean and worst latency of each SD card operation and the busy waits */
+void Telemetry_DisplayDiag(void)
+{
+    char lineBuffer[32];
+
+    ssd1306_Fill(Black);
+
+    ssd1306_SetCursor(0, 0);
+    ssd1306_WriteString("SD us    avg     max", Font_6x8, White);
+
+    for (uint32_t op = 0; op < SD_OP_COUNT; op++) {
+        const SD_Timing_t *t = &SD_Timing[op];
+        ssd1306_SetCursor(0, 8 + op * 8);
+        sprintf(lineBuffer, "%-5s%7lu%8lu", sd_op_names[op],
+            t->count ? (unsigned long)(t->total_us / t->count) : 0UL, t->max_us);
+        ssd1306_WriteString(lineBuffer, Font_6x8, White);
+    }
+
+    // Last line: times the card was busy, the bytes polled meanwhile, and read token polls
+    ssd1306_SetCursor(0, 56);
+    sprintf(lineBuffer, "bsy %lu/%lu tok %lu", SD_Stats.busy_waits, SD_Stats.busy_polls, SD_Stats.token_polls);
+    ssd1306_WriteString(lineBuffer, Font_6x8, White);
+
+    ssd1306_UpdateScreen();
+}
+
+/** Switches pages on a B1 press and keeps the diagnostics page current */
+void Telemetry_PollDisplay(void)
+{
+    static GPIO_PinState b1_last = GPIO_PIN_SET;
+    static uint32_t drawn_tick;
+    GPIO_PinState b1 = HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin); // Low while pressed
+
+    // Sampled once per superloop pass, which is slower than contact bounce
+    if (b1 == GPIO_PIN_RESET && b1_last == GPIO_PIN_SET) {
+        display_diag = !display_diag;
+        drawn_tick = HAL_GetTick();
+        Telemetry_Display(&g_telemetry);
+    } else if (display_diag && (HAL_GetTick() - drawn_tick) >= DIAG_REFRESH_MS) {
+        drawn_tick = HAL_GetTick();
+        Telemetry_DisplayDiag();
+    }
+    b1_last = b1;
+}
+
+/**
+  * Writes the card counters, logger counters and per-operation latency
+  * histograms to the UART, then clears the histograms if asked. Each
+  * histogram entry is lower_us:count for the bucket from lower_us to twice
+  * that. Transmission blocks for about a second at 9600 baud; received
+  * telemetry waits in the ring meanwhile. Refused during a download: its
+  * frames own USART1, at the transfer rate, and the lines would land
+  * between them.
+  */
+void Telemetry_DumpStats(uint8_t clear)
+{
+    const TelemetryLog_Stats_t *ls = TelemetryLog_GetStats();
+    char line[256];
+    int n;
+
+    if (TelemetryDownload_IsActive()) return;
+
+    n = snprintf(line, sizeof(line),
+        "sd reads=%lu writes=%lu syncs=%lu rsec=%lu wsec=%lu streams=%lu busy=%lu/%lu tokens=%lu\r\n",
+        SD_Stats.reads, SD_Stats.writes, SD_Stats.syncs, SD_Stats.read_sectors, SD_Stats.write_sectors,
+        SD_Stats.stream_starts, SD_Stats.busy_waits, SD_Stats.busy_polls, SD_Stats.token_polls);
+    HAL_UART_Transmit(&huart1, (uint8_t*)line, n, 1000);
+
+    n = snprintf(line, sizeof(line), "cache hits=%lu misses=%lu evictions=%lu writebacks=%lu\r\n",
+        SD_Stats.cache_hits, SD_Stats.cache_misses, SD_Stats.cache_evictions, SD_Stats.cache_writebacks);
+    HAL_UART_Transmit(&huart1, (uint8_t*)line, n, 1000);
+
+    n = snprintf(line, sizeof(line),
+        "log records=%lu sectors=%lu commits=%lu overflows=%lu errors=%lu max_stall=%lums rx_overruns=%lu "
+        "events=%lu decimated=%lu\r\n",
+        ls->records, ls->sectors, ls->commits, ls->overflows, ls->errors, ls->max_stall_ms, rx_overruns,
+        ls->events, ls->decimated);
+    HAL_UART_Transmit(&huart1, (uint8_t*)line, n, 1000);
+
+    n = snprintf(line, sizeof(line), "init card=%u clock=/%lu sd_init=%luus mount=%lums ready=%lums\r\n",
+        SD_Card.type, 2UL << ((SD_Card.prescaler & SPI_CR1_BR_Msk) >> SPI_CR1_BR_Pos), SD_Card.init_us,
+        ls->mount_ms, ls->ready_tick);
+    HAL_UART_Transmit(&huart1, (uint8_t*)line, n, 1000);
+
+    for (uint32_t op = 0; op < SD_OP_COUNT; op++) {
+        const SD_Timing_t *t = &SD_Timing[op];
+
+        n = snprintf(line, sizeof(line), "%s n=%lu avg=%lu max=%lu us hist", sd_op_names[op], t->count,
+            t->count ? (unsigned long)(t->total_us / t->count) : 0UL, t->max_us);
+        for (uint32_t k = 0; k < SD_HIST_BUCKETS && n < (int)sizeof(line) - 32; k++) {
+            if (t->hist[k]) n += snprintf(line + n, sizeof(line) - n, " %lu:%lu", k ? 1UL << k : 0UL, t->hist[k]);
+        }
+        n += snprintf(line + n, sizeof(line) - n, "\r\n");
+        HAL_UART_Transmit(&huart1, (uint8_t*)line, n, 1000);
+    }
+
+    if (clear) SD_ResetTiming();
+}
+
+/** Waits for a fresh B1 press: released first, then pressed */
+static void bench_wait_b1(void)
+{
+    while (HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin) == GPIO_PIN_RESET) HAL_Delay(10);
+    while (HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin) == GPIO_PIN_SET) HAL_Delay(10);
+}
+
+static void bench_uart(const char *line, int n)
+{
+    if (n > 0) HAL_UART_Transmit(&huart1, (uint8_t*)line, n, 1000);
+}
+
+/** Sends each case's results as it finishes, and shows the progress */
+static void bench_report(const TelemetrySdbench_Result_t *r)
+{
+    char line[256];
+    int n;
+
+    if (bench_done++ == 0) {
+        n = snprintf(line, sizeof(line), "bench card=%u clock=/%lu sectors=%lu\r\n", SD_Card.type,
+            2UL << ((SD_Card.prescaler & SPI_CR1_BR_Msk) >> SPI_CR1_BR_Pos), SD_Card.sectors);
+        bench_uart(line, n);
+    }
+    for (uint32_t k = 0; (n = TelemetrySdbench_Format(r, k, line, sizeof(line) - 2)) > 0; k++) {
+        n += snprintf(line + n, sizeof(line) - n, "\r\n");
+        bench_uart(line, n);
+    }
+
+    // One line per case, the oldest overwritten
+    uint8_t y = 8 + 8 * ((bench_done - 1) % 7);
+    ssd1306_FillRectangle(0, y, SSD1306_WIDTH - 1, y + 7, Black);
+    ssd1306_SetCursor(0, y);
+    snprintf(line, sizeof(line), "%lu/%u %s %5lu %s", bench_done, TELEMETRY_SDBENCH_CASES,
+        bench_short[r->pattern], r->record, r->errors ? "ERR" : "ok");
+    ssd1306_WriteString(line, Font_6x8, White);
+    ssd1306_UpdateScreen();
+}
 
+/** MB/s of each pattern by record size, the worst write and the errors */
+static void bench_show_summary(void)
+{
+    char line[32];
+    uint32_t worst = 0, errors = 0;
+
+    int n = snprintf(line, sizeof(line), "MB/s ");
+    for (uint32_t s = 0; s < TELEMETRY_SDBENCH_SIZES; s++) {
+        uint32_t size = TelemetrySdbench_RecordSizes[s];
+        n += size < 1024U ? snprintf(line + n, sizeof(line) - n, "%5lu", size)
+                          : snprintf(line + n, sizeof(line) - n, "%4luK", size / 1024U);
+    }
+    ssd1306_Fill(Black);
+    ssd1306_SetCursor(0, 0);
+    ssd1306_WriteString(line, Font_6x8, White);
+
+    for (uint32_t row = 0; row < 2 * TELEMETRY_SDBENCH_PATTERNS; row++) {
+        const TelemetrySdbench_Result_t *r = &bench_results[(row / 2) * TELEMETRY_SDBENCH_SIZES];
+        n = snprintf(line, sizeof(line), "%s %c", bench_short[row / 2], (row & 1) ? 'r' : 'w');
+
+        for (uint32_t s = 0; s < TELEMETRY_SDBENCH_SIZES; s++, r++) {
+            n += snprintf(line + n, sizeof(line) - n, "%5.2f",
+                TelemetrySdbench_MBps(r, (row & 1) ? &r->read : &r->write));
+        }
+        ssd1306_SetCursor(0, 8 + row * 8);
+        ssd1306_WriteString(line, Font_6x8, White);
+    }
+
+    for (uint32_t c = 0; c < TELEMETRY_SDBENCH_CASES; c++) {
+        if (bench_results[c].write.calls.max_us > worst) worst = bench_results[c].write.calls.max_us;
+        errors += bench_results[c].errors;
+    }
+    ssd1306_SetCursor(0, 56);
+    snprintf(line, sizeof(line), "wmax %luus err %lu", worst, errors);
+    ssd1306_WriteString(line, Font_6x8, White);
+    ssd1306_UpdateScreen();
+}
+
+/** Write latency histogram of one case, a bar per log2 bucket from 1 us */
+static void bench_show_histogram(const TelemetrySdbench_Result_t *r)
+{
+    const SD_Timing_t *t = &r->write.calls;
+    const uint32_t height = BENCH_BAR_BOTTOM - BENCH_BAR_TOP + 1;
+    char line[32];
+    uint32_t most = 1;
+
+    ssd1306_Fill(Black);
+    ssd1306_SetCursor(0, 0);
+    snprintf(line, sizeof(line), "%s %lu w %.2fMB/s", bench_short[r->pattern], r->record,
+        TelemetrySdbench_MBps(r, &r->write));
+    ssd1306_WriteString(line, Font_6x8, White);
+    ssd1306_SetCursor(0, 8);
+    snprintf(line, sizeof(line), "max %luus n %lu", t->max_us, t->count);
+    ssd1306_WriteString(line, Font_6x8, White);
+
+    for (uint32_t k = 0; k < SD_HIST_BUCKETS; k++) {
+        if (t->hist[k] > most) most = t->hist[k];
+    }
+    for (uint32_t k = 0; k < SD_HIST_BUCKETS; k++) {
+        if (t->hist[k] == 0) continue;
+        uint32_t h = t->hist[k] * height / most;
+        if (h == 0) h = 1; // A rare slow write still shows
+        ssd1306_FillRectangle(4 + k * 5, BENCH_BAR_BOTTOM + 1 - h, 7 + k * 5, BENCH_BAR_BOTTOM, White);
+    }
+
+    // Bucket k starts at 2^k us
+    ssd1306_SetCursor(0, 56);
+    ssd1306_WriteString("1us", Font_6x8, White);
+    ssd1306_SetCursor(50, 56);
+    ssd1306_WriteString("1ms", Font_6x8, White);
+    ssd1306_SetCursor(100, 56);
+    ssd1306_WriteString("1s", Font_6x8, White);
+    ssd1306_UpdateScreen();
+}
+
+/**
+  * Benchmark mode, entered with B1 held through reset: runs
+  * telemetry_sdbench.h on the card before anything is logged. Each case
+  * goes out over the UART as it finishes, histograms included; the OLED
+  * then shows MB/s for every case, and B1 steps through each case's write
+  * latency histogram and on to normal operation. The OLED must already be
+  * initialised.
+  */
+void Telemetry_SdBench(void)
+{
+    char line[48];
+    int n;
+
+    ssd1306_Fill(Black);
+    ssd1306_SetCursor(0, 0);
+    ssd1306_WriteString("SD BENCH", Font_6x8, White);
     ssd1306_UpdateScreen();
+
+    // Started with B1 down; nothing waits on it until it is let go
+    FRESULT res = TelemetrySdbench_Run(bench_results, bench_report);
+    if (res != FR_OK) {
+        n = snprintf(line, sizeof(line), "bench failed res=%d", (int)res);
+        ssd1306_SetCursor(0, 56);
+        ssd1306_WriteString(line, Font_6x8, White);
+        n += snprintf(line + n, sizeof(line) - n, "\r\n");
+        bench_uart(line, n);
+        ssd1306_UpdateScreen();
+        bench_wait_b1();
+        return;
+    }
+
+    bench_show_summary();
+    for (uint32_t c = 0; c < TELEMETRY_SDBENCH_CASES; c++) {
+        bench_wait_b1();
+        bench_show_histogram(&bench_results[c]);
+    }
+    bench_wait_b1();
 }
 
-/** Receives one line of telemetry, parses CSV, calculates rates, updates times from log */
+/** Parses each buffered line of telemetry as CSV, calculates rates, updates times from log */
 void Telemetry_ReceiveAndParse(void)
 {
     static uint32_t buffer_index = 0;
 
-    if (HAL_UART_Receive(&huart1, &rx_char, 1, 100) == HAL_OK)
+    while (rx_ring_tail != rx_ring_head)
     {
+        rx_char = rx_ring[rx_ring_tail];
+        rx_ring_tail = (rx_ring_tail + 1) % RX_RING_SIZE;
+
         if (rx_char == '\n' || buffer_index >= RX_BUFFER_SIZE - 1)
         {
             rx_buffer[buffer_index] = '\0';
             buffer_index = 0;
 
+            // "STATS" dumps the SD card statistics, "STATS CLEAR" also restarts
+            // them; not during a download
+            if (strncmp((char*)rx_buffer, "STATS", 5) == 0) {
+                Telemetry_DumpStats(strstr((char*)rx_buffer, "CLEAR") != NULL);
+                continue;
+            }
+
+            // "GET n [offset [length [baud]]]" sends log file n back
+            // (telemetry_download.h), "STOP" ends that early
+            if (strncmp((char*)rx_buffer, "GET ", 4) == 0) {
+                uint32_t number, offset = 0, length = 0, baud = 0;
+                if (sscanf((char*)rx_buffer + 4, "%lu %lu %lu %lu", &number, &offset, &length, &baud) >= 1) {
+                    TelemetryDownload_Start(number, offset, length, baud);
+                }
+                continue;
+            }
+            if (strncmp((char*)rx_buffer, "STOP", 4) == 0) {
+                TelemetryDownload_Stop();
+                continue;
+            }
+
+            // "EVENT" logs the black box history and the next seconds at full rate
+            if (strncmp((char*)rx_buffer, "EVENT", 5) == 0) {
+                TelemetryLog_Trigger();
+                continue;
+            }
+
             // --- CSV FORMAT: TimeMS,Hour,Min,Sec,Altitude,Speed,Voltage ---
             uint32_t time_ms, h, m, s;
             float alt, spd, volt;
@@ -197,19 +462,98 @@ int main(void)
   HAL_Init();
   SystemClock_Config();
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_I2C1_Init();
   MX_USART1_UART_Init();
   MX_SPI1_Init();
   MX_FATFS_Init();
 
   HAL_GPIO_WritePin(SD_CS_PORT, SD_CS_PIN, GPIO_PIN_SET);
-  ssd1306_Init();
+  uint8_t bench = HAL_GPIO_ReadPin(B1_GPIO_Port, B1_Pin) == GPIO_PIN_RESET;
+  if (bench) {
+      ssd1306_Init(); // The benchmark shows its progress
+      Telemetry_SdBench();
+  }
+  // The card first: logging starts without waiting out the display's power-up delays
   Mount_SD_Card();
+  if (!bench) ssd1306_Init();
   Telemetry_Display(&g_telemetry);
+  HAL_UART_Receive_IT(&huart1, &rx_it_byte, 1);
 
   while (1)
   {
       Telemetry_ReceiveAndParse();
-      HAL_Delay(10);
+      TelemetryLog_Poll();
+      Telemetry_PollDisplay();
+      TelemetryDownload_Poll();
+      if (!TelemetryDownload_IsActive()) HAL_Delay(10); // A download goes at the UART's pace
   }
 }
+
+/**
+  * Enable DMA controller clock
+  */
+static void MX_DMA_Init(void)
+{
+
+  /* DMA controller clock enable */
+  __HAL_RCC_DMA2_CLK_ENABLE();
+
+  /* DMA interrupt init */
+  /* DMA2_Stream0_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+  /* DMA2_Stream3_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream3_IRQn);
+  /* DMA2_Stream7_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream7_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+
+}
+
+/* USER CODE BEGIN 4 */
+/** Routes SPI DMA completion to the SD card and OLED drivers */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    USER_SPI_TxCpltCallback(hspi);
+#if defined(SSD1306_USE_SPI) && defined(SSD1306_USE_DMA)
+    ssd1306_SPI_TxCpltCallback(hspi);
+#endif
+}
+
+/** SD card blocks are read with TransmitReceive DMA */
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    USER_SPI_TxRxCpltCallback(hspi);
+}
+
+/** DMA errors, and read blocks failing their CRC check */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    USER_SPI_ErrorCallback(hspi);
+}
+
+/** Queues each received byte and re-arms reception */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance != USART1) return;
+
+    uint16_t next = (rx_ring_head + 1) % RX_RING_SIZE;
+    if (next != rx_ring_tail) {
+        rx_ring[rx_ring_head] = rx_it_byte;
+        rx_ring_head = next;
+    } else {
+        rx_overruns++;
+    }
+    HAL_UART_Receive_IT(&huart1, &rx_it_byte, 1);
+}
+
+/** A framing or overrun error stops interrupt reception; restart it */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance != USART1) return;
+    rx_overruns++;
+    HAL_UART_Receive_IT(&huart1, &rx_it_byte, 1);
+}
+/* USER CODE END 4 */
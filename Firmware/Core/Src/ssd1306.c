@@ -21,6 +21,35 @@ void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
 
 #elif defined(SSD1306_USE_SPI)
 
+#ifdef SSD1306_USE_DMA
+static volatile uint8_t SSD1306_DmaBusy = 0;
+
+/* Block until the previous frame has left the SPI port */
+static void ssd1306_WaitDma(void) {
+    uint32_t start = HAL_GetTick();
+    while (SSD1306_DmaBusy && (HAL_GetTick() - start) < SSD1306_DMA_TIMEOUT) {
+    }
+    if (SSD1306_DmaBusy) {
+        // Lost completion: release the bus so the next frame can go out
+        HAL_SPI_DMAStop(&SSD1306_SPI_PORT);
+        HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET);
+        SSD1306_DmaBusy = 0;
+    }
+}
+
+void ssd1306_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
+    if (hspi->Instance != SSD1306_SPI_PORT.Instance) {
+        return;
+    }
+    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET); // un-select OLED
+    SSD1306_DmaBusy = 0;
+}
+
+uint8_t ssd1306_IsBusy(void) {
+    return SSD1306_DmaBusy;
+}
+#endif
+
 void ssd1306_Reset(void) {
     // CS = High (not selected)
     HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET);
@@ -34,6 +63,9 @@ void ssd1306_Reset(void) {
 
 // Send a byte to the command register
 void ssd1306_WriteCommand(uint8_t byte) {
+#ifdef SSD1306_USE_DMA
+    ssd1306_WaitDma();
+#endif
     HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_RESET); // select OLED
     HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, GPIO_PIN_RESET); // command
     HAL_SPI_Transmit(&SSD1306_SPI_PORT, (uint8_t *) &byte, 1, HAL_MAX_DELAY);
@@ -42,6 +74,9 @@ void ssd1306_WriteCommand(uint8_t byte) {
 
 // Send data
 void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
+#ifdef SSD1306_USE_DMA
+    ssd1306_WaitDma();
+#endif
     HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_RESET); // select OLED
     HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, GPIO_PIN_SET); // data
     HAL_SPI_Transmit(&SSD1306_SPI_PORT, buffer, buff_size, HAL_MAX_DELAY);
@@ -56,6 +91,11 @@ void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
 // Screenbuffer
 static uint8_t SSD1306_Buffer[SSD1306_BUFFER_SIZE];
 
+#if defined(SSD1306_USE_SPI) && defined(SSD1306_USE_DMA)
+// Frame being clocked out by DMA, so drawing can go on in SSD1306_Buffer
+static uint8_t SSD1306_DmaBuffer[SSD1306_BUFFER_SIZE];
+#endif
+
 // Screen object
 static SSD1306_t SSD1306;
 
@@ -178,6 +218,30 @@ void ssd1306_Fill(SSD1306_COLOR color) {
 
 /* Write the screenbuffer with changed to the screen */
 void ssd1306_UpdateScreen(void) {
+#if defined(SSD1306_USE_SPI) && defined(SSD1306_USE_DMA)
+    // Horizontal addressing mode (set in ssd1306_Init) walks the whole
+    // column/page window, so one command burst and one DMA transfer cover
+    // the frame: CS is asserted once and DC flips once.
+    uint8_t window[] = {
+        0x21, SSD1306_X_OFFSET_LOWER | (SSD1306_X_OFFSET_UPPER << 4),
+        (SSD1306_X_OFFSET_LOWER | (SSD1306_X_OFFSET_UPPER << 4)) + SSD1306_WIDTH - 1,
+        0x22, 0, SSD1306_HEIGHT / 8 - 1
+    };
+
+    ssd1306_WaitDma();
+    memcpy(SSD1306_DmaBuffer, SSD1306_Buffer, sizeof(SSD1306_DmaBuffer));
+
+    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_RESET); // select OLED
+    HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, GPIO_PIN_RESET); // command
+    HAL_SPI_Transmit(&SSD1306_SPI_PORT, window, sizeof(window), HAL_MAX_DELAY);
+    HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, GPIO_PIN_SET); // data
+
+    SSD1306_DmaBusy = 1;
+    if (HAL_SPI_Transmit_DMA(&SSD1306_SPI_PORT, SSD1306_DmaBuffer, sizeof(SSD1306_DmaBuffer)) != HAL_OK) {
+        HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET); // un-select OLED
+        SSD1306_DmaBusy = 0;
+    }
+#else
     // Write data to each page of RAM. Number of pages
     // depends on the screen height:
     //
@@ -190,6 +254,7 @@ void ssd1306_UpdateScreen(void) {
         ssd1306_WriteCommand(0x10 + SSD1306_X_OFFSET_UPPER);
         ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH*i],SSD1306_WIDTH);
     }
+#endif
 }
 
 /*
@@ -212,6 +277,103 @@ void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color) {
     }
 }
 
+#ifdef SSD1306_USE_PACKED_FONTS
+
+// Recently decoded glyphs, replaced least recently used first
+typedef struct {
+    const uint8_t *font;    // Packed font the glyph belongs to (NULL = free)
+    uint32_t used;          // LRU stamp
+    char ch;
+    uint16_t rows[SSD1306_GLYPH_MAX_HEIGHT];
+} SSD1306_Glyph_t;
+
+static SSD1306_Glyph_t SSD1306_GlyphCache[SSD1306_GLYPH_CACHE_SIZE];
+static uint32_t SSD1306_GlyphClock;
+
+/* Read n bits, MSB first, from a packed glyph stream */
+static uint32_t ssd1306_GetBits(const uint8_t *stream, uint32_t *pos, uint8_t n) {
+    uint32_t v = 0;
+    while (n--) {
+        v = (v << 1) | ((stream[*pos >> 3] >> (7 - (*pos & 7))) & 1);
+        (*pos)++;
+    }
+    return v;
+}
+
+/* Expand one packed glyph into the uint16_t row format of the raw fonts */
+static void ssd1306_DecodeGlyph(const SSD1306_Font_t *Font, uint8_t idx, uint16_t *rows) {
+    const uint8_t *stream = Font->packed + 95 * 2;
+    uint32_t pos = Font->packed[idx * 2] | (Font->packed[idx * 2 + 1] << 8);
+
+    memset(rows, 0, Font->height * sizeof(uint16_t));
+
+    const uint8_t top = ssd1306_GetBits(stream, &pos, 5);
+    const uint8_t n = ssd1306_GetBits(stream, &pos, 5);
+    if (n == 0) {
+        return; // Blank glyph
+    }
+    const uint8_t left = ssd1306_GetBits(stream, &pos, 4);
+    const uint8_t cols = ssd1306_GetBits(stream, &pos, 5);
+    const uint32_t total = (uint32_t)n * cols;
+
+    if (ssd1306_GetBits(stream, &pos, 1) == 0) {
+        for (uint32_t px = 0; px < total; px++) {
+            if (ssd1306_GetBits(stream, &pos, 1)) {
+                rows[top + px / cols] |= 0x8000 >> (left + px % cols);
+            }
+        }
+    } else {
+        // Alternating clear/set runs in 3-bit chunks, 7 = "add 7 and continue"
+        uint8_t set = 0;
+        for (uint32_t px = 0; px < total; set ^= 1) {
+            uint32_t run = 0, chunk;
+            do {
+                chunk = ssd1306_GetBits(stream, &pos, 3);
+                run += chunk;
+            } while (chunk == 7);
+            for (; run && px < total; run--, px++) {
+                if (set) {
+                    rows[top + px / cols] |= 0x8000 >> (left + px % cols);
+                }
+            }
+        }
+    }
+}
+
+#endif /* SSD1306_USE_PACKED_FONTS */
+
+/* Return the rows of a glyph, decoding packed fonts through the glyph cache */
+static const uint16_t* ssd1306_GetGlyph(const SSD1306_Font_t *Font, char ch) {
+    if (Font->data) {
+        return &Font->data[(ch - 32) * Font->height];
+    }
+#ifdef SSD1306_USE_PACKED_FONTS
+    if (Font->packed == NULL || Font->height > SSD1306_GLYPH_MAX_HEIGHT) {
+        return NULL;
+    }
+
+    SSD1306_Glyph_t *victim = &SSD1306_GlyphCache[0];
+    for (uint32_t i = 0; i < SSD1306_GLYPH_CACHE_SIZE; i++) {
+        SSD1306_Glyph_t *slot = &SSD1306_GlyphCache[i];
+        if (slot->font == Font->packed && slot->ch == ch) {
+            slot->used = ++SSD1306_GlyphClock;
+            return slot->rows;
+        }
+        if (slot->used < victim->used) {
+            victim = slot;
+        }
+    }
+
+    ssd1306_DecodeGlyph(Font, ch - 32, victim->rows);
+    victim->font = Font->packed;
+    victim->ch = ch;
+    victim->used = ++SSD1306_GlyphClock;
+    return victim->rows;
+#else
+    return NULL;
+#endif
+}
+
 /*
  * Draw 1 char to the screen buffer
  * ch       => char om weg te schrijven
@@ -235,9 +397,14 @@ char ssd1306_WriteChar(char ch, SSD1306_Font_t Font, SSD1306_COLOR color) {
         return 0;
     }
     
+    const uint16_t *glyph = ssd1306_GetGlyph(&Font, ch);
+    if (glyph == NULL) {
+        return 0;
+    }
+
     // Use the font to write
     for(i = 0; i < Font.height; i++) {
-        b = Font.data[(ch - 32) * Font.height + i];
+        b = glyph[i];
         for(j = 0; j < char_width; j++) {
             if((b << j) & 0x8000)  {
                 ssd1306_DrawPixel(SSD1306.CurrentX + j, (SSD1306.CurrentY + i), (SSD1306_COLOR) color);
@@ -500,16 +667,31 @@ void ssd1306_DrawRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD13
     return;
 }
 
-/* Draw a filled rectangle */
+/* Draw a filled rectangle, a page byte (8 rows) at a time */
 void ssd1306_FillRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, SSD1306_COLOR color) {
     uint8_t x_start = ((x1<=x2) ? x1 : x2);
     uint8_t x_end   = ((x1<=x2) ? x2 : x1);
     uint8_t y_start = ((y1<=y2) ? y1 : y2);
     uint8_t y_end   = ((y1<=y2) ? y2 : y1);
 
-    for (uint8_t y= y_start; (y<= y_end)&&(y<SSD1306_HEIGHT); y++) {
-        for (uint8_t x= x_start; (x<= x_end)&&(x<SSD1306_WIDTH); x++) {
-            ssd1306_DrawPixel(x, y, color);
+    if (x_start >= SSD1306_WIDTH || y_start >= SSD1306_HEIGHT) {
+        return;
+    }
+    if (x_end >= SSD1306_WIDTH) x_end = SSD1306_WIDTH - 1;
+    if (y_end >= SSD1306_HEIGHT) y_end = SSD1306_HEIGHT - 1;
+
+    for (uint8_t page = y_start / 8; page <= y_end / 8; page++) {
+        uint8_t mask = 0xFF;
+        if (page == y_start / 8) mask &= 0xFF << (y_start % 8);
+        if (page == y_end / 8) mask &= 0xFF >> (7 - (y_end % 8));
+
+        uint8_t *p = &SSD1306_Buffer[x_start + page * SSD1306_WIDTH];
+        for (uint8_t x = x_start; x <= x_end; x++, p++) {
+            if (color == White) {
+                *p |= mask;
+            } else {
+                *p &= (uint8_t)~mask;
+            }
         }
     }
     return;
@@ -545,31 +727,138 @@ SSD1306_Error_t ssd1306_InvertRectangle(uint8_t x1, uint8_t y1, uint8_t x2, uint
   return SSD1306_OK;
 }
 
-/* Draw a bitmap */
+/*
+ * Transpose an 8x8 bit block. rows[0..7] are scanlines with the leftmost pixel
+ * in the MSB; cols[0..7] receive page columns with the top pixel in bit 0.
+ */
+static void ssd1306_Transpose8x8(const uint8_t rows[8], uint8_t cols[8]) {
+    // Hacker's Delight transpose8; rows are fed bottom-up so row 0 lands in bit 0
+    uint32_t x = ((uint32_t)rows[7] << 24) | ((uint32_t)rows[6] << 16) | ((uint32_t)rows[5] << 8) | rows[4];
+    uint32_t y = ((uint32_t)rows[3] << 24) | ((uint32_t)rows[2] << 16) | ((uint32_t)rows[1] << 8) | rows[0];
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    cols[0] = (uint8_t)(x >> 24); cols[1] = (uint8_t)(x >> 16);
+    cols[2] = (uint8_t)(x >> 8);  cols[3] = (uint8_t)x;
+    cols[4] = (uint8_t)(y >> 24); cols[5] = (uint8_t)(y >> 16);
+    cols[6] = (uint8_t)(y >> 8);  cols[7] = (uint8_t)y;
+}
+
+/*
+ * OR (White) or clear (Black) one page column into the screenbuffer,
+ * shifted down by `shift` rows so it may straddle two pages.
+ */
+static inline void ssd1306_BlitColumn(uint8_t x, uint8_t page, uint8_t shift, uint8_t bits, SSD1306_COLOR color) {
+    uint8_t *dst = &SSD1306_Buffer[x + page * SSD1306_WIDTH];
+    uint8_t lo = (uint8_t)(bits << shift);
+    uint8_t hi = shift ? (uint8_t)(bits >> (8 - shift)) : 0;
+
+    if (color == White) {
+        dst[0] |= lo;
+        if (hi && page + 1 < SSD1306_HEIGHT / 8) dst[SSD1306_WIDTH] |= hi;
+    } else {
+        dst[0] &= (uint8_t)~lo;
+        if (hi && page + 1 < SSD1306_HEIGHT / 8) dst[SSD1306_WIDTH] &= (uint8_t)~hi;
+    }
+}
+
+/*
+ * Draw a row-major bitmap (MSB first, scanlines padded to whole bytes).
+ * Eight scanlines are transposed into page columns at a time, so a bitmap
+ * costs one buffer access per 8 pixels instead of one per pixel.
+ * Set bits are drawn in `color`, clear bits are left untouched.
+ */
 void ssd1306_DrawBitmap(uint8_t x, uint8_t y, const unsigned char* bitmap, uint8_t w, uint8_t h, SSD1306_COLOR color) {
-    int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-    uint8_t byte = 0;
+    const uint16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+    const uint8_t shift = y % 8;
+    uint8_t rows[8];
+    uint8_t cols[8];
 
     if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
         return;
     }
 
-    for (uint8_t j = 0; j < h; j++, y++) {
-        for (uint8_t i = 0; i < w; i++) {
-            if (i & 7) {
-                byte <<= 1;
-            } else {
-                byte = (*(const unsigned char *)(&bitmap[j * byteWidth + i / 8]));
+    const uint8_t draw_w = (x + w > SSD1306_WIDTH) ? (SSD1306_WIDTH - x) : w;
+
+    for (uint16_t j = 0; j < h && y + j < SSD1306_HEIGHT; j += 8) {
+        const uint8_t band = (h - j < 8) ? (h - j) : 8;
+        const uint8_t page = (y + j) / 8;
+
+        for (uint16_t bx = 0; bx < byteWidth && bx * 8 < draw_w; bx++) {
+            for (uint8_t r = 0; r < 8; r++) {
+                rows[r] = (r < band) ? bitmap[(j + r) * byteWidth + bx] : 0;
+            }
+            if ((rows[0] | rows[1] | rows[2] | rows[3] | rows[4] | rows[5] | rows[6] | rows[7]) == 0) {
+                continue;
             }
+            ssd1306_Transpose8x8(rows, cols);
 
-            if (byte & 0x80) {
-                ssd1306_DrawPixel(x + i, y, color);
+            const uint8_t n = (draw_w - bx * 8 < 8) ? (draw_w - bx * 8) : 8;
+            for (uint8_t i = 0; i < n; i++) {
+                if (cols[i]) {
+                    ssd1306_BlitColumn(x + bx * 8 + i, page, shift, cols[i], color);
+                }
             }
         }
     }
     return;
 }
 
+/*
+ * Draw a page-major bitmap: ceil(h/8) bands of w bytes, bit 0 is the top
+ * pixel of each byte, i.e. the layout of the SSD1306 GDDRAM. No conversion
+ * is needed; when y is page aligned every byte maps onto one buffer byte.
+ */
+void ssd1306_DrawBitmapPaged(uint8_t x, uint8_t y, const uint8_t* pages, uint8_t w, uint8_t h, SSD1306_COLOR color) {
+    const uint8_t shift = y % 8;
+
+    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
+        return;
+    }
+
+    const uint8_t draw_w = (x + w > SSD1306_WIDTH) ? (SSD1306_WIDTH - x) : w;
+
+    for (uint16_t j = 0; j < h && y + j < SSD1306_HEIGHT; j += 8) {
+        const uint8_t page = (y + j) / 8;
+        const uint8_t keep = (h - j < 8) ? (uint8_t)(0xFF >> (8 - (h - j))) : 0xFF;
+        const uint8_t *src = &pages[(j / 8) * w];
+
+        for (uint8_t i = 0; i < draw_w; i++) {
+            ssd1306_BlitColumn(x + i, page, shift, src[i] & keep, color);
+        }
+    }
+    return;
+}
+
+/* Convert a row-major bitmap into the page-major layout of ssd1306_DrawBitmapPaged */
+void ssd1306_BitmapToPages(const unsigned char* bitmap, uint8_t w, uint8_t h, uint8_t* pages) {
+    const uint16_t byteWidth = (w + 7) / 8;
+    uint8_t rows[8];
+    uint8_t cols[8];
+
+    for (uint16_t j = 0; j < h; j += 8) {
+        const uint8_t band = (h - j < 8) ? (h - j) : 8;
+        uint8_t *dst = &pages[(j / 8) * w];
+
+        for (uint16_t bx = 0; bx < byteWidth; bx++) {
+            for (uint8_t r = 0; r < 8; r++) {
+                rows[r] = (r < band) ? bitmap[(j + r) * byteWidth + bx] : 0;
+            }
+            ssd1306_Transpose8x8(rows, cols);
+
+            const uint8_t n = (w - bx * 8 < 8) ? (w - bx * 8) : 8;
+            memcpy(&dst[bx * 8], cols, n);
+        }
+    }
+}
+
 void ssd1306_SetContrast(const uint8_t value) {
     const uint8_t kSetContrastControlRegister = 0x81;
     ssd1306_WriteCommand(kSetContrastControlRegister);
@@ -0,0 +1,152 @@
+#include "ssd1306_bignum.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Segment bits. a..g follow the usual seven-segment naming, h is the
+ * vertical bar of '+', split above and below g so no two segments share
+ * a pixel and clearing one never damages another.
+ *
+ *    aaa
+ *   f   b
+ *   f h b
+ *    ggg
+ *   e h c
+ *   e   c
+ *    ddd  dp
+ */
+#define SEG_A   0x0001
+#define SEG_B   0x0002
+#define SEG_C   0x0004
+#define SEG_D   0x0008
+#define SEG_E   0x0010
+#define SEG_F   0x0020
+#define SEG_G   0x0040
+#define SEG_H   0x0080
+#define SEG_DP  0x0100
+
+static const uint16_t ssd1306_BigNumDigits[10] = {
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F,          // 0
+    SEG_B | SEG_C,                                          // 1
+    SEG_A | SEG_B | SEG_G | SEG_E | SEG_D,                  // 2
+    SEG_A | SEG_B | SEG_G | SEG_C | SEG_D,                  // 3
+    SEG_F | SEG_G | SEG_B | SEG_C,                          // 4
+    SEG_A | SEG_F | SEG_G | SEG_C | SEG_D,                  // 5
+    SEG_A | SEG_F | SEG_G | SEG_E | SEG_C | SEG_D,          // 6
+    SEG_A | SEG_B | SEG_C,                                  // 7
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G,  // 8
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_F | SEG_G,          // 9
+};
+
+static uint16_t ssd1306_BigNumMask(char ch) {
+    if (ch >= '0' && ch <= '9') {
+        return ssd1306_BigNumDigits[ch - '0'];
+    }
+    switch (ch) {
+    case '-': return SEG_G;
+    case '+': return SEG_G | SEG_H;
+    default:  return 0;
+    }
+}
+
+/* Draw (or erase) the given segments of one cell */
+static void ssd1306_BigNumSegments(const SSD1306_BigNum_t *f, uint8_t cell, uint16_t segs, SSD1306_COLOR color) {
+    const uint8_t t = f->thickness;
+    const uint8_t w = f->digit_w;
+    const uint8_t h = f->digit_h;
+    const uint8_t x = f->x + cell * (w + f->gap);
+    const uint8_t y = f->y;
+    const uint8_t mid = (h - t) / 2;
+
+    if (segs & SEG_A) ssd1306_FillRectangle(x + t, y, x + w - t - 1, y + t - 1, color);
+    if (segs & SEG_G) ssd1306_FillRectangle(x + t, y + mid, x + w - t - 1, y + mid + t - 1, color);
+    if (segs & SEG_D) ssd1306_FillRectangle(x + t, y + h - t, x + w - t - 1, y + h - 1, color);
+    if (segs & SEG_F) ssd1306_FillRectangle(x, y + t, x + t - 1, y + mid - 1, color);
+    if (segs & SEG_B) ssd1306_FillRectangle(x + w - t, y + t, x + w - 1, y + mid - 1, color);
+    if (segs & SEG_E) ssd1306_FillRectangle(x, y + mid + t, x + t - 1, y + h - t - 1, color);
+    if (segs & SEG_C) ssd1306_FillRectangle(x + w - t, y + mid + t, x + w - 1, y + h - t - 1, color);
+    if (segs & SEG_H) {
+        const uint8_t hx = x + (w - t) / 2;
+        const uint8_t len = (w - 2 * t) / 2;
+        if (len) {
+            ssd1306_FillRectangle(hx, y + mid - len, hx + t - 1, y + mid - 1, color);
+            ssd1306_FillRectangle(hx, y + mid + t, hx + t - 1, y + mid + t + len - 1, color);
+        }
+    }
+    if (segs & SEG_DP) {
+        const uint8_t dx = x + w + (f->gap - t) / 2;
+        ssd1306_FillRectangle(dx, y + h - t, dx + t - 1, y + h - 1, color);
+    }
+}
+
+void ssd1306_BigNumInit(SSD1306_BigNum_t *field, uint8_t x, uint8_t y, uint8_t digit_w, uint8_t digit_h,
+                        uint8_t thickness, uint8_t cells) {
+    field->x = x;
+    field->y = y;
+    field->digit_w = digit_w;
+    field->digit_h = digit_h;
+    field->thickness = thickness ? thickness : 1;
+    // Leave room for the decimal point between cells
+    field->gap = field->thickness + 2;
+    field->cells = (cells > SSD1306_BIGNUM_MAX_CELLS) ? SSD1306_BIGNUM_MAX_CELLS : cells;
+    ssd1306_BigNumInvalidate(field);
+}
+
+void ssd1306_BigNumInvalidate(SSD1306_BigNum_t *field) {
+    // Claim every segment is lit so the next write clears or draws all of them
+    for (uint8_t i = 0; i < SSD1306_BIGNUM_MAX_CELLS; i++) {
+        field->drawn[i] = 0xFFFF;
+    }
+}
+
+void ssd1306_BigNumWriteString(SSD1306_BigNum_t *field, const char *str, SSD1306_COLOR color) {
+    uint16_t want[SSD1306_BIGNUM_MAX_CELLS] = {0};
+    uint8_t cell = 0;
+
+    for (; *str && cell <= field->cells; str++) {
+        if (*str == '.') {
+            if (cell == 0) {
+                want[cell++] = SEG_DP; // Leading point, e.g. ".5"
+            } else {
+                want[cell - 1] |= SEG_DP;
+            }
+        } else if (cell < field->cells) {
+            want[cell++] = ssd1306_BigNumMask(*str);
+        } else {
+            break;
+        }
+    }
+
+    for (uint8_t i = 0; i < field->cells; i++) {
+        const uint16_t drawn = field->drawn[i];
+        if (drawn == want[i]) {
+            continue;
+        }
+        if (drawn == 0xFFFF) {
+            // Unknown screen content: erase the whole cell once
+            ssd1306_BigNumSegments(field, i, 0x01FF & ~want[i], (SSD1306_COLOR)!color);
+            ssd1306_BigNumSegments(field, i, want[i], color);
+        } else {
+            ssd1306_BigNumSegments(field, i, drawn & ~want[i], (SSD1306_COLOR)!color);
+            ssd1306_BigNumSegments(field, i, want[i] & ~drawn, color);
+        }
+        field->drawn[i] = want[i];
+    }
+}
+
+void ssd1306_BigNumWriteFloat(SSD1306_BigNum_t *field, float value, uint8_t decimals, SSD1306_COLOR color) {
+    char text[2 * SSD1306_BIGNUM_MAX_CELLS + 2];
+    char aligned[sizeof(text)];
+    int len = snprintf(text, sizeof(text), "%.*f", decimals, value);
+    int cells = len - (strchr(text, '.') ? 1 : 0);
+
+    if (len < 0 || cells > field->cells) {
+        // Does not fit: show dashes rather than a truncated number
+        memset(aligned, '-', field->cells);
+        aligned[field->cells] = '\0';
+    } else {
+        memset(aligned, ' ', field->cells - cells);
+        memcpy(&aligned[field->cells - cells], text, len + 1);
+    }
+    ssd1306_BigNumWriteString(field, aligned, color);
+}
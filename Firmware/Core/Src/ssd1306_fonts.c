@@ -1,6 +1,8 @@
 
 #include "ssd1306_fonts.h"
 
+#ifndef SSD1306_USE_PACKED_FONTS
+
 #ifdef SSD1306_INCLUDE_FONT_7x10
 static const uint16_t Font7x10 [] = {
 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // sp
@@ -919,3 +921,5 @@ const SSD1306_Font_t Font_16x24 = {16, 24, Font16x24, NULL};
 */
 const SSD1306_Font_t Font_16x15 = {16, 15, Font16x15, char_width};
 #endif
+
+#endif /* SSD1306_USE_PACKED_FONTS */
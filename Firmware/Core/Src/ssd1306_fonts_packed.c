@@ -0,0 +1,611 @@
+/* Generated by Tools/ssd1306_font_pack.py from ssd1306_fonts.c - do not edit */
+
+#include "ssd1306_fonts.h"
+
+#ifdef SSD1306_USE_PACKED_FONTS
+
+#ifdef SSD1306_INCLUDE_FONT_6x8
+/* 746 bytes, 1520 bytes unpacked */
+static const uint8_t Font6x8_packed[] = {
+0x00, 0x00, 0x0A, 0x00, 0x25, 0x00, 0x42, 0x00, 0x79, 0x00, 0xB0, 0x00, 0xE7, 0x00, 0x1E, 0x01,
+0x3E, 0x01, 0x67, 0x01, 0x90, 0x01, 0xC7, 0x01, 0xF4, 0x01, 0x0E, 0x02, 0x27, 0x02, 0x3F, 0x02,
+0x6C, 0x02, 0xA3, 0x02, 0xCC, 0x02, 0x03, 0x03, 0x3A, 0x03, 0x71, 0x03, 0xA8, 0x03, 0xDF, 0x03,
+0x16, 0x04, 0x4D, 0x04, 0x84, 0x04, 0x9B, 0x04, 0xB9, 0x04, 0xE9, 0x04, 0x09, 0x05, 0x39, 0x05,
+0x70, 0x05, 0xA7, 0x05, 0xDE, 0x05, 0x15, 0x06, 0x4C, 0x06, 0x83, 0x06, 0xBA, 0x06, 0xF1, 0x06,
+0x28, 0x07, 0x5F, 0x07, 0x88, 0x07, 0xBF, 0x07, 0xF6, 0x07, 0x2D, 0x08, 0x64, 0x08, 0x9B, 0x08,
+0xD2, 0x08, 0x09, 0x09, 0x40, 0x09, 0x77, 0x09, 0xAE, 0x09, 0xE5, 0x09, 0x1C, 0x0A, 0x53, 0x0A,
+0x8A, 0x0A, 0xC1, 0x0A, 0xF8, 0x0A, 0x2F, 0x0B, 0x5F, 0x0B, 0x8C, 0x0B, 0xBC, 0x0B, 0xDF, 0x0B,
+0xF8, 0x0B, 0x18, 0x0C, 0x45, 0x0C, 0x7C, 0x0C, 0xA9, 0x0C, 0xE0, 0x0C, 0x0D, 0x0D, 0x3D, 0x0D,
+0x6A, 0x0D, 0xA1, 0x0D, 0xCA, 0x0D, 0xFA, 0x0D, 0x2A, 0x0E, 0x53, 0x0E, 0x80, 0x0E, 0xAD, 0x0E,
+0xDA, 0x0E, 0x07, 0x0F, 0x34, 0x0F, 0x61, 0x0F, 0x8A, 0x0F, 0xC1, 0x0F, 0xEE, 0x0F, 0x1B, 0x10,
+0x48, 0x10, 0x75, 0x10, 0xA2, 0x10, 0xCF, 0x10, 0xF8, 0x10, 0x13, 0x11, 0x3C, 0x11, 0x00, 0x00,
+0x72, 0x0B, 0xE8, 0x06, 0x23, 0x5B, 0x40, 0x70, 0x29, 0x4A, 0xFA, 0xBE, 0xA5, 0x00, 0xE0, 0x51,
+0x1F, 0x47, 0x17, 0xC4, 0x01, 0xC0, 0xAC, 0x64, 0x44, 0x44, 0xC6, 0x03, 0x81, 0x48, 0xA5, 0x11,
+0x59, 0x34, 0x04, 0x11, 0x9B, 0x50, 0x07, 0x11, 0x8A, 0x92, 0x22, 0x03, 0x88, 0xD1, 0x12, 0x54,
+0x01, 0xC0, 0xA2, 0x55, 0xDF, 0x75, 0x48, 0x12, 0x81, 0x44, 0x27, 0xC8, 0x42, 0x0C, 0x84, 0xF8,
+0x61, 0x02, 0xBE, 0x51, 0x10, 0x9E, 0x12, 0x81, 0x41, 0x11, 0x11, 0x00, 0x1C, 0x0A, 0x74, 0x67,
+0x5C, 0xC5, 0xC0, 0x38, 0x8C, 0xB2, 0x49, 0x70, 0x1C, 0x0A, 0x74, 0x42, 0xE8, 0x43, 0xE0, 0x38,
+0x15, 0xF0, 0x88, 0xC1, 0x8B, 0x80, 0x70, 0x28, 0x46, 0x54, 0xBE, 0x21, 0x00, 0xE0, 0x57, 0xE1,
+0xE0, 0x86, 0x2E, 0x01, 0xC0, 0xA3, 0xA2, 0x1E, 0x8C, 0x5C, 0x03, 0x81, 0x5F, 0x08, 0x44, 0x44,
+0x40, 0x07, 0x02, 0x9D, 0x18, 0xBA, 0x31, 0x70, 0x0E, 0x05, 0x3A, 0x31, 0x78, 0x45, 0xC1, 0x0C,
+0x82, 0xA2, 0x28, 0x88, 0x8B, 0x00, 0xE2, 0x40, 0x92, 0x42, 0x10, 0x88, 0x60, 0x58, 0xB6, 0x80,
+0xE2, 0x44, 0x21, 0x09, 0x24, 0x00, 0xE0, 0x53, 0xA2, 0x13, 0x10, 0x04, 0x01, 0xC0, 0xA7, 0x46,
+0xB7, 0xB4, 0x1E, 0x03, 0x81, 0x44, 0x54, 0x63, 0xF8, 0xC4, 0x07, 0x02, 0xBD, 0x18, 0xFA, 0x31,
+0xF0, 0x0E, 0x05, 0x3A, 0x30, 0x84, 0x22, 0xE0, 0x1C, 0x0A, 0xF4, 0x63, 0x18, 0xC7, 0xC0, 0x38,
+0x15, 0xF8, 0x43, 0xD0, 0x87, 0xC0, 0x70, 0x2B, 0xF0, 0x87, 0xA1, 0x08, 0x00, 0xE0, 0x53, 0xE3,
+0x08, 0x4E, 0x2F, 0x01, 0xC0, 0xA8, 0xC6, 0x3F, 0x8C, 0x62, 0x03, 0x88, 0xDD, 0x24, 0x97, 0x01,
+0xC0, 0xA3, 0x88, 0x42, 0x14, 0x98, 0x03, 0x81, 0x51, 0x95, 0x31, 0x49, 0x44, 0x07, 0x02, 0xA1,
+0x08, 0x42, 0x10, 0xF8, 0x0E, 0x05, 0x47, 0x75, 0xAD, 0x63, 0x10, 0x1C, 0x0A, 0x8C, 0x73, 0x59,
+0xC6, 0x20, 0x38, 0x14, 0xE8, 0xC6, 0x31, 0x8B, 0x80, 0x70, 0x2B, 0xD1, 0x8F, 0xA1, 0x08, 0x00,
+0xE0, 0x53, 0xA3, 0x18, 0xD6, 0x4D, 0x01, 0xC0, 0xAF, 0x46, 0x3E, 0xA4, 0xA2, 0x03, 0x81, 0x4E,
+0x8C, 0x1C, 0x18, 0xB8, 0x07, 0x02, 0xBF, 0x52, 0x10, 0x84, 0x20, 0x0E, 0x05, 0x46, 0x31, 0x8C,
+0x62, 0xE0, 0x1C, 0x0A, 0x8C, 0x63, 0x18, 0xA8, 0x80, 0x38, 0x15, 0x18, 0xC6, 0xB5, 0xAA, 0x80,
+0x70, 0x2A, 0x31, 0x51, 0x15, 0x18, 0x80, 0xE0, 0x54, 0x62, 0xA2, 0x10, 0x84, 0x01, 0xC0, 0xAF,
+0x84, 0x4E, 0x44, 0x3E, 0x03, 0x89, 0x1F, 0x11, 0x11, 0x1E, 0x12, 0x81, 0x50, 0x41, 0x04, 0x10,
+0x1C, 0x48, 0xF1, 0x11, 0x11, 0xF0, 0x0C, 0x0A, 0x22, 0xA2, 0x60, 0x81, 0x5F, 0x01, 0x04, 0x6D,
+0x91, 0x11, 0x40, 0xA6, 0x09, 0xD2, 0x78, 0x0E, 0x05, 0x42, 0x16, 0xCC, 0x73, 0x61, 0x14, 0x0A,
+0x74, 0x61, 0x17, 0x00, 0xE0, 0x50, 0x42, 0xD9, 0xC6, 0x6D, 0x11, 0x40, 0xA7, 0x47, 0xF0, 0x70,
+0x0E, 0x24, 0x12, 0xA7, 0x22, 0x20, 0x8A, 0x05, 0x3A, 0x73, 0x68, 0x40, 0x70, 0x2A, 0x10, 0xB6,
+0x63, 0x18, 0x80, 0xE2, 0x32, 0x19, 0x25, 0xC0, 0x70, 0x20, 0x40, 0x44, 0x65, 0x80, 0x70, 0x22,
+0x22, 0x6B, 0x2A, 0x40, 0x71, 0x1B, 0x24, 0x92, 0xE2, 0x28, 0x15, 0xAA, 0xD6, 0xB5, 0x11, 0x40,
+0xAB, 0x66, 0x31, 0x88, 0x8A, 0x05, 0x3A, 0x31, 0x8B, 0x84, 0x50, 0x2A, 0xD9, 0xCD, 0xA0, 0x22,
+0x81, 0x4D, 0x9C, 0xDA, 0x11, 0x14, 0x0A, 0xB6, 0x61, 0x08, 0x08, 0xA0, 0x59, 0xB5, 0xDA, 0x40,
+0x70, 0x28, 0x84, 0xF9, 0x08, 0x51, 0x08, 0xA0, 0x54, 0x63, 0x19, 0xB4, 0x45, 0x02, 0xA3, 0x18,
+0xA8, 0x82, 0x28, 0x15, 0x18, 0xD6, 0xAA, 0x11, 0x40, 0xA8, 0xA8, 0x8A, 0x88, 0x8A, 0x05, 0x46,
+0x2F, 0x0C, 0x44, 0x50, 0x2B, 0xE2, 0x22, 0x3E, 0x03, 0x88, 0xC5, 0x28, 0x91, 0x01, 0xC8, 0x2E,
+0xE0, 0x38, 0x8D, 0x12, 0x29, 0x40, 0x0C, 0x0A, 0x45, 0x44,
+};
+const SSD1306_Font_t Font_6x8 = {6, 8, NULL, NULL, Font6x8_packed};
+#endif
+
+#ifdef SSD1306_INCLUDE_FONT_7x10
+/* 792 bytes, 1900 bytes unpacked */
+static const uint8_t Font7x10_packed[] = {
+0x00, 0x00, 0x0A, 0x00, 0x26, 0x00, 0x43, 0x00, 0x7F, 0x00, 0xC0, 0x00, 0xFC, 0x00, 0x38, 0x01,
+0x4F, 0x01, 0x81, 0x01, 0xB3, 0x01, 0xD3, 0x01, 0x00, 0x02, 0x17, 0x02, 0x2E, 0x02, 0x43, 0x02,
+0x6F, 0x02, 0xAB, 0x02, 0xD7, 0x02, 0x13, 0x03, 0x4F, 0x03, 0x8B, 0x03, 0xC7, 0x03, 0x03, 0x04,
+0x3F, 0x04, 0x7B, 0x04, 0xB7, 0x04, 0xD1, 0x04, 0xEC, 0x04, 0x19, 0x05, 0x39, 0x05, 0x66, 0x05,
+0xA2, 0x05, 0xDE, 0x05, 0x1A, 0x06, 0x56, 0x06, 0x92, 0x06, 0xCE, 0x06, 0x06, 0x07, 0x42, 0x07,
+0x7E, 0x07, 0xBA, 0x07, 0xE6, 0x07, 0x22, 0x08, 0x5E, 0x08, 0x9A, 0x08, 0xD6, 0x08, 0x12, 0x09,
+0x4E, 0x09, 0x8A, 0x09, 0xCB, 0x09, 0x07, 0x0A, 0x43, 0x0A, 0x7F, 0x0A, 0xBB, 0x0A, 0xF7, 0x0A,
+0x33, 0x0B, 0x6F, 0x0B, 0xAB, 0x0B, 0xE7, 0x0B, 0x0F, 0x0C, 0x3B, 0x0C, 0x63, 0x0C, 0x8B, 0x0C,
+0xA6, 0x0C, 0xBE, 0x0C, 0xF0, 0x0C, 0x2C, 0x0D, 0x5E, 0x0D, 0x9A, 0x0D, 0xCC, 0x0D, 0x08, 0x0E,
+0x44, 0x0E, 0x80, 0x0E, 0xAC, 0x0E, 0xE8, 0x0E, 0x24, 0x0F, 0x50, 0x0F, 0x82, 0x0F, 0xB4, 0x0F,
+0xE6, 0x0F, 0x22, 0x10, 0x5E, 0x10, 0x90, 0x10, 0xC2, 0x10, 0xF6, 0x10, 0x28, 0x11, 0x5A, 0x11,
+0x8C, 0x11, 0xBE, 0x11, 0xFA, 0x11, 0x2C, 0x12, 0x5E, 0x12, 0x7B, 0x12, 0xAD, 0x12, 0x00, 0x00,
+0x83, 0x0B, 0xF4, 0x03, 0x21, 0xAD, 0xA0, 0x40, 0x94, 0x94, 0xFD, 0x32, 0xFC, 0xA4, 0x04, 0x89,
+0x4E, 0xAD, 0x1C, 0x5A, 0xD5, 0xC4, 0x02, 0x04, 0xA4, 0x56, 0xCC, 0x55, 0x4A, 0x20, 0x20, 0x4A,
+0x22, 0x94, 0x46, 0xCA, 0x4D, 0x00, 0xCC, 0x2E, 0x05, 0x10, 0xC5, 0x49, 0x24, 0x88, 0x81, 0x44,
+0x34, 0x44, 0x92, 0x4A, 0x80, 0x21, 0x0C, 0xBA, 0xA2, 0x28, 0x94, 0x42, 0x7C, 0x84, 0x38, 0xCC,
+0x2E, 0x50, 0x90, 0xDC, 0xE1, 0x30, 0xA0, 0x41, 0x0C, 0x4A, 0x49, 0x48, 0x04, 0x09, 0x4E, 0x8C,
+0x6B, 0x18, 0xC5, 0xC0, 0x40, 0x8C, 0x5D, 0x24, 0x92, 0x04, 0x09, 0x4E, 0x8C, 0x42, 0x22, 0x23,
+0xE0, 0x40, 0x94, 0xE8, 0x84, 0xC1, 0x0C, 0x5C, 0x04, 0x09, 0x42, 0x32, 0x95, 0x2F, 0x88, 0x40,
+0x40, 0x95, 0xF8, 0x43, 0xC1, 0x0C, 0x5C, 0x04, 0x09, 0x4E, 0x8C, 0x3D, 0x18, 0xC5, 0xC0, 0x40,
+0x95, 0xF0, 0x88, 0x84, 0x42, 0x10, 0x04, 0x09, 0x4E, 0x8C, 0x5D, 0x18, 0xC5, 0xC0, 0x40, 0x94,
+0xE8, 0xC6, 0x2F, 0x0C, 0x5C, 0x23, 0x18, 0x50, 0x8C, 0xE6, 0x14, 0x71, 0x14, 0x4A, 0x1B, 0x20,
+0xC1, 0x8C, 0x62, 0x58, 0xB6, 0x88, 0xA2, 0x56, 0x0C, 0x13, 0x60, 0x08, 0x12, 0x9D, 0x10, 0x88,
+0x84, 0x01, 0x00, 0x81, 0x29, 0xD1, 0x9D, 0x6F, 0x08, 0x38, 0x08, 0x12, 0x88, 0xA5, 0x29, 0x5F,
+0x8C, 0x40, 0x81, 0x2B, 0xD1, 0x8F, 0xA3, 0x18, 0xF8, 0x08, 0x12, 0x9D, 0x18, 0x42, 0x10, 0x8B,
+0x80, 0x81, 0x2B, 0x92, 0x8C, 0x63, 0x19, 0x70, 0x08, 0x12, 0xC6, 0x86, 0x68, 0x61, 0x94, 0x08,
+0x12, 0xBF, 0x08, 0x7A, 0x10, 0x84, 0x00, 0x81, 0x29, 0xD1, 0x84, 0x2F, 0x18, 0xB8, 0x08, 0x12,
+0xA3, 0x18, 0xFE, 0x31, 0x8C, 0x40, 0x82, 0x1B, 0xA4, 0x92, 0x5C, 0x08, 0x12, 0x82, 0x10, 0x84,
+0x21, 0x8B, 0x80, 0x81, 0x2A, 0x32, 0xA6, 0x29, 0x29, 0x44, 0x08, 0x12, 0xA1, 0x08, 0x42, 0x10,
+0x87, 0xC0, 0x81, 0x2A, 0x3B, 0xDD, 0x63, 0x18, 0xC4, 0x08, 0x12, 0xA3, 0x9C, 0xD6, 0xB3, 0x9C,
+0x40, 0x81, 0x29, 0xD1, 0x8C, 0x63, 0x18, 0xB8, 0x08, 0x12, 0xBD, 0x18, 0xC7, 0xD0, 0x84, 0x00,
+0x91, 0x29, 0xD1, 0x8C, 0x63, 0x1A, 0xB8, 0x20, 0x40, 0x95, 0xE8, 0xC6, 0x3E, 0x94, 0xA2, 0x04,
+0x09, 0x4E, 0x8C, 0x18, 0x20, 0xC5, 0xC0, 0x40, 0x95, 0xF2, 0x10, 0x84, 0x21, 0x08, 0x04, 0x09,
+0x51, 0x8C, 0x63, 0x18, 0xC5, 0xC0, 0x40, 0x95, 0x18, 0xC5, 0x4A, 0x51, 0x08, 0x04, 0x09, 0x51,
+0x8D, 0x6B, 0x5D, 0xA9, 0x40, 0x40, 0x95, 0x15, 0x28, 0x84, 0x52, 0xA2, 0x04, 0x09, 0x51, 0x8A,
+0x94, 0x42, 0x10, 0x80, 0x40, 0x95, 0xF0, 0x88, 0x84, 0x44, 0x3E, 0x05, 0x18, 0x9D, 0x55, 0x56,
+0x04, 0x10, 0xD2, 0x24, 0x91, 0x20, 0x51, 0x09, 0xAA, 0xAA, 0xE0, 0x20, 0x94, 0x45, 0x2A, 0x29,
+0x08, 0x1D, 0xFC, 0x02, 0x21, 0x24, 0x46, 0x12, 0x9D, 0x17, 0xC6, 0x6D, 0x02, 0x04, 0xA8, 0x42,
+0xD9, 0x8C, 0x73, 0x61, 0x18, 0x4A, 0x74, 0x61, 0x08, 0xB8, 0x08, 0x12, 0x82, 0x16, 0xCE, 0x31,
+0x9B, 0x44, 0x61, 0x29, 0xD1, 0xFC, 0x22, 0xE0, 0x20, 0x4A, 0x19, 0x3E, 0x42, 0x10, 0x84, 0x12,
+0x04, 0xA6, 0xCE, 0x31, 0x9B, 0x43, 0xE0, 0x20, 0x4A, 0x84, 0x2D, 0x98, 0xC6, 0x31, 0x02, 0x04,
+0x62, 0x39, 0x24, 0x90, 0x28, 0x08, 0x10, 0x71, 0x11, 0x11, 0x1E, 0x02, 0x04, 0xA8, 0x42, 0x54,
+0xC5, 0x25, 0x10, 0x20, 0x46, 0xE4, 0x92, 0x49, 0x11, 0x84, 0xAF, 0x56, 0xB5, 0xAD, 0x44, 0x61,
+0x2A, 0xD9, 0x8C, 0x63, 0x11, 0x18, 0x4A, 0x74, 0x63, 0x18, 0xB8, 0x48, 0x12, 0xAD, 0x98, 0xC7,
+0x36, 0x84, 0x04, 0x81, 0x29, 0xB3, 0x8C, 0x66, 0xD0, 0x84, 0x46, 0x12, 0xAD, 0x98, 0x42, 0x10,
+0x11, 0x84, 0xA7, 0x45, 0x82, 0x8B, 0x80, 0x81, 0x21, 0x13, 0xD1, 0x11, 0x0C, 0x46, 0x12, 0xA3,
+0x18, 0xC6, 0x6D, 0x11, 0x84, 0xA8, 0xC5, 0x4A, 0x51, 0x04, 0x61, 0x2A, 0xB5, 0xAE, 0xD4, 0xA1,
+0x18, 0x4A, 0x8A, 0x88, 0x45, 0x44, 0x48, 0x12, 0xA3, 0x15, 0x28, 0x84, 0x26, 0x04, 0x61, 0x2B,
+0xE2, 0x22, 0x21, 0xF0, 0x28, 0x86, 0x69, 0x29, 0x12, 0x4C, 0x0A, 0x30, 0xC7, 0x60, 0x51, 0x0D,
+0x92, 0x44, 0xA4, 0xB0, 0xC4, 0x25, 0x76, 0x60,
+};
+const SSD1306_Font_t Font_7x10 = {7, 10, NULL, NULL, Font7x10_packed};
+#endif
+
+#ifdef SSD1306_INCLUDE_FONT_11x18
+/* 1433 bytes, 3420 bytes unpacked */
+static const uint8_t Font11x18_packed[] = {
+0x00, 0x00, 0x0A, 0x00, 0x33, 0x00, 0x60, 0x00, 0xF2, 0x00, 0x86, 0x01, 0x26, 0x02, 0xB8, 0x02,
+0xD5, 0x02, 0x43, 0x03, 0xB1, 0x03, 0xE3, 0x03, 0x48, 0x04, 0x66, 0x04, 0x82, 0x04, 0x9A, 0x04,
+0xF4, 0x04, 0x78, 0x05, 0xD2, 0x05, 0x40, 0x06, 0xBD, 0x06, 0x40, 0x07, 0xC0, 0x07, 0x40, 0x08,
+0xAB, 0x08, 0x28, 0x09, 0xA8, 0x09, 0xCB, 0x09, 0xF7, 0x09, 0x50, 0x0A, 0x82, 0x0A, 0xDE, 0x0A,
+0x5B, 0x0B, 0xDF, 0x0B, 0x71, 0x0C, 0xF5, 0x0C, 0x6C, 0x0D, 0xEC, 0x0D, 0x54, 0x0E, 0xBF, 0x0E,
+0x39, 0x0F, 0xA1, 0x0F, 0x03, 0x10, 0x6E, 0x10, 0x00, 0x11, 0x68, 0x11, 0xFA, 0x11, 0x7E, 0x12,
+0xFB, 0x12, 0x6C, 0x13, 0xFE, 0x13, 0x90, 0x14, 0x0D, 0x15, 0x99, 0x15, 0x0A, 0x16, 0x9C, 0x16,
+0x3C, 0x17, 0xDC, 0x17, 0x7A, 0x18, 0xE8, 0x18, 0x44, 0x19, 0x9E, 0x19, 0xFA, 0x19, 0x4E, 0x1A,
+0x6B, 0x1A, 0x8B, 0x1A, 0xF9, 0x1A, 0x76, 0x1B, 0xCF, 0x1B, 0x49, 0x1C, 0xA2, 0x1C, 0x2B, 0x1D,
+0xA5, 0x1D, 0x16, 0x1E, 0x70, 0x1E, 0xE7, 0x1E, 0x79, 0x1F, 0xD3, 0x1F, 0x4B, 0x20, 0xA4, 0x20,
+0xFD, 0x20, 0x7A, 0x21, 0xF4, 0x21, 0x56, 0x22, 0xA9, 0x22, 0x11, 0x23, 0x6A, 0x23, 0xD8, 0x23,
+0x46, 0x24, 0xAA, 0x24, 0x2E, 0x25, 0x7E, 0x25, 0xFE, 0x25, 0x27, 0x26, 0xA7, 0x26, 0x00, 0x02,
+0xE4, 0x14, 0x7F, 0xCA, 0x81, 0x29, 0x95, 0xBD, 0xEF, 0x7B, 0x0B, 0x85, 0x23, 0x31, 0x98, 0xCC,
+0x66, 0xFF, 0xFF, 0xCC, 0xCC, 0xCF, 0xFF, 0xFD, 0x98, 0xCC, 0x66, 0x33, 0x03, 0x01, 0x40, 0xF1,
+0xFB, 0xAF, 0x2F, 0xA1, 0xE0, 0xF0, 0x38, 0x2F, 0x2F, 0x2F, 0xAD, 0xF8, 0xF0, 0x20, 0x20, 0x2E,
+0x05, 0x1C, 0x0D, 0x83, 0x61, 0xD8, 0xF6, 0x67, 0x30, 0x18, 0x0C, 0x06, 0xE3, 0x6D, 0x9B, 0x46,
+0xC1, 0xB0, 0x38, 0x2E, 0x14, 0x8F, 0x0F, 0xC6, 0x63, 0x31, 0x98, 0x78, 0x18, 0x3C, 0xF3, 0x78,
+0xEC, 0x36, 0x39, 0xF6, 0x72, 0x09, 0x50, 0x51, 0xD8, 0x24, 0x85, 0x04, 0x46, 0x63, 0x11, 0x8C,
+0x63, 0x18, 0xC2, 0x18, 0xC3, 0x08, 0x20, 0x91, 0x15, 0x04, 0x30, 0xC6, 0x10, 0xC6, 0x31, 0x8C,
+0x62, 0x31, 0x98, 0x88, 0x04, 0xA4, 0x61, 0x96, 0xFE, 0xF6, 0x63, 0x50, 0x2B, 0x17, 0x2B, 0x95,
+0xCA, 0x9F, 0xE8, 0xB9, 0x5C, 0xAE, 0x54, 0x69, 0x50, 0x4F, 0x59, 0x22, 0x32, 0x3F, 0xDA, 0x24,
+0x13, 0xC2, 0xE3, 0x28, 0x63, 0x19, 0x8C, 0x63, 0x31, 0x8C, 0x66, 0x31, 0x80, 0xB8, 0x50, 0x3C,
+0x7E, 0x66, 0xC3, 0xC3, 0xC3, 0xDB, 0xDB, 0xC3, 0xC3, 0xC3, 0x66, 0x7E, 0x3C, 0x0B, 0x88, 0xA1,
+0x9D, 0xFB, 0x98, 0xC6, 0x31, 0x8C, 0x63, 0x18, 0xC2, 0xE1, 0x45, 0x47, 0x8B, 0x56, 0x48, 0xB2,
+0xAA, 0xAA, 0xAA, 0xAA, 0xAD, 0xFA, 0x0B, 0x85, 0x14, 0xE5, 0x49, 0xA2, 0x9A, 0xCA, 0x3A, 0xF8,
+0x5C, 0x2D, 0x25, 0x4C, 0xE7, 0x10, 0x5C, 0x28, 0xC5, 0x5D, 0x72, 0x49, 0x09, 0x4D, 0x14, 0xD1,
+0x49, 0x24, 0xBF, 0x51, 0x65, 0x92, 0x0B, 0x85, 0x11, 0xC1, 0xE0, 0xAC, 0xB2, 0xC8, 0xB5, 0xC1,
+0x4D, 0xE5, 0xA4, 0xA9, 0x9C, 0xE2, 0x0B, 0x85, 0x15, 0x1E, 0x49, 0x59, 0x32, 0x2D, 0x70, 0x5A,
+0xB2, 0x49, 0x11, 0x49, 0x9C, 0xE2, 0x0B, 0x85, 0x11, 0xFA, 0xCA, 0xAC, 0xAA, 0xCA, 0xAC, 0xB2,
+0xC7, 0x2C, 0xB2, 0x81, 0x70, 0xA2, 0xA3, 0xC5, 0x3B, 0x24, 0x44, 0xC2, 0xE3, 0xC5, 0x49, 0x24,
+0x91, 0x1C, 0xE2, 0x0B, 0x85, 0x15, 0x1E, 0x2D, 0x22, 0xA4, 0x92, 0x54, 0xCF, 0x09, 0x95, 0xA4,
+0xA9, 0x2C, 0xE2, 0x2A, 0x90, 0x51, 0x3D, 0x86, 0x62, 0x09, 0xE0, 0x07, 0xAC, 0x44, 0x8A, 0x3C,
+0x1A, 0xDB, 0x6E, 0x2E, 0x1F, 0x0F, 0x87, 0xC1, 0x29, 0x85, 0x11, 0xFA, 0xFD, 0x7E, 0x88, 0x91,
+0x42, 0x03, 0x80, 0xE0, 0x38, 0x0C, 0x38, 0xE3, 0x82, 0x00, 0x2E, 0x14, 0xD5, 0x7C, 0x16, 0xED,
+0x5C, 0x2C, 0xEB, 0xAE, 0xBC, 0xB8, 0x5F, 0xA5, 0xC2, 0x81, 0x70, 0xA0, 0x78, 0xFC, 0xC7, 0xC7,
+0x8F, 0xBF, 0xB7, 0xB7, 0xBF, 0x9F, 0x80, 0xC8, 0xF8, 0x70, 0x17, 0x0A, 0x43, 0x81, 0xC1, 0xB0,
+0xD8, 0x6C, 0x36, 0x31, 0x98, 0xCF, 0xE7, 0xF3, 0x1B, 0x07, 0x83, 0xC1, 0x85, 0xC2, 0x87, 0xC7,
+0xE6, 0x36, 0x36, 0x36, 0x37, 0xE7, 0xE6, 0x36, 0x1E, 0x1E, 0x3F, 0xF7, 0xE0, 0x5C, 0x28, 0xA8,
+0xF2, 0x4E, 0x49, 0x96, 0x59, 0x65, 0x96, 0x51, 0x14, 0xD1, 0xCE, 0x20, 0xB8, 0x51, 0x15, 0xF0,
+0x53, 0x45, 0x3B, 0x24, 0x92, 0x49, 0x24, 0x8D, 0x14, 0xD1, 0xCA, 0xB0, 0xB8, 0x51, 0x1F, 0xCC,
+0xB2, 0xCB, 0x70, 0x78, 0x2B, 0x2C, 0xB2, 0xDF, 0xA0, 0xB8, 0x51, 0x1F, 0xCC, 0xB2, 0xCB, 0x70,
+0x78, 0x2B, 0x2C, 0xB2, 0xCB, 0x2C, 0x17, 0x0A, 0x2A, 0x3C, 0x93, 0x92, 0x65, 0x96, 0x4E, 0xBB,
+0x24, 0x45, 0x34, 0x78, 0x51, 0x05, 0xC2, 0x88, 0x52, 0x49, 0x24, 0x92, 0x4F, 0xF4, 0x92, 0x49,
+0x24, 0x91, 0x05, 0xC4, 0x68, 0xF5, 0x28, 0xA2, 0x8A, 0x28, 0xA2, 0x8A, 0x28, 0x97, 0xA1, 0x70,
+0xA3, 0x96, 0x59, 0x65, 0x96, 0x59, 0x65, 0xA4, 0x92, 0xA6, 0x73, 0x88, 0x2E, 0x14, 0xB0, 0x78,
+0x6C, 0x66, 0x63, 0x31, 0xB0, 0xF0, 0x7C, 0x33, 0x19, 0x8C, 0x66, 0x1B, 0x0D, 0x83, 0x0B, 0x85,
+0x10, 0xB2, 0xCB, 0x2C, 0xB2, 0xCB, 0x2C, 0xB2, 0xCB, 0x2D, 0xFA, 0x0B, 0x85, 0x2E, 0x3F, 0x1F,
+0xDF, 0xEB, 0xD5, 0xEA, 0xF7, 0x79, 0x3C, 0x1E, 0x0F, 0x07, 0x83, 0xC1, 0xE0, 0xC2, 0xE1, 0x43,
+0x8F, 0x8F, 0xCF, 0xCF, 0xCF, 0x6F, 0x6F, 0x6F, 0x2F, 0x3F, 0x3F, 0x3F, 0x1F, 0x1C, 0x2E, 0x14,
+0x54, 0x79, 0x24, 0x8A, 0x92, 0x49, 0x24, 0x92, 0x49, 0x22, 0x29, 0x25, 0x9C, 0x41, 0x70, 0xA2,
+0x32, 0xE0, 0xA7, 0x64, 0x92, 0x47, 0xD9, 0xC9, 0x65, 0x96, 0x59, 0x60, 0xB8, 0x52, 0x3C, 0x3F,
+0x19, 0x98, 0x6C, 0x36, 0x1B, 0x0D, 0x86, 0xC3, 0x65, 0xB3, 0xCC, 0xC7, 0xF1, 0xE4, 0x2E, 0x14,
+0xBF, 0x1F, 0xCC, 0x76, 0x1B, 0x0D, 0x8E, 0xFE, 0x7E, 0x33, 0x18, 0xCC, 0x66, 0x1B, 0x0D, 0x83,
+0x0B, 0x85, 0x16, 0xE5, 0x49, 0xA2, 0x9A, 0x2B, 0x3D, 0x33, 0xD6, 0x48, 0x8A, 0x68, 0xE7, 0x10,
+0x5C, 0x0A, 0x8F, 0xF4, 0x5C, 0xAE, 0x57, 0x2B, 0x95, 0xCA, 0xE5, 0x72, 0xB9, 0x5C, 0xAE, 0x57,
+0x2A, 0x05, 0xC2, 0x88, 0x52, 0x49, 0x24, 0x92, 0x49, 0x24, 0x92, 0x49, 0x2A, 0x67, 0x38, 0x82,
+0xE1, 0x4B, 0x07, 0x83, 0xC1, 0xB1, 0x98, 0xCC, 0x63, 0x61, 0xB0, 0xD8, 0x6C, 0x1C, 0x0E, 0x07,
+0x01, 0x00, 0xB8, 0x14, 0xC0, 0xF0, 0x3C, 0x0F, 0x03, 0xC0, 0xF3, 0x34, 0xC9, 0x32, 0x5E, 0x94,
+0xA5, 0x29, 0xCE, 0x61, 0x98, 0x60, 0xB8, 0x14, 0xC0, 0xD8, 0x26, 0x18, 0xCC, 0x3B, 0x07, 0x80,
+0xC0, 0x30, 0x1E, 0x07, 0xC3, 0xB1, 0xC6, 0x61, 0xB0, 0x30, 0xB8, 0x15, 0x0B, 0x22, 0xA2, 0x4A,
+0x26, 0x92, 0x89, 0x2B, 0x34, 0xE1, 0x72, 0xB9, 0x5C, 0xAE, 0x57, 0x2B, 0x95, 0x02, 0xE1, 0x44,
+0xF0, 0x78, 0xCA, 0xAC, 0xAA, 0xAB, 0x2A, 0xB2, 0xAA, 0xAD, 0xFA, 0x04, 0x90, 0x8F, 0xFC, 0xCC,
+0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCF, 0xF0, 0xB8, 0xCA, 0xC6, 0x30, 0xC6, 0x31, 0x86, 0x31, 0x8C,
+0x31, 0x8C, 0x12, 0x32, 0x3F, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFF, 0xC2, 0x81, 0x40,
+0x60, 0x60, 0xF0, 0x91, 0x99, 0x9B, 0x0F, 0x0E, 0x01, 0x05, 0xC7, 0x81, 0x19, 0x11, 0xCC, 0x65,
+0x50, 0xA4, 0x7C, 0x7F, 0x61, 0x80, 0xC7, 0xE7, 0xF6, 0x1B, 0x1D, 0xFE, 0x71, 0x85, 0xC2, 0x88,
+0x59, 0x65, 0x96, 0x45, 0xAE, 0x0B, 0x56, 0x49, 0x24, 0x95, 0x76, 0x51, 0x68, 0xAA, 0x14, 0x54,
+0x78, 0xB5, 0x64, 0xCB, 0x29, 0x53, 0x39, 0xC4, 0x17, 0x0A, 0x39, 0x65, 0x96, 0x49, 0x94, 0x7B,
+0x56, 0x49, 0x24, 0x95, 0x33, 0xC2, 0x65, 0x15, 0x42, 0x8A, 0x8F, 0x16, 0x91, 0x53, 0xFD, 0x9B,
+0x47, 0x38, 0x82, 0xE1, 0x4E, 0x57, 0x9A, 0xE1, 0x4E, 0x4F, 0x31, 0x70, 0xB8, 0x5C, 0x2E, 0x17,
+0x0B, 0x85, 0xC2, 0x84, 0x70, 0xA2, 0x99, 0x47, 0xB5, 0x64, 0x92, 0x49, 0x53, 0x3C, 0x26, 0x56,
+0x8F, 0xB5, 0x50, 0x5C, 0x28, 0x85, 0x96, 0x59, 0x64, 0x61, 0xF1, 0xC9, 0x24, 0x92, 0x49, 0x24,
+0x88, 0x2E, 0x22, 0x86, 0x30, 0x03, 0xFF, 0x18, 0xC6, 0x31, 0x8C, 0x63, 0x04, 0x84, 0xD8, 0xA2,
+0xFA, 0x9B, 0x14, 0x51, 0x45, 0x14, 0x51, 0x45, 0x1B, 0xE4, 0xC2, 0x17, 0x0A, 0x58, 0x0C, 0x06,
+0x03, 0x01, 0x86, 0xC6, 0x66, 0x36, 0x1F, 0x0E, 0xC6, 0x33, 0x19, 0x86, 0xC1, 0x85, 0xC4, 0x57,
+0xFE, 0x31, 0x8C, 0x63, 0x18, 0xC6, 0x31, 0x8C, 0x65, 0x50, 0x29, 0xBB, 0x7F, 0xF9, 0xDE, 0x67,
+0x99, 0xE6, 0x79, 0x9E, 0x67, 0x99, 0xE6, 0x65, 0x50, 0xA2, 0x11, 0x87, 0xC7, 0x24, 0x92, 0x49,
+0x24, 0x92, 0x22, 0xA8, 0x51, 0x51, 0xE2, 0xD5, 0x92, 0x49, 0x25, 0x4C, 0xE7, 0x11, 0x1C, 0x28,
+0x84, 0x5A, 0xE0, 0xB5, 0x64, 0x92, 0x49, 0x57, 0x65, 0x16, 0x96, 0x59, 0x65, 0x88, 0xE1, 0x45,
+0x32, 0x8F, 0x6A, 0xC9, 0x24, 0x92, 0xA6, 0x78, 0x4C, 0xAC, 0xB2, 0xCB, 0x22, 0xA8, 0x51, 0x09,
+0x35, 0xC1, 0x68, 0xA5, 0x96, 0x59, 0x65, 0x96, 0x54, 0xAA, 0x14, 0x54, 0x7D, 0x49, 0xB8, 0x5C,
+0x69, 0x3A, 0x71, 0x09, 0xA2, 0x8B, 0x39, 0x65, 0x38, 0x3C, 0x35, 0x96, 0x59, 0x65, 0x96, 0xCE,
+0x95, 0x42, 0x88, 0x52, 0x49, 0x24, 0x92, 0x49, 0x23, 0xF0, 0xC2, 0x8A, 0xA1, 0x4B, 0x06, 0xC6,
+0x63, 0x31, 0x8D, 0x86, 0xC3, 0x60, 0xE0, 0x70, 0x18, 0x2A, 0x81, 0x2D, 0xDE, 0xEF, 0x76, 0xAA,
+0x55, 0x2A, 0x9D, 0xCE, 0xE2, 0x21, 0x10, 0xAA, 0x14, 0x30, 0xD9, 0x99, 0x8F, 0x06, 0x06, 0x0F,
+0x19, 0x99, 0xB0, 0xC8, 0xE1, 0x43, 0x0F, 0x0D, 0x8D, 0x99, 0x98, 0xD8, 0xD8, 0xD8, 0x70, 0x70,
+0x70, 0xE3, 0xE3, 0x80, 0xAA, 0x14, 0xC7, 0xF3, 0x2C, 0xB2, 0xCB, 0x2C, 0xB7, 0xF0, 0x12, 0x33,
+0x07, 0x3C, 0xC3, 0x0C, 0x30, 0xC7, 0x38, 0xE1, 0xC3, 0x0C, 0x30, 0xC3, 0x0F, 0x1C, 0x12, 0x51,
+0x47, 0xFF, 0xF2, 0x09, 0x11, 0x9C, 0x78, 0x61, 0x86, 0x18, 0x61, 0xC3, 0x8E, 0x71, 0x86, 0x18,
+0x61, 0x9E, 0x70, 0x71, 0x8A, 0x0E, 0x3F, 0xF1, 0xC0,
+};
+const SSD1306_Font_t Font_11x18 = {11, 18, NULL, NULL, Font11x18_packed};
+#endif
+
+#ifdef SSD1306_INCLUDE_FONT_16x26
+/* 2465 bytes, 4940 bytes unpacked */
+static const uint8_t Font16x26_packed[] = {
+0x00, 0x00, 0x0A, 0x00, 0x6C, 0x00, 0xC2, 0x00, 0xFC, 0x01, 0xF1, 0x02, 0x2E, 0x04, 0x47, 0x05,
+0x76, 0x05, 0x62, 0x06, 0x51, 0x07, 0xF2, 0x07, 0x90, 0x08, 0xD1, 0x08, 0xF4, 0x08, 0x14, 0x09,
+0x0F, 0x0A, 0x13, 0x0B, 0xE4, 0x0B, 0xB8, 0x0C, 0x8C, 0x0D, 0x7E, 0x0E, 0x55, 0x0F, 0x4D, 0x10,
+0x21, 0x11, 0x1C, 0x12, 0x0B, 0x13, 0x46, 0x13, 0x9F, 0x13, 0x43, 0x14, 0x8D, 0x14, 0x2B, 0x15,
+0xFC, 0x15, 0x36, 0x17, 0x22, 0x18, 0xF0, 0x18, 0xAC, 0x19, 0x86, 0x1A, 0x36, 0x1B, 0xE3, 0x1B,
+0xB7, 0x1C, 0x6A, 0x1D, 0x17, 0x1E, 0xD3, 0x1E, 0xAD, 0x1F, 0x60, 0x20, 0x58, 0x21, 0x1D, 0x22,
+0x12, 0x23, 0xC8, 0x23, 0xE1, 0x24, 0xBE, 0x25, 0x83, 0x26, 0x39, 0x27, 0xFE, 0x27, 0xF0, 0x28,
+0x00, 0x2A, 0xE9, 0x2A, 0xC3, 0x2B, 0x7C, 0x2C, 0x6B, 0x2D, 0x5D, 0x2E, 0x49, 0x2F, 0x20, 0x30,
+0x46, 0x30, 0x5E, 0x30, 0x14, 0x31, 0xF7, 0x31, 0x9B, 0x32, 0x7E, 0x33, 0x1F, 0x34, 0xF0, 0x34,
+0xD6, 0x35, 0xB6, 0x36, 0x72, 0x37, 0x67, 0x38, 0x56, 0x39, 0xEB, 0x39, 0xCE, 0x3A, 0x78, 0x3B,
+0x31, 0x3C, 0x08, 0x3D, 0xDF, 0x3D, 0x7D, 0x3E, 0x1E, 0x3F, 0xD4, 0x3F, 0x78, 0x40, 0x49, 0x41,
+0x3B, 0x42, 0xF7, 0x42, 0xF2, 0x43, 0x96, 0x44, 0x8B, 0x45, 0xC3, 0x45, 0xBB, 0x46, 0x00, 0x01,
+0x56, 0x2C, 0x7F, 0xFF, 0xE8, 0xC4, 0xD3, 0x4D, 0x34, 0xFF, 0x5F, 0x90, 0x1C, 0xD7, 0x11, 0xF2,
+0xF9, 0x7C, 0xBE, 0x5F, 0x2F, 0x97, 0x01, 0x50, 0x87, 0x86, 0x9F, 0x11, 0x3E, 0x21, 0x9C, 0x35,
+0x38, 0x69, 0xF1, 0x13, 0x9F, 0x83, 0xF9, 0xAD, 0x3E, 0x22, 0x7C, 0x43, 0x38, 0x86, 0x70, 0xD4,
+0x7F, 0xFF, 0x1C, 0x33, 0x86, 0xA7, 0x0D, 0x3E, 0x22, 0x7C, 0x43, 0x38, 0x6A, 0x50, 0x5C, 0x9B,
+0x9C, 0xBF, 0x0F, 0x25, 0x98, 0x5D, 0x85, 0xD8, 0x5D, 0x85, 0xDE, 0x77, 0x1C, 0x6E, 0x77, 0x3C,
+0x6E, 0x6F, 0x37, 0x9B, 0xCD, 0xE6, 0xFA, 0x7F, 0xCF, 0x9E, 0x67, 0x52, 0x02, 0xA1, 0x0A, 0xBC,
+0x62, 0xEE, 0x51, 0xF0, 0xA3, 0x65, 0xB6, 0xA1, 0x6D, 0x98, 0x9A, 0x85, 0xB6, 0xB9, 0x70, 0xF1,
+0xBA, 0xF5, 0xFB, 0xDD, 0xF2, 0xF0, 0x94, 0xE5, 0x27, 0x0C, 0x49, 0x45, 0x12, 0x4D, 0xC4, 0x8C,
+0x71, 0x6B, 0xDF, 0x18, 0x15, 0x08, 0x6E, 0xEB, 0xAE, 0x21, 0x9A, 0x99, 0xA9, 0x9A, 0x99, 0xC4,
+0x33, 0x8E, 0x79, 0xE3, 0x9D, 0xCF, 0x53, 0x83, 0x26, 0x55, 0x70, 0xE9, 0xE2, 0x43, 0xC4, 0xF6,
+0xFB, 0x6A, 0xAF, 0x85, 0xF8, 0x7C, 0x98, 0x03, 0xB1, 0x63, 0xFF, 0xCA, 0x64, 0x19, 0x46, 0x76,
+0xB6, 0xDE, 0x27, 0x13, 0x8B, 0xC4, 0xE6, 0x71, 0x78, 0x9C, 0xCE, 0x67, 0x33, 0x99, 0xCC, 0xE6,
+0xF3, 0x39, 0x9C, 0xDE, 0x67, 0x53, 0x9B, 0xD5, 0xE7, 0x73, 0x01, 0x91, 0x64, 0x6E, 0x6F, 0x57,
+0x99, 0xD4, 0xE6, 0xF3, 0x39, 0x9C, 0xDE, 0x67, 0x33, 0x99, 0xCC, 0xE6, 0x73, 0x38, 0xBC, 0x4E,
+0x67, 0x17, 0x89, 0xC4, 0xE2, 0xDB, 0x76, 0x9C, 0x81, 0x84, 0xEC, 0xBD, 0x4F, 0x1E, 0x69, 0xA6,
+0x7F, 0xC7, 0x88, 0x91, 0xE9, 0x17, 0xC7, 0x36, 0x19, 0x2A, 0x95, 0x36, 0xCC, 0xF0, 0x87, 0x87,
+0xF3, 0xF9, 0xFC, 0xFE, 0x7F, 0x3F, 0x9E, 0xFF, 0xF9, 0xC3, 0xF9, 0xFC, 0xFE, 0x7F, 0x3F, 0x9E,
+0x8A, 0x58, 0xAF, 0xFF, 0xFF, 0x7B, 0xDE, 0xEE, 0x2C, 0x44, 0xD8, 0xFF, 0xD8, 0x91, 0x8B, 0x1F,
+0xE0, 0x64, 0x21, 0xF6, 0x7B, 0x3C, 0x9E, 0xCF, 0x27, 0xB3, 0xC9, 0xEC, 0xF2, 0x7B, 0x3C, 0x9E,
+0xCF, 0x27, 0xB3, 0xC9, 0xEC, 0xF2, 0x7B, 0x3C, 0x9E, 0xCF, 0x27, 0xB3, 0xC9, 0xEC, 0xF2, 0x7A,
+0x0A, 0x8B, 0xF3, 0x8E, 0x3A, 0xB4, 0xD7, 0x5D, 0x52, 0xC3, 0x6F, 0x77, 0xAE, 0x39, 0xE3, 0x9E,
+0x39, 0xE3, 0x9E, 0x39, 0xE3, 0x9E, 0x3A, 0xBD, 0xDA, 0x65, 0x8A, 0xBA, 0xE9, 0xB7, 0xAE, 0x38,
+0x80, 0xA9, 0x3B, 0xA7, 0x1C, 0x4E, 0xE7, 0x7D, 0x5E, 0xAF, 0x57, 0xAB, 0xD5, 0xEA, 0xF5, 0x7A,
+0xBD, 0x5E, 0xAF, 0x57, 0xAB, 0xD5, 0xEA, 0xF5, 0x67, 0xFF, 0x80, 0x54, 0x9B, 0x5C, 0x4F, 0x14,
+0x77, 0xA9, 0xD5, 0xE6, 0xF3, 0x79, 0x9D, 0x4E, 0x6F, 0x17, 0x8B, 0xC5, 0xE2, 0xF3, 0x39, 0x9C,
+0xCE, 0x6F, 0x33, 0xAF, 0xFD, 0x05, 0x4D, 0x93, 0xCB, 0xED, 0x37, 0x79, 0xBC, 0x5E, 0x2F, 0x13,
+0x99, 0xAB, 0xE6, 0x75, 0xCD, 0xE6, 0xF3, 0x39, 0x9C, 0xCE, 0x67, 0x1C, 0xBA, 0x7B, 0x5C, 0xC0,
+0x54, 0x21, 0xEA, 0x79, 0x7C, 0xBD, 0xEE, 0xB8, 0xE7, 0x9E, 0x79, 0xE2, 0x19, 0xA2, 0x9A, 0x29,
+0x63, 0x92, 0x49, 0x24, 0x8F, 0xFF, 0xE7, 0x53, 0xD9, 0xEC, 0xF6, 0x7B, 0x3D, 0x8C, 0x15, 0x36,
+0x47, 0x87, 0xC3, 0xE1, 0x9C, 0xCE, 0x67, 0x33, 0x99, 0xCF, 0x33, 0xBE, 0x37, 0x17, 0x9B, 0xC5,
+0xE6, 0x71, 0x78, 0xBC, 0x42, 0xDD, 0x3D, 0xAE, 0x60, 0x2A, 0x2F, 0xEE, 0x37, 0x72, 0xB6, 0xEF,
+0x73, 0xBB, 0xDC, 0xF2, 0x79, 0x0E, 0x9E, 0xAE, 0x15, 0x3A, 0x53, 0x34, 0x33, 0x43, 0x34, 0x33,
+0x43, 0x6C, 0x52, 0x55, 0x55, 0x9D, 0xF1, 0xA0, 0x2A, 0x4E, 0x8F, 0xFF, 0xFC, 0x77, 0x3A, 0x9D,
+0xCE, 0xA7, 0x6F, 0xB9, 0xD4, 0xEE, 0x75, 0x3B, 0x9D, 0x4E, 0xE7, 0x53, 0xAB, 0xD5, 0xEA, 0x75,
+0x7A, 0xBC, 0x82, 0xA2, 0xFC, 0xE7, 0x77, 0x2A, 0xAE, 0x48, 0xAC, 0x8A, 0xC8, 0xE4, 0x8E, 0xA9,
+0x7A, 0xE3, 0x8E, 0x3A, 0xB0, 0xE7, 0x5D, 0x52, 0xF7, 0x7B, 0xDD, 0x68, 0x65, 0xA7, 0x2A, 0xFC,
+0xDC, 0x40, 0x54, 0x5F, 0x9C, 0x71, 0xD5, 0x8A, 0xB9, 0x2A, 0x96, 0x1B, 0x7B, 0xBD, 0xDE, 0xED,
+0x32, 0xD3, 0x5E, 0x5F, 0x4C, 0x67, 0x77, 0xB9, 0xE4, 0xEE, 0xF7, 0x1B, 0x76, 0x77, 0xB9, 0xA6,
+0x7B, 0x16, 0x3F, 0xDF, 0xFF, 0xC7, 0xF8, 0xD4, 0x62, 0xC7, 0xFB, 0xFF, 0xF8, 0xFF, 0x18, 0x61,
+0xE4, 0xB4, 0x67, 0x84, 0x3F, 0x85, 0xEC, 0xEF, 0x73, 0xB9, 0xDC, 0xEE, 0x77, 0x3C, 0x79, 0xBD,
+0xDE, 0xEF, 0x77, 0xBB, 0xD9, 0xF8, 0x4A, 0x38, 0x42, 0x3F, 0xFE, 0x7F, 0xFF, 0xFB, 0xFF, 0xE1,
+0x9E, 0x10, 0x87, 0xF5, 0xF7, 0x7B, 0xBD, 0xDE, 0xEF, 0x77, 0xB7, 0xAD, 0xCE, 0xE7, 0x73, 0xB9,
+0xDD, 0x5F, 0x1F, 0xC0, 0xA9, 0x3A, 0x7A, 0x9E, 0xA7, 0x69, 0x7B, 0x9D, 0x7A, 0x9D, 0xCE, 0xA7,
+0x53, 0xA9, 0xD4, 0xEA, 0x77, 0x3A, 0xBD, 0x5F, 0xFF, 0xFF, 0xAB, 0xD5, 0xEA, 0xE0, 0x54, 0x21,
+0xDC, 0x71, 0xE4, 0xAE, 0x3B, 0x62, 0x8F, 0x83, 0x1F, 0x26, 0x28, 0x61, 0x6A, 0x3E, 0x14, 0x7C,
+0x26, 0xF9, 0x4D, 0xF2, 0x9B, 0xE5, 0x35, 0xD2, 0x6A, 0x96, 0xBB, 0x30, 0xF6, 0x62, 0xA5, 0xA9,
+0xF5, 0x6F, 0x77, 0xCF, 0x0C, 0x72, 0x08, 0x75, 0xF2, 0xF7, 0xC7, 0x5C, 0x75, 0xC7, 0x30, 0xCE,
+0x21, 0x9C, 0x35, 0x6C, 0x72, 0xC7, 0x24, 0x95, 0xFC, 0xFF, 0x06, 0x6A, 0x67, 0x1C, 0xF3, 0xCF,
+0x5C, 0x74, 0xC7, 0x22, 0x74, 0x78, 0xFD, 0x52, 0x53, 0x2C, 0x32, 0xC3, 0x2C, 0x32, 0x53, 0x1D,
+0x5D, 0xCF, 0x1C, 0x78, 0xCB, 0xD5, 0xEB, 0x73, 0xB9, 0xBF, 0xC3, 0xE3, 0x1C, 0x85, 0xFD, 0xD4,
+0xF1, 0x68, 0xCD, 0xEE, 0x77, 0x7B, 0x9E, 0x4F, 0x27, 0x93, 0xC9, 0xE5, 0xEE, 0xF9, 0x7B, 0xDD,
+0xEA, 0xA7, 0x9B, 0xA1, 0xC8, 0x5F, 0x1E, 0x4F, 0x94, 0x98, 0xCD, 0xD6, 0xEB, 0x8E, 0x78, 0xE7,
+0x8E, 0x78, 0xE7, 0x8E, 0x78, 0xE7, 0x8E, 0x78, 0xE7, 0x75, 0xA1, 0x93, 0x1F, 0x5F, 0x74, 0x72,
+0x27, 0x47, 0xFF, 0xDE, 0xAF, 0x57, 0xAB, 0xD5, 0xEA, 0xF5, 0xF1, 0xF8, 0xDE, 0xAF, 0x57, 0xAB,
+0xD5, 0xEA, 0xF5, 0xFF, 0xE0, 0x72, 0x36, 0xC7, 0xFF, 0xAE, 0xA7, 0x53, 0xA9, 0xD4, 0xEA, 0x75,
+0xFF, 0xEB, 0xA9, 0xD4, 0xEA, 0x75, 0x3A, 0x9D, 0x4E, 0xA7, 0x43, 0x90, 0x43, 0xBA, 0xBE, 0xBD,
+0x1A, 0xBD, 0xDF, 0x2F, 0x93, 0xCB, 0xE5, 0xF2, 0xCF, 0x67, 0x06, 0x71, 0x0D, 0xD0, 0xDD, 0x15,
+0xB1, 0xE7, 0x27, 0xBB, 0xA2, 0x39, 0x0B, 0xE2, 0xDE, 0xEF, 0x77, 0xBB, 0xDD, 0xEE, 0xF7, 0x7B,
+0xBF, 0xFF, 0xED, 0xEE, 0xF7, 0x7B, 0xBD, 0xDE, 0xEF, 0x77, 0xBB, 0x47, 0x22, 0x64, 0x7F, 0xDC,
+0xBC, 0x5E, 0x2F, 0x17, 0x8B, 0xC5, 0xE2, 0xF1, 0x78, 0xBC, 0x5E, 0x2F, 0x17, 0x8B, 0xC5, 0x7F,
+0xF6, 0x39, 0x13, 0x27, 0xC3, 0xE7, 0x17, 0x8B, 0xC5, 0xE2, 0xF1, 0x78, 0xBC, 0x5E, 0x2F, 0x17,
+0x8B, 0xC5, 0xE2, 0x73, 0x0B, 0x74, 0xF6, 0xB9, 0x83, 0x91, 0x3A, 0x25, 0xEA, 0xC3, 0x24, 0x51,
+0xC7, 0x14, 0x90, 0xCB, 0xD5, 0xE7, 0x71, 0xC7, 0x3B, 0xAB, 0x0D, 0x91, 0x49, 0x1C, 0x71, 0xD5,
+0x25, 0x32, 0xF5, 0xA0, 0xE4, 0x4C, 0x8B, 0xC5, 0xE2, 0xF1, 0x78, 0xBC, 0x5E, 0x2F, 0x17, 0x8B,
+0xC5, 0xE2, 0xF1, 0x78, 0xBC, 0x5E, 0x2F, 0x17, 0x8F, 0xFB, 0x1C, 0x82, 0x11, 0x77, 0x97, 0xCB,
+0xEB, 0xF9, 0xFC, 0xFF, 0x07, 0xF2, 0x59, 0xF0, 0xB3, 0xC1, 0xE0, 0xF0, 0x72, 0xE1, 0x55, 0xC2,
+0xAB, 0x85, 0x1F, 0x1D, 0x71, 0xD7, 0x1D, 0x71, 0xD3, 0x1C, 0x85, 0xF1, 0x77, 0x5B, 0xBB, 0xE4,
+0xF2, 0x7A, 0xFD, 0x7F, 0x2E, 0x4D, 0x3C, 0xA8, 0x79, 0x5F, 0x3F, 0x5F, 0xB3, 0xCB, 0xDD, 0xEF,
+0x75, 0xA8, 0xE4, 0x10, 0xDE, 0x38, 0xF2, 0x57, 0x55, 0xB4, 0xCE, 0x21, 0x9C, 0x75, 0xC7, 0x5C,
+0x75, 0xC7, 0x5C, 0x75, 0xC7, 0x5C, 0x43, 0x38, 0x86, 0x71, 0x0D, 0xB5, 0x57, 0x67, 0x9C, 0x71,
+0x07, 0x22, 0x74, 0x7A, 0xBF, 0xB3, 0xBB, 0xD5, 0xEA, 0xF5, 0x7A, 0x9D, 0xBF, 0xE2, 0xEE, 0x5E,
+0xAF, 0x57, 0xAB, 0xD5, 0xEA, 0xF5, 0x7A, 0x1D, 0x82, 0x1B, 0xC7, 0x1E, 0x4A, 0xEA, 0xB6, 0x99,
+0xC4, 0x33, 0x8E, 0xB8, 0xEB, 0x8E, 0xB8, 0xEB, 0x8E, 0xB8, 0xEB, 0x88, 0x67, 0x10, 0xCE, 0x21,
+0xB6, 0xAA, 0xEC, 0xF3, 0x8E, 0x7D, 0xBE, 0xEF, 0x67, 0xE1, 0x0E, 0x44, 0xE8, 0xEE, 0x7A, 0xA3,
+0xC6, 0x4A, 0x65, 0x86, 0x58, 0x64, 0xA6, 0x48, 0xA2, 0xCB, 0xB9, 0xD5, 0x86, 0xC8, 0xAB, 0x8E,
+0xA9, 0x29, 0x96, 0x19, 0x7A, 0xD0, 0x72, 0x27, 0x5F, 0x4F, 0xD3, 0x6B, 0x33, 0xB9, 0xDC, 0xEE,
+0xF7, 0xC7, 0x3D, 0x71, 0xD7, 0x3C, 0x75, 0x7B, 0x9D, 0xDE, 0x7A, 0x94, 0xFA, 0xFA, 0x83, 0x90,
+0x42, 0x3F, 0xFE, 0x6B, 0xE5, 0xF2, 0xF9, 0x7C, 0xBE, 0x5F, 0x2F, 0x97, 0xCB, 0xE5, 0xF2, 0xF9,
+0x7C, 0xBE, 0x5F, 0x2F, 0x96, 0x8E, 0x42, 0xF8, 0xBB, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E,
+0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xA1, 0x96, 0x29, 0x62, 0xAE, 0xBF, 0x37, 0x10, 0x72, 0x08,
+0x44, 0xEB, 0x8E, 0xB9, 0xE5, 0x99, 0xC4, 0x37, 0x45, 0x2C, 0x72, 0xC7, 0x64, 0x91, 0xCB, 0x54,
+0xB4, 0xCE, 0x21, 0x9C, 0x75, 0xCF, 0x1D, 0x71, 0xD7, 0x1D, 0xDF, 0x2D, 0x1C, 0x82, 0x10, 0xFC,
+0xDD, 0xEE, 0xF7, 0x5C, 0x2A, 0xB8, 0x55, 0x70, 0xAA, 0x65, 0xAA, 0x99, 0x87, 0x16, 0x7C, 0x2C,
+0xFE, 0x4F, 0x07, 0x83, 0xC1, 0xE0, 0xF0, 0x73, 0xC7, 0x3A, 0xEB, 0xAE, 0xBA, 0xE9, 0x1C, 0x82,
+0x11, 0x79, 0x66, 0xE8, 0xAC, 0x8E, 0xBB, 0x2A, 0x9B, 0xAE, 0x78, 0xEB, 0x79, 0x7C, 0xBD, 0xF1,
+0xCF, 0x5C, 0x43, 0x6C, 0x56, 0x49, 0x54, 0xD4, 0xCE, 0x39, 0xE6, 0x0E, 0x41, 0x08, 0xBC, 0xB3,
+0x39, 0x66, 0xE8, 0xA5, 0x8E, 0xC9, 0x2A, 0x9A, 0x19, 0xC7, 0x5C, 0xF1, 0xDD, 0xF2, 0xF9, 0x7C,
+0xBE, 0x5F, 0x2F, 0x97, 0xCB, 0xE5, 0xA3, 0x90, 0xBE, 0x3F, 0xFD, 0x79, 0x3B, 0xBD, 0x5E, 0xAF,
+0x57, 0xB9, 0xDC, 0xEE, 0xF5, 0x7A, 0xBD, 0xCE, 0xE7, 0x77, 0xAB, 0xDF, 0xFF, 0xA0, 0x65, 0x57,
+0x1F, 0x9E, 0x27, 0x13, 0x89, 0xC4, 0xE2, 0x71, 0x38, 0x9C, 0x4E, 0x27, 0x13, 0x89, 0xC4, 0xE2,
+0x71, 0x38, 0x9C, 0x4E, 0x27, 0x13, 0x89, 0xC4, 0xE2, 0x71, 0xFF, 0x20, 0xC8, 0xBE, 0x27, 0x93,
+0xD9, 0xE4, 0xF6, 0x79, 0x3D, 0x9E, 0x4F, 0x67, 0x93, 0xD9, 0xE4, 0xF6, 0x79, 0x3D, 0x9E, 0x4F,
+0x67, 0x93, 0xD9, 0xE4, 0xF6, 0x79, 0x3D, 0x9E, 0x4F, 0x58, 0x32, 0x2B, 0x8F, 0x38, 0x9C, 0x4E,
+0x27, 0x13, 0x89, 0xC4, 0xE2, 0x71, 0x38, 0x9C, 0x4E, 0x27, 0x13, 0x89, 0xC4, 0xE2, 0x71, 0x38,
+0x9C, 0x4E, 0x27, 0x13, 0x89, 0xC7, 0xFE, 0x82, 0x22, 0xFF, 0x0B, 0xD7, 0xEB, 0xF2, 0xF7, 0x7A,
+0xE3, 0x9E, 0x39, 0x66, 0x68, 0x66, 0x89, 0xD8, 0xE4, 0x8E, 0x39, 0x62, 0x96, 0x27, 0xC7, 0x3C,
+0x73, 0xCB, 0xA8, 0x82, 0x11, 0xFF, 0xF0, 0x01, 0x82, 0x3C, 0xCF, 0x17, 0xDF, 0x53, 0xD7, 0x1D,
+0xF2, 0xF7, 0x7B, 0xB7, 0xB7, 0xEA, 0xAE, 0x9B, 0x29, 0x96, 0x9B, 0x29, 0xAF, 0x2F, 0xC2, 0xE1,
+0x40, 0x54, 0x9D, 0x13, 0xB9, 0xDC, 0xEE, 0x77, 0x3B, 0x9D, 0xC3, 0x9F, 0xC7, 0x2A, 0x6C, 0xEB,
+0x73, 0xB9, 0xDC, 0xEE, 0x77, 0x3B, 0x9B, 0xD5, 0x87, 0x2A, 0x7D, 0x4C, 0xE8, 0x67, 0x8B, 0xF7,
+0xA9, 0xEA, 0xD1, 0x9B, 0xDD, 0xEE, 0x77, 0x7B, 0xBD, 0xDF, 0x27, 0x97, 0xBB, 0xE6, 0x8D, 0xFB,
+0x7A, 0x20, 0xA8, 0xBF, 0xDD, 0xEE, 0xF7, 0x7B, 0xBD, 0xDE, 0xEC, 0xF1, 0x7C, 0x6B, 0xC6, 0x5E,
+0xEF, 0x77, 0xBB, 0xD6, 0xEB, 0x77, 0x7B, 0xB4, 0xC9, 0x8D, 0x5C, 0x2F, 0x9E, 0x34, 0xCF, 0x17,
+0xEF, 0x1B, 0xB9, 0x55, 0x56, 0x45, 0x2F, 0x77, 0xFF, 0xFD, 0xEE, 0xF9, 0x3C, 0xBE, 0x5A, 0xDF,
+0xB7, 0xA2, 0x0A, 0x8B, 0xFB, 0xAB, 0x61, 0xB3, 0xBB, 0xDD, 0xEE, 0xEF, 0xFF, 0x52, 0xF7, 0x7B,
+0xBD, 0xDE, 0xEF, 0x77, 0xBB, 0xDD, 0xEE, 0xF7, 0x7B, 0xBD, 0xDE, 0xEE, 0x35, 0x05, 0xF9, 0x8C,
+0x5F, 0x1A, 0xB8, 0x32, 0xF7, 0x7B, 0xBD, 0x6E, 0xB7, 0x5B, 0xBB, 0xDD, 0xA6, 0x4C, 0x6A, 0xE1,
+0x7C, 0xF1, 0xBD, 0xCF, 0x27, 0x91, 0x39, 0x5F, 0x8C, 0x15, 0x27, 0x44, 0xEE, 0x77, 0x3B, 0x9D,
+0xCE, 0xE7, 0x70, 0xF0, 0xBE, 0x3C, 0x28, 0x73, 0xEE, 0x75, 0x7A, 0xBD, 0x5E, 0xAF, 0x57, 0xAB,
+0xD5, 0xEA, 0xF5, 0x7A, 0xB4, 0x15, 0x15, 0xF5, 0xD7, 0xFF, 0xFF, 0x5D, 0x9E, 0xF8, 0x9C, 0x4E,
+0x27, 0x13, 0x89, 0xC4, 0xE2, 0x71, 0x38, 0x9C, 0x4E, 0x27, 0x13, 0x88, 0x41, 0xA1, 0x67, 0x8B,
+0xC5, 0xFF, 0xFF, 0xF8, 0xF0, 0xF9, 0xC5, 0xE2, 0xF1, 0x78, 0xBC, 0x5E, 0x2F, 0x17, 0x8B, 0xC5,
+0xE2, 0xF1, 0x78, 0xBC, 0x5E, 0x2F, 0x17, 0x88, 0x5B, 0xA7, 0xB4, 0x0A, 0x93, 0xA2, 0x77, 0x3B,
+0x9D, 0xCE, 0xE7, 0x73, 0xB9, 0x7A, 0x94, 0xC7, 0x54, 0x55, 0xC3, 0x64, 0x32, 0xF3, 0xB9, 0xDD,
+0x58, 0x6C, 0x8A, 0xB8, 0xEA, 0x92, 0x99, 0x7A, 0xB4, 0x15, 0x15, 0xC7, 0x9A, 0xEB, 0xAE, 0xBA,
+0xEB, 0xAE, 0xBA, 0xEB, 0xAE, 0xBA, 0xEB, 0xAE, 0xBA, 0xEB, 0xAE, 0xA6, 0x78, 0x42, 0x21, 0x8A,
+0x1F, 0xFF, 0xFF, 0xC3, 0x57, 0x2A, 0x2E, 0x1B, 0x7C, 0x36, 0xF8, 0x6D, 0xF0, 0xDB, 0xE1, 0xB7,
+0xC3, 0x6F, 0x86, 0xDF, 0x0D, 0xBE, 0x1B, 0x6C, 0xCF, 0x27, 0x44, 0x3C, 0x2F, 0x8F, 0x0A, 0x1C,
+0xFB, 0x9D, 0x5E, 0xAF, 0x57, 0xAB, 0xD5, 0xEA, 0xF5, 0x7A, 0xBD, 0x5E, 0xAD, 0x33, 0xC5, 0xF9,
+0xC6, 0xF1, 0xD7, 0x54, 0xBD, 0xDE, 0xB8, 0xE7, 0x8E, 0x78, 0xE7, 0x8E, 0x78, 0xEA, 0xD3, 0x2D,
+0x35, 0xD7, 0xE6, 0xE2, 0x1A, 0x84, 0xE8, 0x87, 0x3F, 0x8E, 0x54, 0xD9, 0xD6, 0xE7, 0x73, 0xB9,
+0xDC, 0xEE, 0x77, 0x37, 0xB9, 0x0E, 0x54, 0xFA, 0xBC, 0x73, 0xB9, 0xDC, 0xEE, 0x77, 0x3B, 0x35,
+0x05, 0xD9, 0x8B, 0x5E, 0x9A, 0xB1, 0x97, 0xAB, 0xCE, 0xE7, 0x73, 0xB9, 0xDC, 0xEE, 0xAF, 0x52,
+0x9A, 0xB2, 0xF5, 0xE3, 0x3B, 0x9D, 0xCE, 0xE7, 0x73, 0xB8, 0x67, 0x9B, 0x62, 0x9F, 0xFF, 0x0B,
+0xB7, 0xD4, 0xE7, 0x9B, 0xCD, 0xE6, 0xF3, 0x79, 0xBC, 0xDE, 0x6F, 0x37, 0x9B, 0xC9, 0x9E, 0x4D,
+0xBE, 0x97, 0xA6, 0x5E, 0x79, 0xBC, 0xEE, 0x79, 0xE3, 0xAE, 0x38, 0xE6, 0xF5, 0x3A, 0xE6, 0x7E,
+0xD7, 0x4C, 0x72, 0x17, 0xE4, 0xF2, 0x79, 0x38, 0xFF, 0xF5, 0x27, 0x93, 0xC9, 0xE4, 0xF2, 0x79,
+0x3C, 0x9E, 0x4F, 0x27, 0x93, 0xCB, 0xE7, 0x7B, 0xA3, 0x3C, 0x9B, 0x12, 0xF3, 0x79, 0xBC, 0xDE,
+0x6F, 0x37, 0x9B, 0xCD, 0xE6, 0xF3, 0x79, 0x9D, 0x3F, 0x0F, 0x07, 0xD5, 0x8C, 0x33, 0xC2, 0x11,
+0x3A, 0x66, 0x71, 0x0C, 0xE2, 0x29, 0x63, 0x96, 0x3B, 0x24, 0x8E, 0x58, 0xE6, 0x86, 0x71, 0x0C,
+0xE3, 0x9E, 0xB8, 0xEB, 0x8E, 0xEF, 0x96, 0x99, 0xE1, 0x08, 0x9D, 0xE7, 0x1E, 0x55, 0xE5, 0x57,
+0x0B, 0x1E, 0x16, 0x2C, 0xF8, 0x59, 0xE0, 0xB2, 0xCF, 0x07, 0x83, 0xC1, 0xE0, 0xF0, 0x78, 0x55,
+0xD7, 0x5D, 0x75, 0xD7, 0x5D, 0x26, 0x78, 0xBE, 0x2E, 0x86, 0xC8, 0xAB, 0x92, 0xA9, 0x7A, 0xE3,
+0x8E, 0x78, 0xEA, 0xF5, 0xC7, 0x3C, 0xEE, 0xAC, 0x55, 0xD7, 0x54, 0xBD, 0x6A, 0x6A, 0x04, 0x22,
+0xF2, 0xCC, 0xE2, 0x1B, 0xA2, 0x96, 0x39, 0x64, 0x8E, 0x58, 0xE5, 0xAA, 0x68, 0x67, 0x1D, 0x73,
+0xC7, 0x5C, 0x77, 0x7C, 0xBE, 0x4F, 0x67, 0xB3, 0xC9, 0xE5, 0xE7, 0x8E, 0x4C, 0xF1, 0x7C, 0xFE,
+0x0F, 0xE3, 0xBB, 0xD5, 0xEA, 0xF5, 0x7A, 0xBD, 0x5E, 0xAF, 0x57, 0xAB, 0xDC, 0xEE, 0x77, 0xFF,
+0xE8, 0x19, 0x26, 0xEF, 0x32, 0xF3, 0x3A, 0x9D, 0x4E, 0xA7, 0x73, 0xA9, 0xD4, 0xE9, 0xF5, 0x2F,
+0x1B, 0x8E, 0xE7, 0x6F, 0xB9, 0xD4, 0xEA, 0x73, 0x3A, 0x9D, 0x4E, 0xA7, 0x57, 0xAE, 0x78, 0xC0,
+0xCB, 0x8E, 0x3F, 0xFF, 0xFF, 0xFF, 0xA0, 0xC9, 0x36, 0x39, 0xEA, 0xF5, 0x3A, 0x9D, 0x4E, 0xA7,
+0x4F, 0xA9, 0xD4, 0xED, 0xF7, 0x3B, 0xE3, 0x71, 0x67, 0x4F, 0xA9, 0xD4, 0xED, 0xF7, 0x3A, 0x9D,
+0x4E, 0xA7, 0x36, 0x73, 0x77, 0x0B, 0x28, 0x42, 0xB5, 0x67, 0xA6, 0xCB, 0x55, 0x70, 0xFE, 0xB8,
+0x80,
+};
+const SSD1306_Font_t Font_16x26 = {16, 26, NULL, NULL, Font16x26_packed};
+#endif
+
+#ifdef SSD1306_INCLUDE_FONT_16x24
+/* 2284 bytes, 4560 bytes unpacked */
+static const uint8_t Font16x24_packed[] = {
+0x00, 0x00, 0x0A, 0x00, 0x42, 0x00, 0x92, 0x00, 0x8D, 0x01, 0x73, 0x02, 0x4D, 0x03, 0x4B, 0x04,
+0x8C, 0x04, 0x24, 0x05, 0xBF, 0x05, 0x75, 0x06, 0x0A, 0x07, 0x4B, 0x07, 0x77, 0x07, 0xA0, 0x07,
+0x41, 0x08, 0x24, 0x09, 0xB3, 0x09, 0x8A, 0x0A, 0x61, 0x0B, 0x44, 0x0C, 0x12, 0x0D, 0xE9, 0x0D,
+0xBA, 0x0E, 0x9A, 0x0F, 0x71, 0x10, 0xB5, 0x10, 0x11, 0x11, 0xD9, 0x11, 0x2F, 0x12, 0xFA, 0x12,
+0xCE, 0x13, 0xC3, 0x14, 0x9D, 0x15, 0x77, 0x16, 0x51, 0x17, 0x37, 0x18, 0xFC, 0x18, 0xC7, 0x19,
+0x9E, 0x1A, 0x6F, 0x1B, 0xFB, 0x1B, 0xD5, 0x1C, 0xD0, 0x1D, 0x9E, 0x1E, 0x8A, 0x1F, 0x6A, 0x20,
+0x44, 0x21, 0x1B, 0x22, 0x07, 0x23, 0xF3, 0x23, 0xCD, 0x24, 0x9B, 0x25, 0x75, 0x26, 0x58, 0x27,
+0x56, 0x28, 0x48, 0x29, 0x2B, 0x2A, 0xF9, 0x2A, 0x82, 0x2B, 0x26, 0x2C, 0xAF, 0x2C, 0x23, 0x2D,
+0x4F, 0x2D, 0x9F, 0x2D, 0x40, 0x2E, 0x1D, 0x2F, 0xC1, 0x2F, 0x9B, 0x30, 0x36, 0x31, 0x13, 0x32,
+0xB4, 0x32, 0x91, 0x33, 0x1A, 0x34, 0xCA, 0x34, 0x98, 0x35, 0x27, 0x36, 0xF5, 0x36, 0x9C, 0x37,
+0x40, 0x38, 0xE1, 0x38, 0x82, 0x39, 0x26, 0x3A, 0xC7, 0x3A, 0xA4, 0x3B, 0x4B, 0x3C, 0xF8, 0x3C,
+0xB7, 0x3D, 0x73, 0x3E, 0x17, 0x3F, 0xAF, 0x3F, 0x47, 0x40, 0x7C, 0x40, 0x17, 0x41, 0x00, 0x01,
+0x56, 0x1C, 0x7F, 0xFF, 0x3F, 0xCE, 0x80, 0x93, 0x4C, 0x37, 0x9E, 0x79, 0xE7, 0x9E, 0x79, 0xE6,
+0xC1, 0x50, 0x7D, 0xB6, 0xF3, 0x6F, 0x36, 0xF3, 0x6F, 0x36, 0xF3, 0x6D, 0xFF, 0xFF, 0xED, 0xB6,
+0xF3, 0x6F, 0x36, 0xDF, 0xFF, 0xFE, 0xDB, 0x6F, 0x36, 0xF3, 0x6F, 0x36, 0xF3, 0x6F, 0x36, 0xD8,
+0x2A, 0x0F, 0xE7, 0xEB, 0xF5, 0xF5, 0xEB, 0xF5, 0xFE, 0x5B, 0xCD, 0xBC, 0xDB, 0xEB, 0xAD, 0xD6,
+0xEB, 0xA6, 0xDE, 0x6D, 0xE6, 0xFF, 0x2F, 0xD7, 0xEF, 0x4F, 0xD7, 0xEB, 0xC0, 0xA8, 0x3E, 0x37,
+0x5B, 0xAD, 0xD6, 0xDD, 0x6E, 0xB3, 0xE9, 0xFA, 0xFD, 0x7D, 0x3F, 0x5F, 0xAF, 0xA7, 0xEB, 0xF5,
+0xF4, 0xF7, 0x5B, 0xAD, 0xBA, 0xDD, 0x6E, 0xB0, 0x2A, 0x0F, 0xBD, 0xD6, 0xEB, 0x67, 0x9B, 0x79,
+0xB7, 0x9B, 0x6D, 0xE6, 0xDE, 0x6D, 0xF4, 0xFD, 0x7E, 0xBE, 0x9B, 0x6F, 0x36, 0xF3, 0x6F, 0x66,
+0xDE, 0x6D, 0xE7, 0xB3, 0x6F, 0x36, 0xF3, 0x60, 0x4B, 0x1A, 0x3F, 0x8D, 0xB6, 0xF3, 0x6D, 0xB0,
+0x54, 0xD3, 0xCF, 0x3C, 0xDB, 0xCF, 0x36, 0xF3, 0xCF, 0x3C, 0xF3, 0xCF, 0x3C, 0xFA, 0x79, 0xE7,
+0xD3, 0xCF, 0x30, 0x54, 0xD3, 0x0F, 0x3C, 0xFA, 0x79, 0xE7, 0xD3, 0xCF, 0x3C, 0xF3, 0xCF, 0x3C,
+0xF3, 0x6F, 0x3C, 0xDB, 0xCF, 0x3C, 0x37, 0x83, 0xF9, 0xFA, 0xFD, 0x79, 0xB6, 0xF3, 0x6F, 0x36,
+0xDB, 0xEB, 0x75, 0xBA, 0x6D, 0xB7, 0x9B, 0x79, 0xB6, 0xF3, 0xF5, 0xFA, 0xF0, 0xDE, 0x0F, 0xE7,
+0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xBD, 0xFF, 0xFF, 0xBC, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF, 0xD7, 0x98,
+0x96, 0x34, 0x7F, 0x1B, 0x6D, 0xE6, 0xDB, 0x69, 0x18, 0x3E, 0x3F, 0xFF, 0xF6, 0xF3, 0x31, 0xA3,
+0xFF, 0xF9, 0x1B, 0xC1, 0xFF, 0x5F, 0xAF, 0xD7, 0xD3, 0xF5, 0xFA, 0xFA, 0x7E, 0xBF, 0x5F, 0x4F,
+0xD7, 0xEB, 0xE9, 0xFA, 0xFD, 0x7E, 0x82, 0xA0, 0xFB, 0xEB, 0x75, 0xBA, 0x6F, 0xAD, 0xD6, 0xEB,
+0x6E, 0xB7, 0x5B, 0xA6, 0xDE, 0x6D, 0xE6, 0xDF, 0x5B, 0xAD, 0xD6, 0xDD, 0x6E, 0xB7, 0x4D, 0xF5,
+0xBA, 0xDD, 0x30, 0x54, 0xD3, 0x6F, 0x3C, 0xDE, 0x79, 0xEC, 0xF3, 0xCF, 0x3C, 0xF3, 0xCF, 0x3C,
+0xF3, 0xCF, 0x37, 0xFF, 0xC0, 0xA8, 0x3E, 0xFA, 0xDD, 0x6E, 0x9B, 0xEB, 0x75, 0xBA, 0x7E, 0xBF,
+0x5F, 0xAF, 0xA7, 0xEB, 0xF5, 0xF4, 0xFD, 0x7E, 0xBE, 0x9F, 0xAF, 0xD7, 0xD7, 0xFF, 0xFE, 0xC1,
+0x50, 0x7C, 0x7F, 0xFF, 0xEF, 0xA7, 0xEB, 0xF5, 0xF4, 0xFD, 0x7E, 0xBF, 0xCB, 0xF5, 0xFA, 0xFF,
+0x2F, 0xD7, 0xEE, 0xEB, 0x75, 0xBA, 0x6F, 0xAD, 0xD6, 0xE9, 0x82, 0xA0, 0xFF, 0x4F, 0xD7, 0xEB,
+0xEB, 0x75, 0xBA, 0xD9, 0xB7, 0x9B, 0x79, 0xB6, 0xDE, 0x6D, 0xE6, 0xDE, 0x6F, 0xFF, 0xFF, 0x7D,
+0x3F, 0x5F, 0xAF, 0xD7, 0xEB, 0xF5, 0xB0, 0x54, 0x1F, 0x1F, 0xFF, 0xFE, 0xF5, 0xFA, 0xFD, 0xF5,
+0xFA, 0xFD, 0xFC, 0xBF, 0x5F, 0xAF, 0xD7, 0xEB, 0xF7, 0x75, 0xBA, 0xDD, 0x37, 0xD6, 0xEB, 0x74,
+0xC1, 0x50, 0x7F, 0x6E, 0xB7, 0x5B, 0x3F, 0x5F, 0xAF, 0xA7, 0xEB, 0xF5, 0xFB, 0xEB, 0xF5, 0xFA,
+0xDF, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0x6F, 0xAD, 0xD6, 0xE9, 0x82, 0xA0, 0xF8, 0xFF, 0xFF,
+0xF7, 0x5B, 0xAD, 0xD3, 0xF5, 0xFA, 0xFD, 0x7D, 0x3F, 0x5F, 0xAF, 0xA7, 0xEB, 0xF5, 0xFA, 0xFD,
+0x7E, 0xBF, 0x5F, 0xAF, 0xD7, 0x81, 0x50, 0x7D, 0xF5, 0xBA, 0xDD, 0x37, 0xD6, 0xEB, 0x75, 0xBA,
+0xDD, 0x6E, 0x9B, 0xEB, 0x75, 0xBA, 0x6F, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x37, 0xD6, 0xEB,
+0x74, 0xC1, 0x50, 0x7D, 0xF5, 0xBA, 0xDD, 0x37, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0x9B, 0xF5,
+0xFA, 0xFD, 0xF5, 0xFA, 0xFD, 0x7D, 0x3F, 0x5F, 0xAF, 0x6E, 0xB7, 0x5B, 0x0D, 0xE6, 0x68, 0xFF,
+0xFE, 0x7F, 0x9F, 0xFF, 0xC8, 0xE4, 0x66, 0x8F, 0xFF, 0xE7, 0xF9, 0xFC, 0x6D, 0xB7, 0x9B, 0x6D,
+0x82, 0xA0, 0xCF, 0x4F, 0xA7, 0xD3, 0xCF, 0xA7, 0xD3, 0xCF, 0xA7, 0xD3, 0xCF, 0xA7, 0xD3, 0xF5,
+0xF4, 0xFA, 0x7E, 0xBE, 0x9F, 0x4F, 0xD7, 0xD3, 0xE9, 0x99, 0x20, 0xF8, 0xFF, 0xFF, 0xDF, 0xFF,
+0xFE, 0xFF, 0xFF, 0xF6, 0x0A, 0x83, 0x21, 0xF4, 0xFA, 0x7E, 0xBE, 0x9F, 0x4F, 0xD7, 0xD3, 0xE9,
+0xFA, 0xFA, 0x7D, 0x3C, 0xFA, 0x7D, 0x3C, 0xFA, 0x7D, 0x3C, 0xFA, 0x7D, 0x3E, 0x81, 0x50, 0x7D,
+0xF5, 0xBA, 0xDD, 0x37, 0xD6, 0xEB, 0x74, 0xFD, 0x7E, 0xBF, 0x5F, 0x4F, 0xD7, 0xEB, 0xE9, 0xFA,
+0xFD, 0x7F, 0xFF, 0xFF, 0xE5, 0xFA, 0xFD, 0x78, 0x15, 0x07, 0xDF, 0x5B, 0xAD, 0xD3, 0x7D, 0x6E,
+0xB7, 0x4F, 0xD7, 0xEB, 0xF5, 0xBC, 0xDB, 0xCD, 0xBC, 0xF3, 0x6F, 0x36, 0xF3, 0x6F, 0x36, 0xF3,
+0x6F, 0x36, 0xDB, 0xEB, 0x75, 0xBA, 0x60, 0xA8, 0x3F, 0x9F, 0xAF, 0xD7, 0xD3, 0x6F, 0x36, 0xF3,
+0x6D, 0xBE, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xFF, 0xFF, 0xF5, 0xD6, 0xEB, 0x75, 0xBA, 0xDD,
+0x6E, 0x98, 0x2A, 0x0F, 0x8F, 0x5F, 0xAF, 0xD6, 0xFA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD7, 0xE5,
+0xFA, 0xFD, 0x6F, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x7E, 0x5F, 0xAF, 0xD6, 0x0A, 0x83, 0xEF,
+0xAD, 0xD6, 0xE9, 0xBE, 0xB7, 0x5B, 0xAD, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF, 0xD7,
+0xEB, 0xEB, 0x75, 0xBA, 0x6F, 0xAD, 0xD6, 0xE9, 0x82, 0xA0, 0xF8, 0xEB, 0x75, 0xBA, 0xCF, 0x36,
+0xF3, 0x6F, 0x36, 0xFA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xD9, 0xB7, 0x9B,
+0x79, 0xBE, 0xB7, 0x5B, 0xAC, 0x0A, 0x83, 0xE3, 0xFF, 0xFF, 0xDE, 0xBF, 0x5F, 0xAF, 0xD7, 0xEB,
+0xF7, 0xD7, 0xEB, 0xF5, 0xBF, 0x5F, 0xAF, 0xD7, 0xEB, 0xF5, 0xFB, 0xFF, 0xFF, 0xB0, 0x54, 0x1F,
+0x1F, 0xFF, 0xFE, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F, 0xBE, 0xBF, 0x5F, 0xAD, 0xFA, 0xFD, 0x7E,
+0xBF, 0x5F, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0x0A, 0x83, 0xEF, 0xAD, 0xD6, 0xE9, 0xBE, 0xB7, 0x5B,
+0xAD, 0xEB, 0xF5, 0xFA, 0xDF, 0xAF, 0xD7, 0xEF, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0x6F, 0xD7,
+0xEB, 0xF4, 0x15, 0x07, 0xC3, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0xFF,
+0xFF, 0xEB, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xA6, 0x0A, 0x9A, 0x63, 0xFF,
+0x9B, 0xCF, 0x3C, 0xF3, 0xCF, 0x3C, 0xF3, 0xCF, 0x3C, 0xF3, 0xCF, 0x37, 0xFF, 0xC0, 0xA8, 0x3F,
+0xBA, 0xDD, 0x6E, 0xBA, 0x7E, 0xBF, 0x5F, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F,
+0xAD, 0xBC, 0xDB, 0xCD, 0xBC, 0xF6, 0xEB, 0x75, 0xB0, 0x2A, 0x0F, 0x87, 0xD6, 0xEB, 0x75, 0xB3,
+0x6F, 0x36, 0xF3, 0x6D, 0xBC, 0xDB, 0xCD, 0xBD, 0xBA, 0xDD, 0x6E, 0x9B, 0x79, 0xB7, 0x9B, 0x79,
+0xE6, 0xDE, 0x6D, 0xE6, 0xDF, 0x5B, 0xAD, 0xD3, 0x05, 0x41, 0xF0, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF,
+0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xFF,
+0xFF, 0xEC, 0x15, 0x07, 0xC3, 0xEB, 0x75, 0xBA, 0xE9, 0xFA, 0xFD, 0x7D, 0x36, 0xF3, 0x6F, 0x36,
+0xF3, 0x6F, 0x36, 0xF3, 0x6F, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x74, 0xC1,
+0x50, 0x7C, 0x3E, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xD6, 0xEB, 0x75, 0xB3, 0x6F, 0x36, 0xF3,
+0x6F, 0x6E, 0xB7, 0x5B, 0xAE, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x74, 0xC1, 0x50, 0x7D, 0xF5, 0xBA,
+0xDD, 0x37, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xDD,
+0x6E, 0xB7, 0x4D, 0xF5, 0xBA, 0xDD, 0x30, 0x54, 0x1F, 0x1E, 0xBF, 0x5F, 0xAD, 0xF5, 0xBA, 0xDD,
+0x6E, 0xB7, 0x5B, 0xAF, 0xCB, 0xF5, 0xFA, 0xDF, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF,
+0x5F, 0xA0, 0xA8, 0x3E, 0xFA, 0xDD, 0x6E, 0x9B, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD,
+0xD6, 0xEB, 0x36, 0xF3, 0x6F, 0x36, 0xF6, 0x6D, 0xE6, 0xDE, 0x7B, 0x36, 0xF3, 0x6F, 0x36, 0x0A,
+0x83, 0xE3, 0xD7, 0xEB, 0xF5, 0xBE, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xF9, 0x7E, 0xBF, 0x5B,
+0x6F, 0x36, 0xF3, 0x6F, 0x3C, 0xDB, 0xCD, 0xBC, 0xDB, 0xEB, 0x75, 0xBA, 0x60, 0xA8, 0x3E, 0xFA,
+0xDD, 0x6E, 0x9B, 0xEB, 0x75, 0xBA, 0xDE, 0xBF, 0x5F, 0xE7, 0xAD, 0xD6, 0xEB, 0xF2, 0xFD, 0x7E,
+0xEE, 0xB7, 0x5B, 0xA6, 0xFA, 0xDD, 0x6E, 0x98, 0x2A, 0x0F, 0x8F, 0xFF, 0xFD, 0xE7, 0xEB, 0xF5,
+0xFA, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF, 0xD7,
+0xEB, 0xC0, 0xA8, 0x3E, 0x1F, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD,
+0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xA6, 0xFA, 0xDD, 0x6E, 0x98, 0x2A, 0x0F, 0x87,
+0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7,
+0x4D, 0xB6, 0xF3, 0x6F, 0x36, 0xFA, 0x7E, 0xBF, 0x5E, 0x05, 0x41, 0xF0, 0xFA, 0xDD, 0x6E, 0xB7,
+0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xCD, 0xBC, 0xDB, 0xCD, 0xBC, 0xDB, 0xCD, 0xBC, 0xDB, 0xCD,
+0xBC, 0xDB, 0xCD, 0xB6, 0xDB, 0x79, 0xB7, 0x9B, 0x6C, 0x15, 0x07, 0xC3, 0xEB, 0x75, 0xBA, 0xDD,
+0x6E, 0xB7, 0x4D, 0xB6, 0xF3, 0x6F, 0x36, 0xFA, 0x7E, 0xBF, 0x5F, 0x4D, 0xBC, 0xDB, 0xCD, 0xB6,
+0xFA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD3, 0x05, 0x41, 0xF0, 0xFA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD,
+0xD6, 0xEB, 0x75, 0xBA, 0x6D, 0xB7, 0x9B, 0x79, 0xB7, 0xD3, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F,
+0xAF, 0xD7, 0xEB, 0xC0, 0xA8, 0x3E, 0x3F, 0xFF, 0xF7, 0xEB, 0xF5, 0xFA, 0xFA, 0x7E, 0xBF, 0x5F,
+0x4F, 0xD7, 0xEB, 0xE9, 0xFA, 0xFD, 0x7D, 0x3F, 0x5F, 0xAF, 0xDF, 0xFF, 0xFD, 0x82, 0xA6, 0x98,
+0xFF, 0xF5, 0x9E, 0x79, 0xE7, 0x9E, 0x79, 0xE7, 0x9E, 0x79, 0xE7, 0x9E, 0x7B, 0xFF, 0x86, 0xF0,
+0x7C, 0x3F, 0x5F, 0xAF, 0xF2, 0xFD, 0x7E, 0xBF, 0xCB, 0xF5, 0xFA, 0xFF, 0x2F, 0xD7, 0xEB, 0xFC,
+0xBF, 0x5F, 0xAC, 0x15, 0x34, 0xC7, 0xFF, 0x67, 0x9E, 0x79, 0xE7, 0x9E, 0x79, 0xE7, 0x9E, 0x79,
+0xE7, 0x9E, 0xFF, 0xF4, 0x04, 0x83, 0xF9, 0xFA, 0xFD, 0x7D, 0x36, 0xF3, 0x6F, 0x36, 0xDB, 0xEB,
+0x75, 0xBA, 0x72, 0x18, 0x3E, 0x3F, 0xFF, 0xF6, 0x04, 0x9A, 0x61, 0xE7, 0x9F, 0x4F, 0x3C, 0xFA,
+0x79, 0xE6, 0x67, 0x83, 0xEF, 0xAD, 0xD6, 0xEB, 0xF2, 0xFD, 0x7E, 0xB7, 0xEB, 0xF5, 0xFE, 0x7A,
+0xDD, 0x6E, 0x9B, 0xF5, 0xFA, 0xFD, 0x05, 0x41, 0xF0, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF, 0xD7, 0xEB,
+0x79, 0xB7, 0x9B, 0x79, 0xED, 0xD6, 0xEB, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xF9, 0x7E,
+0xBF, 0x59, 0x9E, 0x0F, 0xBE, 0xB7, 0x5B, 0xA6, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF, 0xD7, 0xEB, 0xEB,
+0x75, 0xBA, 0x6F, 0xAD, 0xD6, 0xE9, 0x82, 0xA0, 0xFF, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x6F,
+0x36, 0xF3, 0x6F, 0x3D, 0xBA, 0xDD, 0x6E, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD3, 0x7E, 0xBF,
+0x5F, 0xA6, 0x78, 0x3E, 0xFA, 0xDD, 0x6E, 0x9B, 0xEB, 0x75, 0xBA, 0xFF, 0xFF, 0xFA, 0xF5, 0xFA,
+0xFF, 0x3D, 0x6E, 0xB7, 0x4C, 0x15, 0x07, 0xF6, 0xEB, 0x75, 0xB3, 0xCD, 0xBC, 0xDB, 0xCD, 0xBF,
+0x5F, 0xAF, 0xAE, 0xB7, 0x5B, 0xAE, 0x9F, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F,
+0x46, 0x78, 0x3E, 0xFD, 0x7E, 0xBF, 0xCF, 0x5B, 0xAD, 0xD3, 0x7E, 0xBF, 0x5F, 0xBE, 0xBF, 0x5F,
+0xAD, 0xF5, 0xBA, 0xDD, 0x30, 0x54, 0x1F, 0x0F, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0xB7, 0x9B,
+0x79, 0xB7, 0x9E, 0xDD, 0x6E, 0xB6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0xE9,
+0x82, 0xA6, 0x9B, 0x79, 0xE7, 0xFF, 0xF5, 0xE7, 0x9B, 0xCF, 0x3D, 0x9E, 0x79, 0xE7, 0x9E, 0x6F,
+0xFF, 0x81, 0x53, 0x67, 0xA7, 0xD3, 0xE9, 0xFF, 0xFF, 0xE3, 0x6D, 0xB7, 0x4F, 0xA7, 0xD3, 0xE9,
+0xF4, 0xFA, 0xDB, 0x6D, 0x9B, 0xDB, 0x6C, 0xC1, 0x50, 0x64, 0x3E, 0x9F, 0x4F, 0xA7, 0xD3, 0xE9,
+0xF4, 0xF6, 0xDB, 0x66, 0xDB, 0x6D, 0xB6, 0xDE, 0xDB, 0x6C, 0xDB, 0x6D, 0xB6, 0xDB, 0x6F, 0x6D,
+0xB3, 0x05, 0x59, 0x31, 0x9E, 0x7B, 0x3C, 0xF3, 0xCF, 0x3C, 0xF3, 0xCF, 0x3C, 0xF3, 0xCF, 0x3C,
+0xF3, 0x7F, 0xFC, 0x67, 0x83, 0xE3, 0x36, 0xF3, 0x6F, 0x36, 0xDB, 0x6F, 0x36, 0xF3, 0x6F, 0x36,
+0xF3, 0x6F, 0x36, 0xF3, 0x6F, 0x36, 0xF3, 0x6F, 0x36, 0xF3, 0x6F, 0x36, 0xD9, 0x9E, 0x0F, 0x86,
+0xF3, 0x6F, 0x36, 0xF3, 0xDB, 0xAD, 0xD6, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA,
+0xDD, 0x33, 0x3C, 0x1F, 0x7D, 0x6E, 0xB7, 0x4D, 0xF5, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6,
+0xEB, 0x74, 0xDF, 0x5B, 0xAD, 0xD3, 0x33, 0xC1, 0xF1, 0xEB, 0xF5, 0xFA, 0xDF, 0x5B, 0xAD, 0xD7,
+0xE5, 0xFA, 0xFD, 0x6F, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x7E, 0x99, 0xE0, 0xFB, 0xCD, 0xBC, 0xDB,
+0xCF, 0x6E, 0xB7, 0x5B, 0x3F, 0x5F, 0xAF, 0xDF, 0x5F, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0xCC, 0xF0,
+0x7C, 0x37, 0x9B, 0x79, 0xB7, 0x9E, 0xDD, 0x6E, 0xB6, 0xF5, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF,
+0xD7, 0xEB, 0xF4, 0xCF, 0x07, 0xDF, 0x5B, 0xAD, 0xD3, 0x7E, 0xBF, 0x5F, 0xE7, 0xAD, 0xD6, 0xEB,
+0xF2, 0xFD, 0x7E, 0xFE, 0x5F, 0xAF, 0xD6, 0x0A, 0x83, 0xED, 0xFA, 0xFD, 0x7E, 0xBF, 0x5F, 0xAF,
+0xAE, 0xB7, 0x5B, 0xAE, 0x9F, 0xAF, 0xD7, 0xEB, 0xF5, 0xFA, 0xFD, 0x79, 0xB7, 0x9B, 0x79, 0xED,
+0xD6, 0xEB, 0x33, 0x3C, 0x1F, 0x0F, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD,
+0xBA, 0xDD, 0x6C, 0xF3, 0x6F, 0x36, 0xF3, 0x66, 0x78, 0x3E, 0x1F, 0x5B, 0xAD, 0xD6, 0xEB, 0x75,
+0xBA, 0xDD, 0x6E, 0xB7, 0x4D, 0xB6, 0xF3, 0x6F, 0x36, 0xFA, 0x7E, 0xBF, 0x5E, 0x33, 0xC1, 0xF0,
+0xFA, 0xDD, 0x6E, 0xB7, 0x5B, 0xAD, 0xD6, 0x6D, 0xE6, 0xDE, 0x6D, 0xE6, 0xDE, 0x6D, 0xE6, 0xDB,
+0x6D, 0xBC, 0xDB, 0xCD, 0xB6, 0x67, 0x83, 0xE1, 0xF5, 0xBA, 0xDD, 0x36, 0xDB, 0xCD, 0xBC, 0xDB,
+0xE9, 0xFA, 0xFD, 0x7D, 0x36, 0xF3, 0x6F, 0x36, 0xDB, 0xEB, 0x75, 0xBA, 0x66, 0x78, 0x3E, 0x1F,
+0x5B, 0xAD, 0xD6, 0xEB, 0x75, 0xBA, 0x6F, 0xD7, 0xEB, 0xF7, 0xD7, 0xEB, 0xF5, 0xBE, 0xB7, 0x5B,
+0xA6, 0x67, 0x83, 0xE3, 0xFF, 0xFF, 0x7D, 0x3F, 0x5F, 0xAF, 0xA7, 0xEB, 0xF5, 0xF4, 0xFD, 0x7E,
+0xBE, 0xBF, 0xFF, 0xF6, 0x0A, 0x9A, 0x79, 0xE7, 0x9B, 0x79, 0xE7, 0x9E, 0x79, 0xB7, 0x9E, 0x7D,
+0x3C, 0xF3, 0xCF, 0x3C, 0xFA, 0x79, 0xE6, 0x0A, 0xB0, 0xE3, 0xFF, 0xFF, 0xFF, 0x80, 0x54, 0xD3,
+0x0F, 0x3C, 0xFA, 0x79, 0xE7, 0x9E, 0x79, 0xF4, 0xF3, 0xCD, 0xBC, 0xF3, 0xCF, 0x3C, 0xDB, 0xCF,
+0x3C, 0x63, 0x03, 0xEF, 0x36, 0xF3, 0x6F, 0x3D, 0x9B, 0x79, 0xB7, 0x9B,
+};
+const SSD1306_Font_t Font_16x24 = {16, 24, NULL, NULL, Font16x24_packed};
+#endif
+
+#ifdef SSD1306_INCLUDE_FONT_16x15
+/* 1104 bytes, 2945 bytes unpacked */
+static const uint8_t Font16x15_packed[] = {
+0x00, 0x00, 0x0A, 0x00, 0x29, 0x00, 0x43, 0x00, 0xAF, 0x00, 0x11, 0x01, 0x88, 0x01, 0xF4, 0x01,
+0x0B, 0x02, 0x4C, 0x02, 0x9C, 0x02, 0xD4, 0x02, 0x30, 0x03, 0x47, 0x03, 0x5F, 0x03, 0x74, 0x03,
+0xB8, 0x03, 0x0E, 0x04, 0x4E, 0x04, 0xA4, 0x04, 0xFA, 0x04, 0x66, 0x05, 0xBC, 0x05, 0x12, 0x06,
+0x6E, 0x06, 0xC4, 0x06, 0x1A, 0x07, 0x36, 0x07, 0x54, 0x07, 0x92, 0x07, 0xB5, 0x07, 0xF3, 0x07,
+0x3E, 0x08, 0xEE, 0x08, 0x65, 0x09, 0xC6, 0x09, 0x32, 0x0A, 0x93, 0x0A, 0xE6, 0x0A, 0x3C, 0x0B,
+0xA8, 0x0B, 0x01, 0x0C, 0x1E, 0x0C, 0x74, 0x0C, 0xD5, 0x0C, 0x20, 0x0D, 0x97, 0x0D, 0xF8, 0x0D,
+0x63, 0x0E, 0xBF, 0x0E, 0x39, 0x0F, 0x9A, 0x0F, 0xF9, 0x0F, 0x70, 0x10, 0xD5, 0x10, 0x4C, 0x11,
+0xE4, 0x11, 0x5B, 0x12, 0xD2, 0x12, 0x2E, 0x13, 0x5E, 0x13, 0xAE, 0x13, 0xDE, 0x13, 0x06, 0x14,
+0x20, 0x14, 0x38, 0x14, 0x7C, 0x14, 0xD2, 0x14, 0x16, 0x15, 0x6C, 0x15, 0xAD, 0x15, 0xF1, 0x15,
+0x47, 0x16, 0x9D, 0x16, 0xBC, 0x16, 0xFA, 0x16, 0x50, 0x17, 0x6D, 0x17, 0xD9, 0x17, 0x1D, 0x18,
+0x61, 0x18, 0xB7, 0x18, 0x0D, 0x19, 0x41, 0x19, 0x7D, 0x19, 0xB9, 0x19, 0xFD, 0x19, 0x49, 0x1A,
+0xB5, 0x1A, 0x01, 0x1B, 0x62, 0x1B, 0xA6, 0x1B, 0xF6, 0x1B, 0x13, 0x1C, 0x63, 0x1C, 0x00, 0x02,
+0xB3, 0x0B, 0xFC, 0x84, 0x66, 0x27, 0xE1, 0x59, 0x20, 0x24, 0x24, 0x24, 0xFE, 0x48, 0x48, 0x49,
+0xFE, 0x48, 0x90, 0x90, 0x06, 0x99, 0x84, 0x3D, 0x0C, 0x30, 0x20, 0x70, 0x20, 0xC3, 0x0B, 0xC4,
+0x05, 0x66, 0x97, 0x02, 0x49, 0x28, 0x94, 0x74, 0x02, 0x02, 0x72, 0x49, 0x25, 0x12, 0x07, 0x0A,
+0xCD, 0x03, 0x04, 0x88, 0x89, 0x06, 0x06, 0x09, 0x28, 0xA8, 0x68, 0x47, 0xB0, 0x8C, 0x82, 0xE0,
+0x79, 0x8C, 0x54, 0x92, 0x49, 0x24, 0x91, 0x10, 0x3C, 0x88, 0x84, 0x22, 0x22, 0x11, 0x12, 0x22,
+0x24, 0x80, 0x98, 0x8C, 0x20, 0x8A, 0x5E, 0x51, 0x21, 0xA4, 0x90, 0x10, 0x10, 0x10, 0x10, 0xFF,
+0x10, 0x10, 0x10, 0x10, 0x58, 0xCC, 0x2E, 0x70, 0x91, 0x1E, 0xB0, 0x98, 0x50, 0xB0, 0xC8, 0x11,
+0x22, 0x24, 0x44, 0x88, 0x88, 0x0A, 0xCC, 0xC7, 0xA1, 0x86, 0x18, 0x61, 0x86, 0x18, 0x61, 0x78,
+0x2B, 0x32, 0x0F, 0x44, 0x44, 0x44, 0x44, 0x44, 0x2B, 0x33, 0x1E, 0x86, 0x10, 0x42, 0x08, 0x42,
+0x10, 0x83, 0xF0, 0xAC, 0xCC, 0x7A, 0x18, 0x41, 0x04, 0xE0, 0xC1, 0x86, 0x17, 0x82, 0xB2, 0x40,
+0x10, 0x30, 0x50, 0x50, 0x90, 0x91, 0x12, 0x13, 0xFC, 0x10, 0x10, 0x2B, 0x33, 0x1F, 0x82, 0x08,
+0x1E, 0x84, 0x10, 0x61, 0x44, 0xE0, 0xAC, 0xCC, 0x19, 0x88, 0x20, 0xFA, 0x18, 0x61, 0x86, 0x17,
+0x82, 0xB2, 0x3C, 0x71, 0x8D, 0x38, 0xE3, 0x4E, 0x34, 0xE3, 0x4E, 0x30, 0x2B, 0x33, 0x1E, 0x86,
+0x18, 0x61, 0x7B, 0x38, 0x61, 0x85, 0xE0, 0xAC, 0xCC, 0x7A, 0x18, 0x61, 0x86, 0x17, 0xC1, 0x04,
+0x27, 0x08, 0x83, 0x0A, 0x04, 0x8A, 0x30, 0xA0, 0x72, 0x1C, 0xCC, 0x04, 0x66, 0x20, 0x60, 0x60,
+0x4A, 0x43, 0x34, 0x6F, 0x71, 0x0E, 0x66, 0x40, 0xC0, 0xC0, 0x8C, 0xC4, 0x01, 0x59, 0x94, 0xE8,
+0xC4, 0x21, 0x11, 0x08, 0x00, 0x10, 0x4D, 0x36, 0x03, 0xE0, 0xC1, 0x90, 0x0A, 0x1C, 0x62, 0x46,
+0x44, 0x64, 0x46, 0x44, 0x64, 0x4A, 0x3B, 0x90, 0x00, 0x84, 0x07, 0x80, 0x2B, 0x24, 0x86, 0x03,
+0x01, 0x41, 0x20, 0x90, 0x44, 0x42, 0x1F, 0x10, 0x50, 0x28, 0x08, 0x56, 0x67, 0x7E, 0x85, 0x06,
+0x0C, 0x2F, 0x90, 0xE0, 0xC1, 0x83, 0xF8, 0x2B, 0x34, 0x0F, 0x10, 0xA0, 0x60, 0x20, 0x20, 0x20,
+0x20, 0x20, 0x50, 0x8F, 0x02, 0xB4, 0x3B, 0xE4, 0x28, 0x50, 0x60, 0xC1, 0x83, 0x06, 0x14, 0x2F,
+0x81, 0x5A, 0x1A, 0x38, 0xA6, 0x9A, 0x6D, 0x26, 0x9A, 0x69, 0xB8, 0x2B, 0x43, 0x3F, 0x82, 0x08,
+0x20, 0xFA, 0x08, 0x20, 0x82, 0x00, 0xAC, 0xD0, 0x3C, 0x42, 0x81, 0x80, 0x80, 0x80, 0x8F, 0x81,
+0x81, 0x41, 0x3E, 0x0A, 0xD0, 0xF0, 0x6A, 0xAA, 0xAA, 0xAF, 0x55, 0x55, 0x55, 0x54, 0x85, 0x68,
+0x18, 0xF0, 0x2B, 0x33, 0x01, 0x04, 0x10, 0x41, 0x04, 0x18, 0x61, 0x89, 0xC0, 0xAD, 0x0E, 0x87,
+0x12, 0x45, 0x0C, 0x14, 0x28, 0x48, 0x89, 0x0A, 0x08, 0x56, 0x85, 0x42, 0x10, 0x84, 0x21, 0x08,
+0x42, 0x1F, 0x0A, 0xD1, 0x28, 0x0C, 0x06, 0x07, 0x83, 0xC2, 0xE1, 0x68, 0xB4, 0x99, 0x4C, 0xC6,
+0x22, 0x15, 0xA1, 0xD0, 0x60, 0xE1, 0xC3, 0x46, 0x4C, 0x98, 0xB0, 0xE1, 0xC1, 0x0A, 0xCD, 0x15,
+0x19, 0x84, 0x9C, 0xB2, 0xCB, 0x2C, 0xB2, 0xC4, 0x98, 0x5C, 0x41, 0x59, 0x9E, 0x31, 0x35, 0x55,
+0x55, 0x57, 0x82, 0x71, 0xC7, 0x1C, 0x16, 0x9A, 0x2A, 0x33, 0x09, 0x39, 0x65, 0x96, 0x59, 0x65,
+0x89, 0x30, 0xB9, 0xC9, 0xE4, 0x85, 0x68, 0x77, 0xC8, 0x50, 0xA1, 0x42, 0x89, 0xE2, 0x24, 0x48,
+0x50, 0x42, 0xB3, 0x3C, 0xD2, 0x6A, 0xAB, 0x87, 0x9F, 0x07, 0x2A, 0xA9, 0x34, 0x85, 0x64, 0x97,
+0xFC, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x80, 0x40, 0x20, 0x10, 0x0A, 0xCD, 0x10, 0x72,
+0xCB, 0x2C, 0xB2, 0xCB, 0x2C, 0xB1, 0x26, 0x17, 0x10, 0x56, 0x49, 0x40, 0x60, 0x48, 0x24, 0x22,
+0x10, 0x88, 0x48, 0x24, 0x0A, 0x06, 0x03, 0x00, 0xAC, 0xD8, 0x84, 0x18, 0x61, 0x8A, 0x18, 0xA2,
+0x89, 0x24, 0x92, 0x51, 0x25, 0x14, 0x50, 0xC2, 0x04, 0x20, 0x40, 0xAC, 0x92, 0x81, 0x21, 0x08,
+0x84, 0x81, 0x80, 0x40, 0x50, 0x48, 0x22, 0x20, 0xA0, 0x61, 0x59, 0x25, 0x03, 0x41, 0x21, 0x08,
+0x84, 0x81, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0xB3, 0x3C, 0x71, 0x4E, 0x34, 0xD3, 0x8D,
+0x34, 0xD3, 0x8E, 0xE0, 0x0E, 0x31, 0x3A, 0xAA, 0xAA, 0xAC, 0x2C, 0x22, 0xA1, 0x04, 0x20, 0x84,
+0x20, 0x84, 0x20, 0x84, 0x0E, 0x11, 0x35, 0x55, 0x55, 0x5C, 0x25, 0x32, 0x11, 0xAA, 0x65, 0x81,
+0x13, 0x3F, 0x08, 0x8C, 0x49, 0x22, 0x0C, 0xC7, 0xA1, 0x05, 0xF8, 0x61, 0x8D, 0xD0, 0xAC, 0xCC,
+0x82, 0x08, 0x3E, 0x86, 0x18, 0x61, 0x86, 0x1F, 0x88, 0x83, 0x31, 0xE8, 0x61, 0x82, 0x08, 0x21,
+0x78, 0x2B, 0x33, 0x01, 0x04, 0x17, 0xE1, 0x86, 0x18, 0x61, 0x85, 0xF2, 0x20, 0xCD, 0x30, 0x98,
+0xA7, 0x34, 0xE3, 0xA0, 0x18, 0x64, 0x1A, 0x44, 0x74, 0x44, 0x44, 0x44, 0x11, 0x66, 0x63, 0xF0,
+0xC3, 0x0C, 0x30, 0xC2, 0xF8, 0x31, 0x3C, 0x15, 0x99, 0x90, 0x41, 0x05, 0xD8, 0xC3, 0x0C, 0x30,
+0xC3, 0x08, 0x56, 0x61, 0x4F, 0xF0, 0xB8, 0x06, 0x20, 0x12, 0x49, 0x24, 0x93, 0x82, 0xB3, 0x32,
+0x08, 0x20, 0x8E, 0x4A, 0x30, 0xA2, 0x48, 0xA1, 0x0A, 0xCC, 0x31, 0xE1, 0x10, 0x6B, 0x5C, 0xEC,
+0x63, 0x08, 0x61, 0x0C, 0x21, 0x84, 0x30, 0x86, 0x10, 0x91, 0x06, 0x65, 0xD8, 0xC3, 0x0C, 0x30,
+0xC3, 0x09, 0x10, 0x66, 0x3D, 0x0C, 0x30, 0xC3, 0x0C, 0x2F, 0x11, 0x66, 0x67, 0xD0, 0xC3, 0x0C,
+0x30, 0xC3, 0xF4, 0x10, 0x40, 0x45, 0x99, 0x8F, 0xC3, 0x0C, 0x30, 0xC3, 0x0B, 0xE0, 0x82, 0x09,
+0x10, 0x64, 0x5E, 0x44, 0x44, 0x44, 0x11, 0x06, 0x53, 0xA3, 0x06, 0x0C, 0x31, 0x70, 0x94, 0x44,
+0x22, 0x7A, 0x22, 0x22, 0x21, 0x91, 0x06, 0x64, 0x30, 0xC3, 0x0C, 0x30, 0xC2, 0xF9, 0x10, 0x47,
+0x41, 0x84, 0x89, 0x22, 0x42, 0x86, 0x04, 0x11, 0x04, 0xB4, 0x23, 0x8C, 0x49, 0x89, 0x2A, 0x29,
+0x45, 0x28, 0x63, 0x08, 0x41, 0x10, 0x47, 0x43, 0x48, 0x50, 0xC1, 0x82, 0x88, 0xA1, 0x91, 0x64,
+0x74, 0x18, 0x48, 0x92, 0x24, 0x28, 0x60, 0x40, 0x82, 0x0C, 0x08, 0x83, 0x33, 0xE0, 0x84, 0x21,
+0x08, 0x20, 0xFC, 0x0F, 0x32, 0x0D, 0x11, 0x11, 0x12, 0x11, 0x11, 0x11, 0x0C, 0x2D, 0x30, 0xC7,
+0xC0, 0x79, 0x11, 0x08, 0x84, 0x44, 0x42, 0x44, 0x44, 0x89, 0x06, 0x19, 0xA0, 0xC3, 0x33, 0x1C,
+};
+static const uint8_t Font16x15_char_width[] = {
+6, 5, 6, 11, 10, 13, 11, 4, 7, 7, 8, 10, 5, 6, 5, 8,
+10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 5, 5, 10, 10, 10, 9,
+16, 11, 11, 12, 12, 11, 11, 12, 13, 6, 10, 12, 10, 15, 13, 12,
+11, 12, 12, 11, 11, 12, 11, 16, 11, 11, 11, 6, 8, 5, 8, 8,
+6, 10, 10, 10, 10, 10, 8, 10, 10, 5, 5, 9, 5, 15, 10, 10,
+10, 10, 7, 9, 7, 10, 9, 13, 9, 9, 9, 7, 5, 7, 12,
+};
+const SSD1306_Font_t Font_16x15 = {16, 15, NULL, Font16x15_char_width, Font16x15_packed};
+#endif
+
+#endif /* SSD1306_USE_PACKED_FONTS */
@@ -3,6 +3,7 @@
 #include "ssd1306.h"
 #include "ssd1306_tests.h"
 #include "ssd1306_fonts.h"
+#include "ssd1306_bignum.h"
 
 //------------------------------------------------------------------------------
 // Table generated by LCD Assistant
@@ -356,6 +357,22 @@ void ssd1306_TestDrawBitmap()
     ssd1306_UpdateScreen();
 }
 
+/*
+ * Large segment digits: count an altitude-like value, redrawing only
+ * the segments that change.
+ */
+void ssd1306_TestBigNum() {
+    SSD1306_BigNum_t alt;
+
+    ssd1306_Fill(Black);
+    ssd1306_BigNumInit(&alt, 0, 8, 16, 40, 3, 6);
+    for (int32_t v = -250; v <= 250; v += 7) {
+        ssd1306_BigNumWriteFloat(&alt, v / 10.0f, 1, White);
+        ssd1306_UpdateScreen();
+        HAL_Delay(20);
+    }
+}
+
 void ssd1306_TestAll() {
     ssd1306_Init();
 
@@ -389,5 +406,7 @@ void ssd1306_TestAll() {
     HAL_Delay(3000);
     ssd1306_TestDrawBitmap();
     HAL_Delay(3000);
+    ssd1306_TestBigNum();
+    HAL_Delay(3000);
 }
 
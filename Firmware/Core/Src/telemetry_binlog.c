@@ -0,0 +1,372 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry_binlog.c
+  * @brief          : Binary telemetry log format: sector framing, CRC,
+  *                   field packing and packed sectors. See
+  *                   telemetry_binlog.h for the layout.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "telemetry_binlog.h"
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+/* Version 1 record. Names match the CSV header; decimals match its %.2f */
+const TelemetryBinlog_Field_t TelemetryBinlog_Fields[TELEMETRY_BINLOG_FIELD_COUNT] = {
+    { "TimeMS",    TELEMETRY_BINLOG_U32,  0, 0 },
+    { "Hour",      TELEMETRY_BINLOG_U8,   4, 0 },
+    { "Min",       TELEMETRY_BINLOG_U8,   5, 0 },
+    { "Sec",       TELEMETRY_BINLOG_U8,   6, 0 },
+    { "Altitude",  TELEMETRY_BINLOG_I24,  7, 2 },   // m, +-83 km
+    { "Speed",     TELEMETRY_BINLOG_U16, 10, 2 },   // m/s, up to 655
+    { "Voltage",   TELEMETRY_BINLOG_U16, 12, 2 },   // V, up to 655
+    { "AltRate",   TELEMETRY_BINLOG_I16, 14, 2 },   // m/s, +-327
+    { "SpeedRate", TELEMETRY_BINLOG_I16, 16, 2 },   // m/s^2, +-327
+    { "VoltRate",  TELEMETRY_BINLOG_I16, 18, 3 },   // V/s, +-32
+};
+
+static const double pow10_table[] = { 1.0, 10.0, 100.0, 1000.0, 10000.0 };
+
+/* Private functions ---------------------------------------------------------*/
+static void put16(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void begin_frame(uint8_t *sector, uint16_t magic, uint32_t seq)
+{
+    memset(sector, 0, TELEMETRY_BINLOG_SECTOR);
+    put16(sector, magic);
+    put32(sector + TELEMETRY_BINLOG_SEQ_OFFSET, seq);
+}
+
+/** Store v as a varint, 7 bits per byte, low first; returns the end */
+static uint8_t *put_varint(uint8_t *p, uint32_t v)
+{
+    while (v >= 0x80U) {
+        *p++ = (uint8_t)(v | 0x80U);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/** Read a varint of at most 5 bytes from p, before end; NULL if malformed */
+static const uint8_t *get_varint(const uint8_t *p, const uint8_t *end, uint32_t *v)
+{
+    uint32_t shift = 0;
+
+    *v = 0;
+    while (p < end && shift < 35U) {
+        uint8_t b = *p++;
+        *v |= (uint32_t)(b & 0x7FU) << shift;
+        if (!(b & 0x80U)) return p;
+        shift += 7U;
+    }
+    return NULL;
+}
+
+/** Field i of a record as 32 bits, as the packed coding takes it */
+static uint32_t field_value(const uint8_t *record, uint32_t i)
+{
+    const TelemetryBinlog_Field_t *f = &TelemetryBinlog_Fields[i];
+    return (uint32_t)TelemetryBinlog_Get(record, f->type, f->offset);
+}
+
+static int32_t check_frame(const uint8_t *sector, uint16_t magic, uint32_t seq, uint32_t max_count,
+                           uint32_t file_id)
+{
+    uint32_t count = TelemetryBinlog_Get16(sector + TELEMETRY_BINLOG_COUNT_OFFSET);
+
+    if (TelemetryBinlog_Get16(sector) != magic) return -1;
+    if (TelemetryBinlog_Get32(sector + TELEMETRY_BINLOG_SEQ_OFFSET) != seq) return -1;
+    if (count > max_count) return -1;
+    if (TelemetryBinlog_Get32(sector + TELEMETRY_BINLOG_CRC_OFFSET) !=
+        TelemetryBinlog_Crc32Update(file_id, sector, TELEMETRY_BINLOG_CRC_OFFSET)) return -1;
+    return (int32_t)count;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+uint32_t TelemetryBinlog_Get16(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+uint32_t TelemetryBinlog_Get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/** CRC-32 (IEEE 802.3, reflected), nibble table to keep flash use small */
+uint32_t TelemetryBinlog_Crc32(const uint8_t *data, uint32_t len)
+{
+    return TelemetryBinlog_Crc32Update(0, data, len);
+}
+
+/** CRC-32 continued over more data; start from 0, as zlib's crc32 */
+uint32_t TelemetryBinlog_Crc32Update(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+/** Start a sector: frame header, zeroed payload, no trailer yet */
+void TelemetryBinlog_BeginSector(uint8_t *sector, uint32_t seq)
+{
+    begin_frame(sector, TELEMETRY_BINLOG_MAGIC, seq);
+}
+
+/** Write the trailer once a sector's contents are final; the CRC is
+  * seeded with the ID of the file it belongs to */
+void TelemetryBinlog_SealSector(uint8_t *sector, uint16_t count, uint32_t file_id)
+{
+    put16(sector + TELEMETRY_BINLOG_COUNT_OFFSET, count);
+    put32(sector + TELEMETRY_BINLOG_CRC_OFFSET,
+          TelemetryBinlog_Crc32Update(file_id, sector, TELEMETRY_BINLOG_CRC_OFFSET));
+}
+
+/** Fill sector 0 with the file header describing the current record */
+void TelemetryBinlog_BuildHeader(uint8_t *sector, uint32_t file_id, uint32_t history_ms)
+{
+    uint8_t *hdr = sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET;
+
+    TelemetryBinlog_BeginSector(sector, 0);
+    memcpy(hdr, TELEMETRY_BINLOG_HDR_ID, 4);
+    put16(hdr + TELEMETRY_BINLOG_HDR_VERSION, TELEMETRY_BINLOG_VERSION);
+    put16(hdr + TELEMETRY_BINLOG_HDR_RECORD_SIZE, TELEMETRY_BINLOG_RECORD_SIZE);
+    put16(hdr + TELEMETRY_BINLOG_HDR_PER_SECTOR, TELEMETRY_BINLOG_RECORDS_PER_SECTOR);
+    put16(hdr + TELEMETRY_BINLOG_HDR_FIELD_COUNT, TELEMETRY_BINLOG_FIELD_COUNT);
+
+    uint8_t *desc = hdr + TELEMETRY_BINLOG_HDR_FIELDS;
+    for (uint32_t i = 0; i < TELEMETRY_BINLOG_FIELD_COUNT; i++) {
+        const TelemetryBinlog_Field_t *f = &TelemetryBinlog_Fields[i];
+        strncpy((char *)desc, f->name, TELEMETRY_BINLOG_NAME_LEN - 1);
+        desc[TELEMETRY_BINLOG_NAME_LEN + 0] = f->type;
+        desc[TELEMETRY_BINLOG_NAME_LEN + 1] = f->offset;
+        desc[TELEMETRY_BINLOG_NAME_LEN + 2] = f->decimals;
+        desc += TELEMETRY_BINLOG_DESC_SIZE;
+    }
+    put32(hdr + TELEMETRY_BINLOG_HDR_HISTORY_MS, history_ms);
+    put32(hdr + TELEMETRY_BINLOG_HDR_FILE_ID, file_id);
+    TelemetryBinlog_SealSector(sector, 0, file_id);
+}
+
+/** The file ID in a header sector, to check it and the rest of the file by;
+  * 0 in logs from before version 4 */
+uint32_t TelemetryBinlog_FileId(const uint8_t *header)
+{
+    return TelemetryBinlog_Get32(header + TELEMETRY_BINLOG_PAYLOAD_OFFSET + TELEMETRY_BINLOG_HDR_FILE_ID);
+}
+
+/** Start a packed record sector */
+void TelemetryBinlog_BeginPacked(uint8_t *sector, uint32_t seq)
+{
+    begin_frame(sector, TELEMETRY_BINLOG_PACKED_MAGIC, seq);
+}
+
+/**
+  * Validate a sealed sector, plain or packed, read back from position seq
+  * in the file with ID file_id. Returns its record count, or -1 if the
+  * frame, sequence or CRC is wrong, as it is for another file's sector.
+  */
+int32_t TelemetryBinlog_CheckSector(const uint8_t *sector, uint32_t seq, uint32_t file_id)
+{
+    if (TelemetryBinlog_Get16(sector) == TELEMETRY_BINLOG_PACKED_MAGIC) {
+        return check_frame(sector, TELEMETRY_BINLOG_PACKED_MAGIC, seq, TELEMETRY_BINLOG_PACKED_PER_SECTOR, file_id);
+    }
+    return check_frame(sector, TELEMETRY_BINLOG_MAGIC, seq, TELEMETRY_BINLOG_RECORDS_PER_SECTOR, file_id);
+}
+
+/** Start index trailer sector seq; first is the seq of the trailer's first sector */
+void TelemetryBinlog_BeginIndex(uint8_t *sector, uint32_t seq, uint32_t first)
+{
+    begin_frame(sector, TELEMETRY_BINLOG_INDEX_MAGIC, seq);
+    put32(sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET + TELEMETRY_BINLOG_INDEX_FIRST, first);
+}
+
+/** Fill entry slot of an index sector: the sector at byte offset starts at time_ms */
+void TelemetryBinlog_PutIndex(uint8_t *sector, uint32_t slot, uint32_t time_ms, uint32_t offset)
+{
+    uint8_t *p = sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET + TELEMETRY_BINLOG_INDEX_ENTRIES +
+                 slot * TELEMETRY_BINLOG_INDEX_ENTRY_SIZE;
+    put32(p, time_ms);
+    put32(p + 4, offset);
+}
+
+/** As TelemetryBinlog_CheckSector, for an index sector; returns its entry count */
+int32_t TelemetryBinlog_CheckIndex(const uint8_t *sector, uint32_t seq, uint32_t file_id)
+{
+    return check_frame(sector, TELEMETRY_BINLOG_INDEX_MAGIC, seq, TELEMETRY_BINLOG_INDEX_PER_SECTOR, file_id);
+}
+
+/** Start packing from record, the first of a packed sector, stored as is */
+void TelemetryBinlog_PackFirst(TelemetryBinlog_Packer_t *packer, const uint8_t *record)
+{
+    for (uint32_t i = 0; i < TELEMETRY_BINLOG_FIELD_COUNT; i++) packer->value[i] = field_value(record, i);
+    packer->interval = 0;
+}
+
+/**
+  * Pack record as its changes from the previous one into out, which needs
+  * room for TELEMETRY_BINLOG_PACKED_MAX bytes. Returns the bytes used.
+  */
+uint32_t TelemetryBinlog_Pack(TelemetryBinlog_Packer_t *packer, const uint8_t *record, uint8_t *out)
+{
+    uint32_t delta[TELEMETRY_BINLOG_FIELD_COUNT];
+    uint32_t mask = 0;
+    uint8_t *p;
+
+    for (uint32_t i = 0; i < TELEMETRY_BINLOG_FIELD_COUNT; i++) {
+        uint32_t v = field_value(record, i);
+        uint32_t d = v - packer->value[i];
+
+        if (i == TELEMETRY_BINLOG_TIME_MS) {
+            uint32_t step = d;
+            d -= packer->interval;
+            packer->interval = step;
+        }
+        packer->value[i] = v;
+        delta[i] = (d << 1) ^ (uint32_t)((int32_t)d >> 31); // Zigzag
+        if (delta[i]) mask |= 1U << (TELEMETRY_BINLOG_FIELD_COUNT - 1U - i);
+    }
+
+    p = put_varint(out, mask);
+    for (uint32_t i = 0; i < TELEMETRY_BINLOG_FIELD_COUNT; i++) {
+        if (delta[i]) p = put_varint(p, delta[i]);
+    }
+    return (uint32_t)(p - out);
+}
+
+/**
+  * Unpack the record at in, of which avail bytes are readable, onto the
+  * previous one in packer. Returns the bytes it took, or -1 if malformed.
+  */
+int32_t TelemetryBinlog_Unpack(TelemetryBinlog_Packer_t *packer, const uint8_t *in, uint32_t avail)
+{
+    const uint8_t *p = in;
+    const uint8_t *end = in + avail;
+    uint32_t mask;
+
+    p = get_varint(p, end, &mask);
+    if (!p || (mask >> TELEMETRY_BINLOG_FIELD_COUNT)) return -1;
+
+    for (uint32_t i = 0; i < TELEMETRY_BINLOG_FIELD_COUNT; i++) {
+        uint32_t d = 0;
+
+        if (mask & (1U << (TELEMETRY_BINLOG_FIELD_COUNT - 1U - i))) {
+            p = get_varint(p, end, &d);
+            if (!p) return -1;
+            d = (d >> 1) ^ (0U - (d & 1U));
+        }
+        if (i == TELEMETRY_BINLOG_TIME_MS) {
+            packer->interval += d;
+            d = packer->interval;
+        }
+        packer->value[i] += d;
+    }
+    return (int32_t)(p - in);
+}
+
+/**
+  * Walk the count records of a packed sector, leaving packer at the last.
+  * Returns the sector offset just past them, or -1 if they do not unpack.
+  */
+int32_t TelemetryBinlog_PackedEnd(const uint8_t *sector, uint32_t count, TelemetryBinlog_Packer_t *packer)
+{
+    uint32_t fill = TELEMETRY_BINLOG_PAYLOAD_OFFSET;
+
+    if (count == 0) return (int32_t)fill;
+    TelemetryBinlog_PackFirst(packer, sector + fill);
+    fill += TELEMETRY_BINLOG_RECORD_SIZE;
+
+    for (uint32_t r = 1; r < count; r++) {
+        int32_t n = TelemetryBinlog_Unpack(packer, sector + fill, TELEMETRY_BINLOG_COUNT_OFFSET - fill);
+        if (n < 0) return -1;
+        fill += (uint32_t)n;
+    }
+    return (int32_t)fill;
+}
+
+/** Store an integer field, saturating to the range of its type */
+void TelemetryBinlog_Put(uint8_t *record, const TelemetryBinlog_Field_t *field, int64_t value)
+{
+    int64_t lo = 0, hi;
+    uint8_t *p = record + field->offset;
+
+    switch (field->type) {
+    case TELEMETRY_BINLOG_U8:  hi = 0xFF; break;
+    case TELEMETRY_BINLOG_U16: hi = 0xFFFF; break;
+    case TELEMETRY_BINLOG_I16: lo = -0x8000; hi = 0x7FFF; break;
+    case TELEMETRY_BINLOG_I24: lo = -0x800000; hi = 0x7FFFFF; break;
+    default:                   hi = 0xFFFFFFFF; break;
+    }
+    if (value < lo) value = lo;
+    if (value > hi) value = hi;
+
+    uint32_t v = (uint32_t)value;
+    switch (field->type) {
+    case TELEMETRY_BINLOG_U8:  p[0] = (uint8_t)v; break;
+    case TELEMETRY_BINLOG_U16:
+    case TELEMETRY_BINLOG_I16: put16(p, v); break;
+    case TELEMETRY_BINLOG_I24: put16(p, v); p[2] = (uint8_t)(v >> 16); break;
+    default:                   put32(p, v); break;
+    }
+}
+
+/**
+  * Store a value at the field's fixed-point scale, rounded to nearest. The
+  * product is formed in double, where it is exact for any float, and a tie
+  * goes to the even neighbour as printf rounds it. Printed with the field's
+  * decimals, the result is what printf gives for the float: the CSV log's
+  * "%.2f" byte for byte, but for "-0.00", which no integer stands for.
+  */
+void TelemetryBinlog_PutFixed(uint8_t *record, const TelemetryBinlog_Field_t *field, float value)
+{
+    double v = (double)value * pow10_table[field->decimals];
+    int64_t n = (int64_t)v;     // Toward zero
+    double frac = v - (double)n;
+
+    if (frac > 0.5 || (frac == 0.5 && (n & 1))) n++;
+    else if (frac < -0.5 || (frac == -0.5 && (n & 1))) n--;
+    TelemetryBinlog_Put(record, field, n);
+}
+
+/** Read a field as a signed integer, from a descriptor's type and offset */
+int64_t TelemetryBinlog_Get(const uint8_t *record, uint8_t type, uint8_t offset)
+{
+    const uint8_t *p = record + offset;
+
+    switch (type) {
+    case TELEMETRY_BINLOG_U8:  return p[0];
+    case TELEMETRY_BINLOG_U16: return TelemetryBinlog_Get16(p);
+    case TELEMETRY_BINLOG_I16: return (int16_t)TelemetryBinlog_Get16(p);
+    case TELEMETRY_BINLOG_I24: {
+        uint32_t v = TelemetryBinlog_Get16(p) | ((uint32_t)p[2] << 16);
+        return (v & 0x800000U) ? (int64_t)v - 0x1000000 : (int64_t)v;
+    }
+    default:                   return TelemetryBinlog_Get32(p);
+    }
+}
@@ -0,0 +1,230 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry_download.c
+  * @brief          : Log file download over USART1.
+  *
+  *                   Two frame buffers take turns: while DMA sends one, the
+  *                   next chunk is read into the other, so the card's read
+  *                   time hides behind the UART's. Chunks after the first
+  *                   start on a TELEMETRY_DOWNLOAD_CHUNK boundary of the
+  *                   file, so FatFs hands whole runs of sectors to USER_read,
+  *                   which reads them with one CMD18.
+  *
+  *                   The rate is changed by rewriting BRR once the last byte
+  *                   has left, not with HAL_UART_Init, which would drop the
+  *                   interrupt reception main.c keeps armed for commands.
+  *
+  *                   Nothing blocks but the reply line and the card reads;
+  *                   TelemetryDownload_Poll moves the transfer on from the
+  *                   superloop, which then runs without its idle delay.
+  *                   The blocking reply only goes out while no transfer owns
+  *                   the UART, and main.c refuses STATS while one does.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "telemetry_download.h"
+#include "telemetry_log.h"
+#include "telemetry_binlog.h"
+#include "fatfs.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define DL_REPLY_TIMEOUT_MS     100U
+#define DL_TC_TIMEOUT_MS        10U     // Last byte leaving, at the slowest rate
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+    DL_IDLE = 0,
+    DL_SETTLE,          // Rate changed, waiting for the host to follow
+    DL_SEND,            // Sending frames
+    DL_DRAIN            // The END or FAIL frame on the wire
+} DownloadState_t;
+
+/* Private variables ---------------------------------------------------------*/
+extern UART_HandleTypeDef huart1;
+
+static FIL dl_fil;
+static uint8_t dl_frame[2][TELEMETRY_DOWNLOAD_FRAME_MAX] __attribute__((aligned(4)));
+static uint16_t dl_frame_len[2];
+static uint8_t dl_next;             // Frame buffer to send next
+static DownloadState_t dl_state;
+static uint32_t dl_pos;             // File position of the next chunk to read
+static uint32_t dl_end;             // End of the requested range
+static uint32_t dl_crc;             // CRC-32 of the data read so far
+static uint32_t dl_baud;            // Telemetry rate to return to
+static uint32_t dl_tick;
+static uint8_t dl_stop;
+
+/* Private functions ---------------------------------------------------------*/
+static void put16(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, v);
+    put16(p + 2, v >> 16);
+}
+
+/** A line at the telemetry rate, only while no frame is going out by DMA */
+static void reply(const char *line)
+{
+    if (dl_state != DL_IDLE || huart1.gState != HAL_UART_STATE_READY) return;
+    HAL_UART_Transmit(&huart1, (uint8_t*)line, (uint16_t)strlen(line), DL_REPLY_TIMEOUT_MS);
+}
+
+/** Changes the USART1 rate once the last byte has gone */
+static void set_baud(uint32_t baud)
+{
+    uint32_t tick = HAL_GetTick();
+
+    while (!__HAL_UART_GET_FLAG(&huart1, UART_FLAG_TC) && (HAL_GetTick() - tick) < DL_TC_TIMEOUT_MS) {
+    }
+    huart1.Init.BaudRate = baud;
+    huart1.Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK2Freq(), baud);
+}
+
+/** Fills in a frame's header and CRC; returns its length */
+static uint16_t frame_seal(uint8_t *frame, uint8_t type, uint32_t offset, uint32_t length)
+{
+    put16(frame, TELEMETRY_DOWNLOAD_MAGIC);
+    frame[2] = type;
+    frame[3] = 0;
+    put32(frame + 4, offset);
+    put16(frame + 8, length);
+    put32(frame + TELEMETRY_DOWNLOAD_HEADER + length,
+          TelemetryBinlog_Crc32(frame, TELEMETRY_DOWNLOAD_HEADER + length));
+    return (uint16_t)(TELEMETRY_DOWNLOAD_HEADER + length + TELEMETRY_DOWNLOAD_TRAILER);
+}
+
+/** Reads the next chunk into frame buffer b; the END frame once the range
+ *  has all been read, or FAIL if the card cannot read it */
+static void frame_fill(uint8_t b)
+{
+    uint8_t *frame = dl_frame[b];
+    uint32_t n = TELEMETRY_DOWNLOAD_CHUNK - dl_pos % TELEMETRY_DOWNLOAD_CHUNK;
+    UINT br;
+
+    if (n > dl_end - dl_pos) n = dl_end - dl_pos;
+    if (n == 0) {
+        put32(frame + TELEMETRY_DOWNLOAD_HEADER, dl_crc);
+        dl_frame_len[b] = frame_seal(frame, TELEMETRY_DOWNLOAD_END, dl_pos, 4);
+        return;
+    }
+    if (f_read(&dl_fil, frame + TELEMETRY_DOWNLOAD_HEADER, n, &br) != FR_OK || br != n) {
+        dl_frame_len[b] = frame_seal(frame, TELEMETRY_DOWNLOAD_FAIL, dl_pos, 0);
+        return;
+    }
+    dl_crc = TelemetryBinlog_Crc32Update(dl_crc, frame + TELEMETRY_DOWNLOAD_HEADER, n);
+    dl_frame_len[b] = frame_seal(frame, TELEMETRY_DOWNLOAD_DATA, dl_pos, n);
+    dl_pos += n;
+}
+
+static void download_end(void)
+{
+    set_baud(dl_baud);
+    f_close(&dl_fil);
+    dl_state = DL_IDLE;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * Answers a GET: opens the log, replies at the current rate and switches
+  * to the transfer rate. A GET during a transfer is ignored.
+  */
+void TelemetryDownload_Start(uint32_t number, uint32_t offset, uint32_t length, uint32_t baud)
+{
+    char line[64];
+
+    if (dl_state != DL_IDLE) return;
+    if (!TelemetryLog_IsMounted()) {
+        reply("ERR NOCARD\r\n");
+        return;
+    }
+    if (number == TelemetryLog_FileNumber()) {
+        reply("ERR OPEN\r\n");
+        return;
+    }
+    if (baud == 0) baud = huart1.Init.BaudRate;
+    if (baud < 1200U || baud > HAL_RCC_GetPCLK2Freq() / 16U) {
+        reply("ERR BAUD\r\n");
+        return;
+    }
+
+    snprintf(line, sizeof(line), TELEMETRY_LOG_PREFIX "%05lu" TELEMETRY_LOG_EXT, (unsigned long)number);
+    if (f_open(&dl_fil, line, FA_READ) != FR_OK) {
+        reply("ERR NOFILE\r\n");
+        return;
+    }
+    uint32_t size = (uint32_t)f_size(&dl_fil);
+    if (offset > size || f_lseek(&dl_fil, offset) != FR_OK) {
+        f_close(&dl_fil);
+        reply("ERR OFFSET\r\n");
+        return;
+    }
+
+    dl_pos = offset;
+    dl_end = (length && length < size - offset) ? offset + length : size;
+    dl_crc = 0;
+    dl_stop = 0;
+    dl_baud = huart1.Init.BaudRate;
+
+    snprintf(line, sizeof(line), "OK %lu %lu %lu %lu\r\n", (unsigned long)size, (unsigned long)offset,
+        (unsigned long)(dl_end - offset), (unsigned long)baud);
+    reply(line);
+    set_baud(baud);
+    dl_tick = HAL_GetTick();
+    dl_state = DL_SETTLE;
+}
+
+/** Ends the transfer after the frame on the wire */
+void TelemetryDownload_Stop(void)
+{
+    if (dl_state != DL_IDLE) dl_stop = 1;
+}
+
+/**
+  * Starts the next frame once the UART is free, then reads the one after
+  * it. Call from the superloop.
+  */
+void TelemetryDownload_Poll(void)
+{
+    if (dl_state == DL_SETTLE) {
+        if ((HAL_GetTick() - dl_tick) < TELEMETRY_DOWNLOAD_SETTLE_MS) return;
+        dl_next = 0;
+        frame_fill(0);
+        dl_state = DL_SEND;
+    }
+
+    if (dl_state == DL_SEND) {
+        if (huart1.gState != HAL_UART_STATE_READY) return; // Frame still going out
+        if (dl_stop) {
+            download_end();
+            return;
+        }
+        uint8_t *frame = dl_frame[dl_next];
+        if (HAL_UART_Transmit_DMA(&huart1, frame, dl_frame_len[dl_next]) != HAL_OK) {
+            download_end();
+            return;
+        }
+        if (frame[2] != TELEMETRY_DOWNLOAD_DATA) {
+            dl_state = DL_DRAIN;
+            return;
+        }
+        dl_next ^= 1U;
+        frame_fill(dl_next); // Read while the UART sends
+        return;
+    }
+
+    if (dl_state == DL_DRAIN && huart1.gState == HAL_UART_STATE_READY) download_end();
+}
+
+uint8_t TelemetryDownload_IsActive(void)
+{
+    return dl_state != DL_IDLE;
+}
@@ -0,0 +1,1494 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry_log.c
+  * @brief          : Buffered telemetry logging to the SD card.
+  *
+  *                   Records are packed in the binary format of
+  *                   telemetry_binlog.h, or formatted as CSV when
+  *                   TELEMETRY_LOG_BINARY is 0.
+  *
+  *                   log_buf is a ring of sector buffers: log_tail is the
+  *                   oldest full sector waiting for the card, log_head the
+  *                   sector records are going into. Full sectors leave one
+  *                   at a time, and only when USER_Poll reports the card idle,
+  *                   so each write returns as soon as DMA has the block.
+  *
+  *                   Records go into packed sectors, the first as is and
+  *                   the rest as changes from the record before, unless
+  *                   TELEMETRY_LOG_PACKED is 0. A sector counts as full once
+  *                   the longest possible record would not fit, and queues.
+  *
+  *                   The binary log is written in whole sectors. A timed
+  *                   commit seals the partly filled head sector and writes it
+  *                   at its place in the file; it is written again as it
+  *                   fills, so every sector in the file carries a CRC. Once
+  *                   a commit of it is in place, the next goes to the place
+  *                   after it instead, and they alternate (log_copy_seq), so
+  *                   a write torn by a power cut never takes the last
+  *                   commit with it; log_resume takes the newer copy back
+  *                   into place. A new
+  *                   binary log is preallocated contiguously with f_expand,
+  *                   erased (CTRL_TRIM), and its sectors streamed straight
+  *                   to their LBAs with CMD25 (USER_StreamWrite). FatFs is
+  *                   not involved again until the file is closed and cut to
+  *                   the data written.
+  *
+  *                   Each boot starts a new numbered file (log_number); a
+  *                   remount after a write error carries on in the same one.
+  *                   While no card is mounted, records wait in log_backlog
+  *                   and TelemetryLog_Poll retries the mount, backing off
+  *                   between attempts. The mount runs in steps, one per poll
+  *                   (log_mount_step): card initialisation, the FatFs mount,
+  *                   opening the session, and preallocating a new log. A
+  *                   write error puts what the session had not committed
+  *                   back in log_backlog (log_requeue). Once mounted, the
+  *                   ring drains a few records per poll ahead of new ones,
+  *                   which queue behind it until it is empty.
+  *                   With TELEMETRY_LOG_DECIMATE above 1, between events
+  *                   every DECIMATE'th record goes to the log at once and the
+  *                   rest into log_bb, dropped once held for
+  *                   TELEMETRY_LOG_BLACKBOX_MS. An event logs what log_bb
+  *                   holds and passes the records after it straight on.
+  *                   That history enters the log behind kept records up to
+  *                   the window newer. A binary log's header gives the
+  *                   window, and the decoder merges the two by TimeMS; a
+  *                   CSV log has to be sorted by its first column.
+  *                   Closing a binary log, at rotation or TelemetryLog_Close,
+  *                   appends the index trailer built in log_index: one entry
+  *                   per log_index_step sectors, the spacing doubling
+  *                   whenever the table fills so it stays a fixed size.
+  *
+  *                   The CSV log mirrors the file from the last sector
+  *                   boundary not yet written. log_synced counts the bytes at
+  *                   the front of the oldest unwritten sector that a timed
+  *                   commit already put in the file; FatFs keeps those in its
+  *                   file buffer and completes the sector when the rest is
+  *                   written.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "telemetry_log.h"
+#include "telemetry_binlog.h"
+#include "fatfs.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#if TELEMETRY_LOG_BINARY
+#define LOG_INDEX_STEP      (TELEMETRY_LOG_INDEX_RECORDS / TELEMETRY_BINLOG_RECORDS_PER_SECTOR)
+#define LOG_INDEX_SECTORS   ((TELEMETRY_LOG_INDEX_MAX + TELEMETRY_BINLOG_INDEX_PER_SECTOR - 1U) / TELEMETRY_BINLOG_INDEX_PER_SECTOR)
+
+#if TELEMETRY_LOG_INDEX_RECORDS == 0 || (TELEMETRY_LOG_INDEX_RECORDS % TELEMETRY_BINLOG_RECORDS_PER_SECTOR) != 0
+#error "TELEMETRY_LOG_INDEX_RECORDS must be whole sectors of records"
+#endif
+#endif
+
+// How far behind the records before it a black box record may be logged
+#if TELEMETRY_LOG_DECIMATE > 1
+#define LOG_HISTORY_MS      TELEMETRY_LOG_BLACKBOX_MS
+#else
+#define LOG_HISTORY_MS      0U
+#endif
+
+// Pending records moved into the log per TelemetryLog_Poll
+#define LOG_DRAIN_RECORDS   8U
+
+// Mount steps, one per TelemetryLog_Poll
+#define LOG_MOUNT_CARD      0U  // Card initialisation
+#define LOG_MOUNT_VOLUME    1U  // FatFs mount: boot sector and FSInfo
+#define LOG_MOUNT_SESSION   2U  // Find the log, finish the last one if need be, open it
+#define LOG_MOUNT_PREALLOC  3U  // Preallocate and erase a new binary log
+#if TELEMETRY_LOG_BINARY && TELEMETRY_LOG_PREALLOC
+#define LOG_MOUNT_STEPS     4U
+#else
+#define LOG_MOUNT_STEPS     3U
+#endif
+
+#if TELEMETRY_LOG_ROTATE_BYTES < (64UL * TELEMETRY_LOG_SECTOR)
+#error "TELEMETRY_LOG_ROTATE_BYTES is too small to hold a useful log"
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+static FATFS fs;
+static FIL fil;
+static FRESULT f_res;
+static uint8_t is_mounted = 0;
+static uint32_t log_number;         // Open log file; 0 until the first mount
+static uint32_t log_file_tick;      // When the open file was opened
+static uint32_t log_mount_tick;     // When the last mount attempt started
+static uint32_t log_mount_wait;     // From then until the next; 0: at once
+static uint8_t log_mount_step;      // Next step of the mount (LOG_MOUNT_*)
+static uint32_t log_mount_ms;       // Time the steps of this attempt took so far
+static uint8_t log_mount_held;      // TelemetryLog_Close: no retries until Mount_SD_Card
+static uint32_t log_mount_failures;
+
+#if TELEMETRY_LOG_BACKLOG_RECORDS
+static TelemetryData_t log_backlog[TELEMETRY_LOG_BACKLOG_RECORDS];
+static uint32_t log_backlog_head;   // Next slot to fill
+#endif
+static uint32_t log_backlog_count;  // Records waiting for a card
+static uint32_t log_backlog_dropped;
+
+#if TELEMETRY_LOG_DECIMATE > 1
+static TelemetryData_t log_bb[TELEMETRY_LOG_BLACKBOX_RECORDS];
+static uint32_t log_bb_tick[TELEMETRY_LOG_BLACKBOX_RECORDS]; // When each record arrived
+static uint32_t log_bb_head;        // Next slot to fill
+static uint32_t log_bb_count;       // Records held back
+static uint32_t log_bb_number;      // Records outside events, for the decimation
+static uint8_t log_event;           // Every record is logged until...
+static uint32_t log_event_tick;     // ...TELEMETRY_LOG_EVENT_MS after the latest trigger
+#endif
+static uint32_t log_events;
+static uint32_t log_decimated;
+
+static uint8_t log_buf[TELEMETRY_LOG_SECTORS][TELEMETRY_LOG_SECTOR] __attribute__((aligned(4)));
+static uint32_t log_head;           // Sector being filled
+static uint32_t log_tail;           // Oldest full sector not yet written
+static uint32_t log_queued;         // Full sectors waiting for the card
+static uint32_t log_fill;           // Bytes in the head sector
+static uint8_t log_dirty;           // Written since the last commit
+static uint32_t log_pending_tick;   // When the oldest uncommitted byte arrived
+static uint32_t log_uncommitted;    // Records since the last commit
+static uint8_t log_marked;          // TelemetryLog_Mark called since the last commit
+static uint8_t log_policy = TELEMETRY_LOG_SYNC_POLICY;
+static uint32_t log_policy_every = TELEMETRY_LOG_SYNC_EVERY;
+#if TELEMETRY_LOG_BINARY
+static uint32_t log_seq;            // File sector number of the head sector
+static uint32_t log_count;          // Records in the head sector
+static uint32_t log_saved;          // Records of the head sector sealed in the file
+static uint32_t log_copy_seq;       // Sector of the latest synced commit (0: none)...
+static uint32_t log_copy_count;     // ...holding this many of its records...
+static uint8_t log_copy_next;       // ...the latest at the place after its own
+static uint32_t log_unsynced;       // Full sectors behind log_tail that FatFs has not synced
+static TelemetryBinlog_Packer_t log_packer; // Last record of a packed head sector
+static uint32_t log_file_id;        // The open log's, seeding its sectors' CRCs
+#if TELEMETRY_LOG_PREALLOC
+static uint8_t log_raw;             // Streaming to the preallocated sectors
+static uint8_t log_expand;          // New log, to preallocate before its first write
+static DWORD log_lba;               // LBA of file sector 0
+static DWORD log_capacity;          // Sectors preallocated
+#endif
+static uint32_t log_index_time[TELEMETRY_LOG_INDEX_MAX];    // TimeMS of the first record...
+static uint32_t log_index_seq[TELEMETRY_LOG_INDEX_MAX];     // ...of these sectors
+static uint32_t log_index_count;
+static uint32_t log_index_step;     // Sectors between index entries
+#else
+static uint32_t log_synced;         // Bytes of the oldest unwritten sector already in the file
+#endif
+
+static TelemetryLog_Stats_t stats;
+static DWORD disk_ops_base;
+
+/* Private functions ---------------------------------------------------------*/
+static DWORD disk_ops(void)
+{
+    return SD_Stats.reads + SD_Stats.writes + SD_Stats.syncs;
+}
+
+static uint8_t log_pending(void)
+{
+#if TELEMETRY_LOG_BINARY
+    return log_queued || (log_count > log_saved) || log_dirty;
+#else
+    return log_queued || (log_fill > log_synced) || log_dirty;
+#endif
+}
+
+static void log_reset(void)
+{
+    log_head = 0;
+    log_tail = 0;
+    log_queued = 0;
+    log_fill = 0;
+    log_dirty = 0;
+    log_uncommitted = 0;
+    log_marked = 0;
+#if TELEMETRY_LOG_BINARY
+    log_seq = 0;
+    log_count = 0;
+    log_saved = 0;
+    log_copy_seq = 0;
+    log_copy_count = 0;
+    log_copy_next = 0;
+    log_unsynced = 0;
+    log_index_count = 0;
+    log_index_step = LOG_INDEX_STEP;
+#if TELEMETRY_LOG_PREALLOC
+    log_raw = 0;
+    log_expand = 0;
+#endif
+#else
+    log_synced = 0;
+#endif
+}
+
+/** Track the longest time a logging call kept the superloop away */
+static void log_stall(uint32_t start)
+{
+    uint32_t t = HAL_GetTick() - start;
+    if (t > stats.max_stall_ms) stats.max_stall_ms = t;
+}
+
+/** Count a failed mount and wait longer before the next attempt, up to the limit */
+static void log_mount_backoff(void)
+{
+    log_mount_failures++;
+    if (log_mount_wait < TELEMETRY_LOG_MOUNT_RETRY_MIN_MS) {
+        log_mount_wait = TELEMETRY_LOG_MOUNT_RETRY_MIN_MS;
+    } else if (log_mount_wait < TELEMETRY_LOG_MOUNT_RETRY_MAX_MS / 2U) {
+        log_mount_wait *= 2U;
+    } else {
+        log_mount_wait = TELEMETRY_LOG_MOUNT_RETRY_MAX_MS;
+    }
+}
+
+/** Keep a record for when a card is mounted, over the oldest if full */
+static void log_backlog_put(const TelemetryData_t *data)
+{
+#if TELEMETRY_LOG_BACKLOG_RECORDS
+    if (log_backlog_count == TELEMETRY_LOG_BACKLOG_RECORDS) {
+        log_backlog_count--;
+        log_backlog_dropped++;
+    }
+    log_backlog[log_backlog_head] = *data;
+    log_backlog_head = (log_backlog_head + 1U) % TELEMETRY_LOG_BACKLOG_RECORDS;
+    log_backlog_count++;
+#else
+    (void)data;
+    log_backlog_dropped++;
+#endif
+}
+
+/** Put a record back at the front of the backlog; dropped if it is full,
+  * being the oldest */
+static void log_backlog_unget(const TelemetryData_t *data)
+{
+#if TELEMETRY_LOG_BACKLOG_RECORDS
+    if (log_backlog_count < TELEMETRY_LOG_BACKLOG_RECORDS) {
+        log_backlog_count++;
+        log_backlog[(log_backlog_head + TELEMETRY_LOG_BACKLOG_RECORDS - log_backlog_count) %
+                    TELEMETRY_LOG_BACKLOG_RECORDS] = *data;
+        return;
+    }
+#endif
+    (void)data;
+    log_backlog_dropped++;
+}
+
+#if TELEMETRY_LOG_BINARY
+/** Write a sealed sector at its place in the file */
+static FRESULT log_put_sector(uint32_t seq, const uint8_t *sector)
+{
+    UINT bw;
+    FSIZE_t pos = (FSIZE_t)seq * TELEMETRY_LOG_SECTOR;
+
+#if TELEMETRY_LOG_PREALLOC
+    if (log_raw) {
+        if (seq < log_capacity) {
+            return USER_StreamWrite(sector, log_lba + seq, log_capacity - seq) == RES_OK ? FR_OK : FR_DISK_ERR;
+        }
+        // Preallocation used up: FatFs extends the file from here on
+        if (USER_StreamStop() != RES_OK) return FR_DISK_ERR;
+        log_raw = 0;
+    }
+#endif
+    if (f_tell(&fil) != pos) {
+        f_res = f_lseek(&fil, pos);
+        if (f_res != FR_OK) return f_res;
+    }
+    f_res = f_write(&fil, sector, TELEMETRY_LOG_SECTOR, &bw);
+    if (f_res == FR_OK && bw != TELEMETRY_LOG_SECTOR) f_res = FR_DENIED; // Volume full
+    // The header is on the card before f_sync gives the file a size, or a
+    // cut could leave an earlier log's header, and its sectors, in sector 0
+    if (f_res == FR_OK && seq == 0 && disk_ioctl(fs.drv, CTRL_SYNC, NULL) != RES_OK) f_res = FR_DISK_ERR;
+    return f_res;
+}
+
+/** Make everything written so far durable */
+static FRESULT log_sync(void)
+{
+#if TELEMETRY_LOG_PREALLOC
+    if (log_raw) return USER_StreamSync() == RES_OK ? FR_OK : FR_DISK_ERR;
+#endif
+    f_res = f_sync(&fil);
+    if (f_res == FR_OK) log_unsynced = 0;
+    return f_res;
+}
+
+/** True if sector seq's latest commit is at its own place in the file */
+static uint8_t log_copy_in_place(uint32_t seq)
+{
+    return seq && seq == log_copy_seq && !log_copy_next;
+}
+
+/** Write the oldest full sector; blocks only if the card is still busy */
+static FRESULT log_write_sector(void)
+{
+    uint32_t seq = log_seq - log_queued;
+
+    // Overwriting a commit in place: the full sector first goes safely to
+    // the place after it, synced so it reaches the card before the overwrite
+    if (log_copy_in_place(seq)) {
+        f_res = log_put_sector(seq + 1U, log_buf[log_tail]);
+        if (f_res == FR_OK) f_res = log_sync();
+        if (f_res != FR_OK) return f_res;
+        log_copy_count = TelemetryBinlog_Get16(log_buf[log_tail] + TELEMETRY_BINLOG_COUNT_OFFSET);
+        log_copy_next = 1;
+    }
+    f_res = log_put_sector(seq, log_buf[log_tail]);
+    if (f_res != FR_OK) return f_res;
+
+    // Through FatFs it may sit in a cache until the next sync; the ring keeps
+    // it meanwhile, while the head does not need the slot, for log_requeue
+#if TELEMETRY_LOG_PREALLOC
+    if (!log_raw) log_unsynced++;
+#else
+    log_unsynced++;
+#endif
+    stats.sectors++;
+    log_tail = (log_tail + 1) % TELEMETRY_LOG_SECTORS;
+    log_queued--;
+    log_dirty = 1;
+    return FR_OK;
+}
+
+/** Put everything buffered in the file, the head sector sealed as it stands */
+static FRESULT log_commit(void)
+{
+    uint8_t sealed = 0;
+    uint8_t next = 0;
+
+    while (log_queued) {
+        f_res = log_write_sector();
+        if (f_res != FR_OK) return f_res;
+    }
+    if (log_count > log_saved) {
+        // Not over the last commit: at the other of its two places
+        next = log_copy_in_place(log_seq);
+
+        TelemetryBinlog_SealSector(log_buf[log_head], (uint16_t)log_count, log_file_id);
+        f_res = log_put_sector(log_seq + next, log_buf[log_head]);
+        if (f_res != FR_OK) return f_res;
+        sealed = 1;
+        log_dirty = 1;
+    }
+    if (log_dirty) {
+        f_res = log_sync();
+        if (f_res != FR_OK) return f_res;
+        log_dirty = 0;
+        stats.commits++;
+    }
+    // Saved only once synced: until then log_requeue takes the records back
+    if (sealed) {
+        log_copy_seq = log_seq;
+        log_copy_count = log_count;
+        log_copy_next = next;
+        log_saved = log_count;
+    }
+    log_uncommitted = 0;
+    log_marked = 0;
+    return FR_OK;
+}
+
+/** Note the time of sector seq's first record if it falls on the index spacing */
+static void log_index_add(uint32_t seq, uint32_t time_ms)
+{
+    if ((seq - 1U) % log_index_step != 0) return;
+
+    if (log_index_count == TELEMETRY_LOG_INDEX_MAX) {
+        // Full: keep every other entry and space new ones twice as far apart
+        uint32_t n = 0;
+        log_index_step *= 2U;
+        for (uint32_t i = 0; i < log_index_count; i++) {
+            if ((log_index_seq[i] - 1U) % log_index_step != 0) continue;
+            log_index_time[n] = log_index_time[i];
+            log_index_seq[n] = log_index_seq[i];
+            n++;
+        }
+        log_index_count = n;
+        if ((seq - 1U) % log_index_step != 0 || n == TELEMETRY_LOG_INDEX_MAX) return;
+    }
+    log_index_time[log_index_count] = time_ms;
+    log_index_seq[log_index_count] = seq;
+    log_index_count++;
+}
+
+/** Append the index trailer after the last record sector; end gets the file size */
+static FRESULT log_write_index(FSIZE_t *end)
+{
+    uint8_t *sector = log_buf[(log_head + 1) % TELEMETRY_LOG_SECTORS]; // Free once committed
+    uint32_t first = log_seq + (log_count ? 1U : 0U);
+    uint32_t seq = first;
+    uint32_t i = 0;
+
+    do {
+        uint32_t n = 0;
+        TelemetryBinlog_BeginIndex(sector, seq, first);
+        for (; n < TELEMETRY_BINLOG_INDEX_PER_SECTOR && i < log_index_count; n++, i++) {
+            TelemetryBinlog_PutIndex(sector, n, log_index_time[i], log_index_seq[i] * TELEMETRY_LOG_SECTOR);
+        }
+        TelemetryBinlog_SealSector(sector, (uint16_t)n, log_file_id);
+        f_res = log_put_sector(seq++, sector);
+        if (f_res != FR_OK) return f_res;
+    } while (i < log_index_count);
+
+    *end = (FSIZE_t)seq * TELEMETRY_LOG_SECTOR;
+    return FR_OK;
+}
+#else
+/** Write the oldest full sector; blocks only if the card is still busy */
+static FRESULT log_write_sector(void)
+{
+    UINT bw;
+    UINT n = TELEMETRY_LOG_SECTOR - log_synced;
+
+    f_res = f_write(&fil, log_buf[log_tail] + log_synced, n, &bw);
+    if (f_res == FR_OK && bw != n) f_res = FR_DENIED; // Volume full
+    if (f_res != FR_OK) return f_res;
+
+    stats.sectors++;
+    log_tail = (log_tail + 1) % TELEMETRY_LOG_SECTORS;
+    log_queued--;
+    log_synced = 0;
+    log_dirty = 1;
+    return FR_OK;
+}
+
+/** Put everything buffered in the file and update its directory entry */
+static FRESULT log_commit(void)
+{
+    UINT bw;
+
+    while (log_queued) {
+        f_res = log_write_sector();
+        if (f_res != FR_OK) return f_res;
+    }
+    if (log_fill > log_synced) {
+        f_res = f_write(&fil, log_buf[log_head] + log_synced, log_fill - log_synced, &bw);
+        if (f_res == FR_OK && bw != log_fill - log_synced) f_res = FR_DENIED;
+        if (f_res != FR_OK) return f_res;
+        log_synced = log_fill;
+        log_dirty = 1;
+    }
+    if (log_dirty) {
+        f_res = f_sync(&fil);
+        if (f_res != FR_OK) return f_res;
+        log_dirty = 0;
+        stats.commits++;
+    }
+    log_uncommitted = 0;
+    log_marked = 0;
+    return FR_OK;
+}
+#endif
+
+/** Queue the full head sector and start the next one */
+static FRESULT log_next_sector(void)
+{
+    // Ring full: the card has fallen behind, write synchronously
+    if (log_queued == TELEMETRY_LOG_SECTORS - 1U) {
+        stats.overflows++;
+        f_res = log_write_sector();
+        if (f_res != FR_OK) return f_res;
+    }
+    log_queued++;
+    if (log_queued > stats.max_queued) stats.max_queued = log_queued;
+    log_head = (log_head + 1) % TELEMETRY_LOG_SECTORS;
+    log_fill = 0;
+#if TELEMETRY_LOG_BINARY
+    if (log_unsynced > TELEMETRY_LOG_SECTORS - 1U - log_queued) log_unsynced--; // Its slot is the head now
+#endif
+    return FR_OK;
+}
+
+#if TELEMETRY_LOG_BINARY
+/** Longest record that may still go into a sector, by its format */
+static uint32_t log_record_max(const uint8_t *sector)
+{
+    if (TelemetryBinlog_Get16(sector) == TELEMETRY_BINLOG_PACKED_MAGIC) return TELEMETRY_BINLOG_PACKED_MAX;
+    return TELEMETRY_BINLOG_RECORD_SIZE;
+}
+
+/** Pack one record into the head sector, queueing the sector once it is full */
+static FRESULT log_record(const TelemetryData_t *data)
+{
+    const TelemetryBinlog_Field_t *f = TelemetryBinlog_Fields;
+    uint8_t *sector = log_buf[log_head];
+    uint8_t rec[TELEMETRY_BINLOG_RECORD_SIZE];
+
+    if (!log_pending()) log_pending_tick = HAL_GetTick();
+    if (log_fill == 0) {
+#if TELEMETRY_LOG_PACKED
+        TelemetryBinlog_BeginPacked(sector, log_seq);
+#else
+        TelemetryBinlog_BeginSector(sector, log_seq);
+#endif
+        log_fill = TELEMETRY_BINLOG_PAYLOAD_OFFSET;
+        log_index_add(log_seq, data->timestamp_ms);
+    }
+
+    TelemetryBinlog_Put(rec, &f[TELEMETRY_BINLOG_TIME_MS], data->timestamp_ms);
+    TelemetryBinlog_Put(rec, &f[TELEMETRY_BINLOG_HOURS], data->hours);
+    TelemetryBinlog_Put(rec, &f[TELEMETRY_BINLOG_MINUTES], data->minutes);
+    TelemetryBinlog_Put(rec, &f[TELEMETRY_BINLOG_SECONDS], data->seconds);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_ALTITUDE], data->altitude);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_SPEED], data->speed);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_VOLTAGE], data->voltage);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_ALTITUDE_RATE], data->altitude_rate);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_SPEED_RATE], data->speed_rate);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_VOLTAGE_RATE], data->voltage_rate);
+
+    // A plain sector, as resumed from an older log, carries on plain
+    if (log_count && TelemetryBinlog_Get16(sector) == TELEMETRY_BINLOG_PACKED_MAGIC) {
+        log_fill += TelemetryBinlog_Pack(&log_packer, rec, sector + log_fill);
+    } else {
+        if (log_count == 0) TelemetryBinlog_PackFirst(&log_packer, rec);
+        memcpy(sector + log_fill, rec, TELEMETRY_BINLOG_RECORD_SIZE);
+        log_fill += TELEMETRY_BINLOG_RECORD_SIZE;
+    }
+
+    log_count++;
+    if (log_fill + log_record_max(sector) <= TELEMETRY_BINLOG_COUNT_OFFSET) return FR_OK;
+
+    TelemetryBinlog_SealSector(sector, (uint16_t)log_count, log_file_id);
+    log_fill = TELEMETRY_LOG_SECTOR;
+    f_res = log_next_sector();
+    if (f_res != FR_OK) return f_res; // Still the head, for log_requeue
+    log_count = 0;
+    log_saved = 0;
+    log_seq++; // After queueing, so an overflow write still numbers the tail right
+    return FR_OK;
+}
+
+#if TELEMETRY_LOG_PREALLOC
+/** Preallocate the log log_start began and erase it, before anything is
+  * written; without a contiguous run of clusters the log goes through FatFs
+  * as usual */
+static FRESULT log_preallocate(void)
+{
+    log_expand = 0;
+    if (f_expand(&fil, TELEMETRY_LOG_PREALLOC, 1) != FR_OK) return FR_OK;
+    log_lba = fs.database + (fil.obj.sclust - 2) * fs.csize;
+
+    // The header, queued at the tail, goes in before the directory entry
+    // gives the file its size: until it does, sector 0 may still hold an
+    // earlier log's header, which would let log_resume take that log's
+    // sectors for this one's. The clusters are free until the sync
+    if (disk_write(fs.drv, log_buf[log_tail], log_lba, 1) != RES_OK ||
+        disk_ioctl(fs.drv, CTRL_SYNC, NULL) != RES_OK) return FR_DISK_ERR;
+    f_res = f_sync(&fil); // Directory entry and FAT before any streaming
+    if (f_res != FR_OK) return f_res;
+    log_capacity = TELEMETRY_LOG_PREALLOC / TELEMETRY_LOG_SECTOR;
+    log_raw = 1;
+#if TELEMETRY_LOG_PRE_ERASE
+    // Only a hint: a card that cannot erase is written all the same
+    DWORD trim[2] = { log_lba, log_lba + log_capacity - 1U };
+    disk_ioctl(fs.drv, CTRL_TRIM, trim);
+#endif
+    return FR_OK;
+}
+#endif
+
+/**
+  * Pick the ID for a new log. The cycle count here depends on how long the
+  * card took to initialise and answer, which differs from boot to boot; the
+  * tick, the file number and the previous ID go in with it, so the ID is
+  * unlikely to match the log before or an earlier one whose sectors are
+  * still in the clusters this log is given.
+  */
+static uint32_t log_new_file_id(void)
+{
+    uint32_t seed[3] = { DWT->CYCCNT, HAL_GetTick(), log_number };
+    uint32_t id = TelemetryBinlog_Crc32Update(log_file_id, (const uint8_t *)seed, sizeof(seed));
+
+    return id ? id : 1U; // 0 is a log from before file IDs
+}
+
+/** Start an empty log by queueing the header; if configured, log_preallocate
+  * must run before the first write */
+static FRESULT log_start(void)
+{
+#if TELEMETRY_LOG_PREALLOC
+    log_expand = 1;
+#endif
+    log_file_id = log_new_file_id();
+    TelemetryBinlog_BuildHeader(log_buf[log_head], log_file_id, LOG_HISTORY_MS);
+    log_fill = TELEMETRY_LOG_SECTOR;
+    log_pending_tick = HAL_GetTick();
+    f_res = log_next_sector();
+    log_seq = 1;
+    return f_res;
+}
+
+/** Read the sector at place and return its record count as sector seq, or -1 */
+static int32_t log_read_copy(uint32_t place, uint32_t seq, uint8_t *sector)
+{
+    UINT br;
+
+    f_res = f_lseek(&fil, (FSIZE_t)place * TELEMETRY_LOG_SECTOR);
+    if (f_res == FR_OK) f_res = f_read(&fil, sector, TELEMETRY_LOG_SECTOR, &br);
+    if (f_res != FR_OK || br != TELEMETRY_LOG_SECTOR) return -1;
+    return TelemetryBinlog_CheckSector(sector, seq, log_file_id);
+}
+
+/** Read the open log's header and take its file ID; 0 if it is not valid */
+static uint8_t log_read_header(uint8_t *sector)
+{
+    UINT br;
+
+    f_res = f_lseek(&fil, 0);
+    if (f_res == FR_OK) f_res = f_read(&fil, sector, TELEMETRY_LOG_SECTOR, &br);
+    if (f_res != FR_OK || br != TELEMETRY_LOG_SECTOR) return 0;
+    log_file_id = TelemetryBinlog_FileId(sector);
+    return TelemetryBinlog_CheckSector(sector, 0, log_file_id) >= 0;
+}
+
+/**
+  * Read sector seq of the log, of which avail bytes exist, and return its
+  * record count, or -1 if it is not a valid sector at that position. A
+  * short last sector, left unsealed by an older build, counts its whole
+  * records.
+  */
+static int32_t log_read_sector(uint32_t seq, uint8_t *sector, UINT avail)
+{
+    UINT br;
+
+    if (avail == TELEMETRY_LOG_SECTOR) return log_read_copy(seq, seq, sector);
+    f_res = f_lseek(&fil, (FSIZE_t)seq * TELEMETRY_LOG_SECTOR);
+    if (f_res == FR_OK) f_res = f_read(&fil, sector, avail, &br);
+    if (f_res != FR_OK || br != avail) return -1;
+
+    if (avail < TELEMETRY_BINLOG_PAYLOAD_OFFSET ||
+        TelemetryBinlog_Get16(sector) != TELEMETRY_BINLOG_MAGIC ||
+        TelemetryBinlog_Get32(sector + TELEMETRY_BINLOG_SEQ_OFFSET) != seq) return -1;
+    return (int32_t)((avail - TELEMETRY_BINLOG_PAYLOAD_OFFSET) / TELEMETRY_BINLOG_RECORD_SIZE);
+}
+
+/**
+  * After sector last, the last valid in place (count records, in log_buf[0]),
+  * look for a commit that went to the place after its own (log_commit): a
+  * newer copy of last, or of the sector after it when that one is torn.
+  * One found is written back in place. Returns the record count of the
+  * sector now last, -1 on a write error.
+  */
+static int32_t log_recover_copy(uint32_t *last, int32_t count, uint32_t places)
+{
+    uint8_t *copy = log_buf[1];
+    uint32_t seq = *last;
+    int32_t n = -1;
+
+    if (seq + 1U < places) n = log_read_copy(seq + 1U, seq, copy);
+    if (n <= count) {
+        n = -1;
+        if (seq + 2U < places) n = log_read_copy(seq + 2U, seq + 1U, copy);
+        if (n < 0) return count;
+        seq++;
+    }
+
+    f_res = log_put_sector(seq, copy);
+    if (f_res == FR_OK) f_res = f_sync(&fil);
+    if (f_res != FR_OK) return -1;
+    memcpy(log_buf[0], copy, TELEMETRY_LOG_SECTOR);
+    *last = seq;
+    return n;
+}
+
+/** Index sectors 1..last of a resumed log, reading the entries back from the file */
+static void log_index_rebuild(uint32_t last)
+{
+    const TelemetryBinlog_Field_t *f = &TelemetryBinlog_Fields[TELEMETRY_BINLOG_TIME_MS];
+    uint8_t *sector = log_buf[1]; // log_buf[0] holds the head sector
+
+    if (last == 0) return;
+    while ((last - 1U) / log_index_step >= TELEMETRY_LOG_INDEX_MAX) log_index_step *= 2U;
+
+    for (uint32_t seq = 1; seq <= last; seq += log_index_step) {
+        if (log_read_sector(seq, sector, TELEMETRY_LOG_SECTOR) <= 0) continue;
+        log_index_add(seq, (uint32_t)TelemetryBinlog_Get(sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET, f->type, f->offset));
+    }
+}
+
+/** True if the open log ends in an index trailer, i.e. was closed */
+static uint8_t log_is_finished(void)
+{
+    FSIZE_t size = f_size(&fil);
+
+    if (size == 0 || (size % TELEMETRY_LOG_SECTOR) != 0) return 0;
+    uint32_t last = (uint32_t)(size / TELEMETRY_LOG_SECTOR) - 1U;
+    UINT br;
+
+    if (!log_read_header(log_buf[0])) return 0;
+
+    f_res = f_lseek(&fil, size - TELEMETRY_LOG_SECTOR);
+    if (f_res == FR_OK) f_res = f_read(&fil, log_buf[0], TELEMETRY_LOG_SECTOR, &br);
+    if (f_res != FR_OK || br != TELEMETRY_LOG_SECTOR) return 0;
+    return TelemetryBinlog_CheckIndex(log_buf[0], last, log_file_id) >= 0;
+}
+
+/**
+  * Find where the data in the log ends and set up the ring to carry on from
+  * there. The last sector is normally valid and, if partly filled, becomes
+  * the head sector again. A preallocated log that was never closed still
+  * has its full size and ends in whatever the card held before; the last
+  * valid sector is then found by binary search and the rest cut off. Every
+  * sector is checked against the file ID in the header, so sectors of an
+  * earlier log left in the clusters are not taken for this one's. A log
+  * without a valid header is started again.
+  */
+static FRESULT log_resume(void)
+{
+    FSIZE_t size = f_size(&fil);
+    uint8_t *sector = log_buf[0];
+    uint32_t last;
+    UINT avail;
+    int32_t count;
+    int32_t fill;
+
+    log_reset();
+    if (size == 0) return log_start();
+    if (!log_read_header(sector)) {
+        f_res = f_lseek(&fil, 0);
+        if (f_res == FR_OK) f_res = f_truncate(&fil);
+        if (f_res != FR_OK) return f_res;
+        return log_start();
+    }
+
+    last = (uint32_t)((size - 1) / TELEMETRY_LOG_SECTOR);
+    avail = (UINT)(size - (FSIZE_t)last * TELEMETRY_LOG_SECTOR);
+    count = log_read_sector(last, sector, avail);
+
+    if (count < 0) {
+        uint32_t lo = 0, hi = last;
+
+        while (hi - lo > 1) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (log_read_sector(mid, sector, TELEMETRY_LOG_SECTOR) >= 0) lo = mid;
+            else hi = mid;
+        }
+        last = lo;
+        avail = TELEMETRY_LOG_SECTOR;
+        count = log_read_sector(last, sector, avail);
+        if (count < 0) return FR_DISK_ERR;
+        count = log_recover_copy(&last, count, (uint32_t)(size / TELEMETRY_LOG_SECTOR));
+        if (count < 0) return f_res;
+    }
+
+    // Cut off what follows the data: a torn record or unused preallocation.
+    // Cutting one byte short and seeking back also ends the cluster chain
+    // there: a FAT sector torn by a power cut can link the file on to a
+    // cluster still marked free, which FatFs would follow and also give to
+    // the next file
+    FSIZE_t end = (FSIZE_t)last * TELEMETRY_LOG_SECTOR + avail;
+    if (avail < TELEMETRY_LOG_SECTOR) end -= (avail - TELEMETRY_BINLOG_PAYLOAD_OFFSET) % TELEMETRY_BINLOG_RECORD_SIZE;
+    f_res = f_lseek(&fil, end - 1U);
+    if (f_res == FR_OK) f_res = f_truncate(&fil);
+    if (f_res == FR_OK) f_res = f_lseek(&fil, end);
+    if (f_res != FR_OK) return f_res;
+
+    if (last && TelemetryBinlog_Get16(sector) == TELEMETRY_BINLOG_PACKED_MAGIC) {
+        fill = TelemetryBinlog_PackedEnd(sector, (uint32_t)count, &log_packer);
+        if (fill < 0) return FR_INT_ERR;
+    } else {
+        fill = (int32_t)(TELEMETRY_BINLOG_PAYLOAD_OFFSET + (uint32_t)count * TELEMETRY_BINLOG_RECORD_SIZE);
+    }
+
+    log_pending_tick = HAL_GetTick();
+    if (last == 0 || (uint32_t)fill + log_record_max(sector) > TELEMETRY_BINLOG_COUNT_OFFSET) {
+        log_seq = last + 1;
+    } else {
+        // Carry on filling the last sector; an unsealed one is sealed on the next commit
+        log_seq = last;
+        log_count = (uint32_t)count;
+        log_saved = (avail == TELEMETRY_LOG_SECTOR) ? log_count : 0;
+        log_copy_seq = log_saved ? last : 0;
+        log_copy_count = log_saved;
+        log_fill = (uint32_t)fill;
+        memset(sector + log_fill, 0, TELEMETRY_LOG_SECTOR - log_fill);
+    }
+    log_index_rebuild(log_count ? log_seq : log_seq - 1U);
+    return FR_OK;
+}
+#else
+/** Copy bytes into the head sector, moving to the next one as it fills */
+static FRESULT log_append(const char *data, uint32_t len)
+{
+    if (!log_pending()) log_pending_tick = HAL_GetTick();
+
+    while (len) {
+        uint32_t n = TELEMETRY_LOG_SECTOR - log_fill;
+        if (n > len) n = len;
+        memcpy(log_buf[log_head] + log_fill, data, n);
+        log_fill += n;
+        data += n;
+        len -= n;
+
+        if (log_fill == TELEMETRY_LOG_SECTOR) {
+            f_res = log_next_sector();
+            if (f_res != FR_OK) return f_res;
+        }
+    }
+    return FR_OK;
+}
+
+/** Set up the ring for the file just opened, writing the CSV header if it is new */
+static FRESULT log_resume(void)
+{
+    static const char header[] = "TimeMS,Hour,Min,Sec,Altitude,Speed,Voltage\n";
+
+    // Line up the head sector with the sector the file ends in; its
+    // existing bytes stay in the file and are never rewritten from RAM
+    log_reset();
+    log_fill = (uint32_t)(f_size(&fil) % TELEMETRY_LOG_SECTOR);
+    log_synced = log_fill;
+
+    if (f_size(&fil) == 0) return log_append(header, sizeof(header) - 1);
+    return FR_OK;
+}
+#endif
+
+/** Commit and close the file; a binary log gets its index trailer first */
+static FRESULT log_finish(void)
+{
+    f_res = log_commit();
+    if (f_res != FR_OK) return f_res;
+#if TELEMETRY_LOG_BINARY
+    FSIZE_t end;
+
+    // The index goes after the head sector: move its last commit in place first
+    if (log_count && log_copy_seq == log_seq && log_copy_next) {
+        f_res = log_put_sector(log_seq, log_buf[log_head]);
+        if (f_res != FR_OK) return f_res;
+        log_copy_next = 0;
+    }
+    f_res = log_write_index(&end);
+    if (f_res != FR_OK) return f_res;
+#if TELEMETRY_LOG_PREALLOC
+    if (log_raw) {
+        // Hand the file back to FatFs, to be cut to the sectors written
+        log_raw = 0;
+        if (USER_StreamStop() != RES_OK) return FR_DISK_ERR;
+    }
+#endif
+    if (f_size(&fil) > end) {
+        f_res = f_lseek(&fil, end);
+        if (f_res == FR_OK) f_res = f_truncate(&fil);
+        if (f_res != FR_OK) return f_res;
+    }
+#endif
+    return f_close(&fil);
+}
+
+/** The number after n, held at TELEMETRY_LOG_NUMBER_MAX */
+static uint32_t log_next_number(uint32_t n)
+{
+    return n < TELEMETRY_LOG_NUMBER_MAX ? n + 1U : TELEMETRY_LOG_NUMBER_MAX;
+}
+
+/** Open log file number, FA_OPEN_APPEND or FA_CREATE_ALWAYS; log_resume
+  * sets up the ring */
+static FRESULT log_open(uint32_t number, BYTE mode)
+{
+    char name[sizeof(TELEMETRY_LOG_PREFIX) + 5 + sizeof(TELEMETRY_LOG_EXT)];
+
+    number %= TELEMETRY_LOG_NUMBER_MAX + 1UL;   // in range already; bounds the name
+    snprintf(name, sizeof(name), TELEMETRY_LOG_PREFIX "%05lu" TELEMETRY_LOG_EXT, (unsigned long)number);
+    log_number = number;
+    log_file_tick = HAL_GetTick();
+    return f_open(&fil, name, mode | FA_WRITE | FA_READ);
+}
+
+/** Find the highest numbered log file on the card; 0 if there is none.
+  * Names with more than 5 digits are not ours and are skipped */
+static FRESULT log_find_last(uint32_t *last)
+{
+    const size_t prefix = sizeof(TELEMETRY_LOG_PREFIX) - 1;
+    DIR dir;
+    FILINFO fno;
+
+    *last = 0;
+    f_res = f_opendir(&dir, "");
+    if (f_res != FR_OK) return f_res;
+
+    while ((f_res = f_readdir(&dir, &fno)) == FR_OK && fno.fname[0]) {
+        const char *p = fno.fname + prefix;
+        uint32_t n = 0;
+        uint8_t digits = 0;
+
+        if (strncmp(fno.fname, TELEMETRY_LOG_PREFIX, prefix) != 0) continue;
+        while (digits < 5U && *p >= '0' && *p <= '9') {
+            n = n * 10U + (uint32_t)(*p++ - '0');
+            digits++;
+        }
+        if (strcmp(p, TELEMETRY_LOG_EXT) == 0 && n > *last) *last = n;
+    }
+    f_closedir(&dir);
+    return f_res;
+}
+
+/**
+  * Open the file to log to. A remount after an error carries on in the
+  * same file. Otherwise this is a new boot: the previous binary log is
+  * finished if power was lost before it was closed, and logging starts
+  * in the next file number, or in the previous file if it is empty.
+  */
+static FRESULT log_open_session(void)
+{
+    uint32_t last;
+    BYTE mode = FA_OPEN_APPEND;
+
+    if (log_number == 0) {
+        f_res = log_find_last(&last);
+        if (f_res != FR_OK) return f_res;
+
+        if (last) {
+            f_res = log_open(last, FA_OPEN_APPEND);
+            if (f_res != FR_OK) return f_res;
+            if (f_size(&fil) == 0) {
+                f_close(&fil);
+                last--;
+            }
+#if TELEMETRY_LOG_BINARY
+            else if (!log_is_finished()) {
+                // Best effort: the records are there for the decoder either way
+                if (log_resume() != FR_OK || log_finish() != FR_OK) {
+                    stats.errors++;
+                    f_close(&fil);
+                }
+            }
+#endif
+            else {
+                f_close(&fil);
+            }
+        }
+        log_number = log_next_number(last);
+        // Out of numbers: the new log replaces the last one
+        if (log_number == last) mode = FA_CREATE_ALWAYS;
+    }
+    f_res = log_open(log_number, mode);
+    if (f_res != FR_OK) return f_res;
+    return log_resume();
+}
+
+/** True once the open file has reached its size or age limit */
+static uint8_t log_rotate_due(void)
+{
+#if TELEMETRY_LOG_ROTATE_MS
+    if ((HAL_GetTick() - log_file_tick) >= TELEMETRY_LOG_ROTATE_MS) return 1;
+#endif
+#if TELEMETRY_LOG_BINARY
+    // Between sectors only, leaving room for the next sector and the index
+    return log_count == 0 &&
+           (log_seq + 1U + LOG_INDEX_SECTORS) * TELEMETRY_LOG_SECTOR > TELEMETRY_LOG_ROTATE_BYTES;
+#else
+    return f_size(&fil) + log_queued * TELEMETRY_LOG_SECTOR + log_fill >= TELEMETRY_LOG_ROTATE_BYTES;
+#endif
+}
+
+/** Close the open file and carry on in the next one */
+static FRESULT log_rotate(void)
+{
+    uint32_t next;
+
+    f_res = log_finish();
+    if (f_res != FR_OK) return f_res;
+
+    stats.files++;
+    next = log_next_number(log_number);
+    f_res = log_open(next, next == log_number ? FA_CREATE_ALWAYS : FA_OPEN_APPEND);
+    if (f_res != FR_OK) return f_res;
+    f_res = log_resume();
+#if TELEMETRY_LOG_BINARY && TELEMETRY_LOG_PREALLOC
+    if (f_res == FR_OK && log_expand) f_res = log_preallocate();
+#endif
+    return f_res;
+}
+
+#if TELEMETRY_LOG_BINARY
+#if TELEMETRY_LOG_BACKLOG_RECORDS
+/** A fixed-point field back as the value log_record was given */
+static float log_fixed(const uint32_t *value, uint32_t field)
+{
+    static const float scale[] = { 1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f };
+    return (float)(int32_t)value[field] / scale[TelemetryBinlog_Fields[field].decimals];
+}
+
+/** Rebuild the logged fields of a record from the values the packer holds */
+static void log_unrecord(TelemetryData_t *data, const uint32_t *value)
+{
+    memset(data, 0, sizeof(*data));
+    data->timestamp_ms = value[TELEMETRY_BINLOG_TIME_MS];
+    data->hours = value[TELEMETRY_BINLOG_HOURS];
+    data->minutes = value[TELEMETRY_BINLOG_MINUTES];
+    data->seconds = value[TELEMETRY_BINLOG_SECONDS];
+    data->altitude = log_fixed(value, TELEMETRY_BINLOG_ALTITUDE);
+    data->speed = log_fixed(value, TELEMETRY_BINLOG_SPEED);
+    data->voltage = log_fixed(value, TELEMETRY_BINLOG_VOLTAGE);
+    data->altitude_rate = log_fixed(value, TELEMETRY_BINLOG_ALTITUDE_RATE);
+    data->speed_rate = log_fixed(value, TELEMETRY_BINLOG_SPEED_RATE);
+    data->voltage_rate = log_fixed(value, TELEMETRY_BINLOG_VOLTAGE_RATE);
+}
+#endif
+
+/** Records in ring sector i (0: the tail, log_queued: the head); saved gets
+  * how many of the first ones a synced commit holds */
+static uint32_t log_ring_count(uint32_t i, uint32_t *saved)
+{
+    uint32_t seq = log_seq - log_queued + i;
+    const uint8_t *sector = log_buf[(log_tail + i) % TELEMETRY_LOG_SECTORS];
+
+    *saved = (seq == log_copy_seq) ? log_copy_count : 0U;
+    if (seq == 0) return 0; // Header
+    if (i == log_queued) return log_count;
+    return TelemetryBinlog_Get16(sector + TELEMETRY_BINLOG_COUNT_OFFSET);
+}
+#endif
+
+/**
+  * Put the records of a failed session that never reached the card back at
+  * the front of the backlog, ahead of those waiting there: the queued
+  * sectors and the head sector, and the full sectors FatFs wrote but never
+  * synced that are still in the ring, less what a synced commit holds.
+  * Other sectors handed to the card are not taken back; log_resume finds
+  * them if the file reaches them. If the backlog cannot hold them all the
+  * oldest go. CSV lines cannot be taken back, and count as dropped.
+  */
+static void log_requeue(void)
+{
+#if TELEMETRY_LOG_BINARY
+    uint32_t total = 0, saved, n;
+
+    log_tail = (log_tail + TELEMETRY_LOG_SECTORS - log_unsynced) % TELEMETRY_LOG_SECTORS;
+    log_queued += log_unsynced;
+    log_unsynced = 0;
+
+    for (uint32_t i = 0; i <= log_queued; i++) {
+        n = log_ring_count(i, &saved);
+        if (n > saved) total += n - saved;
+    }
+    if (total == 0) return;
+
+#if TELEMETRY_LOG_BACKLOG_RECORDS
+    uint32_t room = TELEMETRY_LOG_BACKLOG_RECORDS - log_backlog_count;
+    uint32_t drop = (total > room) ? total - room : 0U;
+    uint32_t slot = (log_backlog_head + 2U * TELEMETRY_LOG_BACKLOG_RECORDS - log_backlog_count - (total - drop)) %
+                    TELEMETRY_LOG_BACKLOG_RECORDS;
+
+    log_backlog_count += total - drop;
+    log_backlog_dropped += drop;
+    for (uint32_t i = 0; i <= log_queued; i++) {
+        const uint8_t *sector = log_buf[(log_tail + i) % TELEMETRY_LOG_SECTORS];
+        uint8_t packed = TelemetryBinlog_Get16(sector) == TELEMETRY_BINLOG_PACKED_MAGIC;
+        uint32_t fill = TELEMETRY_BINLOG_PAYLOAD_OFFSET;
+        TelemetryBinlog_Packer_t p;
+
+        n = log_ring_count(i, &saved);
+        for (uint32_t r = 0; r < n; r++) {
+            if (r == 0 || !packed) {
+                TelemetryBinlog_PackFirst(&p, sector + fill);
+                fill += TELEMETRY_BINLOG_RECORD_SIZE;
+            } else {
+                int32_t k = TelemetryBinlog_Unpack(&p, sector + fill, TELEMETRY_BINLOG_COUNT_OFFSET - fill);
+                if (k < 0) break; // Cannot happen: log_record packed it
+                fill += (uint32_t)k;
+            }
+            if (r < saved) continue;
+            if (drop) {
+                drop--;
+                continue;
+            }
+            log_unrecord(&log_backlog[slot], p.value);
+            slot = (slot + 1U) % TELEMETRY_LOG_BACKLOG_RECORDS;
+        }
+    }
+#else
+    log_backlog_dropped += total;
+#endif
+#else
+    for (uint32_t i = 0; i <= log_queued; i++) {
+        const uint8_t *sector = log_buf[(log_tail + i) % TELEMETRY_LOG_SECTORS];
+        uint32_t end = (i == log_queued) ? log_fill : TELEMETRY_LOG_SECTOR;
+
+        for (uint32_t b = i ? 0U : log_synced; b < end; b++) {
+            if (sector[b] == '\n') log_backlog_dropped++;
+        }
+    }
+#endif
+}
+
+/**
+  * Drop the session after a write error, its unwritten records back in the
+  * backlog. The next poll remounts at once, unless the session never got
+  * as far as a commit: that counts as a failed mount and backs off.
+  */
+static void log_fail(void)
+{
+    stats.errors++;
+#if TELEMETRY_LOG_BINARY && TELEMETRY_LOG_PREALLOC
+    if (log_raw) USER_StreamStop();
+#endif
+    log_requeue();
+    f_close(&fil);
+    f_mount(NULL, "", 0);
+    is_mounted = 0;
+    log_mount_tick = HAL_GetTick();
+    if (stats.commits) {
+        log_mount_wait = 0;
+    } else {
+        log_mount_backoff();
+    }
+    log_reset();
+}
+
+/**
+  * Run the next step of the mount: card initialisation, the FatFs mount,
+  * opening the session, then preallocating a new binary log. Each step
+  * still blocks for as long as it takes. A failed step releases the card,
+  * and the mount starts over once the backoff wait is out.
+  */
+static void log_mount_next(void)
+{
+    uint32_t start = HAL_GetTick();
+    uint8_t step = log_mount_step;
+
+    switch (step) {
+    case LOG_MOUNT_CARD:
+        log_mount_tick = start;
+        log_mount_ms = 0;
+        // The driver itself: diskio initialises a drive only once, so after
+        // a write error or a card change this is what initialises it again
+        f_res = (USER_Driver.disk_initialize(0) & STA_NOINIT) ? FR_NOT_READY : FR_OK;
+        break;
+    case LOG_MOUNT_VOLUME:
+        f_res = f_mount(&fs, "", 1);
+        if (f_res == FR_OK) {
+            memset(&stats, 0, sizeof(stats));
+            disk_ops_base = disk_ops();
+        }
+        break;
+    case LOG_MOUNT_SESSION:
+        f_res = log_open_session();
+        break;
+#if TELEMETRY_LOG_BINARY && TELEMETRY_LOG_PREALLOC
+    case LOG_MOUNT_PREALLOC:
+        f_res = log_expand ? log_preallocate() : FR_OK;
+        break;
+#endif
+    default:
+        f_res = FR_INT_ERR;
+        break;
+    }
+    log_mount_ms += HAL_GetTick() - start;
+
+    if (f_res != FR_OK) {
+        if (step >= LOG_MOUNT_SESSION) f_close(&fil);
+        if (step >= LOG_MOUNT_VOLUME) f_mount(NULL, "", 0);
+        log_reset();
+        log_mount_step = LOG_MOUNT_CARD;
+        log_mount_backoff();
+        return;
+    }
+    if (++log_mount_step < LOG_MOUNT_STEPS) return;
+
+    log_mount_step = LOG_MOUNT_CARD;
+    is_mounted = 1;
+    stats.ready_tick = HAL_GetTick();
+    stats.mount_ms = log_mount_ms;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/** Mount the SD card and open the log for appending, starting it if new:
+  * every mount step now, where TelemetryLog_Poll runs one per call */
+void Mount_SD_Card(void)
+{
+    if (is_mounted) return;
+
+#if TELEMETRY_LOG_BINARY
+    // Its count goes into each new log's file ID
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    log_mount_held = 0;
+    do {
+        log_mount_next();
+    } while (!is_mounted && log_mount_step != LOG_MOUNT_CARD);
+}
+
+/** Log one record to the open file; a write error ends the session */
+static void log_add(const TelemetryData_t *data)
+{
+    if (log_rotate_due()) {
+        f_res = log_rotate();
+        if (f_res != FR_OK) {
+            log_backlog_unget(data); // Not in the ring yet: first for the next session
+            log_fail();
+            return;
+        }
+    }
+#if TELEMETRY_LOG_BINARY
+    f_res = log_record(data);
+#else
+    char logBuffer[100];
+    int len = snprintf(logBuffer, sizeof(logBuffer), "%lu,%lu,%lu,%lu,%.2f,%.2f,%.2f\n",
+        data->timestamp_ms, data->hours, data->minutes, data->seconds,
+        data->altitude, data->speed, data->voltage);
+    if (len <= 0) return;
+    if (len >= (int)sizeof(logBuffer)) len = sizeof(logBuffer) - 1;
+
+    f_res = log_append(logBuffer, (uint32_t)len);
+#endif
+    if (f_res != FR_OK) {
+        log_fail();
+        return;
+    }
+
+    log_uncommitted++;
+    stats.last_tick = HAL_GetTick();
+    if (stats.records++ == 0) stats.first_tick = stats.last_tick;
+}
+
+/** Hand a record to the log, or keep it in RAM until a card is mounted */
+static void log_submit(const TelemetryData_t *data)
+{
+    // Behind any waiting records, so the file stays in order
+    if (!is_mounted || log_backlog_count) {
+        log_backlog_put(data);
+        return;
+    }
+    log_add(data);
+}
+
+#if TELEMETRY_LOG_DECIMATE > 1
+/** True while an event has every record logged */
+static uint8_t log_event_on(uint32_t now)
+{
+    if (log_event && (now - log_event_tick) >= TELEMETRY_LOG_EVENT_MS) log_event = 0;
+    return log_event;
+}
+
+/** The oldest record in the black box */
+static uint32_t log_bb_oldest(void)
+{
+    return (log_bb_head + TELEMETRY_LOG_BLACKBOX_RECORDS - log_bb_count) % TELEMETRY_LOG_BLACKBOX_RECORDS;
+}
+
+/** Hold back a record decimation leaves out, in case an event wants it */
+static void log_bb_hold(const TelemetryData_t *data, uint32_t now)
+{
+    if (log_bb_count == TELEMETRY_LOG_BLACKBOX_RECORDS) {
+        log_bb_count--;
+        log_decimated++;
+    }
+    log_bb[log_bb_head] = *data;
+    log_bb_tick[log_bb_head] = now;
+    log_bb_head = (log_bb_head + 1U) % TELEMETRY_LOG_BLACKBOX_RECORDS;
+    log_bb_count++;
+}
+
+/** Drop the records that have been held back for the whole window */
+static void log_bb_age(uint32_t now)
+{
+    while (log_bb_count && (now - log_bb_tick[log_bb_oldest()]) >= TELEMETRY_LOG_BLACKBOX_MS) {
+        log_bb_count--;
+        log_decimated++;
+    }
+}
+
+/** A record that fires an event by itself */
+static uint8_t log_event_fires(const TelemetryData_t *data)
+{
+    return (TELEMETRY_LOG_EVENT_VOLTAGE_RATE < 0.0f && data->voltage_rate <= TELEMETRY_LOG_EVENT_VOLTAGE_RATE) ||
+           (TELEMETRY_LOG_EVENT_ALTITUDE_RATE < 0.0f && data->altitude_rate <= TELEMETRY_LOG_EVENT_ALTITUDE_RATE);
+}
+#endif
+
+/** Move the oldest waiting records into the log, while the ring has room */
+static void log_backlog_drain(void)
+{
+#if TELEMETRY_LOG_BACKLOG_RECORDS
+    for (uint32_t n = LOG_DRAIN_RECORDS; n && log_backlog_count && is_mounted; n--) {
+        if (log_queued >= TELEMETRY_LOG_SECTORS - 1U) return; // Full sectors go first
+        uint32_t oldest = (log_backlog_head + TELEMETRY_LOG_BACKLOG_RECORDS - log_backlog_count) %
+                          TELEMETRY_LOG_BACKLOG_RECORDS;
+        log_backlog_count--;
+        log_add(&log_backlog[oldest]); // One that fails goes back, or into log_requeue
+    }
+#endif
+}
+
+/**
+  * Add one record to the log buffer, or keep it in RAM until a card is
+  * mounted. Between events only every DECIMATE'th is logged; the others
+  * wait in the black box for the window, for an event to log them.
+  */
+void Telemetry_Log(const TelemetryData_t *data)
+{
+    uint32_t start = HAL_GetTick();
+
+#if TELEMETRY_LOG_DECIMATE > 1
+    if (log_event_fires(data)) TelemetryLog_Trigger();
+    if (log_event_on(start) || (log_bb_number++ % TELEMETRY_LOG_DECIMATE) == 0) {
+        log_submit(data);
+    } else {
+        log_bb_hold(data, start);
+    }
+    log_bb_age(start);
+#else
+    log_submit(data);
+#endif
+    log_stall(start);
+}
+
+/**
+  * Fire a black box event: log the history held back, then every record for
+  * TELEMETRY_LOG_EVENT_MS. A trigger during an event extends it. The
+  * history goes in after the records decimation kept, which are newer than
+  * some of it: the decoder puts them back in TimeMS order.
+  */
+void TelemetryLog_Trigger(void)
+{
+#if TELEMETRY_LOG_DECIMATE > 1
+    uint32_t start = HAL_GetTick();
+
+    if (!log_event_on(start)) log_events++;
+    log_event = 1;
+    log_event_tick = start;
+    while (log_bb_count) {
+        uint32_t oldest = log_bb_oldest();
+        log_bb_count--;
+        log_submit(&log_bb[oldest]);
+    }
+    log_stall(start);
+#endif
+}
+
+/** True once the sync policy calls for a commit */
+static uint8_t log_commit_due(uint32_t now)
+{
+    switch (log_policy) {
+    case TELEMETRY_LOG_SYNC_RECORDS: return log_uncommitted >= log_policy_every;
+    case TELEMETRY_LOG_SYNC_MARKER:  return log_marked;
+    default:                         return (now - log_pending_tick) >= log_policy_every;
+    }
+}
+
+/**
+  * Superloop hook: retry the mount when its wait is over, move waiting
+  * records into the log, hand the card the next full sector once it is
+  * idle, and commit when the sync policy says so.
+  */
+void TelemetryLog_Poll(void)
+{
+    uint32_t start = HAL_GetTick();
+
+#if TELEMETRY_LOG_DECIMATE > 1
+    if (log_bb_count) log_bb_age(start); // Records stopped coming
+#endif
+    if (!is_mounted) {
+        if (log_mount_held) return;
+        if (log_mount_step == LOG_MOUNT_CARD && (start - log_mount_tick) < log_mount_wait) return;
+        log_mount_next();
+        log_stall(start);
+        if (!is_mounted) return;
+        start = HAL_GetTick();
+    }
+    if (log_backlog_count) {
+        log_backlog_drain();
+        log_stall(start);
+        start = HAL_GetTick();
+    }
+
+    if (!is_mounted || !log_pending()) return;
+    if (!USER_Poll()) return; // Card busy with the previous sector
+
+    uint8_t due = log_commit_due(start);
+
+    if (log_queued && (due || log_queued * TELEMETRY_LOG_SECTOR >= TELEMETRY_LOG_FLUSH_BYTES)) {
+        f_res = log_write_sector();
+    } else if (due) {
+        f_res = log_commit();
+    } else {
+        return;
+    }
+
+    if (f_res != FR_OK) log_fail();
+    log_stall(start);
+}
+
+/** Commit everything buffered now */
+void TelemetryLog_Flush(void)
+{
+    if (is_mounted && log_commit() != FR_OK) log_fail();
+}
+
+/** Ask for a commit from TelemetryLog_Poll, for the marker policy */
+void TelemetryLog_Mark(void)
+{
+    if (is_mounted && log_pending()) log_marked = 1;
+}
+
+/** Choose when data is committed; every is in ms or records, by policy */
+void TelemetryLog_SetSyncPolicy(TelemetryLog_SyncPolicy_t policy, uint32_t every)
+{
+    log_policy = (uint8_t)policy;
+    log_policy_every = every ? every : 1U;
+}
+
+/** Let out the black box, commit, close the file and release the card;
+  * Mount_SD_Card starts the next file, and until then TelemetryLog_Poll
+  * does not remount */
+void TelemetryLog_Close(void)
+{
+    if (!is_mounted) return;
+#if TELEMETRY_LOG_DECIMATE > 1
+    log_decimated += log_bb_count;
+    log_bb_count = 0;
+#endif
+    if (log_finish() != FR_OK) {
+        log_fail();
+        return;
+    }
+    // The next mount picks the file as a boot does, so the number stays capped
+    log_number = 0;
+    f_mount(NULL, "", 0);
+    is_mounted = 0;
+    log_mount_held = 1;
+}
+
+uint8_t TelemetryLog_IsMounted(void)
+{
+    return is_mounted;
+}
+
+/** Number of the file being logged to, as in LOG00001.BIN */
+uint32_t TelemetryLog_FileNumber(void)
+{
+    return log_number;
+}
+
+const TelemetryLog_Stats_t *TelemetryLog_GetStats(void)
+{
+    stats.disk_ops = disk_ops() - disk_ops_base;
+    stats.backlog = log_backlog_count;
+    stats.dropped = log_backlog_dropped;
+    stats.mount_failures = log_mount_failures;
+    stats.events = log_events;
+    stats.decimated = log_decimated;
+    return &stats;
+}
+
+/** Sustained logging rate between the first and latest record */
+float TelemetryLog_RecordsPerSecond(void)
+{
+    uint32_t span = stats.last_tick - stats.first_tick;
+    if (stats.records < 2 || span == 0) return 0.0f;
+    return (stats.records - 1) * 1000.0f / span;
+}
+
+/** Card operations (reads, writes, syncs) per logged record */
+float TelemetryLog_OpsPerRecord(void)
+{
+    if (stats.records == 0) return 0.0f;
+    return (float)TelemetryLog_GetStats()->disk_ops / stats.records;
+}
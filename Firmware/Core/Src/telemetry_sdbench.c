@@ -0,0 +1,258 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry_sdbench.c
+  * @brief          : SD card throughput benchmark.
+  *
+  *                   The test file is written at its LBAs, past FatFs, once
+  *                   f_expand has given it contiguous clusters and f_sync has
+  *                   put its FAT chain and directory entry on the card, as
+  *                   the logger does with a preallocated log. Only its data
+  *                   sectors are touched, so the volume stays consistent.
+  *                   Single-sector calls go through the driver's cache, as
+  *                   FatFs's own do; the sync at the end of the pass writes
+  *                   back what it still holds. The file's slots are dropped
+  *                   before each pass, so every sector is written to and
+  *                   read back from the card, not the cache.
+  *
+  *                   Every sector is filled with words made from its index
+  *                   in the file and the case number, so a sector that
+  *                   reads back from the wrong place or from an earlier
+  *                   case counts as an error. Filling and checking are not
+  *                   timed.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "telemetry_sdbench.h"
+#include "sd_cache.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_SECTOR            512U
+#define BENCH_SECTORS           (TELEMETRY_SDBENCH_BYTES / BENCH_SECTOR)
+
+/* Private variables ---------------------------------------------------------*/
+const char *const TelemetrySdbench_PatternNames[TELEMETRY_SDBENCH_PATTERNS] = {
+    "single", "multi", "stream"
+};
+const uint32_t TelemetrySdbench_RecordSizes[TELEMETRY_SDBENCH_SIZES] = {
+    512U, 2048U, TELEMETRY_SDBENCH_RECORD_MAX
+};
+
+static FATFS bench_fs;
+static FIL bench_fil;
+static uint32_t bench_buf[TELEMETRY_SDBENCH_RECORD_MAX / 4U];
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t bench_us(uint32_t start)
+{
+    return (DWT->CYCCNT - start) / (SystemCoreClock / 1000000U);
+}
+
+/** Adds the time since start, a cycle count, to a latency histogram */
+static void bench_time(SD_Timing_t *t, uint32_t start)
+{
+    uint32_t us = bench_us(start);
+    uint32_t k = us ? 31U - __CLZ(us) : 0U; // floor(log2(us))
+
+    if (k >= SD_HIST_BUCKETS) k = SD_HIST_BUCKETS - 1;
+    t->hist[k]++;
+    t->count++;
+    t->total_us += us;
+    if (us > t->max_us) t->max_us = us;
+}
+
+static uint32_t bench_word(uint32_t sector, uint32_t i, uint32_t salt)
+{
+    return (sector * 0x9E3779B1U) ^ (salt << 24) ^ i;
+}
+
+/** Fills count sectors of the buffer for the file's sector first on */
+static void bench_fill(uint32_t first, uint32_t count, uint32_t salt)
+{
+    for (uint32_t s = 0; s < count; s++) {
+        uint32_t *w = bench_buf + s * (BENCH_SECTOR / 4U);
+        for (uint32_t i = 0; i < BENCH_SECTOR / 4U; i++) w[i] = bench_word(first + s, i, salt);
+    }
+}
+
+/** Sectors of the buffer that are not what bench_fill put there */
+static uint32_t bench_check(uint32_t first, uint32_t count, uint32_t salt)
+{
+    uint32_t bad = 0;
+
+    for (uint32_t s = 0; s < count; s++) {
+        const uint32_t *w = bench_buf + s * (BENCH_SECTOR / 4U);
+        for (uint32_t i = 0; i < BENCH_SECTOR / 4U; i++) {
+            if (w[i] != bench_word(first + s, i, salt)) {
+                bad++;
+                break;
+            }
+        }
+    }
+    return bad;
+}
+
+/** Writes count sectors from the buffer at lba; left is what the file has from there */
+static DRESULT bench_write(uint8_t pattern, DWORD lba, UINT count, DWORD left)
+{
+    const BYTE *buf = (const BYTE*)bench_buf;
+    DRESULT res = RES_OK;
+
+    switch (pattern) {
+    case TELEMETRY_SDBENCH_SINGLE:
+        for (UINT i = 0; i < count && res == RES_OK; i++) {
+            res = disk_write(bench_fs.drv, buf + i * BENCH_SECTOR, lba + i, 1);
+        }
+        return res;
+    case TELEMETRY_SDBENCH_MULTI:
+        return disk_write(bench_fs.drv, buf, lba, count);
+    default:
+        for (UINT i = 0; i < count && res == RES_OK; i++) {
+            res = USER_StreamWrite(buf + i * BENCH_SECTOR, lba + i, left - i);
+        }
+        return res;
+    }
+}
+
+static DRESULT bench_read(uint8_t pattern, DWORD lba, UINT count)
+{
+    BYTE *buf = (BYTE*)bench_buf;
+    DRESULT res = RES_OK;
+
+    if (pattern != TELEMETRY_SDBENCH_SINGLE) return disk_read(bench_fs.drv, buf, lba, count);
+    for (UINT i = 0; i < count && res == RES_OK; i++) {
+        res = disk_read(bench_fs.drv, buf + i * BENCH_SECTOR, lba + i, 1);
+    }
+    return res;
+}
+
+/** Forgets any cached copy of the file's sectors; clean after the last sync */
+static void bench_uncache(DWORD lba)
+{
+#if SD_CACHE_SLOTS
+    SD_CacheDrop(lba, BENCH_SECTORS);
+#else
+    (void)lba;
+#endif
+}
+
+/** Writes the file at lba with one pattern and record size, then reads it back */
+static void bench_case(TelemetrySdbench_Result_t *r, uint8_t pattern, uint32_t record, DWORD lba, uint32_t salt)
+{
+    const uint32_t count = record / BENCH_SECTOR;
+    uint32_t start;
+    DRESULT res;
+
+    memset(r, 0, sizeof(*r));
+    r->pattern = pattern;
+    r->record = record;
+    r->bytes = TELEMETRY_SDBENCH_BYTES;
+
+    bench_uncache(lba);
+    for (uint32_t s = 0; s < BENCH_SECTORS; s += count) {
+        bench_fill(s, count, salt);
+        start = DWT->CYCCNT;
+        res = bench_write(pattern, lba + s, count, BENCH_SECTORS - s);
+        bench_time(&r->write.calls, start);
+        if (res != RES_OK) r->errors++;
+    }
+    start = DWT->CYCCNT;
+    if (pattern == TELEMETRY_SDBENCH_STREAM) {
+        res = USER_StreamStop();
+    } else {
+        res = disk_ioctl(bench_fs.drv, CTRL_SYNC, NULL);
+    }
+    r->write.sync_us = bench_us(start);
+    if (res != RES_OK) r->errors++;
+
+    bench_uncache(lba);
+    for (uint32_t s = 0; s < BENCH_SECTORS; s += count) {
+        start = DWT->CYCCNT;
+        res = bench_read(pattern, lba + s, count);
+        bench_time(&r->read.calls, start);
+        r->errors += res == RES_OK ? bench_check(s, count, salt) : 1U;
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * Mounts the card, runs every pattern at every record size into results,
+  * in pattern order, and unmounts it again. Blocks for the whole run, some
+  * seconds per case on a slow card. Returns the first FatFs error setting
+  * up or removing the test file; card errors during a case are counted in
+  * its result instead.
+  */
+FRESULT TelemetrySdbench_Run(TelemetrySdbench_Result_t results[TELEMETRY_SDBENCH_CASES],
+                             TelemetrySdbench_Report_t report)
+{
+    FRESULT res;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    res = f_mount(&bench_fs, "", 1);
+    if (res == FR_OK) res = f_open(&bench_fil, TELEMETRY_SDBENCH_FILE, FA_CREATE_ALWAYS | FA_WRITE);
+    if (res != FR_OK) {
+        f_mount(NULL, "", 0);
+        return res;
+    }
+
+    res = f_expand(&bench_fil, TELEMETRY_SDBENCH_BYTES, 1);
+    if (res == FR_OK) res = f_sync(&bench_fil); // FAT and directory entry before any raw write
+    if (res == FR_OK) {
+        DWORD lba = bench_fs.database + (bench_fil.obj.sclust - 2) * bench_fs.csize;
+
+        for (uint32_t c = 0; c < TELEMETRY_SDBENCH_CASES; c++) {
+            bench_case(&results[c], (uint8_t)(c / TELEMETRY_SDBENCH_SIZES),
+                       TelemetrySdbench_RecordSizes[c % TELEMETRY_SDBENCH_SIZES], lba, c + 1U);
+            if (report) report(&results[c]);
+        }
+    }
+
+    FRESULT close = f_close(&bench_fil);
+    if (res == FR_OK) res = close;
+    close = f_unlink(TELEMETRY_SDBENCH_FILE);
+    if (res == FR_OK) res = close;
+    f_mount(NULL, "", 0);
+    return res;
+}
+
+/** Throughput of a pass in MB/s (10^6 bytes), its final sync included */
+float TelemetrySdbench_MBps(const TelemetrySdbench_Result_t *result, const TelemetrySdbench_Pass_t *pass)
+{
+    uint64_t us = pass->calls.total_us + pass->sync_us;
+    return us ? (float)result->bytes / (float)us : 0.0f;
+}
+
+/**
+  * Formats line number line of a result, without a line ending: the case,
+  * then the write and the read pass with the histogram as STATS prints it
+  * (lower_us:count per bucket). Returns the length, or 0 past the last line.
+  */
+int TelemetrySdbench_Format(const TelemetrySdbench_Result_t *result, uint32_t line, char *buf, size_t size)
+{
+    const TelemetrySdbench_Pass_t *pass;
+    int n;
+
+    if (line == 0) {
+        return snprintf(buf, size, "bench %s record=%lu bytes=%lu errors=%lu",
+            TelemetrySdbench_PatternNames[result->pattern], (unsigned long)result->record,
+            (unsigned long)result->bytes, (unsigned long)result->errors);
+    }
+    if (line > 2) return 0;
+
+    pass = line == 1 ? &result->write : &result->read;
+    n = snprintf(buf, size, "%s mb_s=%.2f n=%lu avg=%lu max=%lu sync=%lu us hist", line == 1 ? "write" : "read",
+        (double)TelemetrySdbench_MBps(result, pass), (unsigned long)pass->calls.count,
+        pass->calls.count ? (unsigned long)(pass->calls.total_us / pass->calls.count) : 0UL,
+        (unsigned long)pass->calls.max_us, (unsigned long)pass->sync_us);
+    for (uint32_t k = 0; k < SD_HIST_BUCKETS && n > 0 && (size_t)n + 24U < size; k++) {
+        if (pass->calls.hist[k]) {
+            n += snprintf(buf + n, size - n, " %lu:%lu", k ? 1UL << k : 0UL, (unsigned long)pass->calls.hist[k]);
+        }
+    }
+    return n;
+}
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""
+ssd1306_font_pack.py - generate bit-packed SSD1306 fonts
+
+Reads the uint16_t glyph tables in Core/Src/ssd1306_fonts.c and writes
+Core/Src/ssd1306_fonts_packed.c, used when SSD1306_USE_PACKED_FONTS is set.
+
+Packed font blob layout (all multi-byte values little-endian):
+    uint16_t offset[95]   bit offset of each glyph in the stream below
+    bit stream (MSB first), per glyph:
+        5 bits  top    - blank rows above the ink bounding box
+        5 bits  rows   - bounding box height (0 for blank glyphs, nothing follows)
+        4 bits  left   - blank columns left of the bounding box
+        5 bits  cols   - bounding box width
+        1 bit   mode   - 0: raw pixels, 1: run-length coded pixels
+        pixels of the bounding box, row by row, leftmost pixel first
+
+Run-length coding alternates runs of clear and set pixels, starting with a
+(possibly empty) clear run. Each run is written as 3-bit chunks; a chunk of
+7 adds 7 and continues, any other value ends the run. The encoder picks the
+shorter of the two modes per glyph. Columns beyond the character width are
+never drawn and are not stored.
+
+Usage: ssd1306_font_pack.py <ssd1306_fonts.c> <ssd1306_fonts_packed.c>
+"""
+
+import re
+import sys
+
+GLYPHS = 95  # ' ' .. '~'
+
+FONT_DEF = re.compile(
+    r'const\s+SSD1306_Font_t\s+(\w+)\s*=\s*\{\s*(\d+)\s*,\s*(\d+)\s*,\s*(\w+)\s*,\s*(\w+)\s*\}')
+
+
+def strip_comments(text):
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def parse_array(text, name):
+    m = re.search(r'static\s+const\s+uint(?:8|16)_t\s+' + name + r'\s*\[\s*\]\s*=\s*\{(.*?)\};',
+                  text, flags=re.S)
+    if not m:
+        sys.exit("array %s not found" % name)
+    body = strip_comments(m.group(1))
+    return [int(v, 0) for v in re.findall(r'0x[0-9a-fA-F]+|\d+', body)]
+
+
+class BitWriter:
+    def __init__(self):
+        self.bits = []
+
+    def put(self, value, n):
+        for i in range(n - 1, -1, -1):
+            self.bits.append((value >> i) & 1)
+
+    def to_bytes(self):
+        out = bytearray()
+        for i in range(0, len(self.bits), 8):
+            chunk = self.bits[i:i + 8] + [0] * (8 - len(self.bits[i:i + 8]))
+            out.append(int(''.join(map(str, chunk)), 2))
+        return out
+
+
+RUN_BITS = 3
+RUN_MORE = (1 << RUN_BITS) - 1
+
+
+def rle_encode(pixels):
+    runs = []
+    cur, n = 0, 0
+    for p in pixels:
+        if p == cur:
+            n += 1
+        else:
+            runs.append(n)
+            cur, n = p, 1
+    runs.append(n)
+    bw = BitWriter()
+    for r in runs:
+        while r >= RUN_MORE:
+            bw.put(RUN_MORE, RUN_BITS)
+            r -= RUN_MORE
+        bw.put(r, RUN_BITS)
+    return bw.bits
+
+
+def pack_font(width, height, data, char_width):
+    if height > 31:
+        sys.exit("font height %d does not fit the 5-bit row fields" % height)
+    bw = BitWriter()
+    offsets = []
+    for g in range(GLYPHS):
+        cw = char_width[g] if char_width else width
+        mask = (0xFFFF << (16 - cw)) & 0xFFFF
+        rows = [(data[g * height + r] & mask) if g * height + r < len(data) else 0
+                for r in range(height)]
+        offsets.append(len(bw.bits))
+        ink = 0
+        for r in rows:
+            ink |= r
+        if not ink:
+            bw.put(0, 5)
+            bw.put(0, 5)
+            continue
+        top = next(i for i, r in enumerate(rows) if r)
+        bottom = max(i for i, r in enumerate(rows) if r) + 1
+        left = 16 - ink.bit_length()
+        cols = ink.bit_length() - ((ink & -ink).bit_length() - 1)
+        pixels = [(r >> (15 - left - i)) & 1 for r in rows[top:bottom] for i in range(cols)]
+        rle = rle_encode(pixels)
+        bw.put(top, 5)
+        bw.put(bottom - top, 5)
+        bw.put(left, 4)
+        bw.put(cols, 5)
+        if len(rle) < len(pixels):
+            bw.put(1, 1)
+            bw.bits += rle
+        else:
+            bw.put(0, 1)
+            bw.bits += pixels
+    if len(bw.bits) > 0xFFFF:
+        sys.exit("packed stream exceeds 16-bit bit offsets")
+    blob = bytearray()
+    for off in offsets:
+        blob += bytes((off & 0xFF, off >> 8))
+    return blob + bw.to_bytes()
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    src = open(sys.argv[1]).read()
+    clean = strip_comments(src)
+
+    out = ['/* Generated by Tools/ssd1306_font_pack.py from ssd1306_fonts.c - do not edit */',
+           '',
+           '#include "ssd1306_fonts.h"',
+           '',
+           '#ifdef SSD1306_USE_PACKED_FONTS',
+           '']
+    total_raw = total_packed = 0
+    for name, width, height, data_name, cw_name in FONT_DEF.findall(clean):
+        width, height = int(width), int(height)
+        data = parse_array(src, data_name)
+        cw = parse_array(src, cw_name) if cw_name != 'NULL' else None
+        blob = pack_font(width, height, data, cw)
+        raw = len(data) * 2 + (len(cw) if cw else 0)
+        total_raw += raw
+        total_packed += len(blob) + (len(cw) if cw else 0)
+
+        guard = 'SSD1306_INCLUDE_FONT_' + name.split('_', 1)[1]
+        packed_name = name.replace('_', '') + '_packed'
+        out.append('#ifdef %s' % guard)
+        out.append('/* %d bytes, %d bytes unpacked */' % (len(blob), raw))
+        out.append('static const uint8_t %s[] = {' % packed_name)
+        for i in range(0, len(blob), 16):
+            out.append(' '.join('0x%02X,' % b for b in blob[i:i + 16]))
+        out.append('};')
+        if cw:
+            cw_packed = name.replace('_', '') + '_char_width'
+            out.append('static const uint8_t %s[] = {' % cw_packed)
+            for i in range(0, len(cw), 16):
+                out.append(' '.join('%d,' % b for b in cw[i:i + 16]))
+            out.append('};')
+            out.append('const SSD1306_Font_t %s = {%d, %d, NULL, %s, %s};'
+                       % (name, width, height, cw_packed, packed_name))
+        else:
+            out.append('const SSD1306_Font_t %s = {%d, %d, NULL, NULL, %s};'
+                       % (name, width, height, packed_name))
+        out.append('#endif')
+        out.append('')
+    out.append('#endif /* SSD1306_USE_PACKED_FONTS */')
+    out.append('')
+
+    with open(sys.argv[2], 'w') as f:
+        f.write('\n'.join(out))
+    print("fonts: %d bytes packed, %d bytes unpacked" % (total_packed, total_raw))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,227 @@
+/**
+  ******************************************************************************
+  * @file    binlog_bench.c
+  * @brief   Size and speed of packed log sectors on the bundled flight data.
+  *
+  *          Reads Altitude,Speed,Voltage rows (Python_Scripts/
+  *          telemetry_stream.csv), stamps them at the streamer's 5 Hz with
+  *          rates worked out as main.c does, and lays them out in sectors
+  *          the way the firmware logger does, once plain and once packed.
+  *          Prints key=value: sectors either way and the ratio, host time to
+  *          build a sector's worth of records per record (CRC included),
+  *          and unpack throughput through TelemetryBinlog_Unpack. Every
+  *          unpacked record is checked against the plain one.
+  *
+  *          With an output path the packed log, repeated reps times with
+  *          time running on, is written for telemetry_decode --stats.
+  *
+  *          Usage: binlog_bench telemetry_stream.csv [packed.bin [reps]]
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "telemetry_binlog.h"
+
+#define RATE_MS     200U    /* telemetry_streamer.py sends at 5 Hz */
+#define MIN_BENCH_S 0.2
+#define FILE_ID     0x1D5EC7A1U /* Any non-zero ID, as log_start picks one */
+
+static double now_s(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Plain records for every row of the CSV, numbered on from first; returns the count */
+static uint32_t load_records(FILE *in, uint32_t first, uint8_t **out)
+{
+  const TelemetryBinlog_Field_t *f = TelemetryBinlog_Fields;
+  char line[128];
+  uint32_t n = 0, cap = 0;
+  uint8_t *recs = NULL;
+  float prev[3] = { 0 };
+  uint32_t prev_ms = 0;
+
+  while (fgets(line, sizeof(line), in)) {
+    float v[3];
+    if (sscanf(line, "%f,%f,%f", &v[0], &v[1], &v[2]) != 3) continue;
+    if (n == cap) {
+      cap = cap ? cap * 2 : 4096;
+      recs = realloc(recs, (size_t)cap * TELEMETRY_BINLOG_RECORD_SIZE);
+    }
+
+    uint8_t *rec = recs + (size_t)n * TELEMETRY_BINLOG_RECORD_SIZE;
+    uint32_t ms = (first + n) * RATE_MS;
+    uint32_t s = ms / 1000U;
+    float dt = (ms - prev_ms) / 1000.0f;   /* As Telemetry_ReceiveAndParse */
+    if (dt < 0.001f) dt = 0.001f;
+
+    TelemetryBinlog_Put(rec, &f[TELEMETRY_BINLOG_TIME_MS], ms);
+    TelemetryBinlog_Put(rec, &f[TELEMETRY_BINLOG_HOURS], s / 3600U);
+    TelemetryBinlog_Put(rec, &f[TELEMETRY_BINLOG_MINUTES], s / 60U % 60U);
+    TelemetryBinlog_Put(rec, &f[TELEMETRY_BINLOG_SECONDS], s % 60U);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_ALTITUDE], v[0]);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_SPEED], v[1]);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_VOLTAGE], v[2]);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_ALTITUDE_RATE], (v[0] - prev[0]) / dt);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_SPEED_RATE], (v[1] - prev[1]) / dt);
+    TelemetryBinlog_PutFixed(rec, &f[TELEMETRY_BINLOG_VOLTAGE_RATE], (v[2] - prev[2]) / dt);
+    memcpy(prev, v, sizeof(prev));
+    prev_ms = ms;
+    n++;
+  }
+  *out = recs;
+  return n;
+}
+
+/* Lay n records out in sectors from seq on, as log_record does; returns the sectors used */
+static uint32_t build_sectors(const uint8_t *recs, uint32_t n, int packed, uint32_t seq, uint8_t *out)
+{
+  TelemetryBinlog_Packer_t packer;
+  uint32_t sectors = 0, fill = 0, count = 0;
+  uint32_t max = packed ? TELEMETRY_BINLOG_PACKED_MAX : TELEMETRY_BINLOG_RECORD_SIZE;
+  uint8_t *sector = out;
+
+  for (uint32_t i = 0; i < n; i++) {
+    const uint8_t *rec = recs + (size_t)i * TELEMETRY_BINLOG_RECORD_SIZE;
+
+    if (count == 0) {
+      if (packed) {
+        TelemetryBinlog_BeginPacked(sector, seq + sectors);
+      } else {
+        TelemetryBinlog_BeginSector(sector, seq + sectors);
+      }
+      memcpy(sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET, rec, TELEMETRY_BINLOG_RECORD_SIZE);
+      fill = TELEMETRY_BINLOG_PAYLOAD_OFFSET + TELEMETRY_BINLOG_RECORD_SIZE;
+      TelemetryBinlog_PackFirst(&packer, rec);
+    } else if (packed) {
+      fill += TelemetryBinlog_Pack(&packer, rec, sector + fill);
+    } else {
+      memcpy(sector + fill, rec, TELEMETRY_BINLOG_RECORD_SIZE);
+      fill += TELEMETRY_BINLOG_RECORD_SIZE;
+    }
+    count++;
+
+    if (fill + max > TELEMETRY_BINLOG_COUNT_OFFSET || i + 1 == n) {
+      TelemetryBinlog_SealSector(sector, (uint16_t)count, FILE_ID);
+      sector += TELEMETRY_BINLOG_SECTOR;
+      sectors++;
+      count = 0;
+    }
+  }
+  return sectors;
+}
+
+/* Unpack every sector; with recs, compare against them. Returns a checksum, or 0 on a mismatch */
+static uint32_t unpack_sectors(const uint8_t *sectors, uint32_t count, const uint8_t *recs)
+{
+  TelemetryBinlog_Packer_t packer;
+  uint32_t sum = 1;
+
+  for (uint32_t s = 0; s < count; s++) {
+    const uint8_t *sector = sectors + (size_t)s * TELEMETRY_BINLOG_SECTOR;
+    uint32_t n = TelemetryBinlog_Get16(sector + TELEMETRY_BINLOG_COUNT_OFFSET);
+    uint32_t fill = TELEMETRY_BINLOG_PAYLOAD_OFFSET + TELEMETRY_BINLOG_RECORD_SIZE;
+
+    if (TelemetryBinlog_CheckSector(sector, s + 1U, FILE_ID) < 0) return 0;
+    TelemetryBinlog_PackFirst(&packer, sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET);
+    for (uint32_t r = 0; r < n; r++) {
+      if (r) {
+        int32_t used = TelemetryBinlog_Unpack(&packer, sector + fill, TELEMETRY_BINLOG_COUNT_OFFSET - fill);
+        if (used < 0) return 0;
+        fill += (uint32_t)used;
+      }
+      if (recs) {
+        for (uint32_t i = 0; i < TELEMETRY_BINLOG_FIELD_COUNT; i++) {
+          const TelemetryBinlog_Field_t *f = &TelemetryBinlog_Fields[i];
+          if (packer.value[i] != (uint32_t)TelemetryBinlog_Get(recs, f->type, f->offset)) return 0;
+        }
+        recs += TELEMETRY_BINLOG_RECORD_SIZE;
+      }
+      sum = sum * 31U + packer.value[TELEMETRY_BINLOG_ALTITUDE];
+    }
+  }
+  return sum ? sum : 1;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: binlog_bench telemetry_stream.csv [packed.bin [reps]]\n");
+    return 2;
+  }
+  FILE *in = fopen(argv[1], "r");
+  if (!in) {
+    perror(argv[1]);
+    return 1;
+  }
+  uint8_t *recs;
+  uint32_t n = load_records(in, 0, &recs);
+  fclose(in);
+  if (n == 0) {
+    fprintf(stderr, "%s: no Altitude,Speed,Voltage rows\n", argv[1]);
+    return 1;
+  }
+
+  /* Plain records take the most sectors; packed ones at most as many */
+  uint32_t cap = n / TELEMETRY_BINLOG_RECORDS_PER_SECTOR + 1U;
+  uint8_t *plain = malloc((size_t)cap * TELEMETRY_BINLOG_SECTOR);
+  uint8_t *packed = malloc((size_t)cap * TELEMETRY_BINLOG_SECTOR);
+  uint32_t plain_sectors = 0, packed_sectors = 0, reps;
+  double t0, plain_s, packed_s, unpack_s;
+
+  for (reps = 0, t0 = now_s(); reps == 0 || now_s() - t0 < MIN_BENCH_S; reps++) {
+    plain_sectors = build_sectors(recs, n, 0, 1, plain);
+  }
+  plain_s = (now_s() - t0) / reps;
+  for (reps = 0, t0 = now_s(); reps == 0 || now_s() - t0 < MIN_BENCH_S; reps++) {
+    packed_sectors = build_sectors(recs, n, 1, 1, packed);
+  }
+  packed_s = (now_s() - t0) / reps;
+
+  if (!unpack_sectors(packed, packed_sectors, recs)) {
+    fprintf(stderr, "packed records do not unpack to the plain ones\n");
+    return 1;
+  }
+  volatile uint32_t sink = 0;
+  for (reps = 0, t0 = now_s(); reps == 0 || now_s() - t0 < MIN_BENCH_S; reps++) {
+    sink += unpack_sectors(packed, packed_sectors, NULL);
+  }
+  unpack_s = (now_s() - t0) / reps;
+
+  printf("records=%u plain_sectors=%u packed_sectors=%u ratio=%.2f packed_bytes_per_record=%.2f "
+         "plain_ns_per_record=%.1f packed_ns_per_record=%.1f unpack_mb_per_s=%.0f unpack_mrecords_per_s=%.1f\n",
+         n, plain_sectors, packed_sectors, (double)plain_sectors / packed_sectors,
+         (double)packed_sectors * TELEMETRY_BINLOG_SECTOR / n, plain_s * 1e9 / n, packed_s * 1e9 / n,
+         packed_sectors * (double)TELEMETRY_BINLOG_SECTOR / unpack_s / 1e6, n / unpack_s / 1e6);
+
+  if (argc > 2) {
+    uint32_t copies = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1U;
+    uint8_t header[TELEMETRY_BINLOG_SECTOR];
+    uint32_t seq = 1;
+    FILE *out = fopen(argv[2], "wb");
+
+    if (!out) {
+      perror(argv[2]);
+      return 1;
+    }
+    TelemetryBinlog_BuildHeader(header, FILE_ID, 0); /* Records in order */
+    fwrite(header, 1, sizeof(header), out);
+    for (uint32_t c = 0; c < copies; c++) {
+      /* Each copy carries on in time from the last */
+      in = fopen(argv[1], "r");
+      free(recs);
+      n = load_records(in, c * n, &recs);
+      fclose(in);
+      uint32_t s = build_sectors(recs, n, 1, seq, packed);
+      fwrite(packed, TELEMETRY_BINLOG_SECTOR, s, out);
+      seq += s;
+    }
+    fclose(out);
+  }
+  return 0;
+}
@@ -0,0 +1,18 @@
+/**
+  ******************************************************************************
+  * @file    fatfs.h
+  * @brief   Host stand-in for the CubeMX-generated FATFS/App/fatfs.h, so
+  *          firmware that includes it builds against FatFs from FATFS_DIR.
+  *          The USER driver is whichever backend the tool links, e.g.
+  *          sd_image.c.
+  ******************************************************************************
+  */
+
+#ifndef __fatfs_H
+#define __fatfs_H
+
+#include "ff.h"
+#include "ff_gen_drv.h"
+#include "user_diskio.h"
+
+#endif /* __fatfs_H */
@@ -0,0 +1,59 @@
+/**
+  ******************************************************************************
+  * @file    ffconf.h
+  * @brief   FatFs R0.12c configuration for the host tools: the CubeMX
+  *          defaults the firmware is generated with, _USE_EXPAND as set in
+  *          the .ioc, and no RTOS or HAL includes.
+  ******************************************************************************
+  */
+
+#ifndef _FFCONF
+#define _FFCONF 68300   /* Revision ID */
+
+/* Cube additions: disk_write and disk_ioctl in Diskio_drvTypeDef */
+#define _USE_WRITE      1
+#define _USE_IOCTL      1
+
+/* Function configurations */
+#define _FS_READONLY    0
+#define _FS_MINIMIZE    0
+#define _USE_STRFUNC    2
+#define _USE_FIND       0
+#define _USE_MKFS       1   /* f_mkfs formats new images */
+#define _USE_FASTSEEK   1
+#define _USE_EXPAND     1
+#define _USE_CHMOD      0
+#define _USE_LABEL      0
+#define _USE_FORWARD    0
+
+/* Locale and namespace configurations */
+#define _CODE_PAGE      850
+#define _USE_LFN        0
+#define _MAX_LFN        255
+#define _LFN_UNICODE    0
+#define _STRF_ENCODE    3
+#define _FS_RPATH       0
+
+/* Drive/volume configurations */
+#define _VOLUMES        1
+#define _STR_VOLUME_ID  0
+#define _VOLUME_STRS    "RAM","NAND","CF","SD","SD2","USB","USB2","USB3"
+#define _MULTI_PARTITION 0
+#define _MIN_SS         512
+#define _MAX_SS         512
+#define _USE_TRIM       0
+#define _FS_NOFSINFO    0
+
+/* System configurations */
+#define _FS_TINY        0
+#define _FS_EXFAT       0
+#define _FS_NORTC       0
+#define _NORTC_MON      6
+#define _NORTC_MDAY     4
+#define _NORTC_YEAR     2015
+#define _FS_LOCK        2
+#define _FS_REENTRANT   0
+#define _FS_TIMEOUT     1000
+#define _SYNC_t         void*
+
+#endif /* _FFCONF */
@@ -0,0 +1,1615 @@
+/**
+  ******************************************************************************
+  * @file    fatfs_model.c
+  * @brief   Host model of FatFs R0.12c, with the diskio.c and ff_gen_drv.c
+  *          that STM32Cube puts around it, for building the host tools
+  *          when the FatFs sources are not at FATFS_DIR (see Makefile).
+  *
+  *          Reads and writes real FAT12/16/32 volumes through the linked
+  *          driver, following ff.c's algorithms so the sector traffic is
+  *          FatFs's: one window sector (win[]) for FAT and directory
+  *          sectors, written back when another sector moves in or at sync,
+  *          and mirrored into the second FAT; a sector buffer per file,
+  *          with the whole sectors of a transfer going straight between the
+  *          caller's buffer and the disk; the directory entry and FSINFO
+  *          written at f_sync; the FAT walks of create_chain, f_lseek and
+  *          f_expand. f_mkfs lays out a volume as FatFs does, with an MBR,
+  *          one FAT and the data area aligned to the erase block from
+  *          GET_BLOCK_SIZE.
+  *
+  *          Not modelled: long file names, creating directories, file
+  *          locking (_FS_LOCK), the fast seek table, exFAT and partitions
+  *          other than the first. CPU time is not charged. Numbers taken
+  *          with it are the model's; point FATFS_DIR at FatFs to measure
+  *          FatFs itself.
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "ff.h"
+#include "ff_gen_drv.h"
+
+#define SS                  512U        /* Sector size */
+#define SZDIRE              32U         /* Size of a directory entry */
+#define N_ROOTDIR           512U        /* Root directory entries f_mkfs gives FAT12/16 */
+#define N_FATS              1U          /* FATs f_mkfs creates */
+
+#define MAX_FAT12           0xFF5UL
+#define MAX_FAT16           0xFFF5UL
+#define MAX_FAT32           0x0FFFFFF5UL
+#define BAD_CLUST           0xFFFFFFFFUL /* get_fat/create_chain: disk error */
+
+/* File status flags beyond the FA_ open modes */
+#define FA_SEEKEND          0x20
+#define FA_MODIFIED         0x40
+#define FA_DIRTY            0x80
+
+#define AM_VOL              0x08
+#define AM_LFN              0x0F
+#define AM_MASK             0x3F
+
+#define DDEM                0xE5        /* Deleted directory entry mark */
+#define NSFLAG              11          /* Name status byte in DIR.fn[] */
+#define NS_LAST             0x04        /* Last segment of the path */
+#define NS_NONAME           0x80        /* The path named no object: the root */
+
+/* Boot sector and BPB */
+#define BS_JmpBoot          0
+#define BPB_BytsPerSec      11
+#define BPB_SecPerClus      13
+#define BPB_RsvdSecCnt      14
+#define BPB_NumFATs         16
+#define BPB_RootEntCnt      17
+#define BPB_TotSec16        19
+#define BPB_Media           21
+#define BPB_FATSz16         22
+#define BPB_SecPerTrk       24
+#define BPB_NumHeads        26
+#define BPB_HiddSec         28
+#define BPB_TotSec32        32
+#define BS_DrvNum           36
+#define BS_BootSig          38
+#define BS_VolID            39
+#define BS_VolLab           43
+#define BS_FilSysType       54
+#define BPB_FATSz32         36
+#define BPB_FSVer32         42
+#define BPB_RootClus32      44
+#define BPB_FSInfo32        48
+#define BPB_BkBootSec32     50
+#define BS_DrvNum32         64
+#define BS_BootSig32        66
+#define BS_VolID32          67
+#define BS_VolLab32         71
+#define BS_FilSysType32     82
+#define BS_55AA             510
+
+/* FSINFO */
+#define FSI_LeadSig         0
+#define FSI_StrucSig        484
+#define FSI_Free_Count      488
+#define FSI_Nxt_Free        492
+
+/* MBR partition entry */
+#define MBR_Table           446
+#define SZ_PTE              16
+#define PTE_StHead          1
+#define PTE_StSec           2
+#define PTE_System          4
+#define PTE_EdHead          5
+#define PTE_EdSec           6
+#define PTE_EdCyl           7
+#define PTE_StLba           8
+#define PTE_SizLba          12
+
+/* Directory entry */
+#define DIR_Name            0
+#define DIR_Attr            11
+#define DIR_CrtTime         14
+#define DIR_LstAccDate      18
+#define DIR_FstClusHI       20
+#define DIR_ModTime         22
+#define DIR_FstClusLO       26
+#define DIR_FileSize        28
+
+static FATFS *FatFs[_VOLUMES];      /* Mounted file systems */
+static WORD Fsid;                   /* Mount ID */
+static Disk_drvTypeDef disk;        /* Linked drivers, as ff_gen_drv.c keeps them */
+
+/* Byte order ----------------------------------------------------------------*/
+static WORD ld_word(const BYTE *p)
+{
+  return (WORD)(p[0] | (p[1] << 8));
+}
+
+static DWORD ld_dword(const BYTE *p)
+{
+  return (DWORD)p[0] | ((DWORD)p[1] << 8) | ((DWORD)p[2] << 16) | ((DWORD)p[3] << 24);
+}
+
+static void st_word(BYTE *p, WORD val)
+{
+  p[0] = (BYTE)val;
+  p[1] = (BYTE)(val >> 8);
+}
+
+static void st_dword(BYTE *p, DWORD val)
+{
+  p[0] = (BYTE)val;
+  p[1] = (BYTE)(val >> 8);
+  p[2] = (BYTE)(val >> 16);
+  p[3] = (BYTE)(val >> 24);
+}
+
+/* ff_gen_drv.c and diskio.c -------------------------------------------------*/
+uint8_t FATFS_LinkDriverEx(const Diskio_drvTypeDef *drv, char *path, uint8_t lun)
+{
+  if (disk.nbr >= _VOLUMES) return 1;
+  uint8_t n = disk.nbr++;
+
+  disk.is_initialized[n] = 0;
+  disk.drv[n] = drv;
+  disk.lun[n] = lun;
+  path[0] = (char)('0' + n);
+  path[1] = ':';
+  path[2] = '/';
+  path[3] = 0;
+  return 0;
+}
+
+uint8_t FATFS_LinkDriver(const Diskio_drvTypeDef *drv, char *path)
+{
+  return FATFS_LinkDriverEx(drv, path, 0);
+}
+
+uint8_t FATFS_UnLinkDriver(char *path)
+{
+  uint8_t n = (uint8_t)(path[0] - '0');
+
+  if (disk.nbr == 0 || n >= disk.nbr || !disk.drv[n]) return 1;
+  disk.drv[n] = 0;
+  disk.nbr--;
+  return 0;
+}
+
+uint8_t FATFS_GetAttachedDriversNbr(void)
+{
+  return disk.nbr;
+}
+
+DSTATUS disk_status(BYTE pdrv)
+{
+  if (pdrv >= _VOLUMES || !disk.drv[pdrv]) return STA_NOINIT;
+  return disk.drv[pdrv]->disk_status(disk.lun[pdrv]);
+}
+
+/* As Cube's diskio.c: the driver is initialised once, until it succeeds */
+DSTATUS disk_initialize(BYTE pdrv)
+{
+  DSTATUS stat = RES_OK;
+
+  if (pdrv >= _VOLUMES || !disk.drv[pdrv]) return STA_NOINIT;
+  if (disk.is_initialized[pdrv] == 0) {
+    stat = disk.drv[pdrv]->disk_initialize(disk.lun[pdrv]);
+    if (stat == RES_OK) disk.is_initialized[pdrv] = 1;
+  }
+  return stat;
+}
+
+DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+  return disk.drv[pdrv]->disk_read(disk.lun[pdrv], buff, sector, count);
+}
+
+DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+  return disk.drv[pdrv]->disk_write(disk.lun[pdrv], buff, sector, count);
+}
+
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+  return disk.drv[pdrv]->disk_ioctl(disk.lun[pdrv], cmd, buff);
+}
+
+/* The firmware has no RTC: the fixed date of _FS_NORTC */
+__attribute__((weak)) DWORD get_fattime(void)
+{
+  return ((DWORD)(_NORTC_YEAR - 1980) << 25) | ((DWORD)_NORTC_MON << 21) | ((DWORD)_NORTC_MDAY << 16);
+}
+
+/* Window --------------------------------------------------------------------*/
+static FRESULT sync_window(FATFS *fs)
+{
+  DWORD wsect = fs->winsect;
+
+  if (!fs->wflag) return FR_OK;
+  if (disk_write(fs->drv, fs->win, wsect, 1) != RES_OK) return FR_DISK_ERR;
+  fs->wflag = 0;
+  if (wsect - fs->fatbase < fs->fsize) {    /* A FAT sector: mirror it into the other FATs */
+    for (UINT nf = fs->n_fats; nf >= 2; nf--) {
+      wsect += fs->fsize;
+      disk_write(fs->drv, fs->win, wsect, 1);
+    }
+  }
+  return FR_OK;
+}
+
+static FRESULT move_window(FATFS *fs, DWORD sector)
+{
+  FRESULT res = FR_OK;
+
+  if (sector != fs->winsect) {
+    res = sync_window(fs);
+    if (res == FR_OK) {
+      if (disk_read(fs->drv, fs->win, sector, 1) != RES_OK) {
+        sector = 0xFFFFFFFF;              /* Invalidate the window */
+        res = FR_DISK_ERR;
+      }
+      fs->winsect = sector;
+    }
+  }
+  return res;
+}
+
+/* Window, FSINFO if the FAT changed, then CTRL_SYNC */
+static FRESULT sync_fs(FATFS *fs)
+{
+  FRESULT res = sync_window(fs);
+
+  if (res == FR_OK) {
+    if (fs->fs_type == FS_FAT32 && fs->fsi_flag == 1) {
+      memset(fs->win, 0, SS);
+      st_word(fs->win + BS_55AA, 0xAA55);
+      st_dword(fs->win + FSI_LeadSig, 0x41615252);
+      st_dword(fs->win + FSI_StrucSig, 0x61417272);
+      st_dword(fs->win + FSI_Free_Count, fs->free_clst);
+      st_dword(fs->win + FSI_Nxt_Free, fs->last_clst);
+      fs->winsect = fs->volbase + 1;
+      disk_write(fs->drv, fs->win, fs->winsect, 1);
+      fs->fsi_flag = 0;
+    }
+    if (disk_ioctl(fs->drv, CTRL_SYNC, 0) != RES_OK) res = FR_DISK_ERR;
+  }
+  return res;
+}
+
+/* FAT -----------------------------------------------------------------------*/
+static DWORD clust2sect(FATFS *fs, DWORD clst)
+{
+  clst -= 2;
+  if (clst >= fs->n_fatent - 2) return 0;
+  return clst * fs->csize + fs->database;
+}
+
+/* Next cluster in the chain: 1 for a bad argument, BAD_CLUST on disk error */
+static DWORD get_fat(FATFS *fs, DWORD clst)
+{
+  DWORD val = BAD_CLUST;
+  UINT bc, wc;
+
+  if (clst < 2 || clst >= fs->n_fatent) return 1;
+
+  switch (fs->fs_type) {
+  case FS_FAT12:
+    bc = (UINT)clst;
+    bc += bc / 2;
+    if (move_window(fs, fs->fatbase + (bc / SS)) != FR_OK) break;
+    wc = fs->win[bc++ % SS];
+    if (move_window(fs, fs->fatbase + (bc / SS)) != FR_OK) break;
+    wc |= fs->win[bc % SS] << 8;
+    val = (clst & 1) ? (wc >> 4) : (wc & 0xFFF);
+    break;
+  case FS_FAT16:
+    if (move_window(fs, fs->fatbase + (clst / (SS / 2))) != FR_OK) break;
+    val = ld_word(fs->win + clst * 2 % SS);
+    break;
+  case FS_FAT32:
+    if (move_window(fs, fs->fatbase + (clst / (SS / 4))) != FR_OK) break;
+    val = ld_dword(fs->win + clst * 4 % SS) & 0x0FFFFFFF;
+    break;
+  default:
+    val = 1;
+  }
+  return val;
+}
+
+static FRESULT put_fat(FATFS *fs, DWORD clst, DWORD val)
+{
+  FRESULT res = FR_INT_ERR;
+  UINT bc;
+  BYTE *p;
+
+  if (clst < 2 || clst >= fs->n_fatent) return res;
+
+  switch (fs->fs_type) {
+  case FS_FAT12:
+    bc = (UINT)clst;
+    bc += bc / 2;
+    res = move_window(fs, fs->fatbase + (bc / SS));
+    if (res != FR_OK) break;
+    p = fs->win + bc++ % SS;
+    *p = (clst & 1) ? ((*p & 0x0F) | ((BYTE)val << 4)) : (BYTE)val;
+    fs->wflag = 1;
+    res = move_window(fs, fs->fatbase + (bc / SS));
+    if (res != FR_OK) break;
+    p = fs->win + bc % SS;
+    *p = (clst & 1) ? (BYTE)(val >> 4) : ((*p & 0xF0) | ((BYTE)(val >> 8) & 0x0F));
+    fs->wflag = 1;
+    break;
+  case FS_FAT16:
+    res = move_window(fs, fs->fatbase + (clst / (SS / 2)));
+    if (res != FR_OK) break;
+    st_word(fs->win + clst * 2 % SS, (WORD)val);
+    fs->wflag = 1;
+    break;
+  case FS_FAT32:
+    res = move_window(fs, fs->fatbase + (clst / (SS / 4)));
+    if (res != FR_OK) break;
+    p = fs->win + clst * 4 % SS;
+    val = (val & 0x0FFFFFFF) | (ld_dword(p) & 0xF0000000);
+    st_dword(p, val);
+    fs->wflag = 1;
+    break;
+  }
+  return res;
+}
+
+/* Free the chain from clst; pclst, if not 0, becomes the end of what is left */
+static FRESULT remove_chain(FATFS *fs, DWORD clst, DWORD pclst)
+{
+  FRESULT res = FR_OK;
+  DWORD nxt;
+
+  if (clst < 2 || clst >= fs->n_fatent) return FR_INT_ERR;
+  if (pclst && (res = put_fat(fs, pclst, 0xFFFFFFFF)) != FR_OK) return res;
+
+  do {
+    nxt = get_fat(fs, clst);
+    if (nxt == 0) break;
+    if (nxt == 1) return FR_INT_ERR;
+    if (nxt == BAD_CLUST) return FR_DISK_ERR;
+    res = put_fat(fs, clst, 0);
+    if (res != FR_OK) return res;
+    if (fs->free_clst < fs->n_fatent - 2) {
+      fs->free_clst++;
+      fs->fsi_flag |= 1;
+    }
+    clst = nxt;
+  } while (clst < fs->n_fatent);
+  return FR_OK;
+}
+
+/* Cluster after clst, taking a free one if clst ends its chain (clst 0:
+   start a chain). 0: disk full, 1: internal error, BAD_CLUST: disk error */
+static DWORD create_chain(FATFS *fs, DWORD clst)
+{
+  DWORD cs, ncl, scl;
+  FRESULT res;
+
+  if (clst == 0) {
+    scl = fs->last_clst;
+    if (scl == 0 || scl >= fs->n_fatent) scl = 1;
+  } else {
+    cs = get_fat(fs, clst);
+    if (cs < 2) return 1;
+    if (cs == BAD_CLUST || cs < fs->n_fatent) return cs; /* Error, or already followed */
+    scl = clst;
+  }
+
+  ncl = scl;
+  for (;;) {
+    ncl++;
+    if (ncl >= fs->n_fatent) {
+      ncl = 2;
+      if (ncl > scl) return 0;
+    }
+    cs = get_fat(fs, ncl);
+    if (cs == 0) break;
+    if (cs == 1 || cs == BAD_CLUST) return cs;
+    if (ncl == scl) return 0;
+  }
+
+  res = put_fat(fs, ncl, 0xFFFFFFFF);
+  if (res == FR_OK && clst != 0) res = put_fat(fs, clst, ncl);
+  if (res != FR_OK) return (res == FR_DISK_ERR) ? BAD_CLUST : 1;
+
+  fs->last_clst = ncl;
+  if (fs->free_clst <= fs->n_fatent - 2) fs->free_clst--;
+  fs->fsi_flag |= 1;
+  return ncl;
+}
+
+/* Directories ---------------------------------------------------------------*/
+static DWORD ld_clust(FATFS *fs, const BYTE *dir)
+{
+  DWORD cl = ld_word(dir + DIR_FstClusLO);
+
+  if (fs->fs_type == FS_FAT32) cl |= (DWORD)ld_word(dir + DIR_FstClusHI) << 16;
+  return cl;
+}
+
+static void st_clust(FATFS *fs, BYTE *dir, DWORD cl)
+{
+  st_word(dir + DIR_FstClusLO, (WORD)cl);
+  if (fs->fs_type == FS_FAT32) st_word(dir + DIR_FstClusHI, (WORD)(cl >> 16));
+}
+
+/* Point dp at entry offset ofs */
+static FRESULT dir_sdi(DIR *dp, DWORD ofs)
+{
+  FATFS *fs = dp->obj.fs;
+  DWORD csz, clst;
+
+  dp->dptr = ofs;
+  clst = dp->obj.sclust;
+  if (clst == 0 && fs->fs_type >= FS_FAT32) clst = fs->dirbase;
+
+  if (clst == 0) {                      /* FAT12/16 root: a fixed run of sectors */
+    if (ofs / SZDIRE >= fs->n_rootdir) return FR_INT_ERR;
+    dp->sect = fs->dirbase;
+  } else {
+    csz = (DWORD)fs->csize * SS;
+    while (ofs >= csz) {
+      clst = get_fat(fs, clst);
+      if (clst == BAD_CLUST) return FR_DISK_ERR;
+      if (clst < 2 || clst >= fs->n_fatent) return FR_INT_ERR;
+      ofs -= csz;
+    }
+    dp->sect = clust2sect(fs, clst);
+  }
+  dp->clust = clst;
+  if (!dp->sect) return FR_INT_ERR;
+  dp->sect += ofs / SS;
+  dp->dir = fs->win + (ofs % SS);
+  return FR_OK;
+}
+
+/* Move to the next entry; stretch: add a cleared cluster at the end */
+static FRESULT dir_next(DIR *dp, int stretch)
+{
+  FATFS *fs = dp->obj.fs;
+  DWORD ofs = dp->dptr + SZDIRE;
+  DWORD clst;
+  UINT n;
+
+  if (!dp->sect || ofs >= 0x200000UL) return FR_NO_FILE;
+
+  if (ofs % SS == 0) {
+    dp->sect++;
+    if (!dp->clust) {
+      if (ofs / SZDIRE >= fs->n_rootdir) {
+        dp->sect = 0;
+        return FR_NO_FILE;
+      }
+    } else if ((ofs / SS & (fs->csize - 1U)) == 0) {
+      clst = get_fat(fs, dp->clust);
+      if (clst <= 1) return FR_INT_ERR;
+      if (clst == BAD_CLUST) return FR_DISK_ERR;
+      if (clst >= fs->n_fatent) {
+        if (!stretch) {
+          dp->sect = 0;
+          return FR_NO_FILE;
+        }
+        clst = create_chain(fs, dp->clust);
+        if (clst == 0) return FR_DENIED;
+        if (clst == 1) return FR_INT_ERR;
+        if (clst == BAD_CLUST) return FR_DISK_ERR;
+
+        if (sync_window(fs) != FR_OK) return FR_DISK_ERR;
+        memset(fs->win, 0, SS);
+        for (n = 0, fs->winsect = clust2sect(fs, clst); n < fs->csize; n++, fs->winsect++) {
+          fs->wflag = 1;
+          if (sync_window(fs) != FR_OK) return FR_DISK_ERR;
+        }
+        fs->winsect -= n;
+      }
+      dp->clust = clst;
+      dp->sect = clust2sect(fs, clst);
+    }
+  }
+  dp->dptr = ofs;
+  dp->dir = fs->win + ofs % SS;
+  return FR_OK;
+}
+
+/* Find a free entry */
+static FRESULT dir_alloc(DIR *dp)
+{
+  FRESULT res = dir_sdi(dp, 0);
+
+  while (res == FR_OK) {
+    res = move_window(dp->obj.fs, dp->sect);
+    if (res != FR_OK) break;
+    if (dp->dir[DIR_Name] == DDEM || dp->dir[DIR_Name] == 0) return FR_OK;
+    res = dir_next(dp, 1);
+  }
+  return (res == FR_NO_FILE) ? FR_DENIED : res;
+}
+
+/* Find dp->fn */
+static FRESULT dir_find(DIR *dp)
+{
+  FRESULT res = dir_sdi(dp, 0);
+
+  while (res == FR_OK) {
+    res = move_window(dp->obj.fs, dp->sect);
+    if (res != FR_OK) break;
+    if (dp->dir[DIR_Name] == 0) return FR_NO_FILE;
+    dp->obj.attr = dp->dir[DIR_Attr] & AM_MASK;
+    if (!(dp->dir[DIR_Attr] & AM_VOL) && memcmp(dp->dir, dp->fn, 11) == 0) return FR_OK;
+    res = dir_next(dp, 0);
+  }
+  return res;
+}
+
+/* Move to the next file or directory entry, from the current one */
+static FRESULT dir_read(DIR *dp)
+{
+  FRESULT res = FR_NO_FILE;
+
+  while (dp->sect) {
+    res = move_window(dp->obj.fs, dp->sect);
+    if (res != FR_OK) break;
+    BYTE c = dp->dir[DIR_Name];
+    if (c == 0) {
+      res = FR_NO_FILE;
+      break;
+    }
+    BYTE a = dp->dir[DIR_Attr] & AM_MASK;
+    dp->obj.attr = a;
+    if (c != DDEM && c != '.' && a != AM_LFN && (a & ~AM_ARC) != AM_VOL) break;
+    res = dir_next(dp, 0);
+    if (res != FR_OK) break;
+  }
+  if (res != FR_OK) dp->sect = 0;
+  return res;
+}
+
+static FRESULT dir_register(DIR *dp)
+{
+  FATFS *fs = dp->obj.fs;
+  FRESULT res = dir_alloc(dp);
+
+  if (res == FR_OK) {
+    res = move_window(fs, dp->sect);
+    if (res == FR_OK) {
+      memset(dp->dir, 0, SZDIRE);
+      memcpy(dp->dir + DIR_Name, dp->fn, 11);
+      fs->wflag = 1;
+    }
+  }
+  return res;
+}
+
+static void get_fileinfo(DIR *dp, FILINFO *fno)
+{
+  UINT i, j = 0;
+
+  fno->fname[0] = 0;
+  if (!dp->sect) return;
+
+  for (i = 0; i < 11; i++) {
+    TCHAR c = (TCHAR)dp->dir[i];
+    if (c == ' ') continue;
+    if (c == 0x05) c = (TCHAR)DDEM;
+    if (i == 8) fno->fname[j++] = '.';
+    fno->fname[j++] = c;
+  }
+  fno->fname[j] = 0;
+  fno->fattrib = dp->dir[DIR_Attr];
+  fno->fsize = ld_dword(dp->dir + DIR_FileSize);
+  fno->ftime = ld_word(dp->dir + DIR_ModTime);
+  fno->fdate = ld_word(dp->dir + DIR_ModTime + 2);
+}
+
+/* Paths ---------------------------------------------------------------------*/
+/* Next path segment as an upper case 8.3 name in dp->fn */
+static FRESULT create_name(DIR *dp, const TCHAR **path)
+{
+  BYTE *sfn = dp->fn;
+  const TCHAR *p = *path;
+  UINT ni = 8, si = 0, i = 0;
+  BYTE c;
+
+  memset(sfn, ' ', 11);
+  for (;;) {
+    c = (BYTE)p[si++];
+    if (c <= ' ') break;
+    if (c == '/' || c == '\\') {
+      while (p[si] == '/' || p[si] == '\\') si++;
+      break;
+    }
+    if (c == '.' || i >= ni) {
+      if (ni == 11 || c != '.') return FR_INVALID_NAME;
+      i = 8;
+      ni = 11;
+      continue;
+    }
+    /* Code page 850 upper-casing is not modelled: ASCII names only */
+    if (c >= 0x80 || strchr("\"*+,:;<=>?[]|\x7F", c)) return FR_INVALID_NAME;
+    if (c >= 'a' && c <= 'z') c -= 0x20;
+    sfn[i++] = c;
+  }
+  *path = p + si;
+  if (i == 0) return FR_INVALID_NAME;
+  if (sfn[0] == DDEM) sfn[0] = 0x05;
+  sfn[NSFLAG] = (c <= ' ') ? NS_LAST : 0;
+  return FR_OK;
+}
+
+/* Find the object path names, leaving dp on its entry */
+static FRESULT follow_path(DIR *dp, const TCHAR *path)
+{
+  FATFS *fs = dp->obj.fs;
+  FRESULT res;
+
+  while (*path == '/' || *path == '\\') path++;
+  dp->obj.sclust = 0;
+
+  if ((UINT)*path < ' ') {
+    dp->fn[NSFLAG] = NS_NONAME;
+    return dir_sdi(dp, 0);
+  }
+  for (;;) {
+    res = create_name(dp, &path);
+    if (res != FR_OK) break;
+    res = dir_find(dp);
+    BYTE ns = dp->fn[NSFLAG];
+    if (res != FR_OK) {
+      if (res == FR_NO_FILE && !(ns & NS_LAST)) res = FR_NO_PATH;
+      break;
+    }
+    if (ns & NS_LAST) break;
+    if (!(dp->obj.attr & AM_DIR)) {
+      res = FR_NO_PATH;
+      break;
+    }
+    dp->obj.sclust = ld_clust(fs, fs->win + dp->dptr % SS);
+  }
+  return res;
+}
+
+/* Drive number of a path, skipping its "N:" prefix; -1: no such drive */
+static int get_ldnumber(const TCHAR **path)
+{
+  const TCHAR *tp = *path, *tt;
+
+  if (!tp) return -1;
+  for (tt = tp; (UINT)*tt >= '!' && *tt != ':'; tt++) ;
+  if (*tt != ':') return 0;
+  if (tt != tp + 1 || *tp < '0' || *tp - '0' >= _VOLUMES) return -1;
+  *path = tt + 1;
+  return *tp - '0';
+}
+
+/* Volume ----------------------------------------------------------------------*/
+/* 0: FAT boot sector, 2: valid sector but not FAT, 3: not valid, 4: disk error */
+static UINT check_fs(FATFS *fs, DWORD sect)
+{
+  fs->wflag = 0;
+  fs->winsect = 0xFFFFFFFF;
+  if (move_window(fs, sect) != FR_OK) return 4;
+  if (ld_word(fs->win + BS_55AA) != 0xAA55) return 3;
+  if (fs->win[BS_JmpBoot] == 0xE9 || (fs->win[BS_JmpBoot] == 0xEB && fs->win[BS_JmpBoot + 2] == 0x90)) {
+    if ((ld_dword(fs->win + BS_FilSysType) & 0xFFFFFF) == 0x544146) return 0;   /* "FAT" */
+    if (ld_dword(fs->win + BS_FilSysType32) == 0x33544146) return 0;            /* "FAT3" */
+  }
+  return 2;
+}
+
+/* Mount the volume of path if it is not, leaving path past the drive */
+static FRESULT find_volume(const TCHAR **path, FATFS **rfs, BYTE mode)
+{
+  DSTATUS stat;
+  DWORD bsect, fasize, tsect, sysect, nclst, szbfat;
+  WORD nrsv;
+  UINT fmt;
+  FATFS *fs;
+  int vol;
+
+  *rfs = 0;
+  vol = get_ldnumber(path);
+  if (vol < 0) return FR_INVALID_DRIVE;
+  fs = FatFs[vol];
+  if (!fs) return FR_NOT_ENABLED;
+  *rfs = fs;
+
+  mode &= (BYTE)~FA_READ;
+  if (fs->fs_type) {
+    stat = disk_status(fs->drv);
+    if (!(stat & STA_NOINIT)) {
+      if (mode && (stat & STA_PROTECT)) return FR_WRITE_PROTECTED;
+      return FR_OK;
+    }
+  }
+
+  fs->fs_type = 0;
+  fs->drv = (BYTE)vol;
+  stat = disk_initialize(fs->drv);
+  if (stat & STA_NOINIT) return FR_NOT_READY;
+  if (mode && (stat & STA_PROTECT)) return FR_WRITE_PROTECTED;
+
+  /* A boot sector at 0, or the first FAT partition of an MBR */
+  bsect = 0;
+  fmt = check_fs(fs, bsect);
+  if (fmt == 2) {
+    DWORD br[4];
+    UINT i;
+
+    for (i = 0; i < 4; i++) br[i] = ld_dword(fs->win + MBR_Table + i * SZ_PTE + PTE_StLba);
+    i = 0;
+    do {
+      bsect = br[i];
+      fmt = bsect ? check_fs(fs, bsect) : 3;
+    } while (fmt >= 2 && ++i < 4);
+  }
+  if (fmt == 4) return FR_DISK_ERR;
+  if (fmt >= 2) return FR_NO_FILESYSTEM;
+
+  if (ld_word(fs->win + BPB_BytsPerSec) != SS) return FR_NO_FILESYSTEM;
+  fasize = ld_word(fs->win + BPB_FATSz16);
+  if (fasize == 0) fasize = ld_dword(fs->win + BPB_FATSz32);
+  fs->fsize = fasize;
+  fs->n_fats = fs->win[BPB_NumFATs];
+  if (fs->n_fats != 1 && fs->n_fats != 2) return FR_NO_FILESYSTEM;
+  fasize *= fs->n_fats;
+  fs->csize = fs->win[BPB_SecPerClus];
+  if (fs->csize == 0 || (fs->csize & (fs->csize - 1))) return FR_NO_FILESYSTEM;
+  fs->n_rootdir = ld_word(fs->win + BPB_RootEntCnt);
+  if (fs->n_rootdir % (SS / SZDIRE)) return FR_NO_FILESYSTEM;
+  tsect = ld_word(fs->win + BPB_TotSec16);
+  if (tsect == 0) tsect = ld_dword(fs->win + BPB_TotSec32);
+  nrsv = ld_word(fs->win + BPB_RsvdSecCnt);
+  if (nrsv == 0) return FR_NO_FILESYSTEM;
+
+  sysect = nrsv + fasize + fs->n_rootdir / (SS / SZDIRE);
+  if (tsect < sysect) return FR_NO_FILESYSTEM;
+  nclst = (tsect - sysect) / fs->csize;
+  if (nclst == 0) return FR_NO_FILESYSTEM;
+  fmt = FS_FAT32;
+  if (nclst <= MAX_FAT16) fmt = FS_FAT16;
+  if (nclst <= MAX_FAT12) fmt = FS_FAT12;
+
+  fs->n_fatent = nclst + 2;
+  fs->volbase = bsect;
+  fs->fatbase = bsect + nrsv;
+  fs->database = bsect + sysect;
+  if (fmt == FS_FAT32) {
+    if (ld_word(fs->win + BPB_FSVer32) != 0 || fs->n_rootdir) return FR_NO_FILESYSTEM;
+    fs->dirbase = ld_dword(fs->win + BPB_RootClus32);
+    szbfat = fs->n_fatent * 4;
+  } else {
+    if (fs->n_rootdir == 0) return FR_NO_FILESYSTEM;
+    fs->dirbase = fs->fatbase + fasize;
+    szbfat = (fmt == FS_FAT16) ? fs->n_fatent * 2 : fs->n_fatent * 3 / 2 + (fs->n_fatent & 1);
+  }
+  if (fs->fsize < (szbfat + (SS - 1)) / SS) return FR_NO_FILESYSTEM;
+
+  /* Free cluster count and next free from FSINFO, if it is there */
+  fs->last_clst = fs->free_clst = 0xFFFFFFFF;
+  fs->fsi_flag = 0x80;
+  if (fmt == FS_FAT32 && ld_word(fs->win + BPB_FSInfo32) == 1 && move_window(fs, bsect + 1) == FR_OK) {
+    fs->fsi_flag = 0;
+    if (ld_word(fs->win + BS_55AA) == 0xAA55 &&
+        ld_dword(fs->win + FSI_LeadSig) == 0x41615252 &&
+        ld_dword(fs->win + FSI_StrucSig) == 0x61417272) {
+      fs->free_clst = ld_dword(fs->win + FSI_Free_Count);
+      fs->last_clst = ld_dword(fs->win + FSI_Nxt_Free);
+    }
+  }
+  fs->fs_type = (BYTE)fmt;
+  fs->id = ++Fsid;
+  return FR_OK;
+}
+
+/* The object's volume, if it is still the one the object was opened on */
+static FRESULT validate(_FDID *obj, FATFS **fs)
+{
+  if (!obj || !obj->fs || !obj->fs->fs_type || obj->id != obj->fs->id ||
+      (disk_status(obj->fs->drv) & STA_NOINIT)) {
+    *fs = 0;
+    return FR_INVALID_OBJECT;
+  }
+  *fs = obj->fs;
+  return FR_OK;
+}
+
+FRESULT f_mount(FATFS *fs, const TCHAR *path, BYTE opt)
+{
+  const TCHAR *rp = path;
+  int vol = get_ldnumber(&rp);
+
+  if (vol < 0) return FR_INVALID_DRIVE;
+  if (FatFs[vol]) FatFs[vol]->fs_type = 0;
+  if (fs) fs->fs_type = 0;
+  FatFs[vol] = fs;
+  if (!fs || opt != 1) return FR_OK;
+
+  FATFS *mfs;
+  return find_volume(&path, &mfs, 0);
+}
+
+/* Files ---------------------------------------------------------------------*/
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode)
+{
+  FRESULT res;
+  DIR dj;
+  FATFS *fs;
+  DWORD dw, cl, bcs, clst, sc;
+  FSIZE_t ofs;
+
+  if (!fp) return FR_INVALID_OBJECT;
+  mode &= FA_READ | FA_WRITE | FA_CREATE_ALWAYS | FA_CREATE_NEW | FA_OPEN_ALWAYS | FA_OPEN_APPEND | FA_SEEKEND;
+  res = find_volume(&path, &fs, mode);
+  if (res == FR_OK) {
+    dj.obj.fs = fs;
+    res = follow_path(&dj, path);
+    if (res == FR_OK && (dj.fn[NSFLAG] & NS_NONAME)) res = FR_INVALID_NAME;
+
+    if (mode & (FA_CREATE_ALWAYS | FA_OPEN_ALWAYS | FA_CREATE_NEW)) {
+      if (res != FR_OK) {
+        if (res == FR_NO_FILE) res = dir_register(&dj);
+        mode |= FA_CREATE_ALWAYS;
+      } else if (dj.obj.attr & (AM_RDO | AM_DIR)) {
+        res = FR_DENIED;
+      } else if (mode & FA_CREATE_NEW) {
+        res = FR_EXIST;
+      }
+      if (res == FR_OK && (mode & FA_CREATE_ALWAYS)) {
+        /* Empty the entry, and free the clusters an existing file had */
+        dw = get_fattime();
+        st_dword(dj.dir + DIR_CrtTime, dw);
+        st_dword(dj.dir + DIR_ModTime, dw);
+        dj.dir[DIR_Attr] = AM_ARC;
+        cl = ld_clust(fs, dj.dir);
+        st_clust(fs, dj.dir, 0);
+        st_dword(dj.dir + DIR_FileSize, 0);
+        fs->wflag = 1;
+        if (cl) {
+          dw = fs->winsect;
+          res = remove_chain(fs, cl, 0);
+          if (res == FR_OK) {
+            res = move_window(fs, dw);
+            fs->last_clst = cl - 1;
+          }
+        }
+      }
+    } else if (res == FR_OK) {
+      if (dj.obj.attr & AM_DIR) res = FR_NO_FILE;
+      else if ((mode & FA_WRITE) && (dj.obj.attr & AM_RDO)) res = FR_DENIED;
+    }
+
+    if (res == FR_OK) {
+      if (mode & FA_CREATE_ALWAYS) mode |= FA_MODIFIED;
+      fp->dir_sect = fs->winsect;
+      fp->dir_ptr = dj.dir;
+      fp->obj.sclust = ld_clust(fs, dj.dir);
+      fp->obj.objsize = ld_dword(dj.dir + DIR_FileSize);
+#if _USE_FASTSEEK
+      fp->cltbl = 0;
+#endif
+      fp->obj.fs = fs;
+      fp->obj.id = fs->id;
+      fp->obj.attr = dj.obj.attr;
+      fp->obj.stat = 0;
+      fp->flag = mode;
+      fp->err = 0;
+      fp->sect = 0;
+      fp->fptr = 0;
+      memset(fp->buf, 0, sizeof(fp->buf));
+
+      if ((mode & FA_SEEKEND) && fp->obj.objsize > 0) {
+        /* Follow the chain to the end, and load a part filled last sector */
+        fp->fptr = fp->obj.objsize;
+        bcs = (DWORD)fs->csize * SS;
+        clst = fp->obj.sclust;
+        for (ofs = fp->obj.objsize; res == FR_OK && ofs > bcs; ofs -= bcs) {
+          clst = get_fat(fs, clst);
+          if (clst <= 1) res = FR_INT_ERR;
+          if (clst == BAD_CLUST) res = FR_DISK_ERR;
+        }
+        fp->clust = clst;
+        if (res == FR_OK && ofs % SS) {
+          if ((sc = clust2sect(fs, clst)) == 0) {
+            res = FR_INT_ERR;
+          } else {
+            fp->sect = sc + (DWORD)(ofs / SS);
+            if (disk_read(fs->drv, fp->buf, fp->sect, 1) != RES_OK) res = FR_DISK_ERR;
+          }
+        }
+      }
+    }
+  }
+  if (res != FR_OK) fp->obj.fs = 0;
+  return res;
+}
+
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br)
+{
+  FATFS *fs;
+  FRESULT res;
+  DWORD clst, sect;
+  FSIZE_t remain;
+  UINT rcnt, cc, csect;
+  BYTE *rbuff = (BYTE *)buff;
+
+  *br = 0;
+  res = validate(&fp->obj, &fs);
+  if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) return res;
+  if (!(fp->flag & FA_READ)) return FR_DENIED;
+
+  remain = fp->obj.objsize - fp->fptr;
+  if (btr > remain) btr = (UINT)remain;
+
+  for (; btr; rbuff += rcnt, fp->fptr += rcnt, *br += rcnt, btr -= rcnt) {
+    if (fp->fptr % SS == 0) {
+      csect = (UINT)(fp->fptr / SS & (fs->csize - 1U));
+      if (csect == 0) {
+        clst = (fp->fptr == 0) ? fp->obj.sclust : get_fat(fs, fp->clust);
+        if (clst < 2) return fp->err = FR_INT_ERR;
+        if (clst == BAD_CLUST) return fp->err = FR_DISK_ERR;
+        fp->clust = clst;
+      }
+      sect = clust2sect(fs, fp->clust);
+      if (!sect) return fp->err = FR_INT_ERR;
+      sect += csect;
+
+      cc = btr / SS;
+      if (cc) {
+        /* Whole sectors straight into the caller's buffer */
+        if (csect + cc > fs->csize) cc = fs->csize - csect;
+        if (disk_read(fs->drv, rbuff, sect, cc) != RES_OK) return fp->err = FR_DISK_ERR;
+        if ((fp->flag & FA_DIRTY) && fp->sect - sect < cc) {
+          memcpy(rbuff + (fp->sect - sect) * SS, fp->buf, SS);
+        }
+        rcnt = SS * cc;
+        continue;
+      }
+      if (fp->sect != sect) {
+        if (fp->flag & FA_DIRTY) {
+          if (disk_write(fs->drv, fp->buf, fp->sect, 1) != RES_OK) return fp->err = FR_DISK_ERR;
+          fp->flag &= (BYTE)~FA_DIRTY;
+        }
+        if (disk_read(fs->drv, fp->buf, sect, 1) != RES_OK) return fp->err = FR_DISK_ERR;
+      }
+      fp->sect = sect;
+    }
+    rcnt = SS - (UINT)(fp->fptr % SS);
+    if (rcnt > btr) rcnt = btr;
+    memcpy(rbuff, fp->buf + fp->fptr % SS, rcnt);
+  }
+  return FR_OK;
+}
+
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw)
+{
+  FATFS *fs;
+  FRESULT res;
+  DWORD clst, sect;
+  UINT wcnt, cc, csect;
+  const BYTE *wbuff = (const BYTE *)buff;
+
+  *bw = 0;
+  res = validate(&fp->obj, &fs);
+  if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) return res;
+  if (!(fp->flag & FA_WRITE)) return FR_DENIED;
+
+  /* File size stays within 4 GB */
+  if (fp->fptr + btw > 0xFFFFFFFF) btw = (UINT)(0xFFFFFFFF - fp->fptr);
+
+  for (; btw; wbuff += wcnt, fp->fptr += wcnt, *bw += wcnt, btw -= wcnt,
+       fp->obj.objsize = (fp->fptr > fp->obj.objsize) ? fp->fptr : fp->obj.objsize) {
+    if (fp->fptr % SS == 0) {
+      csect = (UINT)(fp->fptr / SS & (fs->csize - 1U));
+      if (csect == 0) {
+        if (fp->fptr == 0) {
+          clst = fp->obj.sclust;
+          if (clst == 0) clst = create_chain(fs, 0);
+        } else {
+          clst = create_chain(fs, fp->clust);
+        }
+        if (clst == 0) break;                 /* Disk full */
+        if (clst == 1) return fp->err = FR_INT_ERR;
+        if (clst == BAD_CLUST) return fp->err = FR_DISK_ERR;
+        fp->clust = clst;
+        if (fp->obj.sclust == 0) fp->obj.sclust = clst;
+      }
+      if (fp->flag & FA_DIRTY) {
+        if (disk_write(fs->drv, fp->buf, fp->sect, 1) != RES_OK) return fp->err = FR_DISK_ERR;
+        fp->flag &= (BYTE)~FA_DIRTY;
+      }
+      sect = clust2sect(fs, fp->clust);
+      if (!sect) return fp->err = FR_INT_ERR;
+      sect += csect;
+
+      cc = btw / SS;
+      if (cc) {
+        /* Whole sectors straight from the caller's buffer */
+        if (csect + cc > fs->csize) cc = fs->csize - csect;
+        if (disk_write(fs->drv, wbuff, sect, cc) != RES_OK) return fp->err = FR_DISK_ERR;
+        if (fp->sect - sect < cc) {
+          memcpy(fp->buf, wbuff + (fp->sect - sect) * SS, SS);
+          fp->flag &= (BYTE)~FA_DIRTY;
+        }
+        wcnt = SS * cc;
+        continue;
+      }
+      if (fp->sect != sect && fp->fptr < fp->obj.objsize) {
+        if (disk_read(fs->drv, fp->buf, sect, 1) != RES_OK) return fp->err = FR_DISK_ERR;
+      }
+      fp->sect = sect;
+    }
+    wcnt = SS - (UINT)(fp->fptr % SS);
+    if (wcnt > btw) wcnt = btw;
+    memcpy(fp->buf + fp->fptr % SS, wbuff, wcnt);
+    fp->flag |= FA_DIRTY;
+  }
+  fp->flag |= FA_MODIFIED;
+  return FR_OK;
+}
+
+FRESULT f_sync(FIL *fp)
+{
+  FATFS *fs;
+  FRESULT res = validate(&fp->obj, &fs);
+
+  if (res == FR_OK && (fp->flag & FA_MODIFIED)) {
+    if (fp->flag & FA_DIRTY) {
+      if (disk_write(fs->drv, fp->buf, fp->sect, 1) != RES_OK) return FR_DISK_ERR;
+      fp->flag &= (BYTE)~FA_DIRTY;
+    }
+    /* The directory entry: size, first cluster, time */
+    res = move_window(fs, fp->dir_sect);
+    if (res == FR_OK) {
+      BYTE *dir = fp->dir_ptr;
+      dir[DIR_Attr] |= AM_ARC;
+      st_clust(fs, dir, fp->obj.sclust);
+      st_dword(dir + DIR_FileSize, (DWORD)fp->obj.objsize);
+      st_dword(dir + DIR_ModTime, get_fattime());
+      st_word(dir + DIR_LstAccDate, 0);
+      fs->wflag = 1;
+      res = sync_fs(fs);
+      fp->flag &= (BYTE)~FA_MODIFIED;
+    }
+  }
+  return res;
+}
+
+FRESULT f_close(FIL *fp)
+{
+  FATFS *fs;
+  FRESULT res = f_sync(fp);
+
+  if (res == FR_OK) {
+    res = validate(&fp->obj, &fs);
+    if (res == FR_OK) fp->obj.fs = 0;
+  }
+  return res;
+}
+
+FRESULT f_lseek(FIL *fp, FSIZE_t ofs)
+{
+  FATFS *fs;
+  FRESULT res;
+  DWORD clst, bcs, nsect = 0;
+  FSIZE_t ifptr;
+
+  res = validate(&fp->obj, &fs);
+  if (res == FR_OK) res = (FRESULT)fp->err;
+  if (res != FR_OK) return res;
+
+  if (ofs > fp->obj.objsize && !(fp->flag & FA_WRITE)) ofs = fp->obj.objsize;
+  ifptr = fp->fptr;
+  fp->fptr = 0;
+  if (ofs > 0) {
+    bcs = (DWORD)fs->csize * SS;
+    if (ifptr > 0 && (ofs - 1) / bcs >= (ifptr - 1) / bcs) {
+      /* Forward within or past the current cluster: start from it */
+      fp->fptr = (ifptr - 1) & ~(FSIZE_t)(bcs - 1);
+      ofs -= fp->fptr;
+      clst = fp->clust;
+    } else {
+      clst = fp->obj.sclust;
+      if (clst == 0) {
+        clst = create_chain(fs, 0);
+        if (clst == 1) return fp->err = FR_INT_ERR;
+        if (clst == BAD_CLUST) return fp->err = FR_DISK_ERR;
+        fp->obj.sclust = clst;
+      }
+      fp->clust = clst;
+    }
+    if (clst != 0) {
+      while (ofs > bcs) {
+        ofs -= bcs;
+        fp->fptr += bcs;
+        if (fp->flag & FA_WRITE) {
+          clst = create_chain(fs, clst);      /* Stretches the file if need be */
+          if (clst == 0) {
+            ofs = 0;
+            break;
+          }
+        } else {
+          clst = get_fat(fs, clst);
+        }
+        if (clst == BAD_CLUST) return fp->err = FR_DISK_ERR;
+        if (clst <= 1 || clst >= fs->n_fatent) return fp->err = FR_INT_ERR;
+        fp->clust = clst;
+      }
+      fp->fptr += ofs;
+      if (ofs % SS) {
+        nsect = clust2sect(fs, clst);
+        if (!nsect) return fp->err = FR_INT_ERR;
+        nsect += (DWORD)(ofs / SS);
+      }
+    }
+  }
+  if (fp->fptr > fp->obj.objsize) {
+    fp->obj.objsize = fp->fptr;
+    fp->flag |= FA_MODIFIED;
+  }
+  if (fp->fptr % SS && nsect != fp->sect) {
+    if (fp->flag & FA_DIRTY) {
+      if (disk_write(fs->drv, fp->buf, fp->sect, 1) != RES_OK) return fp->err = FR_DISK_ERR;
+      fp->flag &= (BYTE)~FA_DIRTY;
+    }
+    if (disk_read(fs->drv, fp->buf, nsect, 1) != RES_OK) return fp->err = FR_DISK_ERR;
+    fp->sect = nsect;
+  }
+  return FR_OK;
+}
+
+FRESULT f_truncate(FIL *fp)
+{
+  FATFS *fs;
+  FRESULT res;
+  DWORD ncl;
+
+  res = validate(&fp->obj, &fs);
+  if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) return res;
+  if (!(fp->flag & FA_WRITE)) return FR_DENIED;
+
+  if (fp->fptr < fp->obj.objsize) {
+    if (fp->fptr == 0) {
+      res = remove_chain(fs, fp->obj.sclust, 0);
+      fp->obj.sclust = 0;
+    } else {
+      ncl = get_fat(fs, fp->clust);
+      res = FR_OK;
+      if (ncl == BAD_CLUST) res = FR_DISK_ERR;
+      if (ncl == 1) res = FR_INT_ERR;
+      if (res == FR_OK && ncl < fs->n_fatent) res = remove_chain(fs, ncl, fp->clust);
+    }
+    fp->obj.objsize = fp->fptr;
+    fp->flag |= FA_MODIFIED;
+    if (res == FR_OK && (fp->flag & FA_DIRTY)) {
+      if (disk_write(fs->drv, fp->buf, fp->sect, 1) != RES_OK) {
+        res = FR_DISK_ERR;
+      } else {
+        fp->flag &= (BYTE)~FA_DIRTY;
+      }
+    }
+    if (res != FR_OK) return fp->err = res;
+  }
+  return FR_OK;
+}
+
+/* Give an empty file fsz bytes of contiguous clusters (opt 1), or find
+   where they would be (opt 0) */
+FRESULT f_expand(FIL *fp, FSIZE_t fsz, BYTE opt)
+{
+  FATFS *fs;
+  FRESULT res;
+  DWORD n, clst, stcl, scl, ncl, tcl, lclst = 0;
+
+  res = validate(&fp->obj, &fs);
+  if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) return res;
+  if (fsz == 0 || fp->obj.objsize != 0 || !(fp->flag & FA_WRITE)) return FR_DENIED;
+
+  n = (DWORD)fs->csize * SS;
+  tcl = (DWORD)(fsz / n) + ((fsz & (n - 1)) ? 1 : 0);
+  stcl = fs->last_clst;
+  if (stcl < 2 || stcl >= fs->n_fatent) stcl = 2;
+
+  /* First run of tcl free clusters from the last allocated one */
+  ncl = 0;
+  scl = clst = stcl;
+  for (;;) {
+    DWORD cs = get_fat(fs, clst);
+    if (++clst >= fs->n_fatent) clst = 2;
+    if (cs == 1) {
+      res = FR_INT_ERR;
+      break;
+    }
+    if (cs == BAD_CLUST) {
+      res = FR_DISK_ERR;
+      break;
+    }
+    if (cs == 0) {
+      if (++ncl == tcl) break;
+    } else {
+      scl = clst;
+      ncl = 0;
+    }
+    if (clst == stcl) {
+      res = FR_DENIED;
+      break;
+    }
+  }
+  if (res == FR_OK) {
+    if (opt) {
+      for (clst = scl, n = tcl; n; clst++, n--) {
+        res = put_fat(fs, clst, (n == 1) ? 0xFFFFFFFF : clst + 1);
+        if (res != FR_OK) break;
+        lclst = clst;
+      }
+    } else {
+      lclst = scl + tcl - 1;
+    }
+  }
+  if (res == FR_OK) {
+    fs->last_clst = lclst;
+    if (opt) {
+      fp->obj.sclust = scl;
+      fp->obj.objsize = fsz;
+      fp->flag |= FA_MODIFIED;
+      if (fs->free_clst < fs->n_fatent - 2) {
+        fs->free_clst -= tcl;
+        fs->fsi_flag |= 1;
+      }
+    }
+  }
+  return res;
+}
+
+/* Directories and names -----------------------------------------------------*/
+FRESULT f_opendir(DIR *dp, const TCHAR *path)
+{
+  FRESULT res;
+  FATFS *fs;
+
+  if (!dp) return FR_INVALID_OBJECT;
+  res = find_volume(&path, &fs, 0);
+  if (res == FR_OK) {
+    dp->obj.fs = fs;
+    res = follow_path(dp, path);
+    if (res == FR_OK) {
+      if (!(dp->fn[NSFLAG] & NS_NONAME)) {
+        if (dp->obj.attr & AM_DIR) {
+          dp->obj.sclust = ld_clust(fs, dp->dir);
+        } else {
+          res = FR_NO_PATH;
+        }
+      }
+      if (res == FR_OK) {
+        dp->obj.id = fs->id;
+        res = dir_sdi(dp, 0);
+      }
+    }
+    if (res == FR_NO_FILE) res = FR_NO_PATH;
+  }
+  if (res != FR_OK) dp->obj.fs = 0;
+  return res;
+}
+
+FRESULT f_closedir(DIR *dp)
+{
+  FATFS *fs;
+  FRESULT res = validate(&dp->obj, &fs);
+
+  if (res == FR_OK) dp->obj.fs = 0;
+  return res;
+}
+
+/* Next entry into fno; fname[0] is 0 at the end. fno NULL: rewind */
+FRESULT f_readdir(DIR *dp, FILINFO *fno)
+{
+  FATFS *fs;
+  FRESULT res = validate(&dp->obj, &fs);
+
+  if (res != FR_OK) return res;
+  if (!fno) return dir_sdi(dp, 0);
+
+  res = dir_read(dp);
+  if (res == FR_NO_FILE) res = FR_OK;
+  if (res == FR_OK) {
+    get_fileinfo(dp, fno);
+    res = dir_next(dp, 0);
+    if (res == FR_NO_FILE) res = FR_OK;
+  }
+  return res;
+}
+
+FRESULT f_stat(const TCHAR *path, FILINFO *fno)
+{
+  FRESULT res;
+  DIR dj;
+
+  res = find_volume(&path, &dj.obj.fs, 0);
+  if (res == FR_OK) {
+    res = follow_path(&dj, path);
+    if (res == FR_OK) {
+      if (dj.fn[NSFLAG] & NS_NONAME) res = FR_INVALID_NAME;
+      else if (fno) get_fileinfo(&dj, fno);
+    }
+  }
+  return res;
+}
+
+/* Free clusters, counted from the FAT unless FSINFO gave a count */
+FRESULT f_getfree(const TCHAR *path, DWORD *nclst, FATFS **fatfs)
+{
+  FRESULT res;
+  FATFS *fs;
+  DWORD nfree = 0, clst, stat;
+
+  res = find_volume(&path, &fs, 0);
+  if (res != FR_OK) return res;
+  *fatfs = fs;
+  if (fs->free_clst <= fs->n_fatent - 2) {
+    *nclst = fs->free_clst;
+    return FR_OK;
+  }
+  for (clst = 2; clst < fs->n_fatent; clst++) {
+    stat = get_fat(fs, clst);
+    if (stat == BAD_CLUST) return FR_DISK_ERR;
+    if (stat == 1) return FR_INT_ERR;
+    if (stat == 0) nfree++;
+  }
+  *nclst = nfree;
+  fs->free_clst = nfree;
+  fs->fsi_flag |= 1;
+  return FR_OK;
+}
+
+FRESULT f_unlink(const TCHAR *path)
+{
+  FRESULT res;
+  DIR dj;
+  FATFS *fs;
+  DWORD dclst = 0;
+
+  res = find_volume(&path, &fs, FA_WRITE);
+  dj.obj.fs = fs;
+  if (res == FR_OK) {
+    res = follow_path(&dj, path);
+    if (res == FR_OK) {
+      if (dj.fn[NSFLAG] & NS_NONAME) {
+        res = FR_INVALID_NAME;
+      } else if (dj.obj.attr & AM_RDO) {
+        res = FR_DENIED;
+      } else {
+        dclst = ld_clust(fs, dj.dir);
+        if (dj.obj.attr & AM_DIR) res = FR_DENIED;  /* Directories are not removed here */
+      }
+    }
+    if (res == FR_OK) {
+      res = move_window(fs, dj.sect);
+      if (res == FR_OK) {
+        dj.dir[DIR_Name] = DDEM;
+        fs->wflag = 1;
+        if (dclst) res = remove_chain(fs, dclst, 0);
+        if (res == FR_OK) res = sync_fs(fs);
+      }
+    }
+  }
+  return res;
+}
+
+/* Format ----------------------------------------------------------------------*/
+FRESULT f_mkfs(const TCHAR *path, BYTE opt, DWORD au, void *work, UINT len)
+{
+  static const WORD cst[] = { 1, 4, 16, 64, 256, 512, 0 };  /* Cluster size boundaries, FAT12/16 (4K sectors) */
+  static const WORD cst32[] = { 1, 2, 4, 8, 16, 32, 0 };    /* FAT32 (128K sectors) */
+  BYTE fmt, sys, *buf, *pte, pdrv;
+  DWORD sz_buf, sz_blk, n_clst, pau, sect, nsect, n;
+  DWORD b_vol, b_fat, b_data, sz_vol, sz_rsv, sz_fat, sz_dir;
+  UINT i;
+  int vol;
+  DSTATUS stat;
+
+  vol = get_ldnumber(&path);
+  if (vol < 0) return FR_INVALID_DRIVE;
+  if (FatFs[vol]) FatFs[vol]->fs_type = 0;
+  pdrv = (BYTE)vol;
+
+  stat = disk_initialize(pdrv);
+  if (stat & STA_NOINIT) return FR_NOT_READY;
+  if (stat & STA_PROTECT) return FR_WRITE_PROTECTED;
+  if (disk_ioctl(pdrv, GET_BLOCK_SIZE, &sz_blk) != RES_OK || !sz_blk || sz_blk > 32768 || (sz_blk & (sz_blk - 1))) {
+    sz_blk = 1;
+  }
+  if (au & (au - 1)) au = 0;
+  au /= SS;
+
+  buf = (BYTE *)work;
+  sz_buf = len / SS;
+  if (!sz_buf) return FR_NOT_ENOUGH_CORE;
+
+  if (disk_ioctl(pdrv, GET_SECTOR_COUNT, &sz_vol) != RES_OK) return FR_DISK_ERR;
+  b_vol = (opt & FM_SFD) ? 0 : 63;
+  if (sz_vol < b_vol) return FR_MKFS_ABORTED;
+  sz_vol -= b_vol;
+  if (sz_vol < 128) return FR_MKFS_ABORTED;
+
+  if (au > 128) return FR_INVALID_PARAMETER;
+  if ((opt & FM_FAT32) && ((opt & FM_ANY) == FM_FAT32 || !(opt & FM_FAT))) {
+    fmt = FS_FAT32;
+  } else if (opt & FM_FAT) {
+    fmt = FS_FAT16;
+  } else {
+    return FR_INVALID_PARAMETER;
+  }
+
+  /* Cluster size and FAT type, retried until the cluster count fits */
+  for (;;) {
+    pau = au;
+    if (fmt == FS_FAT32) {
+      if (!pau) {
+        n = sz_vol / 0x20000;
+        for (i = 0, pau = 1; cst32[i] && cst32[i] <= n; i++, pau <<= 1) ;
+      }
+      n_clst = sz_vol / pau;
+      sz_fat = (n_clst * 4 + 8 + SS - 1) / SS;
+      sz_rsv = 32;
+      sz_dir = 0;
+      if (n_clst <= MAX_FAT16 || n_clst > MAX_FAT32) return FR_MKFS_ABORTED;
+    } else {
+      if (!pau) {
+        n = sz_vol / 0x1000;
+        for (i = 0, pau = 1; cst[i] && cst[i] <= n; i++, pau <<= 1) ;
+      }
+      n_clst = sz_vol / pau;
+      if (n_clst > MAX_FAT12) {
+        n = n_clst * 2 + 4;
+      } else {
+        fmt = FS_FAT12;
+        n = (n_clst * 3 + 1) / 2 + 3;
+      }
+      sz_fat = (n + SS - 1) / SS;
+      sz_rsv = 1;
+      sz_dir = N_ROOTDIR * SZDIRE / SS;
+    }
+    b_fat = b_vol + sz_rsv;
+    b_data = b_fat + sz_fat * N_FATS + sz_dir;
+
+    /* Data area on an erase block boundary */
+    n = ((b_data + sz_blk - 1) & ~(sz_blk - 1)) - b_data;
+    if (fmt == FS_FAT32) {
+      sz_rsv += n;
+      b_fat += n;
+    } else {
+      sz_fat += n / N_FATS;
+    }
+
+    if (sz_vol < b_data + pau * 16 - b_vol) return FR_MKFS_ABORTED;
+    n_clst = (sz_vol - sz_rsv - sz_fat * N_FATS - sz_dir) / pau;
+    if (fmt == FS_FAT32 && n_clst <= MAX_FAT16) {
+      if (!au && (au = pau / 2) != 0) continue;
+      return FR_MKFS_ABORTED;
+    }
+    if (fmt == FS_FAT16) {
+      if (n_clst > MAX_FAT16) {
+        if (!au && (pau * 2) <= 64) {
+          au = pau * 2;
+          continue;
+        }
+        if (opt & FM_FAT32) {
+          fmt = FS_FAT32;
+          continue;
+        }
+        if (!au && (au = pau * 2) <= 128) continue;
+        return FR_MKFS_ABORTED;
+      }
+      if (n_clst <= MAX_FAT12) {
+        if (!au && (au = pau * 2) <= 128) continue;
+        return FR_MKFS_ABORTED;
+      }
+    }
+    if (fmt == FS_FAT12 && n_clst > MAX_FAT12) return FR_MKFS_ABORTED;
+    break;
+  }
+
+  /* Volume boot record */
+  memset(buf, 0, SS);
+  memcpy(buf + BS_JmpBoot, "\xEB\xFE\x90" "MSDOS5.0", 11);
+  st_word(buf + BPB_BytsPerSec, SS);
+  buf[BPB_SecPerClus] = (BYTE)pau;
+  st_word(buf + BPB_RsvdSecCnt, (WORD)sz_rsv);
+  buf[BPB_NumFATs] = N_FATS;
+  st_word(buf + BPB_RootEntCnt, (WORD)((fmt == FS_FAT32) ? 0 : N_ROOTDIR));
+  if (sz_vol < 0x10000) {
+    st_word(buf + BPB_TotSec16, (WORD)sz_vol);
+  } else {
+    st_dword(buf + BPB_TotSec32, sz_vol);
+  }
+  buf[BPB_Media] = 0xF8;
+  st_word(buf + BPB_SecPerTrk, 63);
+  st_word(buf + BPB_NumHeads, 255);
+  st_dword(buf + BPB_HiddSec, b_vol);
+  if (fmt == FS_FAT32) {
+    st_dword(buf + BS_VolID32, get_fattime());
+    st_dword(buf + BPB_FATSz32, sz_fat);
+    st_dword(buf + BPB_RootClus32, 2);
+    st_word(buf + BPB_FSInfo32, 1);
+    st_word(buf + BPB_BkBootSec32, 6);
+    buf[BS_DrvNum32] = 0x80;
+    buf[BS_BootSig32] = 0x29;
+    memcpy(buf + BS_VolLab32, "NO NAME    " "FAT32   ", 19);
+  } else {
+    st_dword(buf + BS_VolID, get_fattime());
+    st_word(buf + BPB_FATSz16, (WORD)sz_fat);
+    buf[BS_DrvNum] = 0x80;
+    buf[BS_BootSig] = 0x29;
+    memcpy(buf + BS_VolLab, "NO NAME    " "FAT     ", 19);
+  }
+  st_word(buf + BS_55AA, 0xAA55);
+  if (disk_write(pdrv, buf, b_vol, 1) != RES_OK) return FR_DISK_ERR;
+
+  if (fmt == FS_FAT32) {
+    disk_write(pdrv, buf, b_vol + 6, 1);    /* Backup boot sector */
+    memset(buf, 0, SS);
+    st_dword(buf + FSI_LeadSig, 0x41615252);
+    st_dword(buf + FSI_StrucSig, 0x61417272);
+    st_dword(buf + FSI_Free_Count, n_clst - 1);
+    st_dword(buf + FSI_Nxt_Free, 2);
+    st_word(buf + BS_55AA, 0xAA55);
+    disk_write(pdrv, buf, b_vol + 7, 1);    /* Backup FSINFO */
+    disk_write(pdrv, buf, b_vol + 1, 1);
+  }
+
+  /* FAT: media and end marks, the FAT32 root directory's cluster */
+  memset(buf, 0, sz_buf * SS);
+  sect = b_fat;
+  for (i = 0; i < N_FATS; i++) {
+    if (fmt == FS_FAT32) {
+      st_dword(buf + 0, 0xFFFFFFF8);
+      st_dword(buf + 4, 0xFFFFFFFF);
+      st_dword(buf + 8, 0x0FFFFFFF);
+    } else {
+      st_dword(buf + 0, (fmt == FS_FAT12) ? 0xFFFFF8 : 0xFFFFFFF8);
+    }
+    nsect = sz_fat;
+    do {
+      n = (nsect > sz_buf) ? sz_buf : nsect;
+      if (disk_write(pdrv, buf, sect, (UINT)n) != RES_OK) return FR_DISK_ERR;
+      memset(buf, 0, SS);
+      sect += n;
+      nsect -= n;
+    } while (nsect);
+  }
+
+  /* Empty root directory */
+  nsect = (fmt == FS_FAT32) ? pau : sz_dir;
+  do {
+    n = (nsect > sz_buf) ? sz_buf : nsect;
+    if (disk_write(pdrv, buf, sect, (UINT)n) != RES_OK) return FR_DISK_ERR;
+    sect += n;
+    nsect -= n;
+  } while (nsect);
+
+  /* One partition in the MBR, unless the volume starts at sector 0 */
+  if (fmt == FS_FAT32) {
+    sys = 0x0C;
+  } else if (sz_vol >= 0x10000) {
+    sys = 0x06;
+  } else {
+    sys = (fmt == FS_FAT16) ? 0x04 : 0x01;
+  }
+  if (!(opt & FM_SFD)) {
+    memset(buf, 0, SS);
+    st_word(buf + BS_55AA, 0xAA55);
+    pte = buf + MBR_Table;
+    pte[PTE_StHead] = 1;
+    pte[PTE_StSec] = 1;
+    pte[PTE_System] = sys;
+    n = (b_vol + sz_vol) / (63 * 255);
+    pte[PTE_EdHead] = 254;
+    pte[PTE_EdSec] = (BYTE)(n >> 2 | 63);
+    pte[PTE_EdCyl] = (BYTE)n;
+    st_dword(pte + PTE_StLba, b_vol);
+    st_dword(pte + PTE_SizLba, sz_vol);
+    if (disk_write(pdrv, buf, 0, 1) != RES_OK) return FR_DISK_ERR;
+  }
+  if (disk_ioctl(pdrv, CTRL_SYNC, 0) != RES_OK) return FR_DISK_ERR;
+  return FR_OK;
+}
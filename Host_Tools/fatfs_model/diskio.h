@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file    diskio.h
+  * @brief   FatFs R0.12c disk I/O interface, for fatfs_model.c.
+  ******************************************************************************
+  */
+
+#ifndef _DISKIO_DEFINED
+#define _DISKIO_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "integer.h"
+
+/* Status of Disk Functions */
+typedef BYTE DSTATUS;
+
+/* Results of Disk Functions */
+typedef enum {
+  RES_OK = 0,     /* 0: Successful */
+  RES_ERROR,      /* 1: R/W Error */
+  RES_WRPRT,      /* 2: Write Protected */
+  RES_NOTRDY,     /* 3: Not Ready */
+  RES_PARERR      /* 4: Invalid Parameter */
+} DRESULT;
+
+DSTATUS disk_initialize(BYTE pdrv);
+DSTATUS disk_status(BYTE pdrv);
+DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count);
+DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count);
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff);
+
+/* Disk Status Bits (DSTATUS) */
+#define STA_NOINIT      0x01    /* Drive not initialized */
+#define STA_NODISK      0x02    /* No medium in the drive */
+#define STA_PROTECT     0x04    /* Write protected */
+
+/* Generic command (Used by FatFs) */
+#define CTRL_SYNC           0   /* Complete pending write process */
+#define GET_SECTOR_COUNT    1   /* Get media size */
+#define GET_SECTOR_SIZE     2   /* Get sector size */
+#define GET_BLOCK_SIZE      3   /* Get erase block size */
+#define CTRL_TRIM           4   /* Inform device that the data on the block of sectors is no longer used */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DISKIO_DEFINED */
@@ -0,0 +1,188 @@
+/**
+  ******************************************************************************
+  * @file    ff.h
+  * @brief   FatFs R0.12c application interface, for fatfs_model.c: the
+  *          types, object layouts and calls of the real ff.h for the
+  *          configuration in ../fatfs/ffconf.h, declaring the subset of
+  *          calls the model implements.
+  ******************************************************************************
+  */
+
+#ifndef _FATFS
+#define _FATFS 68300    /* Revision ID */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "integer.h"    /* Basic integer types */
+#include "ffconf.h"     /* FatFs configuration options */
+
+#if _FATFS != _FFCONF
+#error Wrong configuration file (ffconf.h).
+#endif
+#if _USE_LFN || _FS_EXFAT || _FS_RPATH || _FS_TINY || _MULTI_PARTITION || _MAX_SS != 512
+#error fatfs_model.c covers the Cube defaults only: SFN, FAT12/16/32 volumes, 512-byte sectors
+#endif
+
+/* Type of path name strings on FatFs API */
+typedef char TCHAR;
+#define _T(x) x
+#define _TEXT(x) x
+
+/* Type of file size variables */
+typedef DWORD FSIZE_t;
+
+/* File system object structure (FATFS) */
+typedef struct {
+  BYTE  fs_type;        /* File system type (0:N/A) */
+  BYTE  drv;            /* Physical drive number */
+  BYTE  n_fats;         /* Number of FATs (1 or 2) */
+  BYTE  wflag;          /* win[] flag (b0:dirty) */
+  BYTE  fsi_flag;       /* FSINFO flags (b7:disabled, b0:dirty) */
+  WORD  id;             /* File system mount ID */
+  WORD  n_rootdir;      /* Number of root directory entries (FAT12/16) */
+  WORD  csize;          /* Cluster size [sectors] */
+  DWORD last_clst;      /* Last allocated cluster */
+  DWORD free_clst;      /* Number of free clusters */
+  DWORD n_fatent;       /* Number of FAT entries (number of clusters + 2) */
+  DWORD fsize;          /* Size of an FAT [sectors] */
+  DWORD volbase;        /* Volume base sector */
+  DWORD fatbase;        /* FAT base sector */
+  DWORD dirbase;        /* Root directory base sector/cluster */
+  DWORD database;       /* Data base sector */
+  DWORD winsect;        /* Current sector appearing in the win[] */
+  BYTE  win[_MAX_SS];   /* Disk access window for Directory, FAT (and file data at tiny cfg) */
+} FATFS;
+
+/* Object ID and allocation information (_FDID) */
+typedef struct {
+  FATFS *fs;            /* Pointer to the owner file system object */
+  WORD  id;             /* Owner file system mount ID */
+  BYTE  attr;           /* Object attribute */
+  BYTE  stat;           /* Object chain status (b1-0: =0:not contiguous, =2:contiguous, =3:fragmented in this session) */
+  DWORD sclust;         /* Object start cluster (0:no cluster or root directory) */
+  FSIZE_t objsize;      /* Object size (valid when sclust != 0) */
+} _FDID;
+
+/* File object structure (FIL) */
+typedef struct {
+  _FDID obj;            /* Object identifier (must be the 1st member to detect invalid object pointer) */
+  BYTE  flag;           /* File status flags */
+  BYTE  err;            /* Abort flag (error code) */
+  FSIZE_t fptr;         /* File read/write pointer (Zeroed on file open) */
+  DWORD clust;          /* Current cluster of fpter (invalid when fptr is 0) */
+  DWORD sect;           /* Sector number appearing in buf[] (0:invalid) */
+  DWORD dir_sect;       /* Sector number containing the directory entry */
+  BYTE  *dir_ptr;       /* Pointer to the directory entry in the win[] */
+#if _USE_FASTSEEK
+  DWORD *cltbl;         /* Pointer to the cluster link map table (nulled on open, set by application) */
+#endif
+  BYTE  buf[_MAX_SS];   /* File private data read/write window */
+} FIL;
+
+/* Directory object structure (DIR) */
+typedef struct {
+  _FDID obj;            /* Object identifier */
+  DWORD dptr;           /* Current read/write offset */
+  DWORD clust;          /* Current cluster */
+  DWORD sect;           /* Current sector */
+  BYTE  *dir;           /* Pointer to the directory item in the win[] */
+  BYTE  fn[12];         /* SFN (in/out) {body[8],ext[3],status[1]} */
+} DIR;
+
+/* File information structure (FILINFO) */
+typedef struct {
+  FSIZE_t fsize;        /* File size */
+  WORD  fdate;          /* Modified date */
+  WORD  ftime;          /* Modified time */
+  BYTE  fattrib;        /* File attribute */
+  TCHAR fname[13];      /* File name */
+} FILINFO;
+
+/* File function return code (FRESULT) */
+typedef enum {
+  FR_OK = 0,                /* (0) Succeeded */
+  FR_DISK_ERR,              /* (1) A hard error occurred in the low level disk I/O layer */
+  FR_INT_ERR,               /* (2) Assertion failed */
+  FR_NOT_READY,             /* (3) The physical drive cannot work */
+  FR_NO_FILE,               /* (4) Could not find the file */
+  FR_NO_PATH,               /* (5) Could not find the path */
+  FR_INVALID_NAME,          /* (6) The path name format is invalid */
+  FR_DENIED,                /* (7) Access denied due to prohibited access or directory full */
+  FR_EXIST,                 /* (8) Access denied due to prohibited access */
+  FR_INVALID_OBJECT,        /* (9) The file/directory object is invalid */
+  FR_WRITE_PROTECTED,       /* (10) The physical drive is write protected */
+  FR_INVALID_DRIVE,         /* (11) The logical drive number is invalid */
+  FR_NOT_ENABLED,           /* (12) The volume has no work area */
+  FR_NO_FILESYSTEM,         /* (13) There is no valid FAT volume */
+  FR_MKFS_ABORTED,          /* (14) The f_mkfs() aborted due to any problem */
+  FR_TIMEOUT,               /* (15) Could not get a grant to access the volume within defined period */
+  FR_LOCKED,                /* (16) The operation is rejected according to the file sharing policy */
+  FR_NOT_ENOUGH_CORE,       /* (17) LFN working buffer could not be allocated */
+  FR_TOO_MANY_OPEN_FILES,   /* (18) Number of open files > _FS_LOCK */
+  FR_INVALID_PARAMETER      /* (19) Given parameter is invalid */
+} FRESULT;
+
+/* FatFs module application interface: the calls fatfs_model.c implements */
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode);              /* Open or create a file */
+FRESULT f_close(FIL *fp);                                           /* Close an open file object */
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br);            /* Read data from the file */
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw);     /* Write data to the file */
+FRESULT f_lseek(FIL *fp, FSIZE_t ofs);                              /* Move file pointer of the file object */
+FRESULT f_truncate(FIL *fp);                                        /* Truncate the file */
+FRESULT f_sync(FIL *fp);                                            /* Flush cached data of the writing file */
+FRESULT f_opendir(DIR *dp, const TCHAR *path);                      /* Open a directory */
+FRESULT f_closedir(DIR *dp);                                        /* Close an open directory */
+FRESULT f_readdir(DIR *dp, FILINFO *fno);                           /* Read a directory item */
+FRESULT f_unlink(const TCHAR *path);                                /* Delete an existing file or directory */
+FRESULT f_stat(const TCHAR *path, FILINFO *fno);                    /* Get file status */
+FRESULT f_getfree(const TCHAR *path, DWORD *nclst, FATFS **fatfs);  /* Get number of free clusters on the drive */
+FRESULT f_expand(FIL *fp, FSIZE_t szf, BYTE opt);                   /* Allocate a contiguous block to the file */
+FRESULT f_mount(FATFS *fs, const TCHAR *path, BYTE opt);            /* Mount/Unmount a logical drive */
+FRESULT f_mkfs(const TCHAR *path, BYTE opt, DWORD au, void *work, UINT len); /* Create a FAT volume */
+
+/* RTC function */
+DWORD get_fattime(void);
+
+#define f_eof(fp) ((int)((fp)->fptr == (fp)->obj.objsize))
+#define f_error(fp) ((fp)->err)
+#define f_tell(fp) ((fp)->fptr)
+#define f_size(fp) ((fp)->obj.objsize)
+#define f_rewind(fp) f_lseek((fp), 0)
+#define f_rewinddir(dp) f_readdir((dp), 0)
+
+/* File access mode and open method flags (3rd argument of f_open) */
+#define FA_READ             0x01
+#define FA_WRITE            0x02
+#define FA_OPEN_EXISTING    0x00
+#define FA_CREATE_NEW       0x04
+#define FA_CREATE_ALWAYS    0x08
+#define FA_OPEN_ALWAYS      0x10
+#define FA_OPEN_APPEND      0x30
+
+/* Format options (2nd argument of f_mkfs) */
+#define FM_FAT      0x01
+#define FM_FAT32    0x02
+#define FM_EXFAT    0x04
+#define FM_ANY      0x07
+#define FM_SFD      0x08
+
+/* Filesystem type (FATFS.fs_type) */
+#define FS_FAT12    1
+#define FS_FAT16    2
+#define FS_FAT32    3
+#define FS_EXFAT    4
+
+/* File attribute bits for directory entry (FILINFO.fattrib) */
+#define AM_RDO      0x01    /* Read only */
+#define AM_HID      0x02    /* Hidden */
+#define AM_SYS      0x04    /* System */
+#define AM_DIR      0x10    /* Directory */
+#define AM_ARC      0x20    /* Archive */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FATFS */
@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file    ff_gen_drv.h
+  * @brief   STM32Cube FatFs generic low level driver interface, for
+  *          fatfs_model.c: the driver table diskio.c dispatches through.
+  ******************************************************************************
+  */
+
+#ifndef __FF_GEN_DRV_H
+#define __FF_GEN_DRV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "diskio.h"
+#include "ff.h"
+
+/** Disk IO Driver structure definition */
+typedef struct {
+  DSTATUS (*disk_initialize)(BYTE);                     /* Initialize Disk Drive */
+  DSTATUS (*disk_status)(BYTE);                         /* Get Disk Status */
+  DRESULT (*disk_read)(BYTE, BYTE *, DWORD, UINT);      /* Read Sector(s) */
+#if _USE_WRITE == 1
+  DRESULT (*disk_write)(BYTE, const BYTE *, DWORD, UINT); /* Write Sector(s) when _USE_WRITE = 0 */
+#endif
+#if _USE_IOCTL == 1
+  DRESULT (*disk_ioctl)(BYTE, BYTE, void *);            /* I/O control operation when _USE_IOCTL = 1 */
+#endif
+} Diskio_drvTypeDef;
+
+/** Global Disk IO Drivers structure definition */
+typedef struct {
+  uint8_t is_initialized[_VOLUMES];
+  const Diskio_drvTypeDef *drv[_VOLUMES];
+  uint8_t lun[_VOLUMES];
+  volatile uint8_t nbr;
+} Disk_drvTypeDef;
+
+uint8_t FATFS_LinkDriverEx(const Diskio_drvTypeDef *drv, char *path, uint8_t lun);
+uint8_t FATFS_LinkDriver(const Diskio_drvTypeDef *drv, char *path);
+uint8_t FATFS_UnLinkDriver(char *path);
+uint8_t FATFS_GetAttachedDriversNbr(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FF_GEN_DRV_H */
@@ -0,0 +1,22 @@
+/**
+  ******************************************************************************
+  * @file    integer.h
+  * @brief   FatFs R0.12c integer types, for fatfs_model.c. As in FatFs,
+  *          DWORD is unsigned long: 64 bits on the host.
+  ******************************************************************************
+  */
+
+#ifndef _FF_INTEGER
+#define _FF_INTEGER
+
+typedef int             INT;
+typedef unsigned int    UINT;
+typedef unsigned char   BYTE;
+typedef short           SHORT;
+typedef unsigned short  WORD;
+typedef unsigned short  WCHAR;
+typedef long            LONG;
+typedef unsigned long   DWORD;
+typedef unsigned long long QWORD;
+
+#endif /* _FF_INTEGER */
@@ -0,0 +1,252 @@
+/**
+  ******************************************************************************
+  * @file    fatlog_bench.c
+  * @brief   The firmware logger on FatFs over a disk image.
+  *
+  *          Runs telemetry_log.c as main.c does: Mount_SD_Card at boot,
+  *          Telemetry_Log for each row of the flight CSV at the streamer's
+  *          5 Hz, and TelemetryLog_Poll from a superloop pass every loop_us
+  *          in between, all on the simulated clock. The card is sd_image.c,
+  *          with its injected latencies, over an image that is created and
+  *          formatted with f_mkfs if it does not hold a file system yet.
+  *
+  *          Prints key=value: logger and card counters, the longest and
+  *          mean time a Telemetry_Log or TelemetryLog_Poll call held the
+  *          superloop, and worst latency per card operation. With out= the
+  *          first log file of the run is copied out of the image for
+  *          telemetry_decode.
+  *
+  *          Usage: fatlog_bench image.img telemetry_stream.csv [key=value ...]
+  *            reps=N        play the flight N times over (default 1)
+  *            size_mb=N     size of a new image (default 64)
+  *            loop_us=N     superloop pass between polls (default 1000)
+  *            out=PATH      copy the first log file here
+  *          and any SD_Image_Latency_t field, e.g. program_us=1500.
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_model.h"
+#include "sd_image.h"
+#include "telemetry_log.h"
+
+#define RATE_MS     200U    /* telemetry_streamer.py sends at 5 Hz */
+
+typedef struct {
+  const char *name;
+  uint32_t *value;
+} Option_t;
+
+/* Time one logger call held the superloop */
+typedef struct {
+  uint64_t calls;
+  uint64_t total_ns;
+  uint64_t max_ns;
+} CallTime_t;
+
+static void call_time(CallTime_t *t, uint64_t start_ns)
+{
+  uint64_t ns = hal_model_now_ns() - start_ns;
+  t->calls++;
+  t->total_ns += ns;
+  if (ns > t->max_ns) t->max_ns = ns;
+}
+
+/* Format the image if FatFs finds no volume on it */
+static int prepare_volume(const char *path)
+{
+  FATFS probe;
+  FRESULT res = f_mount(&probe, path, 1);
+
+  if (res == FR_NO_FILESYSTEM) {
+    static BYTE work[_MAX_SS];
+    res = f_mkfs(path, FM_ANY, 0, work, sizeof(work));
+    if (res == FR_OK) res = f_mount(&probe, path, 1);
+  }
+  f_mount(NULL, path, 0);
+  return res == FR_OK ? 0 : -1;
+}
+
+/* Copy a file out of the image */
+static int copy_out(const char *drive, const char *name, const char *dest)
+{
+  FATFS fs;
+  FIL fil;
+  char path[32];
+  BYTE buf[4096];
+  UINT br;
+  int ok = 0;
+
+  snprintf(path, sizeof(path), "%s%s", drive, name);
+  FILE *out = fopen(dest, "wb");
+  if (!out) return -1;
+  if (f_mount(&fs, drive, 1) == FR_OK && f_open(&fil, path, FA_READ) == FR_OK) {
+    ok = 1;
+    while (f_read(&fil, buf, sizeof(buf), &br) == FR_OK && br > 0) {
+      if (fwrite(buf, 1, br, out) != br) ok = 0;
+    }
+    f_close(&fil);
+  }
+  f_mount(NULL, drive, 0);
+  fclose(out);
+  return ok ? 0 : -1;
+}
+
+int main(int argc, char **argv)
+{
+  SD_Image_Latency_t lat = SD_IMAGE_LATENCY_DEFAULT;
+  uint32_t reps = 1, size_mb = 64, loop_us = 1000;
+  const char *out_path = NULL;
+  Option_t options[] = {
+    { "reps", &reps }, { "size_mb", &size_mb }, { "loop_us", &loop_us },
+    { "cmd_us", &lat.cmd_us }, { "xfer_us", &lat.xfer_us }, { "access_us", &lat.access_us },
+    { "program_us", &lat.program_us }, { "stream_us", &lat.stream_us }, { "stop_us", &lat.stop_us },
+    { "spike_us", &lat.spike_us }, { "spike_every", &lat.spike_every }, { "poll_us", &lat.poll_us },
+    { "erase_us", &lat.erase_us }, { "erase_sectors", &lat.erase_sectors },
+  };
+
+  if (argc < 3) {
+    fprintf(stderr, "usage: fatlog_bench image.img telemetry_stream.csv [key=value ...]\n");
+    return 2;
+  }
+  for (int i = 3; i < argc; i++) {
+    char *eq = strchr(argv[i], '=');
+    size_t n = eq ? (size_t)(eq - argv[i]) : 0;
+    size_t k;
+
+    if (eq && n == 3 && strncmp(argv[i], "out", 3) == 0) {
+      out_path = eq + 1;
+      continue;
+    }
+    for (k = 0; k < sizeof(options) / sizeof(options[0]); k++) {
+      if (eq && strlen(options[k].name) == n && strncmp(argv[i], options[k].name, n) == 0) break;
+    }
+    if (k == sizeof(options) / sizeof(options[0])) {
+      fprintf(stderr, "%s: unknown option\n", argv[i]);
+      return 2;
+    }
+    *options[k].value = (uint32_t)strtoul(eq + 1, NULL, 0);
+  }
+
+  FILE *in = fopen(argv[2], "r");
+  if (!in) {
+    perror(argv[2]);
+    return 1;
+  }
+  if (sd_image_open(argv[1], size_mb * 2048U) != 0) {
+    fprintf(stderr, "%s: cannot open or create the image\n", argv[1]);
+    return 1;
+  }
+  sd_image_set_latency(&lat);
+
+  char drive[4];
+  if (FATFS_LinkDriver(&USER_Driver, drive) != 0 || prepare_volume(drive) != 0) {
+    fprintf(stderr, "%s: no FAT volume, and formatting failed\n", argv[1]);
+    return 1;
+  }
+
+  /* Time from here on is the logger's */
+  hal_model_reset();
+  sd_image_reset();
+  memset(&SD_Stats, 0, sizeof(SD_Stats));
+  SD_ResetTiming();
+
+  Mount_SD_Card();
+  if (!TelemetryLog_IsMounted()) {
+    fprintf(stderr, "Mount_SD_Card failed\n");
+    return 1;
+  }
+  uint32_t file = TelemetryLog_FileNumber();
+  uint64_t mount_ns = hal_model_now_ns();
+
+  CallTime_t log_time = { 0 }, poll_time = { 0 };
+  TelemetryData_t d = { 0 };
+  char line[128];
+  uint32_t n = 0;
+
+  for (uint32_t r = 0; r < reps && TelemetryLog_IsMounted(); r++) {
+    rewind(in);
+    while (fgets(line, sizeof(line), in) && TelemetryLog_IsMounted()) {
+      float v[3];
+      if (sscanf(line, "%f,%f,%f", &v[0], &v[1], &v[2]) != 3) continue;
+
+      /* Superloop passes until the record arrives */
+      uint64_t due_ns = mount_ns + (uint64_t)n * RATE_MS * 1000000U;
+      while (hal_model_now_ns() < due_ns) {
+        uint64_t t0 = hal_model_now_ns();
+        TelemetryLog_Poll();
+        call_time(&poll_time, t0);
+        if (hal_model_now_ns() < due_ns) hal_model_advance((uint64_t)loop_us * 1000U);
+      }
+
+      /* Stamped and rated as Telemetry_ReceiveAndParse does */
+      uint32_t ms = n * RATE_MS;
+      float dt = (ms - d.timestamp_ms) / 1000.0f;
+      if (dt < 0.001f) dt = 0.001f;
+      d.altitude_prev = d.altitude;
+      d.speed_prev = d.speed;
+      d.voltage_prev = d.voltage;
+      d.timestamp_prev = d.timestamp_ms;
+      d.altitude = v[0];
+      d.speed = v[1];
+      d.voltage = v[2];
+      d.timestamp_ms = ms;
+      d.hours = ms / 3600000U;
+      d.minutes = ms / 60000U % 60U;
+      d.seconds = ms / 1000U % 60U;
+      d.altitude_rate = (d.altitude - d.altitude_prev) / dt;
+      d.speed_rate = (d.speed - d.speed_prev) / dt;
+      d.voltage_rate = (d.voltage - d.voltage_prev) / dt;
+
+      uint64_t t0 = hal_model_now_ns();
+      Telemetry_Log(&d);
+      call_time(&log_time, t0);
+      n++;
+    }
+  }
+  fclose(in);
+
+  const TelemetryLog_Stats_t *ls = TelemetryLog_GetStats();
+  uint8_t failed = !TelemetryLog_IsMounted();
+  uint64_t t0 = hal_model_now_ns();
+  TelemetryLog_Close();
+  uint64_t close_ns = hal_model_now_ns() - t0;
+
+  printf("records=%u logged=%u errors=%u sectors=%u commits=%u overflows=%u files=%u max_queued=%u "
+         "events=%u decimated=%u failed=%u sim_s=%.1f mount_ms=%.2f close_ms=%.2f\n",
+         n, ls->records, ls->errors, ls->sectors, ls->commits, ls->overflows, ls->files, ls->max_queued,
+         ls->events, ls->decimated, failed, hal_model_now_ns() / 1e9, mount_ns / 1e6, close_ns / 1e6);
+  printf("log_max_us=%.0f log_mean_us=%.1f poll_max_us=%.0f poll_mean_us=%.2f ops_per_record=%.3f\n",
+         log_time.max_ns / 1e3, log_time.calls ? log_time.total_ns / 1e3 / log_time.calls : 0.0,
+         poll_time.max_ns / 1e3, poll_time.calls ? poll_time.total_ns / 1e3 / poll_time.calls : 0.0,
+         n ? (double)(SD_Stats.reads + SD_Stats.writes + SD_Stats.syncs) / n : 0.0);
+  printf("reads=%lu writes=%lu syncs=%lu read_sectors=%lu write_sectors=%lu stream_starts=%lu busy_waits=%lu "
+         "trims=%lu trim_sectors=%lu\n",
+         (unsigned long)SD_Stats.reads, (unsigned long)SD_Stats.writes, (unsigned long)SD_Stats.syncs,
+         (unsigned long)SD_Stats.read_sectors, (unsigned long)SD_Stats.write_sectors,
+         (unsigned long)SD_Stats.stream_starts, (unsigned long)SD_Stats.busy_waits,
+         (unsigned long)SD_Stats.trims, (unsigned long)SD_Stats.trim_sectors);
+  printf("cache_slots=%d cache_hits=%lu cache_misses=%lu cache_evictions=%lu cache_writebacks=%lu\n",
+         SD_CACHE_SLOTS, (unsigned long)SD_Stats.cache_hits, (unsigned long)SD_Stats.cache_misses,
+         (unsigned long)SD_Stats.cache_evictions, (unsigned long)SD_Stats.cache_writebacks);
+
+  static const char *const op_names[SD_OP_COUNT] = { "read", "write", "strm", "wait", "rblk", "prog" };
+  for (int op = 0; op < SD_OP_COUNT; op++) {
+    printf("%s%s_count=%lu %s_max_us=%lu", op ? " " : "", op_names[op], (unsigned long)SD_Timing[op].count,
+           op_names[op], (unsigned long)SD_Timing[op].max_us);
+  }
+  printf("\n");
+
+  if (out_path) {
+    char name[24];
+    snprintf(name, sizeof(name), TELEMETRY_LOG_PREFIX "%05lu" TELEMETRY_LOG_EXT, (unsigned long)file);
+    if (copy_out(drive, name, out_path) != 0) {
+      fprintf(stderr, "%s: cannot copy %s out of the image\n", out_path, name);
+      return 1;
+    }
+  }
+  sd_image_close();
+  return failed ? 1 : 0;
+}
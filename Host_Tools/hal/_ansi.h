@@ -0,0 +1,13 @@
+/* Host stand-in for newlib's <_ansi.h> */
+#ifndef __HOST_ANSI_H
+#define __HOST_ANSI_H
+
+#ifdef __cplusplus
+#define _BEGIN_STD_C extern "C" {
+#define _END_STD_C   }
+#else
+#define _BEGIN_STD_C
+#define _END_STD_C
+#endif
+
+#endif /* __HOST_ANSI_H */
@@ -0,0 +1,198 @@
+/**
+  ******************************************************************************
+  * @file    stm32f4xx_hal.h
+  * @brief   Host stand-in for the STM32F4 HAL.
+  *          Declares the subset of types and calls used by the firmware
+  *          sources built on the host; hal_model.c implements them on top of
+  *          a simulated clock and bus timing model.
+  ******************************************************************************
+  */
+
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  HAL_OK       = 0x00U,
+  HAL_ERROR    = 0x01U,
+  HAL_BUSY     = 0x02U,
+  HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY      0xFFFFFFFFU
+
+/* GPIO ----------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef enum {
+  GPIO_PIN_RESET = 0,
+  GPIO_PIN_SET
+} GPIO_PinState;
+
+extern GPIO_TypeDef hal_model_gpio[3];
+#define GPIOA              (&hal_model_gpio[0])
+#define GPIOB              (&hal_model_gpio[1])
+#define GPIOC              (&hal_model_gpio[2])
+
+#define GPIO_PIN_0         ((uint16_t)0x0001)
+#define GPIO_PIN_1         ((uint16_t)0x0002)
+#define GPIO_PIN_2         ((uint16_t)0x0004)
+#define GPIO_PIN_3         ((uint16_t)0x0008)
+#define GPIO_PIN_4         ((uint16_t)0x0010)
+#define GPIO_PIN_5         ((uint16_t)0x0020)
+#define GPIO_PIN_6         ((uint16_t)0x0040)
+#define GPIO_PIN_7         ((uint16_t)0x0080)
+#define GPIO_PIN_8         ((uint16_t)0x0100)
+#define GPIO_PIN_9         ((uint16_t)0x0200)
+#define GPIO_PIN_10        ((uint16_t)0x0400)
+#define GPIO_PIN_11        ((uint16_t)0x0800)
+#define GPIO_PIN_12        ((uint16_t)0x1000)
+#define GPIO_PIN_13        ((uint16_t)0x2000)
+#define GPIO_PIN_14        ((uint16_t)0x4000)
+#define GPIO_PIN_15        ((uint16_t)0x8000)
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+/* I2C -----------------------------------------------------------------------*/
+typedef struct {
+  uint32_t ClockSpeed;      /* Bus clock used by the timing model (Hz) */
+} I2C_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+
+/* SPI -----------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t CR1;
+  volatile uint32_t CR2;
+  volatile uint32_t SR;
+  volatile uint32_t DR;
+  volatile uint32_t CRCPR;
+  volatile uint32_t RXCRCR;
+  volatile uint32_t TXCRCR;
+} SPI_TypeDef;
+
+extern SPI_TypeDef hal_model_spi[3];
+#define SPI1               (&hal_model_spi[0])
+#define SPI2               (&hal_model_spi[1])
+#define SPI3               (&hal_model_spi[2])
+
+/* DMA stream registers; only the frame sizes in CR are looked at */
+typedef struct {
+  volatile uint32_t CR;
+  volatile uint32_t NDTR;
+  volatile uint32_t PAR;
+  volatile uint32_t M0AR;
+  volatile uint32_t M1AR;
+  volatile uint32_t FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct {
+  DMA_Stream_TypeDef *Instance;
+} DMA_HandleTypeDef;
+
+#define DMA_SxCR_PSIZE_0            (0x1UL << 11)
+#define DMA_SxCR_PSIZE              (0x3UL << 11)
+#define DMA_SxCR_MSIZE_0            (0x1UL << 13)
+#define DMA_SxCR_MSIZE              (0x3UL << 13)
+
+typedef struct {
+  uint32_t DataSize;
+  uint32_t CRCCalculation;
+  uint32_t CRCPolynomial;
+} SPI_InitTypeDef;
+
+typedef struct {
+  SPI_TypeDef *Instance;
+  SPI_InitTypeDef Init;
+  DMA_HandleTypeDef *hdmatx;
+  DMA_HandleTypeDef *hdmarx;
+  uint32_t ClockSpeed;      /* Kernel clock before the CR1 prescaler (Hz) */
+} SPI_HandleTypeDef;
+
+/* CR1 frame format and CRC unit: 16-bit frames go out MSB first, and with
+   CRCEN the CRC of the frames follows a transfer out and is checked after
+   one in, as the HAL does with USE_SPI_CRC */
+#define SPI_CR1_SPE                 (0x1UL << 6)
+#define SPI_CR1_DFF                 (0x1UL << 11)
+#define SPI_CR1_CRCEN               (0x1UL << 13)
+#define SPI_SR_CRCERR               (0x1UL << 4)
+#define SPI_DATASIZE_8BIT           (0x00000000U)
+#define SPI_DATASIZE_16BIT          SPI_CR1_DFF
+#define SPI_CRCCALCULATION_DISABLE  (0x00000000U)
+#define SPI_CRCCALCULATION_ENABLE   SPI_CR1_CRCEN
+
+#define __HAL_SPI_ENABLE(h)             ((h)->Instance->CR1 |= SPI_CR1_SPE)
+#define __HAL_SPI_DISABLE(h)            ((h)->Instance->CR1 &= ~SPI_CR1_SPE)
+#define __HAL_SPI_CLEAR_OVRFLAG(h)      do { (void)(h)->Instance->DR; (void)(h)->Instance->SR; } while (0)
+#define __HAL_SPI_CLEAR_CRCERRFLAG(h)   ((h)->Instance->SR &= ~SPI_SR_CRCERR)
+
+#define SPI_CR1_BR_Pos              (3U)
+#define SPI_CR1_BR_Msk              (0x7UL << SPI_CR1_BR_Pos)
+#define SPI_BAUDRATEPRESCALER_2     (0x00000000U)
+#define SPI_BAUDRATEPRESCALER_4     (0x00000008U)
+#define SPI_BAUDRATEPRESCALER_8     (0x00000010U)
+#define SPI_BAUDRATEPRESCALER_16    (0x00000018U)
+#define SPI_BAUDRATEPRESCALER_32    (0x00000020U)
+#define SPI_BAUDRATEPRESCALER_64    (0x00000028U)
+#define SPI_BAUDRATEPRESCALER_128   (0x00000030U)
+#define SPI_BAUDRATEPRESCALER_256   (0x00000038U)
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                          uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                              uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_DMAStop(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+/* Core ----------------------------------------------------------------------*/
+#define MODIFY_REG(REG, CLEARMASK, SETMASK) ((REG) = (((REG) & (~(CLEARMASK))) | (SETMASK)))
+
+typedef struct {
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+  volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+/* The cycle counter reads simulated time at SystemCoreClock */
+DWT_Type *hal_model_dwt(void);
+extern CoreDebug_Type hal_model_coredebug;
+extern uint32_t SystemCoreClock;
+#define DWT                         (hal_model_dwt())
+#define CoreDebug                   (&hal_model_coredebug)
+#define DWT_CTRL_CYCCNTENA_Msk      (0x1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk  (0x1UL << 24)
+
+#define __CLZ(x)                    ((uint8_t)((x) ? __builtin_clz(x) : 32U))
+
+static inline uint32_t __REV16(uint32_t value)
+{
+  return ((value & 0x00FF00FFU) << 8) | ((value >> 8) & 0x00FF00FFU);
+}
+
+/* System --------------------------------------------------------------------*/
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32F4xx_HAL_H */
@@ -0,0 +1 @@
+/* Host stand-in: GPIO definitions live in stm32f4xx_hal.h */
@@ -0,0 +1,328 @@
+/**
+  ******************************************************************************
+  * @file    hal_model.c
+  * @brief   Host implementation of the HAL subset with simulated timing.
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "hal_model.h"
+#include "ssd1306_model.h"
+
+#define SSD1306_MODEL_I2C_ADDR  (0x3C << 1)
+
+GPIO_TypeDef hal_model_gpio[3];
+SPI_TypeDef hal_model_spi[3];
+CoreDebug_Type hal_model_coredebug;
+uint32_t SystemCoreClock = 84000000U;
+
+static uint64_t now_ns;
+static uint64_t wire_ns;        /* Into the transfer being clocked, for devices */
+static uint32_t clocking_hz;    /* Its bit rate */
+static HAL_Model_Stats_t stats;
+static DWT_Type dwt;
+
+static struct {
+  HAL_Model_SpiDevice_t dev;
+  uint64_t busy_until_ns;       /* End of the transfer on the wire */
+  SPI_HandleTypeDef *dma_hspi;  /* Pending DMA completion */
+  uint8_t dma_rx;               /* It was HAL_SPI_TransmitReceive_DMA */
+  uint8_t crc_error;            /* The last transfer in failed its CRC check */
+} spi_port[3];
+
+static struct {
+  GPIO_TypeDef *cs_port, *dc_port;
+  uint16_t cs_pin, dc_pin;
+} oled_spi;
+
+static int spi_index(const SPI_TypeDef *spi)
+{
+  return (int)(spi - hal_model_spi);
+}
+
+/* Weak so a host program can forward completions like main.c does */
+__attribute__((weak)) void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi;
+}
+
+__attribute__((weak)) void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi;
+}
+
+__attribute__((weak)) void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi;
+}
+
+void hal_model_reset(void)
+{
+  now_ns = 0;
+  memset(&stats, 0, sizeof(stats));
+  memset(spi_port, 0, sizeof(spi_port));
+  memset(hal_model_gpio, 0, sizeof(hal_model_gpio));
+  ssd1306_model_reset();
+}
+
+uint64_t hal_model_now_ns(void)
+{
+  return now_ns + wire_ns;
+}
+
+DWT_Type *hal_model_dwt(void)
+{
+  if (dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) dwt.CYCCNT = (uint32_t)(now_ns * (SystemCoreClock / 1000000U) / 1000U);
+  return &dwt;
+}
+
+const HAL_Model_Stats_t *hal_model_stats(void)
+{
+  return &stats;
+}
+
+/* Move simulated time forward and deliver DMA completions that fall due */
+void hal_model_advance(uint64_t ns)
+{
+  now_ns += ns;
+  for (int i = 0; i < 3; i++) {
+    SPI_HandleTypeDef *h = spi_port[i].dma_hspi;
+    if (h && now_ns >= spi_port[i].busy_until_ns) {
+      spi_port[i].dma_hspi = NULL;
+      if (spi_port[i].crc_error) HAL_SPI_ErrorCallback(h);
+      else if (spi_port[i].dma_rx) HAL_SPI_TxRxCpltCallback(h);
+      else HAL_SPI_TxCpltCallback(h);
+    }
+  }
+}
+
+/* Wait for the wire to be free, as a blocking call would */
+static void wait_bus(uint64_t busy_until_ns)
+{
+  if (busy_until_ns > now_ns) hal_model_advance(busy_until_ns - now_ns);
+}
+
+uint32_t HAL_GetTick(void)
+{
+  hal_model_advance(HAL_MODEL_TICK_POLL_NS);
+  return (uint32_t)(now_ns / 1000000U);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+  stats.delay_ns += (uint64_t)Delay * 1000000U;
+  hal_model_advance((uint64_t)Delay * 1000000U);
+}
+
+/* GPIO ----------------------------------------------------------------------*/
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  if (PinState == GPIO_PIN_SET) GPIOx->ODR |= GPIO_Pin;
+  else GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+  hal_model_advance(HAL_MODEL_GPIO_NS);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+  return (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/* I2C -----------------------------------------------------------------------*/
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+  (void)Timeout;
+  /* START + address + memory address + data, 9 clocks per byte, STOP */
+  uint64_t bits = 1 + 9 * (1 + MemAddSize + (uint64_t)Size) + 1;
+  uint64_t wire = bits * 1000000000ULL / (hi2c->ClockSpeed ? hi2c->ClockSpeed : 100000U);
+
+  if (DevAddress == SSD1306_MODEL_I2C_ADDR) {
+    for (uint16_t i = 0; i < Size; i++) {
+      if (MemAddress == 0x40) ssd1306_model_data(pData[i]);
+      else ssd1306_model_command(pData[i]);
+    }
+  }
+
+  stats.i2c.bytes += 1 + MemAddSize + Size;
+  stats.i2c.wire_ns += wire;
+  stats.i2c.calls++;
+  hal_model_advance(HAL_MODEL_I2C_CALL_NS + wire);
+  return HAL_OK;
+}
+
+/* SPI -----------------------------------------------------------------------*/
+uint32_t hal_model_spi_hz(const SPI_HandleTypeDef *hspi)
+{
+  uint32_t br = (hspi->Instance->CR1 & SPI_CR1_BR_Msk) >> SPI_CR1_BR_Pos;
+  uint32_t clk = hspi->ClockSpeed ? hspi->ClockSpeed : 42000000U;
+  return clk >> (br + 1);
+}
+
+uint32_t hal_model_spi_clocking_hz(void)
+{
+  return clocking_hz;
+}
+
+void hal_model_spi_attach(SPI_TypeDef *spi, const HAL_Model_SpiDevice_t *dev)
+{
+  spi_port[spi_index(spi)].dev = *dev;
+}
+
+static uint8_t oled_exchange(void *ctx, uint8_t mosi)
+{
+  (void)ctx;
+  if (HAL_GPIO_ReadPin(oled_spi.cs_port, oled_spi.cs_pin) == GPIO_PIN_RESET) {
+    if (HAL_GPIO_ReadPin(oled_spi.dc_port, oled_spi.dc_pin) == GPIO_PIN_SET) ssd1306_model_data(mosi);
+    else ssd1306_model_command(mosi);
+  }
+  return 0xFF;
+}
+
+void hal_model_attach_oled_spi(SPI_TypeDef *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin,
+                               GPIO_TypeDef *dc_port, uint16_t dc_pin)
+{
+  HAL_Model_SpiDevice_t dev = { NULL, oled_exchange };
+  oled_spi.cs_port = cs_port;
+  oled_spi.cs_pin = cs_pin;
+  oled_spi.dc_port = dc_port;
+  oled_spi.dc_pin = dc_pin;
+  hal_model_spi_attach(spi, &dev);
+}
+
+/* One frame of width bits into the CRC unit's CRC, polynomial CRCPR */
+static uint16_t spi_crc(uint16_t crc, uint16_t frame, uint32_t width, uint16_t poly)
+{
+  for (uint32_t b = width; b--;) {
+    uint16_t fb = ((crc >> (width - 1)) ^ (frame >> b)) & 1U;
+    crc <<= 1;
+    if (width == 8) crc &= 0xFF;
+    if (fb) crc ^= poly;
+  }
+  return crc;
+}
+
+/* Exchange one frame, MSB first, with the attached device */
+static uint16_t spi_frame(int i, uint16_t out, uint32_t width, uint64_t byte_ns)
+{
+  uint16_t in = 0;
+
+  for (uint32_t b = width; b;) {
+    uint8_t miso = 0xFF;
+    b -= 8;
+    wire_ns += byte_ns;
+    if (spi_port[i].dev.exchange) miso = spi_port[i].dev.exchange(spi_port[i].dev.ctx, (uint8_t)(out >> b));
+    in |= (uint16_t)(miso << b);
+  }
+  return in;
+}
+
+/*
+ * Clock Size frames through the attached device and returns the wire time.
+ * 16-bit frames (CR1 DFF) are little-endian in memory. With CR1 CRCEN the
+ * CRC of the frames out follows them, and when receiving, the frame after
+ * the data is checked against the CRC of the frames in.
+ */
+static uint64_t spi_clock_bytes(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t Size)
+{
+  int i = spi_index(hspi->Instance);
+  SPI_TypeDef *spi = hspi->Instance;
+  uint32_t width = (spi->CR1 & SPI_CR1_DFF) ? 16U : 8U;
+  uint32_t crc_on = (spi->CR1 & SPI_CR1_CRCEN) != 0;
+  uint16_t poly = (uint16_t)spi->CRCPR;
+  uint16_t crc_out = 0, crc_in = 0;
+  uint64_t byte_ns = 8U * 1000000000ULL / hal_model_spi_hz(hspi);
+  uint32_t bytes = (Size + crc_on) * (width / 8U);
+
+  wire_ns = 0;
+  clocking_hz = hal_model_spi_hz(hspi);
+  for (uint16_t n = 0; n < Size; n++) {
+    uint16_t out = 0xFFFF, in;
+    if (tx) out = (width == 16) ? (uint16_t)(tx[2 * n] | (tx[2 * n + 1] << 8)) : tx[n];
+    in = spi_frame(i, out, width, byte_ns);
+    if (rx && width == 16) {
+      rx[2 * n] = (uint8_t)in;
+      rx[2 * n + 1] = (uint8_t)(in >> 8);
+    } else if (rx) {
+      rx[n] = (uint8_t)in;
+    }
+    crc_out = spi_crc(crc_out, out, width, poly);
+    crc_in = spi_crc(crc_in, in, width, poly);
+  }
+  spi_port[i].crc_error = 0;
+  if (crc_on) {
+    uint16_t in = spi_frame(i, tx ? crc_out : 0xFFFF, width, byte_ns);
+    if (rx && in != crc_in) {
+      spi->SR |= SPI_SR_CRCERR;
+      spi_port[i].crc_error = 1;
+    }
+  }
+  wire_ns = 0;
+
+  uint64_t wire = (uint64_t)bytes * 8U * 1000000000ULL / hal_model_spi_hz(hspi);
+  stats.spi[i].bytes += bytes;
+  stats.spi[i].wire_ns += wire;
+  stats.spi[i].calls++;
+  return wire;
+}
+
+static HAL_StatusTypeDef spi_blocking(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t Size)
+{
+  int i = spi_index(hspi->Instance);
+  if (spi_port[i].dma_hspi) return HAL_BUSY;
+  wait_bus(spi_port[i].busy_until_ns);
+  hal_model_advance(HAL_MODEL_SPI_CALL_NS + spi_clock_bytes(hspi, tx, rx, Size));
+  return spi_port[i].crc_error ? HAL_ERROR : HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+  (void)Timeout;
+  return spi_blocking(hspi, pData, NULL, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+  (void)Timeout;
+  return spi_blocking(hspi, NULL, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                          uint16_t Size, uint32_t Timeout)
+{
+  (void)Timeout;
+  return spi_blocking(hspi, pTxData, pRxData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+  int i = spi_index(hspi->Instance);
+  if (spi_port[i].dma_hspi) return HAL_BUSY;
+
+  wait_bus(spi_port[i].busy_until_ns);
+  hal_model_advance(HAL_MODEL_DMA_START_NS);
+  spi_port[i].busy_until_ns = now_ns + spi_clock_bytes(hspi, pData, NULL, Size);
+  spi_port[i].dma_hspi = hspi;
+  spi_port[i].dma_rx = 0;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                              uint16_t Size)
+{
+  int i = spi_index(hspi->Instance);
+  if (spi_port[i].dma_hspi) return HAL_BUSY;
+
+  /* The data lands at once; the caller only looks after the completion */
+  wait_bus(spi_port[i].busy_until_ns);
+  hal_model_advance(HAL_MODEL_DMA_START_NS);
+  spi_port[i].busy_until_ns = now_ns + spi_clock_bytes(hspi, pTxData, pRxData, Size);
+  spi_port[i].dma_hspi = hspi;
+  spi_port[i].dma_rx = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_DMAStop(SPI_HandleTypeDef *hspi)
+{
+  spi_port[spi_index(hspi->Instance)].dma_hspi = NULL;
+  return HAL_OK;
+}
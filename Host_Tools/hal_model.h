@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file    hal_model.h
+  * @brief   Simulated clock and bus timing behind the host HAL stand-in.
+  *
+  *          Time only advances when firmware code touches the HAL: a bus
+  *          transfer costs its bits at the configured clock plus a fixed call
+  *          overhead, HAL_Delay costs its argument and each HAL_GetTick poll
+  *          costs a few cycles. DMA transfers run "in the background": they
+  *          occupy the bus and fire HAL_SPI_TxCpltCallback when simulated
+  *          time passes their end.
+  ******************************************************************************
+  */
+
+#ifndef __HAL_MODEL_H
+#define __HAL_MODEL_H
+
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+/* Modelled CPU costs of the HAL calls on an 84 MHz STM32F401 */
+#define HAL_MODEL_I2C_CALL_NS    4000U   /* HAL_I2C_Mem_Write setup and flag polling */
+#define HAL_MODEL_SPI_CALL_NS    1500U   /* Blocking HAL_SPI_* call */
+#define HAL_MODEL_DMA_START_NS   2500U   /* HAL_SPI_Transmit_DMA stream setup */
+#define HAL_MODEL_GPIO_NS          50U   /* HAL_GPIO_WritePin */
+#define HAL_MODEL_TICK_POLL_NS     50U   /* HAL_GetTick in a polling loop */
+
+/** Per-bus traffic counters */
+typedef struct {
+  uint64_t bytes;           /* Bytes clocked on the wire */
+  uint64_t wire_ns;         /* Time the bus was driven */
+  uint64_t calls;           /* HAL transfer calls */
+} HAL_Model_Bus_t;
+
+typedef struct {
+  HAL_Model_Bus_t i2c;
+  HAL_Model_Bus_t spi[3];
+  uint64_t delay_ns;        /* Time spent in HAL_Delay */
+} HAL_Model_Stats_t;
+
+/** SPI slave attached to a port: exchanges one byte while the bus clocks */
+typedef struct {
+  void *ctx;
+  uint8_t (*exchange)(void *ctx, uint8_t mosi);
+} HAL_Model_SpiDevice_t;
+
+void hal_model_reset(void);
+uint64_t hal_model_now_ns(void);
+void hal_model_advance(uint64_t ns);
+const HAL_Model_Stats_t *hal_model_stats(void);
+
+void hal_model_spi_attach(SPI_TypeDef *spi, const HAL_Model_SpiDevice_t *dev);
+
+/** SSD1306 on SPI: bytes are routed by the DC pin while CS is low */
+void hal_model_attach_oled_spi(SPI_TypeDef *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin,
+                               GPIO_TypeDef *dc_port, uint16_t dc_pin);
+
+/** Bit rate of an SPI port given its kernel clock and CR1 prescaler */
+uint32_t hal_model_spi_hz(const SPI_HandleTypeDef *hspi);
+
+/** Bit rate of the transfer being clocked, for a device's exchange */
+uint32_t hal_model_spi_clocking_hz(void);
+
+#endif /* __HAL_MODEL_H */
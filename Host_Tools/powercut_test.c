@@ -0,0 +1,455 @@
+/**
+  ******************************************************************************
+  * @file    powercut_test.c
+  * @brief   Power cuts under the firmware logger, on FatFs over a disk image.
+  *
+  *          Each run logs the first rows of the flight CSV as fatlog_bench
+  *          does, on a copy of a freshly formatted image, and cuts the power
+  *          after a random number of sector writes: the sector being
+  *          written is torn, a random part of it reaching the image, and
+  *          the card stops answering. The records the logger had committed
+  *          by then are noted. A second boot mounts the image, which
+  *          recovers and finishes the log, and the log is read back. Every
+  *          sector in it must be valid and its records the same as those of
+  *          a run without a cut, at least up to the last committed one.
+  *
+  *          Each boot runs in a child process, so the logger starts from its
+  *          power-on state as the firmware does; the parent only formats
+  *          the image and reads the logs back.
+  *
+  *          With stale=1 the image is not fresh: an older flight, with the
+  *          altitudes lifted, is logged on it first and the image formatted
+  *          again, so its sectors are still in the clusters the new log is
+  *          given. CTRL_TRIM fails throughout (no_erase), so nothing erases
+  *          them. None of them may turn up in the log read back.
+  *
+  *          Prints key=value: a line per failed run, then a summary. Exits
+  *          1 if any run failed.
+  *
+  *          Usage: powercut_test image.img telemetry_stream.csv [key=value ...]
+  *            runs=N        power cuts (default 200)
+  *            records=N     rows logged per run, short of the log's rotation
+  *                          (default 3000, 10 minutes)
+  *            seed=N        for the cut points (default 1)
+  *            size_mb=N     size of the image (default 32)
+  *            loop_us=N     superloop pass between polls (default 1000)
+  *            policy=N      TelemetryLog_SyncPolicy_t, with every=N (default
+  *                          the build's)
+  *            cut=N, torn=N one run, cut at that write with that many bytes
+  *                          of the sector landing, to replay a failed run;
+  *                          its image is kept
+  *            stale=1       start from an image holding an older log
+  *          and any SD_Image_Latency_t field, e.g. program_us=1500. The run
+  *          image is image.img with .cut appended.
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "hal_model.h"
+#include "sd_image.h"
+#include "telemetry_log.h"
+#include "telemetry_binlog.h"
+
+#define RATE_MS     200U    /* telemetry_streamer.py sends at 5 Hz */
+#define CHUNK       65536U  /* Image copy granularity */
+#define STALE_LIFT  1000.0f /* m added to the older flight's altitudes */
+#define STALE_BOOT_MS 3000U /* The older flight boots this much later: the
+                               model's card takes the same time on every boot,
+                               where the cycle count that goes into a real
+                               log's file ID varies */
+
+typedef struct {
+  const char *name;
+  uint32_t *value;
+} Option_t;
+
+/* One record as the packer holds it */
+typedef struct {
+  uint32_t value[TELEMETRY_BINLOG_FIELD_COUNT];
+} Record_t;
+
+/* What a boot reports back to the parent */
+typedef struct {
+  uint32_t writes;          /* Sectors written while logging */
+  uint32_t logged;          /* Records in the log */
+  uint32_t committed;       /* Records in the log when the last commit completed */
+  uint8_t mounted;
+} Boot_t;
+
+/* A log file read back */
+typedef struct {
+  Record_t *records;
+  uint32_t count;
+  uint32_t bad;             /* Sectors that fail their check */
+  uint8_t found;
+  uint8_t finished;         /* Ends in its index trailer */
+} Log_t;
+
+static SD_Image_Latency_t lat = SD_IMAGE_LATENCY_DEFAULT;
+static uint32_t loop_us = 1000, policy = 0xFFFFFFFFU, every = 0;
+static float (*rows)[3];
+static uint32_t row_count;
+static char drive[4];
+
+/* The formatted image, as its non-zero chunks */
+static uint8_t *base;
+static uint8_t *base_used;
+static uint32_t base_chunks;
+
+/* The image in the slot, as after power-on: diskio initialises a drive
+   once per link, so each attach links the driver afresh */
+static int attach(const char *path, uint32_t sectors)
+{
+  if (sd_image_open(path, sectors) != 0) return -1;
+  if (FATFS_LinkDriver(&USER_Driver, drive) != 0) {
+    sd_image_close();
+    return -1;
+  }
+  sd_image_set_latency(&lat);
+  return 0;
+}
+
+static void detach(void)
+{
+  FATFS_UnLinkDriver(drive);
+  sd_image_close();
+}
+
+/* xorshift32, so a seed gives the same cuts on any host */
+static uint32_t rng_state = 1;
+
+static uint32_t rng(void)
+{
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+/* Format the image, creating it with sectors (0: the existing one); the
+   data area is left as it is */
+static int format(const char *path, uint32_t sectors)
+{
+  static BYTE work[_MAX_SS];
+  FATFS fs;
+
+  if (attach(path, sectors) != 0) return -1;
+  FRESULT res = f_mkfs(drive, FM_ANY, 0, work, sizeof(work));
+  if (res == FR_OK) res = f_mount(&fs, drive, 1);
+  f_mount(NULL, drive, 0);
+  detach();
+  return res == FR_OK ? 0 : -1;
+}
+
+static int boot(const char *path, int log, uint32_t cut, uint32_t torn, Boot_t *shared);
+
+/* Format a new image, with stale over an older flight's log, then keep its
+   contents for the runs */
+static int make_base(const char *path, uint32_t size_mb, int stale, Boot_t *shared)
+{
+  unlink(path);
+  if (format(path, size_mb * 2048U) != 0) return -1;
+  if (stale && (boot(path, 2, 0, 0, shared) != 0 || !shared->logged || format(path, 0) != 0)) return -1;
+
+  FILE *f = fopen(path, "rb");
+  if (!f) return -1;
+  base_chunks = size_mb * (1024U * 1024U / CHUNK);
+  base = malloc((size_t)base_chunks * CHUNK);
+  base_used = calloc(base_chunks, 1);
+  if (!base || !base_used || fread(base, CHUNK, base_chunks, f) != base_chunks) {
+    fclose(f);
+    return -1;
+  }
+  fclose(f);
+  for (uint32_t c = 0; c < base_chunks; c++) {
+    const uint8_t *p = base + (size_t)c * CHUNK;
+    for (uint32_t i = 0; i < CHUNK && !base_used[c]; i++) base_used[c] = p[i] != 0;
+  }
+  return 0;
+}
+
+/* A fresh copy of the formatted image, sparse where it is zero */
+static int copy_base(const char *path)
+{
+  FILE *f = fopen(path, "wb");
+  int ok = f != NULL;
+
+  if (!f) return -1;
+  if (ftruncate(fileno(f), (off_t)base_chunks * CHUNK) != 0) ok = 0;
+  for (uint32_t c = 0; c < base_chunks && ok; c++) {
+    if (!base_used[c]) continue;
+    if (fseeko(f, (off_t)c * CHUNK, SEEK_SET) != 0 || fwrite(base + (size_t)c * CHUNK, CHUNK, 1, f) != 1) ok = 0;
+  }
+  if (fclose(f) != 0) ok = 0;
+  return ok ? 0 : -1;
+}
+
+/* Log the rows as fatlog_bench does, until they run out or the power is
+   cut; lift is added to the altitudes */
+static void boot_log(Boot_t *out, float lift)
+{
+  TelemetryData_t d = { 0 };
+  uint32_t commits = 0;
+
+  Mount_SD_Card();
+  if (!TelemetryLog_IsMounted()) return;
+  out->mounted = 1;
+  if (policy != 0xFFFFFFFFU) TelemetryLog_SetSyncPolicy((TelemetryLog_SyncPolicy_t)policy, every);
+  uint64_t mount_ns = hal_model_now_ns();
+
+  for (uint32_t n = 0; n < row_count && !sd_image_cut(); n++) {
+    uint64_t due_ns = mount_ns + (uint64_t)n * RATE_MS * 1000000U;
+    while (hal_model_now_ns() < due_ns && !sd_image_cut()) {
+      TelemetryLog_Poll();
+      const TelemetryLog_Stats_t *ls = TelemetryLog_GetStats();
+      if (ls->commits != commits && !sd_image_cut()) {
+        commits = ls->commits;
+        out->committed = ls->records;
+      }
+      if (hal_model_now_ns() < due_ns) hal_model_advance((uint64_t)loop_us * 1000U);
+    }
+    if (sd_image_cut()) break;
+
+    uint32_t ms = n * RATE_MS;
+    float dt = (ms - d.timestamp_ms) / 1000.0f;
+    if (dt < 0.001f) dt = 0.001f;
+    d.altitude_prev = d.altitude;
+    d.speed_prev = d.speed;
+    d.voltage_prev = d.voltage;
+    d.timestamp_prev = d.timestamp_ms;
+    d.altitude = rows[n][0] + lift;
+    d.speed = rows[n][1];
+    d.voltage = rows[n][2];
+    d.timestamp_ms = ms;
+    d.hours = ms / 3600000U;
+    d.minutes = ms / 60000U % 60U;
+    d.seconds = ms / 1000U % 60U;
+    d.altitude_rate = (d.altitude - d.altitude_prev) / dt;
+    d.speed_rate = (d.speed - d.speed_prev) / dt;
+    d.voltage_rate = (d.voltage - d.voltage_prev) / dt;
+
+    /* A commit here is a rotation, before the record goes in */
+    uint32_t before = TelemetryLog_GetStats()->records;
+    Telemetry_Log(&d);
+    const TelemetryLog_Stats_t *ls = TelemetryLog_GetStats();
+    if (ls->commits != commits && !sd_image_cut()) {
+      commits = ls->commits;
+      out->committed = before;
+    }
+  }
+  out->logged = TelemetryLog_GetStats()->records;
+  out->writes = sd_image_writes();
+}
+
+/* One boot in a child process: log with the power cut after cut writes
+   (0: none, closing the log at the end), or only mount and close; log 2
+   logs the older flight for stale=1 */
+static int boot(const char *path, int log, uint32_t cut, uint32_t torn, Boot_t *shared)
+{
+  memset(shared, 0, sizeof(*shared));
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid < 0) return -1;
+  if (pid == 0) {
+    if (attach(path, 0) != 0) _exit(1);
+    hal_model_reset();
+    sd_image_reset();
+    if (log == 2) hal_model_advance((uint64_t)STALE_BOOT_MS * 1000000U);
+    if (log) {
+      sd_image_set_cut(cut, torn);
+      boot_log(shared, log == 2 ? STALE_LIFT : 0.0f);
+      if (!cut) TelemetryLog_Close();
+    } else {
+      Mount_SD_Card();
+      shared->mounted = TelemetryLog_IsMounted();
+      TelemetryLog_Close();
+    }
+    detach();
+    exit(0);
+  }
+
+  int status;
+  if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) return -1;
+  return WEXITSTATUS(status) == 0 ? 0 : -1;
+}
+
+/* Read LOG00001 back, checking every sector */
+static int read_log(const char *path, Log_t *log)
+{
+  FATFS fs;
+  FIL fil;
+  uint8_t sector[TELEMETRY_LOG_SECTOR];
+  char name[16];
+  UINT br;
+  uint32_t cap = 0;
+  uint32_t id = 0;
+
+  memset(log, 0, sizeof(*log));
+  if (attach(path, 0) != 0) return -1;
+  snprintf(name, sizeof(name), "%s" TELEMETRY_LOG_PREFIX "00001" TELEMETRY_LOG_EXT, drive);
+  if (f_mount(&fs, drive, 1) != FR_OK) {
+    detach();
+    return -1;
+  }
+  if (f_open(&fil, name, FA_READ) == FR_OK) {
+    log->found = 1;
+    for (uint32_t seq = 0; f_read(&fil, sector, sizeof(sector), &br) == FR_OK && br; seq++) {
+      TelemetryBinlog_Packer_t p;
+      int32_t n;
+
+      if (br != sizeof(sector)) {
+        log->bad++;
+        break;
+      }
+      if (seq && TelemetryBinlog_Get16(sector) == TELEMETRY_BINLOG_INDEX_MAGIC) {
+        log->finished = TelemetryBinlog_CheckIndex(sector, seq, id) >= 0;
+        if (!log->finished) log->bad++;
+        break;
+      }
+      if (seq == 0) id = TelemetryBinlog_FileId(sector);
+      n = TelemetryBinlog_CheckSector(sector, seq, id);
+      if (n < 0) {
+        log->bad++;
+        continue;
+      }
+      if (seq == 0) continue;   /* Header */
+
+      uint8_t packed = TelemetryBinlog_Get16(sector) == TELEMETRY_BINLOG_PACKED_MAGIC;
+      uint32_t fill = TELEMETRY_BINLOG_PAYLOAD_OFFSET;
+      for (int32_t r = 0; r < n; r++) {
+        if (r == 0 || !packed) {
+          TelemetryBinlog_PackFirst(&p, sector + fill);
+          fill += TELEMETRY_BINLOG_RECORD_SIZE;
+        } else {
+          int32_t k = TelemetryBinlog_Unpack(&p, sector + fill, TELEMETRY_BINLOG_COUNT_OFFSET - fill);
+          if (k < 0) {
+            log->bad++;
+            break;
+          }
+          fill += (uint32_t)k;
+        }
+        if (log->count == cap) {
+          cap = cap ? cap * 2U : 1024U;
+          log->records = realloc(log->records, cap * sizeof(Record_t));
+          if (!log->records) abort();
+        }
+        memcpy(log->records[log->count++].value, p.value, sizeof(p.value));
+      }
+    }
+    f_close(&fil);
+  }
+  f_mount(NULL, drive, 0);
+  detach();
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t runs = 200, records = 3000, seed = 1, size_mb = 32, only_cut = 0, only_torn = 0, stale = 0;
+  Option_t options[] = {
+    { "runs", &runs }, { "records", &records }, { "seed", &seed }, { "size_mb", &size_mb },
+    { "loop_us", &loop_us }, { "policy", &policy }, { "every", &every },
+    { "cut", &only_cut }, { "torn", &only_torn }, { "stale", &stale },
+    { "cmd_us", &lat.cmd_us }, { "xfer_us", &lat.xfer_us }, { "access_us", &lat.access_us },
+    { "program_us", &lat.program_us }, { "stream_us", &lat.stream_us }, { "stop_us", &lat.stop_us },
+    { "spike_us", &lat.spike_us }, { "spike_every", &lat.spike_every }, { "poll_us", &lat.poll_us },
+    { "erase_us", &lat.erase_us }, { "erase_sectors", &lat.erase_sectors }, { "no_erase", &lat.no_erase },
+  };
+
+  if (argc < 3) {
+    fprintf(stderr, "usage: powercut_test image.img telemetry_stream.csv [key=value ...]\n");
+    return 2;
+  }
+  for (int i = 3; i < argc; i++) {
+    char *eq = strchr(argv[i], '=');
+    size_t n = eq ? (size_t)(eq - argv[i]) : 0;
+    size_t k;
+
+    for (k = 0; k < sizeof(options) / sizeof(options[0]); k++) {
+      if (eq && strlen(options[k].name) == n && strncmp(argv[i], options[k].name, n) == 0) break;
+    }
+    if (k == sizeof(options) / sizeof(options[0])) {
+      fprintf(stderr, "%s: unknown option\n", argv[i]);
+      return 2;
+    }
+    *options[k].value = (uint32_t)strtoul(eq + 1, NULL, 0);
+  }
+  rng_state = seed ? seed : 1;
+  if (stale) lat.no_erase = 1;
+  if ((uint64_t)records * RATE_MS >= TELEMETRY_LOG_ROTATE_MS) {
+    fprintf(stderr, "records=%u: the log would rotate\n", records);
+    return 2;
+  }
+
+  FILE *in = fopen(argv[2], "r");
+  char line[128];
+  if (!in) {
+    perror(argv[2]);
+    return 1;
+  }
+  rows = malloc((size_t)records * sizeof(*rows));
+  while (rows && row_count < records && fgets(line, sizeof(line), in)) {
+    if (sscanf(line, "%f,%f,%f", &rows[row_count][0], &rows[row_count][1], &rows[row_count][2]) == 3) row_count++;
+  }
+  fclose(in);
+
+  char run_path[512];
+  snprintf(run_path, sizeof(run_path), "%s.cut", argv[1]);
+  Boot_t *shared = mmap(NULL, sizeof(Boot_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared == MAP_FAILED || make_base(argv[1], size_mb, stale != 0, shared) != 0) {
+    fprintf(stderr, "%s: cannot create and format the image\n", argv[1]);
+    return 1;
+  }
+
+  /* The run without a cut: what every run must match */
+  Log_t ref;
+  if (copy_base(run_path) != 0 || boot(run_path, 1, 0, 0, shared) != 0 || !shared->mounted ||
+      read_log(run_path, &ref) != 0 || !ref.finished || ref.bad || ref.count != shared->logged) {
+    fprintf(stderr, "%s: the run without a cut failed\n", run_path);
+    return 1;
+  }
+  uint32_t writes = shared->writes;
+  if (only_cut) runs = 1;
+
+  uint32_t failed = 0, torn_valid = 0;
+  uint64_t committed_sum = 0, recovered_sum = 0;
+  for (uint32_t r = 0; r < runs; r++) {
+    uint32_t cut = only_cut ? only_cut : 1U + rng() % writes;
+    uint32_t torn = only_cut ? only_torn : rng() % TELEMETRY_LOG_SECTOR;
+    Boot_t first;
+    Log_t log = { 0 };
+    int ok = copy_base(run_path) == 0 && boot(run_path, 1, cut, torn, shared) == 0;
+
+    first = *shared;
+    ok = ok && boot(run_path, 0, 0, 0, shared) == 0 && shared->mounted && read_log(run_path, &log) == 0;
+    if (ok) {
+      /* Nothing lost that was committed, nothing there that was not logged */
+      ok = log.bad == 0 && log.count >= first.committed && log.count <= ref.count &&
+           (first.committed == 0 || (log.found && log.finished));
+      for (uint32_t i = 0; ok && i < log.count; i++) {
+        ok = memcmp(&log.records[i], &ref.records[i], sizeof(Record_t)) == 0;
+      }
+    }
+    if (!ok) {
+      failed++;
+      printf("run=%u cut=%u torn=%u committed=%u logged=%u recovered=%u bad=%u found=%u finished=%u\n",
+             r, cut, torn, first.committed, first.logged, log.count, log.bad, log.found, log.finished);
+    }
+    if (torn) torn_valid++;
+    committed_sum += first.committed;
+    recovered_sum += log.count;
+    free(log.records);
+  }
+
+  printf("runs=%u failed=%u writes=%u records=%u torn=%u committed_mean=%.1f recovered_mean=%.1f stale=%u\n",
+         runs, failed, writes, ref.count, torn_valid, runs ? (double)committed_sum / runs : 0.0,
+         runs ? (double)recovered_sum / runs : 0.0, stale);
+  if (!only_cut) unlink(run_path);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,326 @@
+/**
+  ******************************************************************************
+  * @file    sd_bench.c
+  * @brief   SD_Card_Driver/user_diskio.c against the SPI-mode card model.
+  *
+  *          Builds the firmware driver unchanged, SPI1 with its DMA streams
+  *          and CS on PB10 as main.c sets them up, and attaches
+  *          sd_card_model.c to the bus. Initialises the card, then for each
+  *          access pattern writes or reads count sectors and checks every
+  *          byte against the card's storage:
+  *            write1   USER_write one sector at a time, then CTRL_SYNC
+  *            write8   USER_write eight sectors at a time (CMD25)
+  *            stream   USER_StreamWrite, ACMD23 hint, then USER_StreamStop
+  *            read1    USER_read one sector at a time
+  *            read8    USER_read eight sectors at a time (CMD18)
+  *            readpoll USER_ReadStart eight sectors, USER_Poll until done
+  *
+  *          Then CTRL_TRIM erases most of what write1 left, and it must read
+  *          back erased. The card is then formatted and the firmware's B1
+  *          benchmark (telemetry_sdbench.c) runs on FatFs over the driver,
+  *          printing its lines as the board sends them; every sector it
+  *          reads back must match. Last, the card is initialised twice more: as it is,
+  *          which a remount does and the driver picks up without starting
+  *          over, and after a power cycle, as a swapped card is.
+  *
+  *          Prints key=value per pattern: simulated time and KB/s, bus
+  *          bytes per sector, and what the card saw. The init lines have
+  *          the capacity and erase block the driver read from the card, and
+  *          the clock it settled on.
+  *
+  *          Usage: sd_bench sdv1|sdv2|sdhc [key=value ...]
+  *            count=N       sectors per pattern (default 2048)
+  *            pclk_hz=N     SPI1 kernel clock (default 84000000, APB2)
+  *          and any SD_Card_Model_Config_t timing field, e.g. stream_us=500,
+  *          or max_hz to have the clock chosen lower. The sdv1 card has no
+  *          CMD6, so it stays at 21 MHz.
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_model.h"
+#include "sd_card_model.h"
+#include "ff_gen_drv.h"
+#include "user_diskio.h"
+#include "telemetry_sdbench.h"
+
+#define PATTERNS    6U
+
+SPI_HandleTypeDef hspi1;
+static DMA_Stream_TypeDef dma2_stream2, dma2_stream3;
+static DMA_HandleTypeDef hdma_spi1_rx = { &dma2_stream2 };
+static DMA_HandleTypeDef hdma_spi1_tx = { &dma2_stream3 };
+
+/* As main.c forwards them */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  USER_SPI_TxCpltCallback(hspi);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  USER_SPI_TxRxCpltCallback(hspi);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  USER_SPI_ErrorCallback(hspi);
+}
+
+typedef struct {
+  const char *name;
+  uint32_t *value;
+} Option_t;
+
+static uint32_t count = 2048;
+
+/* Contents of one sector for pattern p */
+static void fill(uint8_t *buf, uint32_t p, DWORD lba)
+{
+  uint32_t x = (lba + 1U) * 2654435761U ^ (p + 1U) * 40503U;
+
+  for (uint32_t i = 0; i < 512; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    buf[i] = (uint8_t)x;
+  }
+}
+
+/* Sectors wrong on the card, or in buf (NULL: not read) */
+static uint32_t verify(uint32_t p, DWORD base, const uint8_t *buf)
+{
+  uint8_t want[512];
+  uint32_t bad = 0;
+
+  for (uint32_t i = 0; i < count; i++) {
+    fill(want, p, base + i);
+    if (memcmp(sd_card_model_data() + (size_t)(base + i) * 512U, want, 512) != 0 ||
+        (buf && memcmp(buf + (size_t)i * 512U, want, 512) != 0)) bad++;
+  }
+  return bad;
+}
+
+static SD_Card_Model_Config_t cfg = SD_CARD_MODEL_CONFIG_DEFAULT;
+
+typedef struct {
+  uint64_t ns;
+  uint64_t bus_bytes;
+  SD_Card_Model_Stats_t card;
+} Mark_t;
+
+static void mark(Mark_t *m)
+{
+  m->ns = hal_model_now_ns();
+  m->bus_bytes = hal_model_stats()->spi[0].bytes;
+  m->card = *sd_card_model_stats();
+}
+
+static void report(const char *card, const char *name, const Mark_t *m, DRESULT res, uint32_t bad)
+{
+  Mark_t e;
+  mark(&e);
+  double s = (e.ns - m->ns) / 1e9;
+
+  printf("card=%s pattern=%s sectors=%u res=%d bad=%u ms=%.2f kb_per_s=%.0f bus_bytes_per_sector=%.1f "
+         "commands=%u busy_bytes=%u token_bytes=%u crc_errors=%u refused=%u\n",
+         card, name, count, (int)res, bad, s * 1e3, s > 0 ? count / 2.0 / s : 0.0,
+         (double)(e.bus_bytes - m->bus_bytes) / count,
+         e.card.commands - m->card.commands, e.card.busy_bytes - m->card.busy_bytes,
+         e.card.token_bytes - m->card.token_bytes, e.card.crc_errors - m->card.crc_errors,
+         e.card.refused - m->card.refused);
+}
+
+/* USER_initialize, checked against what the card is */
+static DSTATUS init(const char *card, const char *name)
+{
+  Mark_t m, e;
+  DWORD sectors = 0, erase_sectors = 0;
+
+  mark(&m);
+  DSTATUS st = USER_Driver.disk_initialize(0);
+  mark(&e);
+  USER_Driver.disk_ioctl(0, GET_SECTOR_COUNT, &sectors);
+  USER_Driver.disk_ioctl(0, GET_BLOCK_SIZE, &erase_sectors);
+  printf("card=%s %s_ms=%.2f status=0x%02X commands=%u bus_hz=%u sectors=%lu erase_sectors=%lu\n",
+         card, name, (e.ns - m.ns) / 1e6, st, e.card.commands - m.card.commands, hal_model_spi_hz(&hspi1),
+         (unsigned long)sectors, (unsigned long)erase_sectors);
+  if (!(st & STA_NOINIT) && (sectors != cfg.sectors || erase_sectors == 0)) {
+    fprintf(stderr, "%s: capacity or erase block not read from the card\n", card);
+    st |= STA_NOINIT;
+  }
+  if (e.card.blocks_written != m.card.blocks_written) {
+    fprintf(stderr, "%s: initialisation wrote to the card\n", card);
+    st |= STA_NOINIT;
+  }
+  return st;
+}
+
+/* The firmware's benchmark on a freshly formatted card; 0 if every case
+   read back what it wrote */
+static int fw_bench(const char *card)
+{
+  static TelemetrySdbench_Result_t results[TELEMETRY_SDBENCH_CASES];
+  static BYTE work[_MAX_SS];
+  char drive[4], line[256];
+  uint32_t errors = 0;
+  FRESULT res = FR_NOT_READY;
+
+  if (FATFS_LinkDriver(&USER_Driver, drive) == 0) {
+    res = f_mkfs(drive, FM_ANY, 0, work, sizeof(work));
+    if (res == FR_OK) res = TelemetrySdbench_Run(results, NULL);
+    FATFS_UnLinkDriver(drive);
+  }
+  for (uint32_t c = 0; res == FR_OK && c < TELEMETRY_SDBENCH_CASES; c++) {
+    for (uint32_t k = 0; TelemetrySdbench_Format(&results[c], k, line, sizeof(line)) > 0; k++) {
+      printf("card=%s %s\n", card, line);
+    }
+    errors += results[c].errors;
+  }
+  printf("card=%s fw_bench res=%d cases=%u errors=%u\n", card, (int)res, (unsigned)TELEMETRY_SDBENCH_CASES, errors);
+  return res != FR_OK || errors;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t pclk_hz = 84000000U;
+  Option_t options[] = {
+    { "count", &count }, { "pclk_hz", &pclk_hz },
+    { "init_us", &cfg.init_us }, { "access_us", &cfg.access_us }, { "program_us", &cfg.program_us },
+    { "stream_us", &cfg.stream_us }, { "stop_us", &cfg.stop_us }, { "erase_us", &cfg.erase_us },
+    { "spike_us", &cfg.spike_us }, { "spike_every", &cfg.spike_every }, { "max_hz", &cfg.max_hz },
+  };
+
+  if (argc < 2) {
+    fprintf(stderr, "usage: sd_bench sdv1|sdv2|sdhc [key=value ...]\n");
+    return 2;
+  }
+  if (strcmp(argv[1], "sdv1") == 0) cfg.type = SD_CARD_MODEL_SDV1;
+  else if (strcmp(argv[1], "sdv2") == 0) cfg.type = SD_CARD_MODEL_SDV2;
+  else if (strcmp(argv[1], "sdhc") != 0) {
+    fprintf(stderr, "%s: not a card type\n", argv[1]);
+    return 2;
+  }
+  for (int i = 2; i < argc; i++) {
+    char *eq = strchr(argv[i], '=');
+    size_t n = eq ? (size_t)(eq - argv[i]) : 0;
+    size_t k;
+
+    for (k = 0; k < sizeof(options) / sizeof(options[0]); k++) {
+      if (eq && strlen(options[k].name) == n && strncmp(argv[i], options[k].name, n) == 0) break;
+    }
+    if (k == sizeof(options) / sizeof(options[0])) {
+      fprintf(stderr, "%s: unknown option\n", argv[i]);
+      return 2;
+    }
+    *options[k].value = (uint32_t)strtoul(eq + 1, NULL, 0);
+  }
+  count = (count + 7U) & ~7U;
+  if (count == 0 || cfg.sectors < PATTERNS * count) {
+    fprintf(stderr, "count=%u does not fit %u patterns on the card\n", count, PATTERNS);
+    return 2;
+  }
+
+  /* MX_SPI1_Init and MX_DMA_Init: 8-bit frames at PCLK2/2 */
+  hal_model_reset();
+  hspi1.Instance = SPI1;
+  hspi1.ClockSpeed = pclk_hz;
+  hspi1.Init.DataSize = SPI_DATASIZE_8BIT;
+  hspi1.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+  hspi1.Init.CRCPolynomial = 10;
+  hspi1.hdmatx = &hdma_spi1_tx;
+  hspi1.hdmarx = &hdma_spi1_rx;
+  SPI1->CR1 = SPI_BAUDRATEPRESCALER_2 | SPI_CR1_SPE;
+  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_10, GPIO_PIN_SET);
+
+  if (sd_card_model_init(&cfg) != 0) {
+    fprintf(stderr, "%s: sectors=%u is not a size the CSD can describe\n", argv[1], cfg.sectors);
+    return 2;
+  }
+  sd_card_model_attach(SPI1, GPIOB, GPIO_PIN_10);
+
+  Mark_t m;
+  DSTATUS st = init(argv[1], "init");
+  if (st & STA_NOINIT) return 1;
+
+  uint8_t *buf = malloc((size_t)count * 512U);
+  if (!buf) return 1;
+  int failed = 0;
+
+  for (uint32_t p = 0; p < PATTERNS; p++) {
+    static const char *const names[PATTERNS] = { "write1", "write8", "stream", "read1", "read8", "readpoll" };
+    DWORD base = p * count;
+    DRESULT res = RES_OK;
+    uint32_t bad;
+
+    if (p >= 3) {
+      /* Reads go back over what write1, write8 and stream left */
+      base = (p - 3U) * count;
+      memset(buf, 0, (size_t)count * 512U);
+    } else {
+      for (uint32_t i = 0; i < count; i++) fill(buf + (size_t)i * 512U, p, base + i);
+    }
+
+    mark(&m);
+    switch (p) {
+    case 0:
+      for (uint32_t i = 0; i < count && res == RES_OK; i++) res = USER_Driver.disk_write(0, buf + (size_t)i * 512U, base + i, 1);
+      if (res == RES_OK) res = USER_Driver.disk_ioctl(0, CTRL_SYNC, NULL);
+      break;
+    case 1:
+      for (uint32_t i = 0; i < count && res == RES_OK; i += 8) res = USER_Driver.disk_write(0, buf + (size_t)i * 512U, base + i, 8);
+      if (res == RES_OK) res = USER_Driver.disk_ioctl(0, CTRL_SYNC, NULL);
+      break;
+    case 2:
+      for (uint32_t i = 0; i < count && res == RES_OK; i++) res = USER_StreamWrite(buf + (size_t)i * 512U, base + i, i ? 0 : count);
+      if (USER_StreamStop() != RES_OK) res = RES_ERROR;
+      break;
+    case 3:
+      for (uint32_t i = 0; i < count && res == RES_OK; i++) res = USER_Driver.disk_read(0, buf + (size_t)i * 512U, base + i, 1);
+      break;
+    case 4:
+      for (uint32_t i = 0; i < count && res == RES_OK; i += 8) res = USER_Driver.disk_read(0, buf + (size_t)i * 512U, base + i, 8);
+      break;
+    case 5:
+      for (uint32_t i = 0; i < count && res == RES_OK; i += 8) {
+        res = USER_ReadStart(buf + (size_t)i * 512U, base + i, 8);
+        while (res == RES_OK && !USER_Poll()) continue;
+        if (res == RES_OK) res = USER_ReadResult();
+      }
+      break;
+    }
+    bad = verify(p >= 3 ? p - 3U : p, base, p >= 3 ? buf : NULL);
+    report(argv[1], names[p], &m, res, bad);
+    if (res != RES_OK || bad) failed = 1;
+  }
+
+  /* Sectors 1..count-2 of write1; the first and last must survive */
+  DWORD range[2] = { 1, count - 2U };
+  uint8_t want[512];
+  uint32_t bad = 0;
+  DRESULT res;
+
+  mark(&m);
+  res = USER_Driver.disk_ioctl(0, CTRL_TRIM, range);
+  for (DWORD i = 0; i < count && res == RES_OK; i++) {
+    if (i >= range[0] && i <= range[1]) memset(want, 0, 512);
+    else fill(want, 0, i);
+    res = USER_Driver.disk_read(0, buf, i, 1);
+    if (memcmp(buf, want, 512) != 0) bad++;
+  }
+  report(argv[1], "trim", &m, res, bad);
+  if (res != RES_OK || bad) failed = 1;
+
+  if (fw_bench(argv[1])) failed = 1;
+
+  /* A remount, then a power cycle */
+  if (init(argv[1], "reinit") & STA_NOINIT) failed = 1;
+  sd_card_model_init(&cfg);
+  sd_card_model_attach(SPI1, GPIOB, GPIO_PIN_10);
+  if (init(argv[1], "power_cycle") & STA_NOINIT) failed = 1;
+
+  free(buf);
+  return failed;
+}
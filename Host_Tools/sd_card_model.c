@@ -0,0 +1,565 @@
+/**
+  ******************************************************************************
+  * @file    sd_card_model.c
+  * @brief   Host model of an SD card in SPI mode. See sd_card_model.h.
+  *
+  *          Each byte the bus clocks while the card is selected goes out
+  *          from, in order: a queued response, the read data in flight, or
+  *          0x00 while the card is busy, else 0xFF. The byte coming in goes
+  *          to whatever the card was doing when it started. While sending
+  *          read data the card still takes command frames, so any byte the
+  *          host clocks out then other than 0xFF can start one.
+  ******************************************************************************
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "hal_model.h"
+#include "sd_card_model.h"
+
+/* R1 bits */
+#define R1_IDLE         0x01
+#define R1_ILLEGAL      0x04
+#define R1_CRC_ERROR    0x08
+#define R1_ADDR_ERROR   0x20
+#define R1_PARAM_ERROR  0x40
+
+/* Tokens and data responses */
+#define TOKEN_START     0xFE    /* CMD17/18 data, CMD24 data */
+#define TOKEN_MULTI     0xFC    /* CMD25 data */
+#define TOKEN_STOP      0xFD    /* End of CMD25 */
+#define TOKEN_RANGE     0x08    /* Data error token: out of range */
+#define DATA_ACCEPTED   0x05
+#define DATA_CRC_ERROR  0x0B
+#define DATA_WR_ERROR   0x0D
+
+#define ERASED_BYTE     0x00    /* DATA_STAT_AFTER_ERASE */
+#define SD_STATUS_AU_SIZE 9U    /* Allocation unit of 4 MB */
+#define DEFAULT_SPEED_HZ 25000000U /* Fastest clock before CMD6 switches to high speed */
+
+typedef enum {
+  PHASE_CMD = 0,        /* Taking command frames */
+  PHASE_READ,           /* Sending data blocks, or a register */
+  PHASE_WRITE,          /* Waiting for a data or stop token */
+  PHASE_WRITE_DATA      /* Taking a block and its CRC */
+} Phase_t;
+
+static struct {
+  SD_Card_Model_Config_t cfg;
+  SD_Card_Model_Stats_t stats;
+  uint8_t *data;
+  GPIO_TypeDef *cs_port;
+  uint16_t cs_pin;
+
+  uint32_t powerup_clocks;  /* Clocks while deselected, before the first CMD0 */
+  uint8_t spi_mode;         /* CMD0 taken with CS low */
+  uint8_t idle;             /* Initialising; ACMD41 ends it */
+  uint8_t app;              /* The last command was CMD55 */
+  uint8_t crc_on;           /* CMD59 */
+  uint8_t high_speed;       /* CMD6 switched function group 1 to high speed */
+  uint8_t init_started;     /* First ACMD41 seen, at ready_ns - init_us */
+  uint64_t ready_ns;
+  uint64_t busy_until_ns;   /* DO held low until then */
+
+  uint8_t frame[6];         /* Command frame */
+  uint8_t frame_len;
+  uint8_t resp[8];          /* Response bytes, ahead of anything else */
+  uint8_t resp_len, resp_pos;
+
+  Phase_t phase;
+  uint8_t multi;            /* CMD18 or CMD25 */
+  uint8_t reg;              /* Reading a CSD, CID or SD status, not storage */
+  uint32_t block;           /* Next block to read or write */
+  uint8_t buf[512 + 2];     /* Data and its CRC16 */
+  uint16_t buf_len;         /* Data bytes in buf */
+  int32_t buf_pos;          /* Read: -1 until the token goes out */
+  uint64_t token_ns;        /* Read: when the next token is ready */
+  uint32_t erase_start, erase_end;
+  uint32_t programmed;      /* Blocks written, for spike_every */
+} card;
+
+/* CRC ------------------------------------------------------------------------*/
+/* CRC7 of a command and its end bit, as the frame's last byte */
+static uint8_t crc7(const uint8_t *p, uint32_t n)
+{
+  uint8_t crc = 0;
+
+  while (n--) {
+    uint8_t d = *p++;
+    for (int i = 0; i < 8; i++) {
+      crc <<= 1;
+      if ((d ^ crc) & 0x80) crc ^= 0x09;
+      d <<= 1;
+    }
+  }
+  return (uint8_t)((crc << 1) | 1);
+}
+
+/* CRC16 of a data block, x^16 + x^12 + x^5 + 1 */
+static uint16_t crc16(const uint8_t *p, uint32_t n)
+{
+  uint16_t crc = 0;
+
+  while (n--) {
+    crc ^= (uint16_t)(*p++ << 8);
+    for (int i = 0; i < 8; i++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+/* Registers ------------------------------------------------------------------*/
+/* Field of a 128-bit register at bits lsb..lsb+width-1, bit 127 first in memory */
+static void reg_field(uint8_t *reg, uint32_t lsb, uint32_t width, uint32_t value)
+{
+  for (uint32_t i = 0; i < width; i++) {
+    uint32_t bit = lsb + i;
+    if ((value >> i) & 1U) reg[15 - bit / 8] |= (uint8_t)(1U << (bit % 8));
+  }
+}
+
+static void build_csd(uint8_t *csd)
+{
+  memset(csd, 0, 16);
+  reg_field(csd, 112, 8, 0x0E);             /* TAAC: 1 ms */
+  reg_field(csd, 96, 8, 0x32);              /* TRAN_SPEED: 25 MHz */
+  reg_field(csd, 84, 12, 0x5B5);            /* CCC */
+  reg_field(csd, 80, 4, 9);                 /* READ_BL_LEN: 512 */
+  if (card.cfg.type == SD_CARD_MODEL_SDHC) {
+    reg_field(csd, 126, 2, 1);              /* CSD version 2.0 */
+    reg_field(csd, 48, 22, card.cfg.sectors / 1024U - 1U);
+  } else {
+    reg_field(csd, 62, 12, card.cfg.sectors / 512U - 1U);
+    reg_field(csd, 47, 3, 7);               /* C_SIZE_MULT: 512 */
+  }
+  reg_field(csd, 46, 1, 1);                 /* ERASE_BLK_EN */
+  reg_field(csd, 39, 7, 0x7F);              /* SECTOR_SIZE */
+  reg_field(csd, 22, 4, 9);                 /* WRITE_BL_LEN: 512 */
+  csd[15] = crc7(csd, 15);
+}
+
+static void build_cid(uint8_t *cid)
+{
+  memset(cid, 0, 16);
+  cid[0] = 0xAA;                            /* MID */
+  memcpy(cid + 1, "HTMODEL", 7);            /* OID, PNM */
+  cid[8] = 0x10;                            /* PRV 1.0 */
+  cid[9] = 0x12;                            /* PSN */
+  cid[10] = 0x34;
+  cid[11] = 0x56;
+  cid[12] = 0x78;
+  reg_field(cid, 8, 12, (25U << 4) | 10U);  /* MDT: 2025-10 */
+  cid[15] = crc7(cid, 15);
+}
+
+/* SD status (ACMD13), 512 bits; only AU_SIZE is filled in */
+static void build_status(uint8_t *status)
+{
+  memset(status, 0, 64);
+  status[10] = SD_STATUS_AU_SIZE << 4;
+}
+
+/* CMD6 switch status, 512 bits: function group 1 offers default and high
+   speed, and reports fn, or 0xF if it cannot be had */
+static void build_switch_status(uint8_t *status, uint8_t fn)
+{
+  memset(status, 0, 64);
+  status[1] = 100;                          /* Maximum current, mA */
+  status[13] = 0x03;                        /* Group 1 functions 0 and 1 */
+  status[16] = fn;                          /* Group 1 result, bits 379:376 */
+}
+
+/* Card ----------------------------------------------------------------------*/
+/* Whether the bus clock is too fast for the card or the wiring, so that data
+   blocks pick up bit errors */
+static int clock_too_fast(void)
+{
+  uint32_t hz = hal_model_spi_clocking_hz();
+  if (card.cfg.max_hz && hz > card.cfg.max_hz) return 1;
+  return !card.high_speed && hz > DEFAULT_SPEED_HZ;
+}
+
+static void respond(const uint8_t *r, uint8_t n)
+{
+  card.resp[0] = 0xFF;                      /* Ncr */
+  memcpy(card.resp + 1, r, n);
+  card.resp_len = (uint8_t)(n + 1);
+  card.resp_pos = 0;
+}
+
+static void set_busy(uint32_t us)
+{
+  card.busy_until_ns = hal_model_now_ns() + (uint64_t)us * 1000U;
+}
+
+static void read_start(void)
+{
+  card.phase = PHASE_READ;
+  card.buf_pos = -1;
+  card.token_ns = hal_model_now_ns() + (uint64_t)card.cfg.access_us * 1000U;
+}
+
+static void phase_end(void)
+{
+  card.phase = PHASE_CMD;
+  card.frame_len = 0;
+}
+
+/* Block a read or write command addresses, or -1 with the R1 error */
+static int32_t cmd_block(uint32_t arg, uint8_t *r1)
+{
+  uint32_t block = arg;
+
+  if (card.cfg.type != SD_CARD_MODEL_SDHC) {
+    if (arg % 512U) {
+      *r1 |= R1_ADDR_ERROR;
+      return -1;
+    }
+    block = arg / 512U;
+  }
+  if (block >= card.cfg.sectors) {
+    *r1 |= R1_PARAM_ERROR;
+    return -1;
+  }
+  return (int32_t)block;
+}
+
+static void app_command(uint8_t cmd, uint32_t arg, uint8_t *r1)
+{
+  switch (cmd) {
+  case 41:                                  /* SD_SEND_OP_COND */
+    if (!card.init_started) {
+      card.init_started = 1;
+      card.ready_ns = hal_model_now_ns() + (uint64_t)card.cfg.init_us * 1000U;
+    }
+    /* A high capacity card stays idle for a host that does not set HCS */
+    if (card.cfg.type == SD_CARD_MODEL_SDHC && !(arg & (1UL << 30))) break;
+    if (hal_model_now_ns() >= card.ready_ns) card.idle = 0;
+    *r1 = card.idle ? R1_IDLE : 0;
+    break;
+  case 23:                                  /* SET_WR_BLK_ERASE_COUNT: a hint */
+    break;
+  default:
+    *r1 |= R1_ILLEGAL;
+  }
+}
+
+static void command(void)
+{
+  uint8_t cmd = card.frame[0] & 0x3F;
+  uint32_t arg = ((uint32_t)card.frame[1] << 24) | ((uint32_t)card.frame[2] << 16) |
+                 ((uint32_t)card.frame[3] << 8) | card.frame[4];
+  uint8_t app = card.app;
+  uint8_t r[5] = { 0 };
+  uint8_t n = 1;
+  int32_t block;
+
+  /* Only CMD0 with CS low puts a powered-up card in SPI mode */
+  if (!card.spi_mode && (cmd != 0 || card.powerup_clocks < 74)) return;
+
+  card.stats.commands++;
+  card.app = 0;
+  r[0] = card.idle ? R1_IDLE : 0;
+
+  /* In SPI mode CMD0 and CMD8 always carry a checked CRC */
+  if ((card.crc_on || cmd == 0 || cmd == 8) && crc7(card.frame, 5) != card.frame[5]) {
+    card.stats.crc_errors++;
+    r[0] |= R1_CRC_ERROR;
+    respond(r, 1);
+    return;
+  }
+
+  if (app && cmd == 13 && !card.idle) {                 /* SD_STATUS, R2 and a data block */
+    build_status(card.buf);
+    card.buf_len = 64;
+    card.reg = 1;
+    card.multi = 0;
+    respond(r, 2);
+    read_start();
+    return;
+  } else if (app) {
+    app_command(cmd, arg, &r[0]);
+  } else if (card.idle && cmd != 0 && cmd != 8 && cmd != 55 && cmd != 58 && cmd != 59) {
+    r[0] |= R1_ILLEGAL;
+  } else {
+    switch (cmd) {
+    case 0:                                 /* GO_IDLE_STATE */
+      card.spi_mode = 1;
+      card.idle = 1;
+      card.crc_on = 0;
+      card.high_speed = 0;
+      card.init_started = 0;
+      phase_end();
+      r[0] = R1_IDLE;
+      break;
+    case 8:                                 /* SEND_IF_COND, R7 */
+      if (card.cfg.type == SD_CARD_MODEL_SDV1) {
+        r[0] |= R1_ILLEGAL;
+        break;
+      }
+      r[3] = (uint8_t)((arg >> 8) & 0x0F);  /* Voltage accepted */
+      r[4] = (uint8_t)arg;                  /* Check pattern */
+      n = 5;
+      break;
+    case 6:                                 /* SWITCH_FUNC, R1 and a data block */
+      if (card.cfg.type == SD_CARD_MODEL_SDV1) {
+        r[0] |= R1_ILLEGAL;                 /* SD 1.0 has no CMD6 */
+        break;
+      }
+      if ((arg & 0xFU) > 1U) {
+        build_switch_status(card.buf, 0xF);
+      } else {
+        uint8_t fn = (arg & 0xFU) == 1U || ((arg & 0xFU) == 0xFU && card.high_speed);
+        if (arg & 0x80000000UL) card.high_speed = fn;
+        build_switch_status(card.buf, fn);
+      }
+      card.buf_len = 64;
+      card.reg = 1;
+      card.multi = 0;
+      respond(r, 1);
+      read_start();
+      return;
+    case 9:                                 /* SEND_CSD */
+    case 10:                                /* SEND_CID */
+      if (cmd == 9) build_csd(card.buf);
+      else build_cid(card.buf);
+      card.buf_len = 16;
+      card.reg = 1;
+      card.multi = 0;
+      respond(r, 1);
+      read_start();
+      return;
+    case 12:                                /* STOP_TRANSMISSION */
+      phase_end();
+      break;
+    case 13:                                /* SEND_STATUS, R2 */
+      n = 2;
+      break;
+    case 16:                                /* SET_BLOCKLEN */
+      if (arg != 512U && card.cfg.type != SD_CARD_MODEL_SDHC) r[0] |= R1_PARAM_ERROR;
+      break;
+    case 17:                                /* READ_SINGLE_BLOCK */
+    case 18:                                /* READ_MULTIPLE_BLOCK */
+      block = cmd_block(arg, &r[0]);
+      if (block < 0) break;
+      card.block = (uint32_t)block;
+      card.reg = 0;
+      card.multi = (cmd == 18);
+      respond(r, 1);
+      read_start();
+      return;
+    case 24:                                /* WRITE_BLOCK */
+    case 25:                                /* WRITE_MULTIPLE_BLOCK */
+      block = cmd_block(arg, &r[0]);
+      if (block < 0) break;
+      card.block = (uint32_t)block;
+      card.multi = (cmd == 25);
+      card.phase = PHASE_WRITE;
+      break;
+    case 32:                                /* ERASE_WR_BLK_START */
+    case 33:                                /* ERASE_WR_BLK_END */
+      block = cmd_block(arg, &r[0]);
+      if (block < 0) break;
+      if (cmd == 32) card.erase_start = (uint32_t)block;
+      else card.erase_end = (uint32_t)block;
+      break;
+    case 38:                                /* ERASE */
+      if (card.erase_end < card.erase_start) {
+        r[0] |= R1_PARAM_ERROR;
+        break;
+      }
+      memset(card.data + (size_t)card.erase_start * 512U, ERASED_BYTE,
+             (size_t)(card.erase_end - card.erase_start + 1U) * 512U);
+      set_busy(card.cfg.erase_us);
+      break;
+    case 55:                                /* APP_CMD */
+      card.app = 1;
+      break;
+    case 58:                                /* READ_OCR, R3 */
+      r[1] = card.idle ? 0x00 : 0x80;       /* Power up done */
+      if (!card.idle && card.cfg.type == SD_CARD_MODEL_SDHC) r[1] |= 0x40; /* CCS */
+      r[2] = 0xFF;                          /* 2.7-3.6 V */
+      r[3] = 0x80;
+      n = 5;
+      break;
+    case 59:                                /* CRC_ON_OFF */
+      card.crc_on = (uint8_t)(arg & 1U);
+      break;
+    default:
+      r[0] |= R1_ILLEGAL;
+    }
+  }
+  if (r[0] & (R1_ILLEGAL | R1_ADDR_ERROR | R1_PARAM_ERROR)) card.stats.refused++;
+  respond(r, n);
+}
+
+/* Next byte of read data: 0xFF until the token is due, then the token,
+   the block and its CRC */
+static uint8_t read_byte(void)
+{
+  if (card.buf_pos < 0) {
+    if (hal_model_now_ns() < card.token_ns) {
+      card.stats.token_bytes++;
+      return 0xFF;
+    }
+    if (!card.reg) {
+      if (card.block >= card.cfg.sectors) {
+        phase_end();
+        return TOKEN_RANGE;
+      }
+      memcpy(card.buf, card.data + (size_t)card.block * 512U, 512);
+      card.buf_len = 512;
+    }
+    uint16_t crc = crc16(card.buf, card.buf_len);
+    card.buf[card.buf_len] = (uint8_t)(crc >> 8);
+    card.buf[card.buf_len + 1] = (uint8_t)crc;
+    card.buf_pos = 0;
+    return TOKEN_START;
+  }
+
+  uint8_t b = card.buf[card.buf_pos++];
+  /* Too fast: every 64th bit sampled wrong */
+  if (clock_too_fast() && card.buf_pos % 8 == 0) b ^= 0x01;
+  if (card.buf_pos == card.buf_len + 2) {
+    if (!card.reg) {
+      card.stats.blocks_read++;
+      card.block++;
+    }
+    if (card.multi) {
+      card.buf_pos = -1;
+      card.token_ns = hal_model_now_ns() + (uint64_t)card.cfg.access_us * 1000U;
+    } else {
+      phase_end();
+    }
+  }
+  return b;
+}
+
+static void cmd_input(uint8_t mosi)
+{
+  if (card.frame_len == 0) {
+    if ((mosi & 0xC0) != 0x40) return;      /* Start and transmission bits */
+    if (hal_model_now_ns() < card.busy_until_ns) return;
+  }
+  card.frame[card.frame_len++] = mosi;
+  if (card.frame_len == sizeof(card.frame)) {
+    card.frame_len = 0;
+    command();
+  }
+}
+
+/* Sending data: a command frame, normally CMD12, starts on any 01xxxxxx byte */
+static void read_input(uint8_t mosi)
+{
+  if (card.frame_len == 0 && (mosi & 0xC0) != 0x40) return;
+  card.frame[card.frame_len++] = mosi;
+  if (card.frame_len == sizeof(card.frame)) {
+    card.frame_len = 0;
+    command();
+  }
+}
+
+static void write_input(uint8_t mosi)
+{
+  if (hal_model_now_ns() < card.busy_until_ns) return;
+  if (mosi == (card.multi ? TOKEN_MULTI : TOKEN_START)) {
+    card.phase = PHASE_WRITE_DATA;
+    card.buf_pos = 0;
+  } else if (card.multi && mosi == TOKEN_STOP) {
+    phase_end();
+    set_busy(card.cfg.stop_us);
+  }
+}
+
+static void write_data_input(uint8_t mosi)
+{
+  card.buf[card.buf_pos++] = mosi;
+  if (clock_too_fast() && card.buf_pos % 8 == 0) card.buf[card.buf_pos - 1] ^= 0x01;
+  if (card.buf_pos < 512 + 2) return;
+
+  uint16_t crc = (uint16_t)((card.buf[512] << 8) | card.buf[513]);
+  uint8_t resp = DATA_ACCEPTED;
+
+  if (card.crc_on && crc != crc16(card.buf, 512)) {
+    card.stats.crc_errors++;
+    resp = DATA_CRC_ERROR;
+  } else if (card.block >= card.cfg.sectors) {
+    resp = DATA_WR_ERROR;
+  } else {
+    uint32_t us = card.multi ? card.cfg.stream_us : card.cfg.program_us;
+    memcpy(card.data + (size_t)card.block * 512U, card.buf, 512);
+    card.stats.blocks_written++;
+    card.block++;
+    if (card.cfg.spike_every && ++card.programmed % card.cfg.spike_every == 0) us = card.cfg.spike_us;
+    set_busy(us);
+  }
+  /* The data response goes out on the next byte, then busy */
+  card.resp[0] = resp;
+  card.resp_len = 1;
+  card.resp_pos = 0;
+  if (card.multi) card.phase = PHASE_WRITE;
+  else phase_end();
+}
+
+static uint8_t card_exchange(void *ctx, uint8_t mosi)
+{
+  (void)ctx;
+  if (HAL_GPIO_ReadPin(card.cs_port, card.cs_pin) == GPIO_PIN_SET) {
+    if (!card.spi_mode) card.powerup_clocks += 8;
+    return 0xFF;                            /* DO released */
+  }
+
+  Phase_t phase = card.phase;
+  uint8_t miso = 0xFF;
+
+  if (card.resp_pos < card.resp_len) {
+    miso = card.resp[card.resp_pos++];
+  } else if (phase == PHASE_READ) {
+    miso = read_byte();
+  } else if (hal_model_now_ns() < card.busy_until_ns) {
+    miso = 0x00;
+    card.stats.busy_bytes++;
+  }
+
+  switch (phase) {
+  case PHASE_CMD:        cmd_input(mosi); break;
+  case PHASE_READ:       read_input(mosi); break;
+  case PHASE_WRITE:      write_input(mosi); break;
+  case PHASE_WRITE_DATA: write_data_input(mosi); break;
+  }
+  return miso;
+}
+
+/* API -----------------------------------------------------------------------*/
+int sd_card_model_init(const SD_Card_Model_Config_t *config)
+{
+  /* Sizes the CSD can describe: SDSC as C_SIZE x 512 blocks up to 1 GB,
+     SDHC in 512 KB units */
+  uint32_t unit = (config->type == SD_CARD_MODEL_SDHC) ? 1024U : 512U;
+  if (config->sectors == 0 || config->sectors % unit) return -1;
+  if (config->type != SD_CARD_MODEL_SDHC && config->sectors > 4096U * 512U) return -1;
+
+  free(card.data);
+  memset(&card, 0, sizeof(card));
+  card.cfg = *config;
+  card.data = calloc(config->sectors, 512U);
+  card.idle = 1;
+  return card.data ? 0 : -1;
+}
+
+void sd_card_model_attach(SPI_TypeDef *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin)
+{
+  HAL_Model_SpiDevice_t dev = { NULL, card_exchange };
+  card.cs_port = cs_port;
+  card.cs_pin = cs_pin;
+  hal_model_spi_attach(spi, &dev);
+}
+
+uint8_t *sd_card_model_data(void)
+{
+  return card.data;
+}
+
+const SD_Card_Model_Stats_t *sd_card_model_stats(void)
+{
+  return &card.stats;
+}
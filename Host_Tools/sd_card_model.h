@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file    sd_card_model.h
+  * @brief   Host model of an SD card in SPI mode, attached behind HAL_SPI_*
+  *          so SD_Card_Driver/user_diskio.c runs unchanged against it.
+  *
+  *          Models the SPI-mode protocol byte by byte: power-up clocks,
+  *          command frames and their CRC7, R1/R2/R3/R7 responses, the
+  *          CMD0/CMD8/ACMD41/CMD58 initialisation, data tokens and CRC16
+  *          on data blocks (checked once CMD59 turns checking on), CMD17/18
+  *          reads stopped by CMD12, CMD24/25 writes ended by the stop token,
+  *          CSD/CID, the SD status (ACMD13) with a 4 MB allocation unit,
+  *          the CMD6 switch to high speed (not on SDv1), and erase. Above
+  *          25 MHz until that switch, or above max_hz, data blocks either
+  *          way pick up bit errors. Card times run on the simulated clock: the
+  *          read token comes access_us after the command, and the card holds
+  *          DO low while it programs.
+  ******************************************************************************
+  */
+
+#ifndef __SD_CARD_MODEL_H
+#define __SD_CARD_MODEL_H
+
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+typedef enum {
+  SD_CARD_MODEL_SDV1 = 0,   /* No CMD8; byte addressed */
+  SD_CARD_MODEL_SDV2,       /* Standard capacity v2; byte addressed */
+  SD_CARD_MODEL_SDHC        /* High capacity; block addressed */
+} SD_Card_Model_Type_t;
+
+/** Card type, size and timing */
+typedef struct {
+  SD_Card_Model_Type_t type;
+  uint32_t sectors;         /* 512-byte blocks */
+  uint32_t init_us;         /* ACMD41 reports idle until this long after the first */
+  uint32_t access_us;       /* Read command, or the end of a block, to the next data token */
+  uint32_t program_us;      /* Busy after a CMD24 block */
+  uint32_t stream_us;       /* Busy after each CMD25 block */
+  uint32_t stop_us;         /* Busy after the CMD25 stop token */
+  uint32_t erase_us;        /* Busy after CMD38 */
+  uint32_t spike_us;        /* Busy after every spike_every'th block written */
+  uint32_t spike_every;     /* 0: no spikes */
+  uint32_t max_hz;          /* Data clocked faster than this has bit errors, as on long wires; 0: none */
+} SD_Card_Model_Config_t;
+
+/* A card like a class 10 microSD; a starting point, not a measurement */
+#define SD_CARD_MODEL_CONFIG_DEFAULT { \
+  .type = SD_CARD_MODEL_SDHC, .sectors = 131072, .init_us = 100000, \
+  .access_us = 250, .program_us = 1000, .stream_us = 250, .stop_us = 1000, \
+  .erase_us = 5000, .spike_us = 100000, .spike_every = 2048 }
+
+/** What the card saw */
+typedef struct {
+  uint32_t commands;        /* Command frames taken */
+  uint32_t refused;         /* Answered illegal, parameter or address error */
+  uint32_t crc_errors;      /* Command or data CRCs that failed while checked */
+  uint32_t blocks_read;
+  uint32_t blocks_written;
+  uint32_t busy_bytes;      /* Bytes clocked while the card held DO low */
+  uint32_t token_bytes;     /* Bytes clocked waiting for a read token */
+} SD_Card_Model_Stats_t;
+
+/** Power the card up (it then needs clocks and CMD0) with zeroed storage;
+    returns 0 on success */
+int sd_card_model_init(const SD_Card_Model_Config_t *config);
+
+/** Attach to an SPI port, selected while cs_pin reads low; again after
+    hal_model_reset */
+void sd_card_model_attach(SPI_TypeDef *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin);
+
+/** The card's storage, sectors * 512 bytes */
+uint8_t *sd_card_model_data(void);
+
+const SD_Card_Model_Stats_t *sd_card_model_stats(void);
+
+#endif /* __SD_CARD_MODEL_H */
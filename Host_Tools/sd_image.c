@@ -0,0 +1,472 @@
+/**
+  ******************************************************************************
+  * @file    sd_image.c
+  * @brief   USER_Driver on a disk image file, with SD card latencies charged
+  *          to the simulated clock. See sd_image.h.
+  *
+  *          Follows the card-facing behaviour of user_diskio.c: a write
+  *          returns once its last block is on the bus and the card programs
+  *          it in the background; any command first waits for the card and
+  *          ends an open CMD25 stream. Single-sector requests pass through
+  *          the driver's own sector cache (SD_Card_Driver/sd_cache.c), so
+  *          SD_Stats counts the card operations the firmware would make.
+  ******************************************************************************
+  */
+
+#define _FILE_OFFSET_BITS 64
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "hal_model.h"
+#include "sd_image.h"
+#include "sd_cache.h"
+
+#define SECTOR 512U
+
+static FILE *image;
+static uint32_t image_sectors;
+static uint8_t *erased;             /* Bit per sector: trimmed, not written since */
+static SD_Image_Latency_t lat = SD_IMAGE_LATENCY_DEFAULT;
+static DSTATUS Stat = STA_NOINIT;
+
+static uint64_t busy_until_ns;      /* Card programming, or a started read, until then */
+static uint32_t programmed;         /* Blocks programmed, for spike_every */
+static uint8_t stream_open;
+static DWORD stream_next;           /* LBA the next streamed block goes to */
+static DRESULT read_result = RES_OK;
+static uint32_t image_writes;       /* Sectors written, for the power cut */
+static uint32_t cut_at;             /* image_writes at the power cut; 0: none */
+static uint32_t cut_torn;           /* Bytes of the last sector that reach the image */
+static uint8_t cut_done;
+
+SD_Stats_t SD_Stats;
+SD_Timing_t SD_Timing[SD_OP_COUNT];
+
+/* Timing --------------------------------------------------------------------*/
+static void sd_time_us(SD_Op_t op, uint64_t us)
+{
+  SD_Timing_t *t = &SD_Timing[op];
+  uint32_t k = 0;
+
+  while (k + 1 < SD_HIST_BUCKETS && (us >> (k + 1))) k++; /* floor(log2(us)) */
+  t->hist[k]++;
+  t->count++;
+  t->total_us += us;
+  if (us > t->max_us) t->max_us = (DWORD)us;
+}
+
+static void sd_time(SD_Op_t op, uint64_t start_ns)
+{
+  sd_time_us(op, (hal_model_now_ns() - start_ns) / 1000U);
+}
+
+void SD_ResetTiming(void)
+{
+  memset(SD_Timing, 0, sizeof(SD_Timing));
+  SD_Stats.busy_waits = 0;
+  SD_Stats.busy_polls = 0;
+  SD_Stats.token_polls = 0;
+}
+
+/* Card ----------------------------------------------------------------------*/
+static void advance_us(uint64_t us)
+{
+  hal_model_advance(us * 1000U);
+}
+
+/* Bytes the driver would clock polling for ns */
+static DWORD poll_bytes(uint64_t ns)
+{
+  uint64_t byte_ns = (uint64_t)lat.xfer_us * 1000U / SECTOR;
+  return (DWORD)(byte_ns ? ns / byte_ns + 1U : 1U);
+}
+
+/* Blocks until the card is ready, as spi_wait_ready */
+static void card_wait(void)
+{
+  uint64_t now = hal_model_now_ns();
+
+  if (now >= busy_until_ns) return;
+  SD_Stats.busy_waits++;
+  SD_Stats.busy_polls += poll_bytes(busy_until_ns - now);
+  hal_model_advance(busy_until_ns - now);
+  sd_time(SD_OP_WAIT_READY, now);
+}
+
+static uint8_t sector_erased(DWORD sector)
+{
+  return (erased[sector / 8U] >> (sector % 8U)) & 1U;
+}
+
+/* Leaves the card programming one block; one put in an erased sector
+   does not wait for an erase */
+static void card_program(DWORD sector, uint32_t us)
+{
+  if (sector_erased(sector)) {
+    erased[sector / 8U] &= (uint8_t)~(1U << (sector % 8U));
+  } else if (lat.spike_every && ++programmed % lat.spike_every == 0) {
+    us = lat.spike_us;
+  }
+  busy_until_ns = hal_model_now_ns() + (uint64_t)us * 1000U;
+  sd_time_us(SD_OP_PROGRAM, us);
+}
+
+static int image_io(DWORD sector, BYTE *rd, const BYTE *wr, UINT count)
+{
+  if (!image || sector >= image_sectors || count > image_sectors - sector) return -1;
+  if (fseeko(image, (off_t)sector * SECTOR, SEEK_SET) != 0) return -1;
+  if (rd) return fread(rd, SECTOR, count, image) == count ? 0 : -1;
+  return fwrite(wr, SECTOR, count, image) == count ? 0 : -1;
+}
+
+/* Writes count sectors, unless the power cut falls among them: those
+   before it are written, the one it falls on only in part, and the card
+   goes dead */
+static int card_store(DWORD sector, const BYTE *buff, UINT count)
+{
+  if (cut_done) return -1;
+  if (!cut_at || cut_at - image_writes > count) {
+    image_writes += count;
+    return image_io(sector, NULL, buff, count);
+  }
+
+  UINT whole = (UINT)(cut_at - image_writes - 1U);
+  if (whole) image_io(sector, NULL, buff, whole);
+  if (cut_torn && fseeko(image, (off_t)(sector + whole) * SECTOR, SEEK_SET) == 0) {
+    fwrite(buff + whole * SECTOR, 1, cut_torn < SECTOR ? cut_torn : SECTOR, image);
+  }
+  fflush(image);
+  image_writes = cut_at;
+  cut_done = 1;
+  Stat = STA_NOINIT;
+  return -1;
+}
+
+static DRESULT stream_stop(void)
+{
+  if (!stream_open) return RES_OK;
+  stream_open = 0;
+  card_wait();
+  advance_us(lat.cmd_us);             /* Stop token */
+  busy_until_ns = hal_model_now_ns() + (uint64_t)lat.stop_us * 1000U;
+  card_wait();
+  return RES_OK;
+}
+
+/* Ready for a command: the card idle and any stream ended */
+static void card_select(void)
+{
+  stream_stop();
+  card_wait();
+}
+
+/* Image ---------------------------------------------------------------------*/
+int sd_image_open(const char *path, uint32_t sectors)
+{
+  sd_image_close();
+  image = fopen(path, "r+b");
+  if (!image && sectors) image = fopen(path, "w+b");
+  if (!image) return -1;
+
+  if (fseeko(image, 0, SEEK_END) != 0) goto fail;
+  off_t size = ftello(image);
+  if (sectors && size < (off_t)sectors * SECTOR) {
+    /* Sparse, like an erased card reads as zeros */
+    if (ftruncate(fileno(image), (off_t)sectors * SECTOR) != 0) goto fail;
+    size = (off_t)sectors * SECTOR;
+  }
+  image_sectors = (uint32_t)(size / SECTOR);
+  if (image_sectors == 0) goto fail;
+  erased = calloc(image_sectors / 8U + 1U, 1);
+  if (!erased) goto fail;
+  return 0;
+
+fail:
+  sd_image_close();
+  return -1;
+}
+
+void sd_image_close(void)
+{
+  if (image) fclose(image);
+  image = NULL;
+  image_sectors = 0;
+  free(erased);
+  erased = NULL;
+  Stat = STA_NOINIT;
+  image_writes = 0;
+  cut_at = 0;
+  cut_done = 0;
+}
+
+uint32_t sd_image_sectors(void)
+{
+  return image_sectors;
+}
+
+void sd_image_set_latency(const SD_Image_Latency_t *latency)
+{
+  lat = *latency;
+}
+
+void sd_image_reset(void)
+{
+  stream_stop();
+  busy_until_ns = 0;
+}
+
+void sd_image_set_cut(uint32_t writes, uint32_t torn_bytes)
+{
+  cut_at = writes ? image_writes + writes : 0;
+  cut_torn = torn_bytes;
+}
+
+uint8_t sd_image_cut(void)
+{
+  return cut_done;
+}
+
+uint32_t sd_image_writes(void)
+{
+  return image_writes;
+}
+
+/* Driver --------------------------------------------------------------------*/
+uint8_t USER_Poll(void)
+{
+  if (hal_model_now_ns() >= busy_until_ns) return 1;
+  SD_Stats.busy_polls++;
+  advance_us(lat.poll_us);
+  return 0;
+}
+
+/* Reads count blocks into buff after the command; returns how long the
+   blocks take to arrive */
+static uint64_t card_read(BYTE *buff, DWORD sector, UINT count)
+{
+  uint64_t block_us = (uint64_t)lat.access_us + lat.xfer_us;
+
+  card_select();
+  SD_Stats.reads++;
+  SD_Stats.read_sectors += count;
+  advance_us(lat.cmd_us);
+  read_result = image_io(sector, buff, NULL, count) ? RES_ERROR : RES_OK;
+  for (UINT i = 0; i < count; i++) sd_time_us(SD_OP_RCVR_BLOCK, block_us);
+  sd_time_us(SD_OP_READ, lat.cmd_us + count * block_us);
+  return count * block_us;
+}
+
+DRESULT USER_ReadStart(BYTE *buff, DWORD sector, UINT count)
+{
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  if (count == 0) return RES_PARERR;
+#if SD_CACHE_SLOTS
+  if (SD_CacheClean(sector, count) != RES_OK) return RES_ERROR;
+#endif
+
+  /* The data lands at once; USER_ReadResult holds it back until the
+     blocks would have arrived */
+  uint64_t us = card_read(buff, sector, count);
+  busy_until_ns = hal_model_now_ns() + us * 1000U;
+  return RES_OK;
+}
+
+DRESULT USER_ReadResult(void)
+{
+  return hal_model_now_ns() < busy_until_ns ? RES_NOTRDY : read_result;
+}
+
+DRESULT USER_StreamWrite(const BYTE *buff, DWORD sector, DWORD erase_hint)
+{
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+#if SD_CACHE_SLOTS
+  SD_CacheDrop(sector, 1);
+#endif
+  uint64_t t0 = hal_model_now_ns();
+
+  if (!stream_open || sector != stream_next) {
+    stream_stop();
+    card_wait();
+    if (erase_hint) advance_us(2U * lat.cmd_us); /* ACMD23 */
+    advance_us(lat.cmd_us);
+    stream_open = 1;
+    stream_next = sector;
+    SD_Stats.stream_starts++;
+  }
+  card_wait();
+
+  SD_Stats.writes++;
+  SD_Stats.write_sectors++;
+  advance_us(lat.xfer_us);
+  if (card_store(sector, buff, 1)) {
+    stream_stop();
+    sd_time(SD_OP_STREAM, t0);
+    return RES_ERROR;
+  }
+  card_program(sector, lat.stream_us);
+  stream_next++;
+  sd_time(SD_OP_STREAM, t0);
+  return RES_OK;
+}
+
+DRESULT USER_StreamSync(void)
+{
+  card_wait();
+  return RES_OK;
+}
+
+DRESULT USER_StreamStop(void)
+{
+  return stream_stop();
+}
+
+/* Card writes, past the cache */
+static DRESULT card_write(const BYTE *buff, DWORD sector, UINT count)
+{
+  uint64_t t0 = hal_model_now_ns();
+
+  card_select();
+  SD_Stats.writes++;
+  SD_Stats.write_sectors += count;
+  advance_us(lat.cmd_us);
+  DRESULT res = card_store(sector, buff, count) ? RES_ERROR : RES_OK;
+  /* CMD25 for several: each block waits for the one before */
+  for (UINT i = 0; i < count; i++) {
+    card_wait();
+    advance_us(lat.xfer_us);
+    card_program(sector + i, lat.program_us);
+  }
+  sd_time(SD_OP_WRITE, t0);
+  return res;
+}
+
+#if SD_CACHE_SLOTS
+/* The card under the sector cache */
+static DRESULT cache_card_read(BYTE *buff, DWORD lba)
+{
+  advance_us(card_read(buff, lba, 1));
+  return read_result;
+}
+
+static DRESULT cache_card_write(const BYTE *buff, DWORD lba)
+{
+  return card_write(buff, lba, 1);
+}
+
+static const SD_CacheCard_t cache_card = { cache_card_read, cache_card_write };
+#endif
+
+static DSTATUS USER_initialize(BYTE pdrv)
+{
+  (void)pdrv;
+  if (!image || cut_done) return Stat;
+  stream_open = 0;
+  busy_until_ns = 0;
+  advance_us(lat.cmd_us);
+#if SD_CACHE_SLOTS
+  SD_CacheInit(&cache_card);
+#endif
+  Stat = 0;
+  return Stat;
+}
+
+static DSTATUS USER_status(BYTE pdrv)
+{
+  (void)pdrv;
+  return Stat;
+}
+
+static DRESULT USER_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+  (void)pdrv;
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  if (count == 0) return RES_PARERR;
+#if SD_CACHE_SLOTS
+  if (count == 1) return SD_CacheRead(buff, sector);
+#endif
+  advance_us(card_read(buff, sector, count));
+  return read_result;
+}
+
+static DRESULT USER_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+  (void)pdrv;
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  if (count == 0) return RES_PARERR;
+#if SD_CACHE_SLOTS
+  if (count == 1) return SD_CacheWrite(buff, sector);
+  SD_CacheUpdate(buff, sector, count);
+#endif
+  return card_write(buff, sector, count);
+}
+
+/* CMD32/CMD33/CMD38 over sectors start..end, the card holding the bus
+   until the erase is done */
+static DRESULT card_trim(DWORD start, DWORD end)
+{
+  static const BYTE zeros[64 * SECTOR];
+  DWORD n = lat.erase_sectors ? lat.erase_sectors : 1U;
+
+  if (end < start || end >= image_sectors) return RES_PARERR;
+  if (lat.no_erase) return RES_ERROR;
+#if SD_CACHE_SLOTS
+  SD_CacheDrop(start, end - start + 1U);
+#endif
+  card_select();
+  advance_us(3U * lat.cmd_us);
+  advance_us((uint64_t)(end / n - start / n + 1U) * lat.erase_us);
+
+  for (DWORD s = start; s <= end; s += 64U) {
+    UINT count = (end - s + 1U < 64U) ? (UINT)(end - s + 1U) : 64U;
+    if (image_io(s, NULL, zeros, count)) return RES_ERROR;
+  }
+  for (DWORD s = start; s <= end; s++) erased[s / 8U] |= (uint8_t)(1U << (s % 8U));
+  SD_Stats.trims++;
+  SD_Stats.trim_sectors += end - start + 1U;
+  return RES_OK;
+}
+
+static DRESULT USER_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+  (void)pdrv;
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+
+  switch (cmd) {
+  case CTRL_SYNC:
+    SD_Stats.syncs++;
+#if SD_CACHE_SLOTS
+    if (SD_CacheClean(0, 0) != RES_OK) return RES_ERROR;
+#endif
+    card_wait();
+    return fflush(image) == 0 ? RES_OK : RES_ERROR;
+  case GET_SECTOR_COUNT:            /* For f_mkfs on a new image */
+    *(DWORD *)buff = image_sectors;
+    return RES_OK;
+  case GET_SECTOR_SIZE:
+    *(WORD *)buff = SECTOR;
+    return RES_OK;
+  case GET_BLOCK_SIZE:              /* For f_mkfs to align the data area to */
+    if (!lat.erase_sectors) return RES_ERROR;
+    *(DWORD *)buff = lat.erase_sectors;
+    return RES_OK;
+  case CTRL_TRIM:
+    return card_trim(((DWORD *)buff)[0], ((DWORD *)buff)[1]);
+  default:
+    return RES_PARERR;
+  }
+}
+
+Diskio_drvTypeDef USER_Driver =
+{
+  USER_initialize,
+  USER_status,
+  USER_read,
+#if _USE_WRITE
+  USER_write,
+#endif
+#if _USE_IOCTL == 1
+  USER_ioctl,
+#endif
+};
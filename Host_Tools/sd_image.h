@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    sd_image.h
+  * @brief   USER_Driver on a disk image file, for running FatFs on the host.
+  *
+  *          sd_image.c stands in for SD_Card_Driver/user_diskio.c: the same
+  *          USER_Driver, stream and poll entry points and SD_Stats/SD_Timing
+  *          counters, over sectors of a file instead of a card on SPI. Card
+  *          time is charged to the simulated clock (hal_model.h): commands
+  *          and bus transfers block the caller, while programming a written
+  *          sector only leaves the card busy, as a posted write does, until
+  *          simulated time passes it. The next operation, or USER_Poll,
+  *          sees the busy card. CTRL_TRIM zeroes its sectors, as a card
+  *          that reads erased data as 0 does, and a block programmed into
+  *          an erased sector never takes a spike; with no_erase it fails
+  *          and leaves them, as on a card that cannot erase.
+  ******************************************************************************
+  */
+
+#ifndef __SD_IMAGE_H
+#define __SD_IMAGE_H
+
+#include <stdint.h>
+#include "fatfs.h"
+
+/** Injected card latencies, in microseconds, and the erase geometry */
+typedef struct {
+  uint32_t cmd_us;          /* Command and response, before any data */
+  uint32_t xfer_us;         /* One 512-byte block on the bus, either way */
+  uint32_t access_us;       /* Read: command to data token, per block */
+  uint32_t program_us;      /* Busy programming a single-block write */
+  uint32_t stream_us;       /* Busy programming a block of a CMD25 stream */
+  uint32_t stop_us;         /* Busy after the stream stop token */
+  uint32_t spike_us;        /* Programming time of every spike_every'th block */
+  uint32_t spike_every;     /* 0: no spikes */
+  uint32_t poll_us;         /* One USER_Poll of a busy card */
+  uint32_t erase_us;        /* CTRL_TRIM, per erase block touched */
+  uint32_t erase_sectors;   /* Erase block for GET_BLOCK_SIZE (0: unknown) */
+  uint32_t no_erase;        /* 1: CTRL_TRIM fails, the sectors left as they are */
+} SD_Image_Latency_t;
+
+/* Roughly a class 10 card in SPI mode at 10.5 MHz, with the occasional
+   block that takes an erase, and the 4 MB allocation unit of an SDHC card;
+   a starting point, not a measurement */
+#define SD_IMAGE_LATENCY_DEFAULT { \
+  .cmd_us = 20, .xfer_us = 400, .access_us = 250, .program_us = 1000, \
+  .stream_us = 250, .stop_us = 1000, .spike_us = 100000, .spike_every = 2048, \
+  .poll_us = 1, .erase_us = 2000, .erase_sectors = 8192 }
+
+/** Open an image of sectors 512-byte sectors, creating it if needed
+    (sectors 0: use an existing image at its own size). Returns 0 on success. */
+int sd_image_open(const char *path, uint32_t sectors);
+void sd_image_close(void);
+
+/** Sectors in the open image */
+uint32_t sd_image_sectors(void);
+
+void sd_image_set_latency(const SD_Image_Latency_t *latency);
+
+/** Leave the card idle, for a run that starts the clock again with
+    hal_model_reset after preparing the image */
+void sd_image_reset(void);
+
+/** Cut the power once writes more sectors have been written: the last of
+    them is torn, only its first torn_bytes reaching the image, and from
+    then on the card answers nothing (writes 0: no cut) */
+void sd_image_set_cut(uint32_t writes, uint32_t torn_bytes);
+
+/** True once the power has been cut */
+uint8_t sd_image_cut(void);
+
+/** Sectors written to the image since it was opened, trims not counted */
+uint32_t sd_image_writes(void);
+
+#endif /* __SD_IMAGE_H */
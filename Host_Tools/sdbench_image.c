@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    sdbench_image.c
+  * @brief   The firmware's SD card benchmark over a disk image.
+  *
+  *          Runs telemetry_sdbench.c as main.c does with B1 held through
+  *          reset, on FatFs over sd_image.c with its injected card
+  *          latencies on the simulated clock, and prints the lines the
+  *          board sends over the UART. A card's results can then be set
+  *          beside the model's, or the model tuned until they agree. The
+  *          image is created and formatted with f_mkfs if it does not hold
+  *          a file system yet.
+  *
+  *          Usage: sdbench_image image.img [key=value ...]
+  *            size_mb=N     size of a new image (default 64)
+  *          and any SD_Image_Latency_t field, e.g. program_us=1500.
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_model.h"
+#include "sd_image.h"
+#include "telemetry_sdbench.h"
+
+typedef struct {
+  const char *name;
+  uint32_t *value;
+} Option_t;
+
+/* Format the image if FatFs finds no volume on it */
+static int prepare_volume(const char *path)
+{
+  FATFS probe;
+  FRESULT res = f_mount(&probe, path, 1);
+
+  if (res == FR_NO_FILESYSTEM) {
+    static BYTE work[_MAX_SS];
+    res = f_mkfs(path, FM_ANY, 0, work, sizeof(work));
+    if (res == FR_OK) res = f_mount(&probe, path, 1);
+  }
+  f_mount(NULL, path, 0);
+  return res == FR_OK ? 0 : -1;
+}
+
+static void report(const TelemetrySdbench_Result_t *result)
+{
+  char line[256];
+
+  for (uint32_t k = 0; TelemetrySdbench_Format(result, k, line, sizeof(line)) > 0; k++) printf("%s\n", line);
+  fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+  static TelemetrySdbench_Result_t results[TELEMETRY_SDBENCH_CASES];
+  SD_Image_Latency_t lat = SD_IMAGE_LATENCY_DEFAULT;
+  uint32_t size_mb = 64;
+  Option_t options[] = {
+    { "size_mb", &size_mb },
+    { "cmd_us", &lat.cmd_us }, { "xfer_us", &lat.xfer_us }, { "access_us", &lat.access_us },
+    { "program_us", &lat.program_us }, { "stream_us", &lat.stream_us }, { "stop_us", &lat.stop_us },
+    { "spike_us", &lat.spike_us }, { "spike_every", &lat.spike_every }, { "poll_us", &lat.poll_us },
+    { "erase_us", &lat.erase_us }, { "erase_sectors", &lat.erase_sectors },
+  };
+
+  if (argc < 2) {
+    fprintf(stderr, "usage: sdbench_image image.img [key=value ...]\n");
+    return 2;
+  }
+  for (int i = 2; i < argc; i++) {
+    char *eq = strchr(argv[i], '=');
+    size_t n = eq ? (size_t)(eq - argv[i]) : 0;
+    size_t k;
+
+    for (k = 0; k < sizeof(options) / sizeof(options[0]); k++) {
+      if (eq && strlen(options[k].name) == n && strncmp(argv[i], options[k].name, n) == 0) break;
+    }
+    if (k == sizeof(options) / sizeof(options[0])) {
+      fprintf(stderr, "%s: unknown option\n", argv[i]);
+      return 2;
+    }
+    *options[k].value = (uint32_t)strtoul(eq + 1, NULL, 0);
+  }
+
+  if (sd_image_open(argv[1], size_mb * 2048U) != 0) {
+    fprintf(stderr, "%s: cannot open or create the image\n", argv[1]);
+    return 1;
+  }
+  sd_image_set_latency(&lat);
+
+  char drive[4];
+  if (FATFS_LinkDriver(&USER_Driver, drive) != 0 || prepare_volume(drive) != 0) {
+    fprintf(stderr, "%s: no FAT volume, and formatting failed\n", argv[1]);
+    return 1;
+  }
+
+  hal_model_reset();
+  sd_image_reset();
+  FRESULT res = TelemetrySdbench_Run(results, report);
+  sd_image_close();
+  if (res != FR_OK) {
+    printf("bench failed res=%d\n", (int)res);
+    return 1;
+  }
+
+  uint32_t errors = 0;
+  for (uint32_t c = 0; c < TELEMETRY_SDBENCH_CASES; c++) errors += results[c].errors;
+  printf("cases=%u errors=%u sim_s=%.1f\n", (unsigned)TELEMETRY_SDBENCH_CASES, errors, hal_model_now_ns() / 1e9);
+  return errors ? 3 : 0;
+}
@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file    ssd1306_bench.c
+  * @brief   Frame rate of the SSD1306 transport on the host bus model.
+  *
+  *          Renders a scrolling graph page and pushes it with
+  *          ssd1306_UpdateScreen. The transport (I2C, SPI or SPI+DMA) is the
+  *          one ssd1306.c was compiled for; the bus clock comes from argv.
+  *          Bus and HAL call time is simulated; drawing is charged a fixed
+  *          render_us per frame, which a DMA transfer can overlap.
+  *          cpu_us_per_update is how long ssd1306_UpdateScreen keeps the CPU
+  *          from drawing the next frame.
+  *
+  *          Usage: ssd1306_bench <bus clock Hz> [frames] [render_us]
+  ******************************************************************************
+  */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "hal_model.h"
+#include "ssd1306_model.h"
+#include "ssd1306.h"
+#include "ssd1306_fonts.h"
+
+#if defined(SSD1306_USE_I2C)
+#define TRANSPORT "i2c"
+#elif defined(SSD1306_USE_DMA)
+#define TRANSPORT "spi_dma"
+#else
+#define TRANSPORT "spi"
+#endif
+
+I2C_HandleTypeDef hi2c1;
+SPI_HandleTypeDef hspi2;
+
+#if defined(SSD1306_USE_SPI) && defined(SSD1306_USE_DMA)
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  ssd1306_SPI_TxCpltCallback(hspi);
+}
+#endif
+
+static uint32_t crc32(const uint8_t *p, size_t n)
+{
+  uint32_t crc = 0xFFFFFFFFU;
+  while (n--) {
+    crc ^= *p++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+  }
+  return ~crc;
+}
+
+/* Smallest SPI prescaler whose bit rate does not exceed hz */
+static uint32_t spi_prescaler_for(uint32_t kernel_hz, uint32_t hz)
+{
+  uint32_t br = 0;
+  while (br < 7 && (kernel_hz >> (br + 1)) > hz) br++;
+  return br << SPI_CR1_BR_Pos;
+}
+
+/* Simulated time the CPU spends inside ssd1306_UpdateScreen */
+static uint64_t update_ns;
+static uint32_t render_us;
+
+/* A 60 fps telemetry graph page: scrolling trace, axes and a label */
+static void draw_graph(uint32_t frame)
+{
+  SSD1306_VERTEX trace[64];
+
+  ssd1306_Fill(Black);
+  ssd1306_Line(0, 63, 127, 63, White);
+  ssd1306_Line(0, 12, 0, 63, White);
+  for (uint8_t i = 0; i < 64; i++) {
+    trace[i].x = i * 2;
+    trace[i].y = (uint8_t)(38 + 22 * sinf((i + frame) * 0.15f));
+  }
+  ssd1306_Polyline(trace, 64, White);
+  ssd1306_SetCursor(0, 0);
+  ssd1306_WriteString("ALT", Font_6x8, White);
+  hal_model_advance((uint64_t)render_us * 1000U);
+
+  uint64_t t0 = hal_model_now_ns();
+  ssd1306_UpdateScreen();
+  update_ns += hal_model_now_ns() - t0;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t clock_hz = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 400000U;
+  uint32_t frames = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 600U;
+  render_us = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 0U;
+
+  hal_model_reset();
+  hi2c1.ClockSpeed = clock_hz;
+  hspi2.Instance = SPI2;
+  hspi2.ClockSpeed = 42000000U;   /* APB1 */
+  hspi2.Instance->CR1 = spi_prescaler_for(hspi2.ClockSpeed, clock_hz);
+  hal_model_attach_oled_spi(SPI2, SSD1306_CS_Port, SSD1306_CS_Pin, SSD1306_DC_Port, SSD1306_DC_Pin);
+
+  ssd1306_Init();
+
+  const HAL_Model_Stats_t *st = hal_model_stats();
+  uint64_t start_ns = hal_model_now_ns();
+  uint64_t start_bytes = st->i2c.bytes + st->spi[1].bytes;
+
+  for (uint32_t f = 0; f < frames; f++) draw_graph(f);
+
+#if defined(SSD1306_USE_SPI) && defined(SSD1306_USE_DMA)
+  while (ssd1306_IsBusy()) hal_model_advance(1000);
+#endif
+
+  double sim_s = (hal_model_now_ns() - start_ns) / 1e9;
+  uint64_t bytes = st->i2c.bytes + st->spi[1].bytes - start_bytes;
+  uint32_t bus_hz = TRANSPORT[0] == 'i' ? clock_hz : hal_model_spi_hz(&hspi2);
+
+  printf("transport=%s bus_hz=%u frames=%u render_us=%u sim_ms=%.3f fps=%.1f us_per_frame=%.1f "
+         "cpu_us_per_update=%.1f wire_bytes_per_frame=%.1f gddram_crc32=%08x\n",
+         TRANSPORT, bus_hz, frames, render_us, sim_s * 1e3, frames / sim_s, sim_s * 1e6 / frames,
+         update_ns / 1e3 / frames, (double)bytes / frames, crc32(ssd1306_model_gddram(), 1024));
+  return 0;
+}
@@ -0,0 +1,114 @@
+/**
+  ******************************************************************************
+  * @file    ssd1306_model.c
+  * @brief   Host model of the SSD1306 controller.
+  *          Implements the addressing commands (page, horizontal and vertical
+  *          modes, column/page windows); every other command is consumed with
+  *          its argument bytes and otherwise ignored.
+  ******************************************************************************
+  */
+
+#include <string.h>
+#include "ssd1306_model.h"
+
+static struct {
+    uint8_t gddram[SSD1306_MODEL_PAGES][SSD1306_MODEL_COLUMNS];
+    uint8_t mode;               /* 0 horizontal, 1 vertical, 2 page */
+    uint8_t col, page;
+    uint8_t col_start, col_end;
+    uint8_t page_start, page_end;
+    uint8_t cmd;                /* Command waiting for arguments */
+    uint8_t args_left;
+    uint8_t args[2];
+    uint8_t nargs;
+} oled;
+
+/* Number of argument bytes following a command byte */
+static uint8_t cmd_arg_count(uint8_t cmd)
+{
+    switch (cmd) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+void ssd1306_model_reset(void)
+{
+    memset(&oled, 0, sizeof(oled));
+    oled.mode = 2;  /* Page addressing after reset */
+    oled.col_end = SSD1306_MODEL_COLUMNS - 1;
+    oled.page_end = SSD1306_MODEL_PAGES - 1;
+}
+
+static void cmd_execute(void)
+{
+    switch (oled.cmd) {
+    case 0x20:
+        oled.mode = oled.args[0] & 0x03;
+        break;
+    case 0x21:
+        oled.col_start = oled.col = oled.args[0] & 0x7F;
+        oled.col_end = oled.args[1] & 0x7F;
+        break;
+    case 0x22:
+        oled.page_start = oled.page = oled.args[0] & 0x07;
+        oled.page_end = oled.args[1] & 0x07;
+        break;
+    default:
+        break;
+    }
+}
+
+void ssd1306_model_command(uint8_t byte)
+{
+    if (oled.args_left) {
+        oled.args[oled.nargs++] = byte;
+        if (--oled.args_left == 0) cmd_execute();
+        return;
+    }
+
+    if (byte <= 0x0F) {
+        oled.col = (oled.col & 0xF0) | byte;            /* Lower column nibble */
+    } else if (byte <= 0x1F) {
+        oled.col = (oled.col & 0x0F) | ((byte & 0x07) << 4);
+    } else if (byte >= 0xB0 && byte <= 0xB7) {
+        oled.page = byte & 0x07;
+    } else {
+        oled.cmd = byte;
+        oled.nargs = 0;
+        oled.args_left = cmd_arg_count(byte);
+    }
+}
+
+void ssd1306_model_data(uint8_t byte)
+{
+    oled.gddram[oled.page & 0x07][oled.col & 0x7F] = byte;
+
+    switch (oled.mode) {
+    case 0: /* Horizontal: column first, wrap into the next page */
+        if (oled.col++ >= oled.col_end) {
+            oled.col = oled.col_start;
+            if (oled.page++ >= oled.page_end) oled.page = oled.page_start;
+        }
+        break;
+    case 1: /* Vertical: page first, wrap into the next column */
+        if (oled.page++ >= oled.page_end) {
+            oled.page = oled.page_start;
+            if (oled.col++ >= oled.col_end) oled.col = oled.col_start;
+        }
+        break;
+    default: /* Page mode: column wraps within the page */
+        oled.col = (oled.col + 1) & 0x7F;
+        break;
+    }
+}
+
+const uint8_t *ssd1306_model_gddram(void)
+{
+    return &oled.gddram[0][0];
+}
@@ -0,0 +1,24 @@
+/**
+  ******************************************************************************
+  * @file    ssd1306_model.h
+  * @brief   Host model of the SSD1306 controller: decodes the command and
+  *          data stream written by ssd1306.c into an emulated GDDRAM.
+  ******************************************************************************
+  */
+
+#ifndef __SSD1306_MODEL_H
+#define __SSD1306_MODEL_H
+
+#include <stdint.h>
+
+#define SSD1306_MODEL_COLUMNS   128
+#define SSD1306_MODEL_PAGES     8
+
+void ssd1306_model_reset(void);
+void ssd1306_model_command(uint8_t byte);
+void ssd1306_model_data(uint8_t byte);
+
+/** GDDRAM as page-major bytes, SSD1306_MODEL_COLUMNS per page */
+const uint8_t *ssd1306_model_gddram(void);
+
+#endif /* __SSD1306_MODEL_H */
@@ -0,0 +1,232 @@
+/**
+  ******************************************************************************
+  * @file    ssd1306_suite.c
+  * @brief   Benchmark suite running the ssd1306_Test* scenarios on the host.
+  *
+  *          Each scenario is the firmware test function itself, compiled from
+  *          ssd1306_tests.c with ssd1306_suite_hooks.h force-included. One
+  *          line per scenario is printed as key=value pairs:
+  *
+  *            ops               drawing calls the scenario makes
+  *            updates           ssd1306_UpdateScreen calls
+  *            ns_per_op         host CPU time per drawing call (best of 5)
+  *            fb_bytes_touched  frame buffer bytes the scenario changes
+  *            wire_bytes        bytes sent to the panel
+  *            bus_us_<clock>    simulated time spent in ssd1306_UpdateScreen
+  *                              with I2C at 100 kHz, 400 kHz and 1 MHz
+  *            fps_<clock>       frame rate, for the timed ssd1306_TestFPS loop
+  *
+  *          ops, updates and wire_bytes are taken from the 400 kHz run.
+  *          Everything but ns_per_op is deterministic, so two runs can be
+  *          diffed directly; host timings need a tolerance.
+  *
+  *          Usage: ssd1306_suite [scenario ...]
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hal_model.h"
+#include "ssd1306_model.h"
+#include "ssd1306.h"
+#include "ssd1306_tests.h"
+
+#define SUITE_BATCHES        5
+#define SUITE_BATCH_NS       20000000ULL   /* Host time each timing batch aims for */
+
+I2C_HandleTypeDef hi2c1;
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+  uint8_t timed;            /* Runs for a fixed simulated time and reports fps */
+} Suite_Scenario_t;
+
+static const Suite_Scenario_t scenarios[] = {
+  { "fps",              ssd1306_TestFPS,             1 },
+  { "border",           ssd1306_TestBorder,          0 },
+  { "fonts1",           ssd1306_TestFonts1,          0 },
+  { "fonts2",           ssd1306_TestFonts2,          0 },
+  { "fonts3",           ssd1306_TestFonts3,          0 },
+  { "line",             ssd1306_TestLine,            0 },
+  { "rectangle",        ssd1306_TestRectangle,       0 },
+  { "rectangle_fill",   ssd1306_TestRectangleFill,   0 },
+  { "rectangle_invert", ssd1306_TestRectangleInvert, 0 },
+  { "circle",           ssd1306_TestCircle,          0 },
+  { "arc",              ssd1306_TestArc,             0 },
+  { "polyline",         ssd1306_TestPolyline,        0 },
+  { "draw_bitmap",      ssd1306_TestDrawBitmap,      0 },
+  { "bignum",           ssd1306_TestBigNum,          0 },
+};
+
+static const struct {
+  const char *label;
+  uint32_t hz;
+} clocks[] = {
+  { "100k",  100000U },
+  { "400k",  400000U },
+  { "1m",   1000000U },
+};
+
+#define NUM_SCENARIOS  (sizeof(scenarios) / sizeof(scenarios[0]))
+#define NUM_CLOCKS     (sizeof(clocks) / sizeof(clocks[0]))
+
+/* Counters fed by the hooks in ssd1306_tests.c */
+uint32_t suite_ops;
+static uint32_t updates;
+static uint64_t update_host_ns;
+static uint64_t update_sim_ns;
+
+static uint64_t host_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void suite_update(void)
+{
+  uint64_t h0 = host_ns();
+  uint64_t s0 = hal_model_now_ns();
+  ssd1306_UpdateScreen();
+  update_sim_ns += hal_model_now_ns() - s0;
+  update_host_ns += host_ns() - h0;
+  updates++;
+}
+
+static void reset_counters(void)
+{
+  suite_ops = 0;
+  updates = 0;
+  update_host_ns = 0;
+  update_sim_ns = 0;
+}
+
+/* Fresh bus model and panel with the given frame on screen */
+static void start_panel(uint32_t i2c_hz, const uint8_t *frame)
+{
+  hal_model_reset();
+  hi2c1.ClockSpeed = i2c_hz;
+  ssd1306_Init();
+  if (frame) ssd1306_FillBuffer((uint8_t *)frame, SSD1306_BUFFER_SIZE);
+  ssd1306_UpdateScreen();
+  reset_counters();
+}
+
+typedef struct {
+  uint32_t ops;
+  uint32_t updates;
+  uint64_t wire_bytes;
+  uint64_t update_ns;       /* Simulated time in ssd1306_UpdateScreen */
+  uint64_t active_ns;       /* Simulated time outside HAL_Delay */
+} Suite_Sim_t;
+
+static Suite_Sim_t run_simulated(const Suite_Scenario_t *sc, uint32_t i2c_hz)
+{
+  Suite_Sim_t r;
+  start_panel(i2c_hz, NULL);
+
+  const HAL_Model_Stats_t *st = hal_model_stats();
+  uint64_t t0 = hal_model_now_ns();
+  uint64_t bytes0 = st->i2c.bytes;
+  uint64_t delay0 = st->delay_ns;
+
+  sc->run();
+
+  r.ops = suite_ops;
+  r.updates = updates;
+  r.wire_bytes = st->i2c.bytes - bytes0;
+  r.update_ns = update_sim_ns;
+  r.active_ns = hal_model_now_ns() - t0 - (st->delay_ns - delay0);
+  return r;
+}
+
+/*
+ * Bytes the scenario changes. Run it over a pattern and over its complement:
+ * any store, OR, AND-NOT or XOR that alters a byte differs from at least one
+ * of the two starting values, so together they catch every touched byte.
+ */
+static uint32_t bytes_touched(const Suite_Scenario_t *sc)
+{
+  static uint8_t before[SSD1306_BUFFER_SIZE];
+  uint8_t touched[SSD1306_BUFFER_SIZE] = { 0 };
+  uint32_t count = 0;
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (uint32_t i = 0; i < SSD1306_BUFFER_SIZE; i++) {
+      uint8_t p = (uint8_t)(i * 37U + 11U) ^ 0xA5U;
+      before[i] = pass ? (uint8_t)~p : p;
+    }
+    start_panel(1000000U, before);
+    sc->run();
+    const uint8_t *after = ssd1306_model_gddram();
+    for (uint32_t i = 0; i < SSD1306_BUFFER_SIZE; i++) touched[i] |= (after[i] != before[i]);
+  }
+  for (uint32_t i = 0; i < SSD1306_BUFFER_SIZE; i++) count += touched[i];
+  return count;
+}
+
+/* Host CPU time per drawing call, excluding ssd1306_UpdateScreen */
+static double host_ns_per_op(const Suite_Scenario_t *sc)
+{
+  uint64_t h0, draw_ns;
+  double best = 0.0;
+
+  start_panel(1000000U, NULL);
+  h0 = host_ns();
+  sc->run();
+  draw_ns = host_ns() - h0 - update_host_ns;
+  if (suite_ops == 0) return 0.0;
+
+  uint32_t reps = (uint32_t)(SUITE_BATCH_NS / (draw_ns + update_host_ns + 1U)) + 1U;
+
+  for (int b = 0; b < SUITE_BATCHES; b++) {
+    uint64_t ops = 0;
+    draw_ns = 0;
+    for (uint32_t n = 0; n < reps; n++) {
+      start_panel(1000000U, NULL);
+      h0 = host_ns();
+      sc->run();
+      draw_ns += host_ns() - h0 - update_host_ns;
+      ops += suite_ops;
+    }
+    double ns = (double)draw_ns / (double)ops;
+    if (b == 0 || ns < best) best = ns;
+  }
+  return best;
+}
+
+static void run_scenario(const Suite_Scenario_t *sc)
+{
+  Suite_Sim_t sim[NUM_CLOCKS];
+
+  for (uint32_t c = 0; c < NUM_CLOCKS; c++) sim[c] = run_simulated(sc, clocks[c].hz);
+
+  printf("scenario=%s ops=%u updates=%u ns_per_op=%.1f fb_bytes_touched=%u wire_bytes=%llu",
+         sc->name, sim[1].ops, sim[1].updates, host_ns_per_op(sc), bytes_touched(sc),
+         (unsigned long long)sim[1].wire_bytes);
+  for (uint32_t c = 0; c < NUM_CLOCKS; c++) {
+    printf(" bus_us_%s=%.1f", clocks[c].label, sim[c].update_ns / 1e3);
+  }
+  if (sc->timed) {
+    for (uint32_t c = 0; c < NUM_CLOCKS; c++) {
+      printf(" fps_%s=%.1f", clocks[c].label, sim[c].updates * 1e9 / sim[c].active_ns);
+    }
+  }
+  printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+  printf("suite=ssd1306 format=1 transport=i2c clocks=100k,400k,1m\n");
+
+  for (uint32_t s = 0; s < NUM_SCENARIOS; s++) {
+    int selected = (argc < 2);
+    for (int a = 1; a < argc; a++) {
+      if (strcmp(argv[a], scenarios[s].name) == 0) selected = 1;
+    }
+    if (selected) run_scenario(&scenarios[s]);
+  }
+  return 0;
+}
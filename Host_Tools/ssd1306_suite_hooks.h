@@ -0,0 +1,41 @@
+/**
+  ******************************************************************************
+  * @file    ssd1306_suite_hooks.h
+  * @brief   Force-included into ssd1306_tests.c for the benchmark suite.
+  *
+  *          Counts every drawing call the test scenarios make and routes
+  *          ssd1306_UpdateScreen through the suite, so drawing and transfer
+  *          time can be measured apart without touching the firmware tests.
+  *          A function-like macro does not expand inside its own body, so
+  *          each hook still calls the real driver function.
+  ******************************************************************************
+  */
+
+#ifndef __SSD1306_SUITE_HOOKS_H
+#define __SSD1306_SUITE_HOOKS_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+#include "ssd1306_bignum.h"
+
+extern uint32_t suite_ops;
+void suite_update(void);
+
+#define ssd1306_UpdateScreen()            suite_update()
+
+#define ssd1306_Fill(...)                 (suite_ops++, ssd1306_Fill(__VA_ARGS__))
+#define ssd1306_DrawPixel(...)            (suite_ops++, ssd1306_DrawPixel(__VA_ARGS__))
+#define ssd1306_WriteString(...)          (suite_ops++, ssd1306_WriteString(__VA_ARGS__))
+#define ssd1306_Line(...)                 (suite_ops++, ssd1306_Line(__VA_ARGS__))
+#define ssd1306_Polyline(...)             (suite_ops++, ssd1306_Polyline(__VA_ARGS__))
+#define ssd1306_DrawArc(...)              (suite_ops++, ssd1306_DrawArc(__VA_ARGS__))
+#define ssd1306_DrawArcWithRadiusLine(...) (suite_ops++, ssd1306_DrawArcWithRadiusLine(__VA_ARGS__))
+#define ssd1306_DrawCircle(...)           (suite_ops++, ssd1306_DrawCircle(__VA_ARGS__))
+#define ssd1306_FillCircle(...)           (suite_ops++, ssd1306_FillCircle(__VA_ARGS__))
+#define ssd1306_DrawRectangle(...)        (suite_ops++, ssd1306_DrawRectangle(__VA_ARGS__))
+#define ssd1306_FillRectangle(...)        (suite_ops++, ssd1306_FillRectangle(__VA_ARGS__))
+#define ssd1306_InvertRectangle(...)      (suite_ops++, ssd1306_InvertRectangle(__VA_ARGS__))
+#define ssd1306_DrawBitmap(...)           (suite_ops++, ssd1306_DrawBitmap(__VA_ARGS__))
+#define ssd1306_BigNumWriteFloat(...)     (suite_ops++, ssd1306_BigNumWriteFloat(__VA_ARGS__))
+
+#endif /* __SSD1306_SUITE_HOOKS_H */
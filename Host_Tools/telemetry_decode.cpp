@@ -0,0 +1,693 @@
+/**
+  ******************************************************************************
+  * @file    telemetry_decode.cpp
+  * @brief   Decoder for the binary telemetry logs (LOG00001.BIN, ...).
+  *
+  *          The record layout is taken from the descriptors in the file
+  *          header, not from telemetry_binlog.h, so older logs decode as
+  *          they were written. Sectors are checked by sequence number and
+  *          CRC, as TelemetryBinlog_CheckSector does but with a slicing-by-8
+  *          CRC, which is several times faster than the firmware's small
+  *          table on the host. The CRC is seeded with the header's file ID
+  *          (version 4), so a sector an earlier log left at the same place
+  *          fails like a damaged one. A sector that fails is skipped and counted. A partial
+  *          last sector, left by a power cut or an open session, is
+  *          decoded but counted as unverified. Invalid sectors at the end
+  *          of the file are the unused part of a preallocated log that was
+  *          not closed, and are counted as unused rather than bad.
+  *
+  *          Packed sectors (version 3) are unpacked against the header's
+  *          field list, as TelemetryBinlog_Unpack does for the firmware's
+  *          own; plain and packed sectors may be mixed in one file.
+  *
+  *          Decoding stops at the index trailer of a closed log. With
+  *          --from, the trailer is read first and decoding starts at the
+  *          last indexed sector at or before that time, so a time range is
+  *          found without reading the records before it. Logs without a
+  *          trailer are read from the start.
+  *
+  *          TimeMS increases through a file, except for the history a
+  *          black box event logs behind newer records (version 5). Rows
+  *          are then held back for the header's history window and
+  *          written in TimeMS order, the late ones merged in; one further
+  *          behind than the window is written where it falls, and counted.
+  *          --from seeks back by the window too.
+  *
+  *          --legacy writes the CSV the firmware logged before the binary
+  *          format (TELEMETRY_LOG_BINARY=0): its seven columns and header,
+  *          with values rounded as its "%.2f" rounds them, so the file is
+  *          byte-identical for scripts written against telemetry.csv. The
+  *          one exception is a value printed "-0.00" there, "0.00" here.
+  *
+  *          Usage: telemetry_decode [options] LOG00001.BIN
+  *            -o FILE       write CSV to FILE instead of stdout
+  *            --legacy      CSV in the firmware's TimeMS,...,Voltage format
+  *            --columns DIR write one little-endian float64 array per field
+  *                          (DIR/<name>.f64) and DIR/columns.txt
+  *            --from MS     only records with TimeMS >= MS
+  *            --to MS       only records with TimeMS <= MS
+  *            --stats       print key=value totals and throughput to stderr
+  ******************************************************************************
+  */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "telemetry_binlog.h"
+
+namespace {
+
+const size_t kSector = TELEMETRY_BINLOG_SECTOR;
+const size_t kChunkSectors = 2048;     // 1 MB reads
+
+/* Columns of the firmware's CSV log, in its order: "%lu" or "%.2f" */
+const struct {
+  const char *name;
+  uint8_t decimals;
+} kLegacyColumns[] = {
+  {"TimeMS", 0}, {"Hour", 0}, {"Min", 0}, {"Sec", 0}, {"Altitude", 2}, {"Speed", 2}, {"Voltage", 2},
+};
+
+struct Field {
+  std::string name;
+  uint8_t type;
+  uint8_t offset;
+  uint8_t decimals;
+};
+
+struct Schema {
+  uint32_t version = 0;
+  uint32_t record_size = 0;
+  uint32_t per_sector = 0;
+  uint32_t file_id = 0;           // Seeds every sector's CRC; 0 before version 4
+  uint32_t history_ms = 0;        // How far behind a record may be logged; 0 before version 5
+  std::vector<Field> fields;
+};
+
+/* Running values through a packed sector, as in TelemetryBinlog_Packer_t */
+struct Packer {
+  std::vector<uint32_t> value;
+  uint32_t interval = 0;
+};
+
+struct IndexEntry {
+  uint32_t time_ms;
+  uint32_t offset;
+};
+
+struct Totals {
+  uint64_t sectors = 0;
+  uint64_t records = 0;
+  uint64_t bad_sectors = 0;
+  uint64_t unverified = 0;
+  uint64_t unused = 0;            // Trailing invalid sectors
+  uint64_t late = 0;              // Records behind the history window
+  uint64_t index = 0;             // Index trailer entries
+  uint64_t start_sector = 1;
+  uint64_t bytes_in = 0;
+};
+
+/* CRC-32 matching TelemetryBinlog_Crc32, eight bytes per step */
+class Crc32 {
+ public:
+  Crc32() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320U & (0U - (c & 1U)));
+      t_[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+      for (int s = 1; s < 8; s++) t_[s][i] = (t_[s - 1][i] >> 8) ^ t_[0][t_[s - 1][i] & 0xFF];
+    }
+  }
+
+  /* Seeded as TelemetryBinlog_Crc32Update continues from crc */
+  uint32_t operator()(const uint8_t *p, size_t len, uint32_t crc = 0) const {
+    uint32_t c = ~crc;
+    for (; len >= 8; len -= 8, p += 8) {
+      uint32_t a = c ^ TelemetryBinlog_Get32(p);
+      uint32_t b = TelemetryBinlog_Get32(p + 4);
+      c = t_[7][a & 0xFF] ^ t_[6][(a >> 8) & 0xFF] ^ t_[5][(a >> 16) & 0xFF] ^ t_[4][a >> 24] ^
+          t_[3][b & 0xFF] ^ t_[2][(b >> 8) & 0xFF] ^ t_[1][(b >> 16) & 0xFF] ^ t_[0][b >> 24];
+    }
+    while (len--) c = (c >> 8) ^ t_[0][(c ^ *p++) & 0xFF];
+    return ~c;
+  }
+
+ private:
+  uint32_t t_[8][256];
+};
+
+/* TelemetryBinlog_CheckSector, or CheckIndex given the index magic, with the faster CRC */
+int32_t CheckSector(const Crc32 &crc, const uint8_t *sector, uint32_t seq, uint32_t file_id, uint32_t per_sector,
+                    uint32_t magic = TELEMETRY_BINLOG_MAGIC) {
+  uint32_t count = TelemetryBinlog_Get16(sector + TELEMETRY_BINLOG_COUNT_OFFSET);
+
+  if (TelemetryBinlog_Get16(sector) != magic) return -1;
+  if (TelemetryBinlog_Get32(sector + TELEMETRY_BINLOG_SEQ_OFFSET) != seq) return -1;
+  if (count > per_sector) return -1;
+  if (TelemetryBinlog_Get32(sector + TELEMETRY_BINLOG_CRC_OFFSET) !=
+      crc(sector, TELEMETRY_BINLOG_CRC_OFFSET, file_id)) return -1;
+  return (int32_t)count;
+}
+
+/* Same as TelemetryBinlog_Get, inlined into the per-value loop */
+inline int64_t ReadField(const uint8_t *p, uint8_t type) {
+  switch (type) {
+    case TELEMETRY_BINLOG_U8:  return p[0];
+    case TELEMETRY_BINLOG_U16: return (uint16_t)(p[0] | p[1] << 8);
+    case TELEMETRY_BINLOG_I16: return (int16_t)(p[0] | p[1] << 8);
+    case TELEMETRY_BINLOG_I24: return (int32_t)((uint32_t)(p[0] | p[1] << 8 | p[2] << 16) << 8) >> 8;
+    default:                   return TelemetryBinlog_Get32(p);
+  }
+}
+
+/* Read a varint of at most 5 bytes; single-byte ones, the usual case, first */
+inline bool ReadVarint(const uint8_t *&p, const uint8_t *end, uint32_t *v) {
+  if (p < end && !(*p & 0x80)) {
+    *v = *p++;
+    return true;
+  }
+  uint32_t x = 0;
+  for (uint32_t shift = 0; p < end && shift < 35; shift += 7) {
+    uint8_t b = *p++;
+    x |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      *v = x;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* TelemetryBinlog_Unpack over the header's fields (1 to 32 of them); false if malformed */
+inline bool Unpack(const uint8_t *&pos, const uint8_t *end, Packer *packer) {
+  const uint32_t n = (uint32_t)packer->value.size();
+  uint32_t *value = packer->value.data();
+  const uint8_t *p = pos;
+  uint32_t mask, d;
+
+  if (!ReadVarint(p, end, &mask) || (n < 32 && (mask >> n))) return false;
+  if (mask & (1U << (n - 1))) {   // TimeMS, coded as the change in its step
+    if (!ReadVarint(p, end, &d)) return false;
+    packer->interval += (d >> 1) ^ (0U - (d & 1U));
+    mask &= ~(1U << (n - 1));
+  }
+  value[0] += packer->interval;
+  while (mask) {
+    uint32_t bit = 31 - (uint32_t)__builtin_clz(mask);   // Fields in order
+    mask &= ~(1U << bit);
+    if (!ReadVarint(p, end, &d)) return false;
+    value[n - 1 - bit] += (d >> 1) ^ (0U - (d & 1U));
+  }
+  pos = p;
+  return true;
+}
+
+/* A packed value as TelemetryBinlog_Get would read it from a plain record */
+inline int64_t PackedField(uint32_t v, uint8_t type) {
+  return type == TELEMETRY_BINLOG_U32 ? (int64_t)v : (int64_t)(int32_t)v;
+}
+
+/* Buffered output with fixed-point formatting, avoiding printf per value */
+class CsvWriter {
+ public:
+  explicit CsvWriter(FILE *out) : out_(out), buf_(kFlush + kRowMax), p_(buf_.data()) {}
+  ~CsvWriter() { Flush(); }
+
+  void Text(const std::string &s) {
+    memcpy(p_, s.data(), s.size());
+    p_ += s.size();
+  }
+  void Char(char c) { *p_++ = c; }
+
+  /* Field values are at most 32 bits wide, so the digits fit in uint32_t */
+  void Fixed(int64_t v, uint8_t decimals) {
+    char tmp[24];
+    char *p = tmp + sizeof(tmp);
+    bool neg = v < 0;
+    uint32_t u = (uint32_t)(neg ? -v : v);
+
+    for (uint8_t d = 0; d < decimals; d++) {
+      *--p = (char)('0' + u % 10);
+      u /= 10;
+    }
+    if (decimals) *--p = '.';
+    do {
+      *--p = (char)('0' + u % 10);
+      u /= 10;
+    } while (u);
+    if (neg) *--p = '-';
+    size_t n = (size_t)(tmp + sizeof(tmp) - p);
+    memcpy(p_, p, n);
+    p_ += n;
+  }
+
+  void EndRow() {
+    *p_++ = '\n';
+    if ((size_t)(p_ - buf_.data()) >= kFlush) Flush();
+  }
+
+  void Flush() {
+    fwrite(buf_.data(), 1, (size_t)(p_ - buf_.data()), out_);
+    p_ = buf_.data();
+  }
+
+ private:
+  static const size_t kFlush = 1 << 20;
+  static const size_t kRowMax = 256 * 24;   // Longest possible row: 255 fields
+  FILE *out_;
+  std::vector<char> buf_;
+  char *p_;
+};
+
+/* One output file per field, buffered */
+class ColumnWriter {
+ public:
+  bool Open(const std::string &dir, const Schema &schema) {
+    dir_ = dir;
+    for (const Field &f : schema.fields) {
+      FILE *fp = fopen((dir + "/" + f.name + ".f64").c_str(), "wb");
+      if (!fp) return false;
+      files_.push_back(fp);
+      bufs_.emplace_back();
+      bufs_.back().reserve(kFlush);
+    }
+    return true;
+  }
+
+  void Value(size_t field, double v) {
+    bufs_[field].push_back(v);
+    if (bufs_[field].size() == kFlush) FlushOne(field);
+  }
+
+  void Close(const Schema &schema, uint64_t records) {
+    for (size_t i = 0; i < files_.size(); i++) {
+      FlushOne(i);
+      fclose(files_[i]);
+    }
+    FILE *fp = fopen((dir_ + "/columns.txt").c_str(), "w");
+    if (!fp) return;
+    fprintf(fp, "records=%llu\n", (unsigned long long)records);
+    for (const Field &f : schema.fields) {
+      fprintf(fp, "%s.f64 name=%s decimals=%u\n", f.name.c_str(), f.name.c_str(), f.decimals);
+    }
+    fclose(fp);
+  }
+
+ private:
+  static const size_t kFlush = 1 << 16;
+
+  void FlushOne(size_t i) {
+    fwrite(bufs_[i].data(), sizeof(double), bufs_[i].size(), files_[i]);
+    bufs_[i].clear();
+  }
+
+  std::string dir_;
+  std::vector<FILE *> files_;
+  std::vector<std::vector<double>> bufs_;
+};
+
+bool ParseHeader(const uint8_t *sector, Schema *schema) {
+  schema->file_id = TelemetryBinlog_FileId(sector);
+  if (TelemetryBinlog_CheckSector(sector, 0, schema->file_id) < 0) return false;
+
+  const uint8_t *hdr = sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET;
+  if (memcmp(hdr, TELEMETRY_BINLOG_HDR_ID, 4) != 0) return false;
+
+  schema->version = TelemetryBinlog_Get16(hdr + TELEMETRY_BINLOG_HDR_VERSION);
+  schema->record_size = TelemetryBinlog_Get16(hdr + TELEMETRY_BINLOG_HDR_RECORD_SIZE);
+  schema->per_sector = TelemetryBinlog_Get16(hdr + TELEMETRY_BINLOG_HDR_PER_SECTOR);
+  uint32_t count = TelemetryBinlog_Get16(hdr + TELEMETRY_BINLOG_HDR_FIELD_COUNT);
+  uint32_t fields_end = TELEMETRY_BINLOG_HDR_FILE_ID;
+  if (schema->version >= 5) {
+    schema->history_ms = TelemetryBinlog_Get32(hdr + TELEMETRY_BINLOG_HDR_HISTORY_MS);
+    fields_end = TELEMETRY_BINLOG_HDR_HISTORY_MS;
+  }
+
+  if (schema->record_size == 0 ||
+      schema->per_sector * schema->record_size > TELEMETRY_BINLOG_PAYLOAD ||
+      TELEMETRY_BINLOG_HDR_FIELDS + count * TELEMETRY_BINLOG_DESC_SIZE > fields_end) {
+    return false;
+  }
+
+  const uint8_t *desc = hdr + TELEMETRY_BINLOG_HDR_FIELDS;
+  for (uint32_t i = 0; i < count; i++, desc += TELEMETRY_BINLOG_DESC_SIZE) {
+    Field f;
+    f.name.assign((const char *)desc, strnlen((const char *)desc, TELEMETRY_BINLOG_NAME_LEN));
+    f.type = desc[TELEMETRY_BINLOG_NAME_LEN + 0];
+    f.offset = desc[TELEMETRY_BINLOG_NAME_LEN + 1];
+    f.decimals = desc[TELEMETRY_BINLOG_NAME_LEN + 2];
+    schema->fields.push_back(f);
+  }
+  return true;
+}
+
+/* Entries of the index trailer, if the log was closed with one; empty if not */
+std::vector<IndexEntry> ReadIndex(FILE *in, const Crc32 &crc, uint32_t file_id) {
+  std::vector<IndexEntry> index;
+  uint8_t sector[kSector];
+
+  if (fseeko(in, 0, SEEK_END) != 0) return index;
+  off_t size = ftello(in);
+  if (size < (off_t)(2 * kSector) || size % kSector) return index;
+
+  uint32_t last = (uint32_t)(size / kSector) - 1;
+  if (fseeko(in, (off_t)last * kSector, SEEK_SET) != 0 || fread(sector, 1, kSector, in) != kSector ||
+      CheckSector(crc, sector, last, file_id, TELEMETRY_BINLOG_INDEX_PER_SECTOR, TELEMETRY_BINLOG_INDEX_MAGIC) < 0) {
+    return index;
+  }
+  uint32_t first = TelemetryBinlog_Get32(sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET + TELEMETRY_BINLOG_INDEX_FIRST);
+  if (first == 0 || first > last || fseeko(in, (off_t)first * kSector, SEEK_SET) != 0) return index;
+
+  for (uint32_t seq = first; seq <= last; seq++) {
+    if (fread(sector, 1, kSector, in) != kSector) return {};
+    int32_t n = CheckSector(crc, sector, seq, file_id, TELEMETRY_BINLOG_INDEX_PER_SECTOR, TELEMETRY_BINLOG_INDEX_MAGIC);
+    if (n < 0) return {};
+    const uint8_t *e = sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET + TELEMETRY_BINLOG_INDEX_ENTRIES;
+    for (int32_t i = 0; i < n; i++, e += TELEMETRY_BINLOG_INDEX_ENTRY_SIZE) {
+      index.push_back({TelemetryBinlog_Get32(e), TelemetryBinlog_Get32(e + 4)});
+    }
+  }
+  return index;
+}
+
+void Usage() {
+  fprintf(stderr, "usage: telemetry_decode [-o out.csv [--legacy] | --columns DIR] [--from MS] [--to MS] [--stats] LOG00001.BIN\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *in_path = nullptr;
+  const char *csv_path = nullptr;
+  const char *col_dir = nullptr;
+  bool want_stats = false;
+  bool legacy = false;
+  bool ranged = false;
+  uint64_t from_ms = 0;
+  uint64_t to_ms = UINT64_MAX;
+
+  for (int a = 1; a < argc; a++) {
+    if (!strcmp(argv[a], "-o") && a + 1 < argc) {
+      csv_path = argv[++a];
+    } else if (!strcmp(argv[a], "--columns") && a + 1 < argc) {
+      col_dir = argv[++a];
+    } else if (!strcmp(argv[a], "--from") && a + 1 < argc) {
+      from_ms = strtoull(argv[++a], nullptr, 10);
+      ranged = true;
+    } else if (!strcmp(argv[a], "--to") && a + 1 < argc) {
+      to_ms = strtoull(argv[++a], nullptr, 10);
+      ranged = true;
+    } else if (!strcmp(argv[a], "--legacy")) {
+      legacy = true;
+    } else if (!strcmp(argv[a], "--stats")) {
+      want_stats = true;
+    } else if (argv[a][0] != '-' && !in_path) {
+      in_path = argv[a];
+    } else {
+      Usage();
+      return 2;
+    }
+  }
+  if (!in_path || (legacy && col_dir)) {
+    Usage();
+    return 2;
+  }
+
+  FILE *in = fopen(in_path, "rb");
+  if (!in) {
+    perror(in_path);
+    return 1;
+  }
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<uint8_t> chunk(kChunkSectors * kSector);
+  Schema schema;
+  Crc32 crc;
+  Totals totals;
+
+  size_t got = fread(chunk.data(), 1, chunk.size(), in);
+  if (got < kSector || !ParseHeader(chunk.data(), &schema)) {
+    fprintf(stderr, "%s: not a telemetry log, or its header sector is damaged\n", in_path);
+    return 1;
+  }
+
+  // The range is matched against TimeMS
+  const size_t nf = schema.fields.size();
+  size_t time_index = nf;
+  for (size_t i = 0; i < nf; i++) {
+    if (schema.fields[i].name == "TimeMS") time_index = i;
+  }
+  if (ranged && time_index == nf) {
+    fprintf(stderr, "%s: no TimeMS field to select a range by\n", in_path);
+    return 1;
+  }
+
+  // Fields written, by index into the record
+  std::vector<size_t> columns;
+  if (legacy) {
+    for (const auto &col : kLegacyColumns) {
+      size_t i = 0;
+      while (i < nf && schema.fields[i].name != col.name) i++;
+      if (i == nf || schema.fields[i].decimals != col.decimals) {
+        fprintf(stderr, "%s: no %s field as the CSV log has it\n", in_path, col.name);
+        return 1;
+      }
+      columns.push_back(i);
+    }
+  } else {
+    for (size_t i = 0; i < nf; i++) columns.push_back(i);
+  }
+
+  FILE *out = stdout;
+  if (!col_dir && csv_path) {
+    out = fopen(csv_path, "wb");
+    if (!out) {
+      perror(csv_path);
+      return 1;
+    }
+  }
+  CsvWriter csv(out);
+  ColumnWriter cols;
+  if (col_dir && !cols.Open(col_dir, schema)) {
+    fprintf(stderr, "%s: cannot create column files\n", col_dir);
+    return 1;
+  }
+
+  if (!col_dir) {
+    for (size_t c = 0; c < columns.size(); c++) {
+      if (c) csv.Char(',');
+      csv.Text(schema.fields[columns[c]].name);
+    }
+    csv.EndRow();
+  }
+
+  std::vector<double> scale;
+  for (const Field &f : schema.fields) {
+    double s = 1.0;
+    for (uint8_t d = 0; d < f.decimals; d++) s /= 10.0;
+    scale.push_back(s);
+  }
+
+  // Packed sectors need the field count to fit the change mask
+  const bool packable = nf >= 1 && nf <= 32 && schema.record_size <= TELEMETRY_BINLOG_PAYLOAD;
+  const uint32_t packed_per_sector = packable ? TELEMETRY_BINLOG_PAYLOAD - schema.record_size + 1 : 0;
+  Packer packer;
+  packer.value.resize(nf);
+
+  // Write one record, value(i) giving field i, if it is in the range
+  auto emit = [&](auto value) {
+    if (ranged) {
+      uint64_t t = (uint64_t)value(time_index);
+      if (t < from_ms || t > to_ms) return;
+    }
+    for (size_t c = 0; c < columns.size(); c++) {
+      size_t i = columns[c];
+      int64_t v = value(i);
+      if (col_dir) {
+        cols.Value(i, (double)v * scale[i]);
+      } else {
+        if (c) csv.Char(',');
+        csv.Fixed(v, schema.fields[i].decimals);
+      }
+    }
+    if (!col_dir) csv.EndRow();
+    totals.records++;
+  };
+
+  // Rows held back for the history window, nf values each in TimeMS order;
+  // those before held_first are written
+  const uint64_t window = time_index < nf ? schema.history_ms : 0;
+  std::vector<int64_t> held;
+  size_t held_first = 0;
+  uint64_t newest = 0;        // Latest TimeMS read
+  uint64_t written_ms = 0;    // TimeMS of the last held row written
+
+  auto held_time = [&](size_t r) { return (uint64_t)held[r * nf + time_index]; };
+  // Write the held rows older than limit
+  auto release = [&](uint64_t limit) {
+    size_t rows = held.size() / nf;
+    for (; held_first < rows && held_time(held_first) < limit; held_first++) {
+      const int64_t *v = &held[held_first * nf];
+      emit([v](size_t i) { return v[i]; });
+      written_ms = held_time(held_first);
+    }
+    if (held_first == rows || held_first > 4096) {
+      held.erase(held.begin(), held.begin() + (std::ptrdiff_t)(held_first * nf));
+      held_first = 0;
+    }
+  };
+
+  // Take one record, value(i) giving field i; false once past the range
+  auto row = [&](auto value) {
+    if (!window) {
+      if (ranged && (uint64_t)value(time_index) > to_ms) return false;
+      emit(value);
+      return true;
+    }
+    uint64_t t = (uint64_t)value(time_index);
+    if (t < written_ms) {
+      totals.late++;
+      emit(value);
+      return true;
+    }
+    // After the held rows at or before it: at the end, but for history
+    size_t at = held.size() / nf;
+    while (at > held_first && held_time(at - 1) > t) at--;
+    held.insert(held.begin() + (std::ptrdiff_t)(at * nf), nf, 0);
+    for (size_t i = 0; i < nf; i++) held[at * nf + i] = value(i);
+    if (t > newest) newest = t;
+    if (newest <= window) return true;
+    release(newest - window);
+    return !ranged || newest - window <= to_ms;
+  };
+
+  uint64_t seq = 1;
+  size_t pos = kSector;   // Sector 0 is the header
+  bool done = false;
+  totals.sectors = 1;
+  totals.bytes_in = got;
+
+  if (ranged) {
+    // Start at the last indexed sector that begins at or before from_ms
+    // An entry may be a history record's time, up to the window behind
+    std::vector<IndexEntry> index = ReadIndex(in, crc, schema.file_id);
+    for (size_t i = 1; i < index.size(); i++) index[i].time_ms = std::max(index[i].time_ms, index[i - 1].time_ms);
+    uint64_t seek_ms = from_ms > window ? from_ms - window : 0;
+    auto it = std::upper_bound(index.begin(), index.end(), seek_ms,
+                               [](uint64_t t, const IndexEntry &e) { return t < e.time_ms; });
+    totals.index = index.size();
+    if (it != index.begin() && (--it)->offset / kSector > 1) {
+      seq = it->offset / kSector;
+      if (fseeko(in, (off_t)seq * kSector, SEEK_SET) != 0) {
+        perror(in_path);
+        return 1;
+      }
+      got = fread(chunk.data(), 1, chunk.size(), in);
+      totals.bytes_in += got;
+      pos = 0;
+    } else {
+      fseeko(in, (off_t)got, SEEK_SET);
+    }
+    totals.start_sector = seq;
+  }
+
+  while (!done && got > pos) {
+    for (; pos < got; pos += kSector, seq++) {
+      const uint8_t *sector = chunk.data() + pos;
+      size_t avail = got - pos;
+      int32_t count;
+
+      uint32_t magic = avail >= TELEMETRY_BINLOG_PAYLOAD_OFFSET ? TelemetryBinlog_Get16(sector) : 0;
+      // Index trailer: the records end here. One of another file's, left
+      // in an unclosed log's preallocation, is only an unused sector
+      if (magic == TELEMETRY_BINLOG_INDEX_MAGIC &&
+          (avail < kSector || CheckSector(crc, sector, (uint32_t)seq, schema.file_id,
+                                          TELEMETRY_BINLOG_INDEX_PER_SECTOR, TELEMETRY_BINLOG_INDEX_MAGIC) >= 0)) {
+        done = true;
+        break;
+      }
+      bool packed = packable && magic == TELEMETRY_BINLOG_PACKED_MAGIC;
+      totals.sectors++;
+      if (avail >= kSector) {
+        count = packed ? CheckSector(crc, sector, (uint32_t)seq, schema.file_id, packed_per_sector,
+                                     TELEMETRY_BINLOG_PACKED_MAGIC)
+                       : CheckSector(crc, sector, (uint32_t)seq, schema.file_id, schema.per_sector);
+        if (count < 0) {
+          totals.unused++;    // Bad unless a valid sector follows
+          continue;
+        }
+        totals.bad_sectors += totals.unused;
+        totals.unused = 0;
+      } else {
+        // Unsealed tail: take the whole records it holds if the frame is ours
+        if (avail < TELEMETRY_BINLOG_PAYLOAD_OFFSET ||
+            TelemetryBinlog_Get16(sector) != TELEMETRY_BINLOG_MAGIC ||
+            TelemetryBinlog_Get32(sector + TELEMETRY_BINLOG_SEQ_OFFSET) != seq) {
+          totals.unused++;
+          break;
+        }
+        totals.bad_sectors += totals.unused;
+        totals.unused = 0;
+        count = (int32_t)((avail - TELEMETRY_BINLOG_PAYLOAD_OFFSET) / schema.record_size);
+        if ((uint32_t)count > schema.per_sector) count = (int32_t)schema.per_sector;
+        totals.unverified += (uint64_t)count;
+      }
+
+      const uint8_t *rec = sector + TELEMETRY_BINLOG_PAYLOAD_OFFSET;
+      auto plain = [&](size_t i) { return ReadField(rec + schema.fields[i].offset, schema.fields[i].type); };
+      auto unpacked = [&](size_t i) { return PackedField(packer.value[i], schema.fields[i].type); };
+
+      if (packed) {
+        // The first record is stored plain, the rest as changes from the one before
+        const uint8_t *p = rec + schema.record_size;
+        const uint8_t *end = sector + TELEMETRY_BINLOG_COUNT_OFFSET;
+
+        for (size_t i = 0; i < nf; i++) packer.value[i] = (uint32_t)plain(i);
+        packer.interval = 0;
+        for (int32_t r = 0; r < count && !done; r++) {
+          if (r && !Unpack(p, end, &packer)) {
+            totals.bad_sectors++;
+            break;
+          }
+          done = !row(unpacked);
+        }
+      } else {
+        for (int32_t r = 0; r < count && !done; r++, rec += schema.record_size) done = !row(plain);
+      }
+      if (done) break;
+    }
+    if (done || got < chunk.size()) break;
+    got = fread(chunk.data(), 1, chunk.size(), in);
+    totals.bytes_in += got;
+    pos = 0;
+  }
+  fclose(in);
+  if (window) release(UINT64_MAX);
+
+  if (col_dir) {
+    cols.Close(schema, totals.records);
+  } else {
+    csv.Flush();
+    if (out != stdout) fclose(out);
+  }
+
+  if (want_stats) {
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "version=%u record_size=%u fields=%zu sectors=%llu records=%llu "
+            "bad_sectors=%llu unverified=%llu unused=%llu late=%llu index=%llu start_sector=%llu bytes=%llu mb_per_s=%.1f\n",
+            schema.version, schema.record_size, schema.fields.size(),
+            (unsigned long long)totals.sectors, (unsigned long long)totals.records,
+            (unsigned long long)totals.bad_sectors, (unsigned long long)totals.unverified,
+            (unsigned long long)totals.unused, (unsigned long long)totals.late, (unsigned long long)totals.index,
+            (unsigned long long)totals.start_sector,
+            (unsigned long long)totals.bytes_in, s > 0 ? totals.bytes_in / s / 1e6 : 0.0);
+  }
+  return totals.bad_sectors ? 3 : 0;
+}
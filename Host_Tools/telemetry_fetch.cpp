@@ -0,0 +1,407 @@
+/**
+  ******************************************************************************
+  * @file    telemetry_fetch.cpp
+  * @brief   Downloads a log file from the device over its serial port.
+  *
+  *          Speaks the protocol in telemetry_download.h: asks for the file
+  *          at the telemetry rate (9600 baud), follows the device to the
+  *          transfer rate, and writes each data frame at its offset once its
+  *          CRC checks. A bad, out-of-order or missing frame ends the
+  *          transfer with STOP, and the rest is asked for again from the last
+  *          good offset, up to --retries times. At the END frame the CRC-32
+  *          of the data must match the device's, and what was written is
+  *          read back from disk and checked once more.
+  *
+  *          The device only ever logs binary. With --csv the fetched log is
+  *          also turned into the CSV the firmware used to log, by running
+  *          telemetry_decode --legacy on it (from beside this program, or
+  *          PATH), so the card costs binary and the scripts still get CSV.
+  *
+  *          Usage: telemetry_fetch [options] PORT FILE_NUMBER
+  *            -o FILE       output file (default LOG<n>.BIN, as on the card)
+  *            --baud N      transfer rate (default 921600; 0 stays at 9600)
+  *            --resume      keep what FILE already holds and fetch the rest
+  *            --retries N   re-requests after a bad frame (default 5)
+  *            --csv FILE    also write the log as legacy CSV to FILE
+  *            --stats       print key=value totals and throughput to stderr
+  ******************************************************************************
+  */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "telemetry_binlog.h"
+#include "telemetry_download.h"
+
+extern char **environ;
+
+namespace {
+
+const uint32_t kTelemetryBaud = 9600;
+const int kReplyTimeoutMs = 2000;
+const int kQuietMs = 300;             // Line silent this long: the device has stopped
+
+struct Totals {
+  uint64_t bytes = 0;
+  uint64_t frames = 0;
+  uint64_t bad_frames = 0;
+  uint32_t requests = 0;
+};
+
+struct BaudRate {
+  uint32_t baud;
+  speed_t speed;
+};
+
+const BaudRate kBaudRates[] = {
+  { 1200, B1200 }, { 2400, B2400 }, { 4800, B4800 }, { 9600, B9600 },
+  { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 }, { 115200, B115200 },
+  { 230400, B230400 },
+#ifdef B460800
+  { 460800, B460800 },
+#endif
+#ifdef B921600
+  { 921600, B921600 },
+#endif
+#ifdef B1000000
+  { 1000000, B1000000 },
+#endif
+#ifdef B2000000
+  { 2000000, B2000000 },
+#endif
+};
+
+/* Raw serial port with a read buffer */
+class Port {
+ public:
+  ~Port() {
+    if (fd_ >= 0) close(fd_);
+  }
+
+  bool Open(const char *path) {
+    fd_ = open(path, O_RDWR | O_NOCTTY);
+    if (fd_ < 0) return false;
+    termios t;
+    if (tcgetattr(fd_, &t) != 0) return false;
+    cfmakeraw(&t);
+    t.c_cflag |= CLOCAL | CREAD;
+    t.c_cflag &= ~(CSTOPB | CRTSCTS);
+    t.c_cc[VMIN] = 0;
+    t.c_cc[VTIME] = 0;
+    return tcsetattr(fd_, TCSANOW, &t) == 0 && SetBaud(kTelemetryBaud);
+  }
+
+  /* After what was written has gone, as the device changes rate */
+  bool SetBaud(uint32_t baud) {
+    for (const BaudRate &r : kBaudRates) {
+      if (r.baud != baud) continue;
+      termios t;
+      tcdrain(fd_);
+      if (tcgetattr(fd_, &t) != 0) return false;
+      cfsetispeed(&t, r.speed);
+      cfsetospeed(&t, r.speed);
+      return tcsetattr(fd_, TCSANOW, &t) == 0;
+    }
+    return false;
+  }
+
+  bool Write(const std::string &s) {
+    return write(fd_, s.data(), s.size()) == (ssize_t)s.size();
+  }
+
+  /* At least n bytes buffered, waiting up to timeout_ms for each read */
+  bool Need(size_t n, int timeout_ms) {
+    while (buf_.size() - pos_ < n) {
+      if (pos_ && pos_ == buf_.size()) {
+        buf_.clear();
+        pos_ = 0;
+      }
+      uint8_t tmp[16384];
+      pollfd p = { fd_, POLLIN, 0 };
+      if (poll(&p, 1, timeout_ms) <= 0) return false;
+      ssize_t got = read(fd_, tmp, sizeof(tmp));
+      if (got <= 0) return false;
+      buf_.insert(buf_.end(), tmp, tmp + got);
+    }
+    return true;
+  }
+
+  const uint8_t *Data() const { return buf_.data() + pos_; }
+
+  void Consume(size_t n) { pos_ += n; }
+
+  /* The next line, without its CR/LF */
+  bool ReadLine(std::string *line, int timeout_ms) {
+    line->clear();
+    while (Need(1, timeout_ms)) {
+      char c = (char)*Data();
+      Consume(1);
+      if (c == '\n') return true;
+      if (c != '\r') *line += c;
+    }
+    return false;
+  }
+
+  /* Throws away input until the line has been quiet for quiet_ms */
+  void Drain(int quiet_ms) {
+    buf_.clear();
+    pos_ = 0;
+    while (Need(1, quiet_ms)) {
+      buf_.clear();
+      pos_ = 0;
+    }
+    tcflush(fd_, TCIFLUSH);
+  }
+
+ private:
+  int fd_ = -1;
+  std::vector<uint8_t> buf_;
+  size_t pos_ = 0;
+};
+
+struct Frame {
+  uint8_t type;
+  uint32_t offset;
+  const uint8_t *payload;
+  uint16_t length;
+};
+
+/* The next frame, CRC checked; false on a bad frame or a silent line */
+bool ReadFrame(Port &port, int timeout_ms, Frame *f) {
+  if (!port.Need(TELEMETRY_DOWNLOAD_HEADER, timeout_ms)) return false;
+  const uint8_t *h = port.Data();
+  uint32_t length = TelemetryBinlog_Get16(h + 8);
+  if (TelemetryBinlog_Get16(h) != TELEMETRY_DOWNLOAD_MAGIC || length > TELEMETRY_DOWNLOAD_CHUNK) return false;
+
+  size_t total = TELEMETRY_DOWNLOAD_HEADER + length + TELEMETRY_DOWNLOAD_TRAILER;
+  if (!port.Need(total, timeout_ms)) return false;
+  h = port.Data();
+  if (TelemetryBinlog_Get32(h + total - TELEMETRY_DOWNLOAD_TRAILER) !=
+      TelemetryBinlog_Crc32(h, TELEMETRY_DOWNLOAD_HEADER + length)) return false;
+
+  f->type = h[2];
+  f->offset = TelemetryBinlog_Get32(h + 4);
+  f->payload = h + TELEMETRY_DOWNLOAD_HEADER;
+  f->length = (uint16_t)length;
+  port.Consume(total);
+  return true;
+}
+
+/* CRC-32 of [from, to) of the file as it is on disk */
+bool FileCrc(int fd, uint64_t from, uint64_t to, uint32_t *crc) {
+  std::vector<uint8_t> buf(1 << 20);
+  *crc = 0;
+  while (from < to) {
+    size_t n = (size_t)std::min<uint64_t>(buf.size(), to - from);
+    if (pread(fd, buf.data(), n, (off_t)from) != (ssize_t)n) return false;
+    *crc = TelemetryBinlog_Crc32Update(*crc, buf.data(), (uint32_t)n);
+    from += n;
+  }
+  return true;
+}
+
+/* Exit status of telemetry_decode --legacy on the log, or -1 if it did not run */
+int DecodeCsv(const char *self, const std::string &log, const std::string &csv) {
+  std::string decoder = "telemetry_decode";
+  const char *slash = strrchr(self, '/');
+  if (slash) decoder = std::string(self, (size_t)(slash - self) + 1) + decoder;
+
+  const char *args[] = {decoder.c_str(), "--legacy", "-o", csv.c_str(), log.c_str(), nullptr};
+  pid_t pid;
+  int status;
+  if (posix_spawnp(&pid, args[0], nullptr, nullptr, (char *const *)args, environ) != 0 ||
+      waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+    return -1;
+  }
+  return WEXITSTATUS(status);
+}
+
+void Usage() {
+  fprintf(stderr, "usage: telemetry_fetch [-o FILE] [--csv FILE] [--baud N] [--resume] [--retries N] [--stats] "
+          "PORT FILE_NUMBER\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *port_path = nullptr;
+  const char *number_arg = nullptr;
+  std::string out_path;
+  std::string csv_path;
+  uint32_t baud = 921600;
+  uint32_t retries = 5;
+  bool resume = false;
+  bool want_stats = false;
+
+  for (int a = 1; a < argc; a++) {
+    if (!strcmp(argv[a], "-o") && a + 1 < argc) {
+      out_path = argv[++a];
+    } else if (!strcmp(argv[a], "--csv") && a + 1 < argc) {
+      csv_path = argv[++a];
+    } else if (!strcmp(argv[a], "--baud") && a + 1 < argc) {
+      baud = (uint32_t)strtoul(argv[++a], nullptr, 10);
+    } else if (!strcmp(argv[a], "--retries") && a + 1 < argc) {
+      retries = (uint32_t)strtoul(argv[++a], nullptr, 10);
+    } else if (!strcmp(argv[a], "--resume")) {
+      resume = true;
+    } else if (!strcmp(argv[a], "--stats")) {
+      want_stats = true;
+    } else if (argv[a][0] != '-' && !port_path) {
+      port_path = argv[a];
+    } else if (argv[a][0] != '-' && !number_arg) {
+      number_arg = argv[a];
+    } else {
+      Usage();
+      return 2;
+    }
+  }
+  if (!port_path || !number_arg) {
+    Usage();
+    return 2;
+  }
+  if (baud == 0) baud = kTelemetryBaud;
+  uint32_t number = (uint32_t)strtoul(number_arg, nullptr, 10);
+  if (out_path.empty()) {
+    char name[32];
+    snprintf(name, sizeof(name), "LOG%05u.BIN", number);
+    out_path = name;
+  }
+
+  Port port;
+  if (!port.Open(port_path)) {
+    perror(port_path);
+    return 1;
+  }
+  if (!port.SetBaud(baud)) {
+    fprintf(stderr, "%u: not a rate this host can set\n", baud);
+    return 2;
+  }
+  port.SetBaud(kTelemetryBaud);
+
+  // Created once the device has the file, so a refused GET leaves nothing behind
+  struct stat st;
+  int fd = -1;
+  if (resume && stat(out_path.c_str(), &st) != 0) st.st_size = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  const uint64_t start = resume ? (uint64_t)st.st_size : 0;
+  uint64_t pos = start;
+  uint64_t end = 0;
+  uint32_t crc = 0;                   // Of [start, pos), across requests
+  bool done = false;
+  Totals totals;
+
+  // Each request carries on from the last good frame
+  for (uint32_t attempt = 0; attempt <= retries && !done; attempt++) {
+    if (attempt) {
+      // Stop the device, let it finish its frame, then meet it at the telemetry rate
+      port.Write("STOP\n");
+      port.Drain(kQuietMs);
+      port.SetBaud(kTelemetryBaud);
+    }
+    port.Drain(50);
+    totals.requests++;
+    port.Write("GET " + std::to_string(number) + " " + std::to_string(pos) + " 0 " + std::to_string(baud) + "\n");
+
+    // Telemetry lines may still be on the way before the reply
+    std::string line;
+    bool replied = false;
+    auto asked = std::chrono::steady_clock::now();
+    while (!replied && std::chrono::steady_clock::now() - asked < std::chrono::milliseconds(kReplyTimeoutMs)) {
+      if (!port.ReadLine(&line, kReplyTimeoutMs)) break;
+      replied = !line.compare(0, 3, "OK ") || !line.compare(0, 4, "ERR ");
+    }
+    if (!replied) {
+      fprintf(stderr, "%s: no reply to GET\n", port_path);
+      continue;
+    }
+    unsigned long size, offset, length, rate;
+    if (sscanf(line.c_str(), "OK %lu %lu %lu %lu", &size, &offset, &length, &rate) != 4) {
+      fprintf(stderr, "%s: LOG%05u: %s\n", port_path, number, line.c_str());
+      return 1;
+    }
+    end = offset + length;
+    if (fd < 0) {
+      fd = open(out_path.c_str(), O_RDWR | O_CREAT | (resume ? 0 : O_TRUNC), 0644);
+      if (fd < 0) {
+        perror(out_path.c_str());
+        return 1;
+      }
+    }
+    if (rate != kTelemetryBaud) port.SetBaud((uint32_t)rate);
+
+    // Two frame times at the transfer rate, past the settle time and card reads
+    const int timeout_ms = 500 + (int)(2000ULL * 10U * TELEMETRY_DOWNLOAD_FRAME_MAX / rate);
+    uint32_t request_crc = 0;
+    Frame f;
+    while (ReadFrame(port, timeout_ms, &f) && f.offset == pos) {
+      totals.frames++;
+      if (f.type == TELEMETRY_DOWNLOAD_DATA && f.length) {
+        if (pwrite(fd, f.payload, f.length, (off_t)pos) != (ssize_t)f.length) {
+          perror(out_path.c_str());
+          return 1;
+        }
+        request_crc = TelemetryBinlog_Crc32Update(request_crc, f.payload, f.length);
+        crc = TelemetryBinlog_Crc32Update(crc, f.payload, f.length);
+        pos += f.length;
+        totals.bytes += f.length;
+        continue;
+      }
+      if (f.type == TELEMETRY_DOWNLOAD_END && f.length == 4 && pos == end &&
+          TelemetryBinlog_Get32(f.payload) == request_crc) {
+        done = true;
+      } else if (f.type == TELEMETRY_DOWNLOAD_FAIL) {
+        fprintf(stderr, "%s: LOG%05u: the card failed to read at offset %lu\n", port_path, number,
+                (unsigned long)pos);
+        port.SetBaud(kTelemetryBaud);
+        return 1;
+      }
+      break;
+    }
+    if (!done) totals.bad_frames++;
+  }
+  port.SetBaud(kTelemetryBaud);
+
+  if (!done) {
+    fprintf(stderr, "%s: LOG%05u: gave up at offset %lu after %u requests; --resume carries on\n",
+            port_path, number, (unsigned long)pos, totals.requests);
+    return 1;
+  }
+  uint32_t disk_crc;
+  if (ftruncate(fd, (off_t)end) != 0 || fsync(fd) != 0 || !FileCrc(fd, start, end, &disk_crc) ||
+      disk_crc != crc) {
+    fprintf(stderr, "%s: does not read back as received\n", out_path.c_str());
+    return 1;
+  }
+  close(fd);
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  if (want_stats) {
+    // Efficiency: payload bits against the line's, 10 bits to the byte
+    fprintf(stderr, "file=LOG%05u size=%llu fetched=%llu frames=%llu bad_frames=%llu requests=%u baud=%u "
+            "seconds=%.2f bytes_per_s=%.0f line_efficiency=%.3f\n",
+            number, (unsigned long long)end, (unsigned long long)totals.bytes,
+            (unsigned long long)totals.frames, (unsigned long long)totals.bad_frames, totals.requests,
+            baud, seconds, totals.bytes / seconds, totals.bytes * 10.0 / seconds / baud);
+  }
+
+  if (!csv_path.empty()) {
+    int rc = DecodeCsv(argv[0], out_path, csv_path);
+    if (rc != 0) {
+      fprintf(stderr, "%s: telemetry_decode %s (%d)\n", csv_path.c_str(), rc < 0 ? "did not run" : "failed", rc);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,181 @@
+/**
+  ******************************************************************************
+  * @file    sd_cache.c
+  * @brief   Write-back sector cache between FatFs and an SD card backend.
+  *          See sd_cache.h.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "sd_cache.h"
+
+#if SD_CACHE_SLOTS
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+    DWORD lba;
+    DWORD used;         // cache_clock at the last access, for LRU
+    uint8_t valid;
+    uint8_t dirty;      // Newer than the card
+    BYTE data[512] __attribute__((aligned(4)));
+} SD_CacheSlot_t;
+
+/* Private variables ---------------------------------------------------------*/
+static SD_CacheSlot_t cache[SD_CACHE_SLOTS];
+static DWORD cache_clock;
+static const SD_CacheCard_t *card;
+
+/* Private function prototypes -----------------------------------------------*/
+static SD_CacheSlot_t *cache_find(DWORD lba);
+static SD_CacheSlot_t *cache_victim(void);
+#if _USE_WRITE == 1
+static DRESULT cache_writeback(SD_CacheSlot_t *slot);
+#endif
+
+/**
+  * @brief Finds the slot holding sector lba, or NULL.
+  */
+static SD_CacheSlot_t *cache_find(DWORD lba)
+{
+    for (UINT i = 0; i < SD_CACHE_SLOTS; i++) {
+        if (cache[i].valid && cache[i].lba == lba) return &cache[i];
+    }
+    return NULL;
+}
+
+/**
+  * @brief Frees a slot: an unused one, else the least recently used,
+  *        written back first if dirty.
+  * @retval The slot, now invalid, or NULL if the write-back failed.
+  */
+static SD_CacheSlot_t *cache_victim(void)
+{
+    SD_CacheSlot_t *victim = &cache[0];
+
+    for (UINT i = 0; i < SD_CACHE_SLOTS; i++) {
+        SD_CacheSlot_t *s = &cache[i];
+        if (!s->valid) return s;
+        if ((cache_clock - s->used) > (cache_clock - victim->used)) victim = s;
+    }
+    SD_Stats.cache_evictions++;
+#if _USE_WRITE == 1
+    if (victim->dirty && cache_writeback(victim) != RES_OK) return NULL;
+#endif
+    victim->valid = 0;
+    return victim;
+}
+
+/**
+  * @brief Empties the cache over a newly initialised card.
+  */
+void SD_CacheInit(const SD_CacheCard_t *c)
+{
+    memset(cache, 0, sizeof(cache)); // Possibly another card
+    card = c;
+}
+
+/**
+  * @brief Reads one sector, from its slot or into a new one.
+  */
+DRESULT SD_CacheRead(BYTE *buff, DWORD lba)
+{
+    SD_CacheSlot_t *slot = cache_find(lba);
+
+    if (slot) {
+        SD_Stats.cache_hits++;
+    } else {
+        SD_Stats.cache_misses++;
+        slot = cache_victim();
+        if (!slot || card->read(slot->data, lba) != RES_OK) return RES_ERROR;
+        slot->lba = lba;
+        slot->valid = 1;
+    }
+    slot->used = ++cache_clock;
+    memcpy(buff, slot->data, 512);
+    return RES_OK;
+}
+
+/**
+  * @brief Forgets slots for sectors about to be written past the cache.
+  */
+void SD_CacheDrop(DWORD lba, UINT count)
+{
+    for (UINT i = 0; i < SD_CACHE_SLOTS; i++) {
+        if (cache[i].lba - lba < count) {
+            cache[i].valid = 0;
+            cache[i].dirty = 0;
+        }
+    }
+}
+
+#if _USE_WRITE == 1
+/**
+  * @brief Writes a dirty slot to the card.
+  */
+static DRESULT cache_writeback(SD_CacheSlot_t *slot)
+{
+    DRESULT res = card->write(slot->data, slot->lba);
+
+    if (res != RES_OK) return res;
+    slot->dirty = 0;
+    SD_Stats.cache_writebacks++;
+    return RES_OK;
+}
+
+/**
+  * @brief Writes back dirty slots in ascending sector order.
+  * @param lba, count: Only slots for these sectors (count 0: every slot)
+  */
+DRESULT SD_CacheClean(DWORD lba, UINT count)
+{
+    for (;;) {
+        SD_CacheSlot_t *next = NULL;
+
+        for (UINT i = 0; i < SD_CACHE_SLOTS; i++) {
+            SD_CacheSlot_t *s = &cache[i];
+            if (!s->dirty || (count && s->lba - lba >= count)) continue;
+            if (!next || s->lba < next->lba) next = s;
+        }
+        if (!next) return RES_OK;
+        if (cache_writeback(next) != RES_OK) return RES_ERROR;
+    }
+}
+
+/**
+  * @brief Writes one sector into its slot, or a new one, and marks it dirty.
+  */
+DRESULT SD_CacheWrite(const BYTE *buff, DWORD lba)
+{
+    SD_CacheSlot_t *slot = cache_find(lba);
+
+    if (slot) {
+        SD_Stats.cache_hits++;
+    } else {
+        SD_Stats.cache_misses++;
+        slot = cache_victim();
+        if (!slot) return RES_ERROR;
+        slot->lba = lba;
+        slot->valid = 1;
+    }
+    memcpy(slot->data, buff, 512);
+    slot->dirty = 1;
+    slot->used = ++cache_clock;
+    return RES_OK;
+}
+
+/**
+  * @brief Brings slots up to date with a multi-sector write that goes
+  *        straight to the card.
+  */
+void SD_CacheUpdate(const BYTE *buff, DWORD lba, UINT count)
+{
+    for (UINT i = 0; i < SD_CACHE_SLOTS; i++) {
+        SD_CacheSlot_t *s = &cache[i];
+        if (s->valid && s->lba - lba < count) {
+            memcpy(s->data, buff + (s->lba - lba) * 512, 512);
+            s->dirty = 0;
+        }
+    }
+}
+#endif /* _USE_WRITE == 1 */
+#endif /* SD_CACHE_SLOTS */
@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    sd_cache.h
+  * @brief   Write-back sector cache between FatFs and an SD card backend.
+  *
+  *          SD_CACHE_SLOTS 512-byte slots (user_diskio.h), least recently
+  *          used replaced. Single-sector reads and writes go through it; a
+  *          written slot reaches the card when it is evicted or cleaned on
+  *          CTRL_SYNC. FatFs moves its window between the same FAT and
+  *          directory sectors on every sync, so those stay here instead of
+  *          crossing the bus. Used by user_diskio.c on the card, and by
+  *          Host_Tools/sd_image.c on a disk image, so both count the same
+  *          card operations in SD_Stats.
+  ******************************************************************************
+  */
+
+#ifndef __SD_CACHE_H
+#define __SD_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ff_gen_drv.h"
+#include "user_diskio.h"
+
+/** The card under the cache: one sector either way, past the cache */
+typedef struct {
+  DRESULT (*read)(BYTE *buff, DWORD lba);
+  DRESULT (*write)(const BYTE *buff, DWORD lba);
+} SD_CacheCard_t;
+
+#if SD_CACHE_SLOTS
+/* Empties every slot, dirty or not, over card from here on */
+void SD_CacheInit(const SD_CacheCard_t *card);
+
+/* One sector, from its slot or into a new one */
+DRESULT SD_CacheRead(BYTE *buff, DWORD lba);
+
+/* Forgets slots for count sectors from lba, e.g. written past the cache
+   or trimmed */
+void SD_CacheDrop(DWORD lba, UINT count);
+
+#if _USE_WRITE == 1
+/* One sector into its slot, or a new one, marked dirty */
+DRESULT SD_CacheWrite(const BYTE *buff, DWORD lba);
+
+/* Brings slots up to date with a multi-sector write going straight to the card */
+void SD_CacheUpdate(const BYTE *buff, DWORD lba, UINT count);
+
+/* Writes back dirty slots for count sectors from lba (count 0: every slot),
+   in ascending sector order */
+DRESULT SD_CacheClean(DWORD lba, UINT count);
+#endif
+#endif /* SD_CACHE_SLOTS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SD_CACHE_H */
@@ -12,6 +12,8 @@
 #include <stdlib.h>
 #include "ff_gen_drv.h"
 #include "main.h" // Includes HAL and peripheral handles
+#include "user_diskio.h"
+#include "sd_cache.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -23,6 +25,8 @@
 
 // SD Card Commands
 #define CMD0   (0x40 + 0)  // GO_IDLE_STATE
+#define CMD1   (0x40 + 1)  // SEND_OP_COND (MMC)
+#define CMD6   (0x40 + 6)  // SWITCH_FUNC
 #define CMD8   (0x40 + 8)  // SEND_IF_COND
 #define CMD17  (0x40 + 17) // READ_SINGLE_BLOCK
 #define CMD24  (0x40 + 24) // WRITE_BLOCK
@@ -34,27 +38,226 @@
 #define CMD12  (0x40 + 12) // STOP_TRANSMISSION  <-- MISSING (Needed for CMD18 stop)
 #define CMD13  (0x40 + 13) // SEND_STATUS
 #define CMD18  (0x40 + 18) // READ_MULTIPLE_BLOCK <-- MISSING
+#define CMD23  (0x40 + 23) // SET_WR_BLK_ERASE_COUNT (ACMD23, after CMD55)
 #define CMD25  (0x40 + 25) // WRITE_MULTIPLE_BLOCK <-- MISSING
+#define CMD32  (0x40 + 32) // ERASE_WR_BLK_START
+#define CMD33  (0x40 + 33) // ERASE_WR_BLK_END
+#define CMD38  (0x40 + 38) // ERASE
 #define CMD58  (0x40 + 58) // READ_OCR <-- MISSING
+#define CMD59  (0x40 + 59) // CRC_ON_OFF
 // ---------------------------------------------
 // Data Tokens
 #define DATA_START_BLOCK        0xFE
 #define WRITE_START_BLOCK       0xFE
 #define WRITE_MULTIPLE_BLOCK    0xFC
+#define STOP_TRAN               0xFD
+
+// Data block CRC16 polynomial, x^16 + x^12 + x^5 + 1
+#define SD_CRC16_POLY           0x1021
+// SPI frames per data block written: 16-bit frames when the CRC unit is in use
+#define SD_BLOCK_FRAMES         (SD_CRC ? 256U : 512U)
+
+// Timeouts (ms), deadlines on HAL_GetTick while the card is polled back to back
+#define SD_DMA_TIMEOUT          100     // 512-byte DMA transfer
+#define SD_BUSY_TIMEOUT         500     // Card programming after the data response
+#define SD_READY_TIMEOUT        500     // Card ready before a command or data block
+#define SD_TOKEN_TIMEOUT        200     // Read data token; the spec allows 100 ms
+#define SD_ERASE_TIMEOUT        250     // Per erase block, the spec's default
+#define SD_INIT_TIMEOUT         1000    // Card leaving the idle state after ACMD41
+
+// Bytes a step polls before handing back to the main loop
+#define SD_POLL_BYTES           32
+
+// SPI1 clock while the card is identified: PCLK2/256, under 400 kHz
+#define SD_INIT_PRESCALER       SPI_BAUDRATEPRESCALER_256
+
+// CMD6 argument switching function group 1 to high speed (50 MHz)
+#define SD_SWITCH_HIGH_SPEED    0x80FFFFF1UL
+// Sectors read back with good CRCs at PCLK2/2 before it is kept
+#define SD_HS_TEST_BLOCKS       8U
 
 /* Private variables ---------------------------------------------------------*/
 extern SPI_HandleTypeDef hspi1; // Your SPI handle
 
 static volatile DSTATUS Stat = STA_NOINIT;
 static BYTE CardType;  // Type of SD card (SDv1/SDv2/MMC)
+#define CARD_MMC 3      // CardType value for MMC, which has no ACMD23
+SD_Stats_t SD_Stats;
+SD_Timing_t SD_Timing[SD_OP_COUNT];
+SD_CardInfo_t SD_Card;
+
+// Card operation in flight. A posted write copies the sector to post_buf,
+// clocks it out by DMA and leaves the card programming; a started read
+// waits for each data token and takes the block into post_buf by DMA.
+// USER_Poll steps either one along without waiting, and the blocking calls
+// FatFs makes step it to the end.
+typedef enum {
+    SD_STATE_IDLE = 0,  // Nothing in flight
+    SD_STATE_XMIT,      // Write: data block going out by DMA
+    SD_STATE_BUSY,      // Write: block sent, card programming
+    SD_STATE_TOKEN,     // Read: waiting for the next data token
+    SD_STATE_RECV       // Read: data block coming in by DMA
+} SD_State_t;
+
+static SD_State_t sd_state = SD_STATE_IDLE;
+static uint32_t state_tick;         // When the current phase started
+static uint32_t state_cycles;       // Cycle count then, for its timing
+static volatile uint8_t dma_done;
+static volatile uint8_t dma_error;  // Transfer error, or the block CRC did not match
+static uint8_t post_error;          // A posted write failed; reported by the next write
+static BYTE post_buf[514] __attribute__((aligned(4))); // Every data block passes through here, a read with its CRC
+
+static BYTE *read_buff;             // Where the next block read goes
+static UINT read_count;             // Blocks still to read
+static uint8_t read_multi;          // CMD18, ended with CMD12
+static uint32_t read_cycles;        // Cycle count when the read started
+static DRESULT read_result = RES_OK;
+
+// Raw CMD25 stream left open between blocks, for USER_StreamWrite. The card
+// stays selected for the whole stream; any other command ends it first.
+static uint8_t stream_open;
+static DWORD stream_next;           // LBA the next streamed block goes to
+
+// Clocks the bus test tries once the card is initialised, fastest first. A
+// card runs at up to 25 MHz until CMD6 switches it to high speed, so /2
+// (42 MHz) is only taken after that (sd_high_speed).
+static const uint32_t sd_prescalers[] = {
+    SPI_BAUDRATEPRESCALER_4, SPI_BAUDRATEPRESCALER_8,
+    SPI_BAUDRATEPRESCALER_16, SPI_BAUDRATEPRESCALER_32
+};
+
+// CRC16 of each byte value, for checking blocks read
+static const WORD sd_crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
 
 /* Private function prototypes -----------------------------------------------*/
 static void spi_xmit_byte(BYTE data);
 static BYTE spi_rcvr_byte(void);
 static BYTE spi_wait_ready(void);
+#if SD_CRC
+static void spi_block_mode(uint8_t on);
+#endif
+static DRESULT spi_block_start(uint8_t receive);
+static uint8_t spi_block_wait(void);
+static void spi_block_end(void);
+static void sd_copy_block(BYTE *dst, const BYTE *src);
+static BYTE sd_crc7(const BYTE *buf, UINT len);
+static WORD sd_crc16(const BYTE *buf, UINT len);
 static BYTE sd_send_cmd(BYTE cmd, DWORD arg);
-static DRESULT sd_rcvr_datablock(BYTE *buff, UINT btr);
+static BYTE sd_wait_init(BYTE cmd, DWORD arg);
+static void spi_set_prescaler(uint32_t prescaler);
+static uint8_t sd_bus_test(const BYTE *cid);
+static uint8_t sd_select_clock(uint32_t *prescaler);
+static uint8_t sd_high_speed(BYTE ty);
+static uint8_t sd_resume(void);
+static DRESULT sd_read_register(BYTE *buf, UINT len);
+static void sd_read_card_info(void);
+static BYTE sd_poll_token(void);
 static DRESULT sd_xmit_datablock(const BYTE *buff, BYTE token);
+static DRESULT sd_post_datablock(const BYTE *buff, BYTE token);
+static void sd_read_end(void);
+static uint8_t sd_step(void);
+static void sd_complete(void);
+static DRESULT sd_stream_stop(void);
+static DRESULT sd_stream_write(const BYTE *buff, DWORD sector, DWORD erase_hint);
+static DRESULT sd_read_start(BYTE *buff, DWORD sector, UINT count);
+#if _USE_WRITE == 1
+static DRESULT sd_write(const BYTE *buff, DWORD sector, UINT count);
+#endif
+static DRESULT sd_trim(DWORD start, DWORD end);
+#if SD_CACHE_SLOTS
+static DRESULT cache_card_read(BYTE *buff, DWORD lba);
+#if _USE_WRITE == 1
+static DRESULT cache_card_write(const BYTE *buff, DWORD lba);
+#endif
+#endif
+#if SD_TIMING
+static void sd_timing_init(void);
+static void sd_time(SD_Op_t op, uint32_t start);
+#endif
+
+/*-----------------------------------------------------------------------*/
+/* Operation Timing                                                      */
+/*-----------------------------------------------------------------------*/
+
+#if SD_TIMING
+#define sd_cycles()         (DWT->CYCCNT)
+
+/**
+  * @brief Starts the DWT cycle counter that the timing reads.
+  */
+static void sd_timing_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+  * @brief Adds the time since start, a cycle count, to the latency of op.
+  *        At 84 MHz the counter wraps after 51 s, well past any timeout.
+  */
+static void sd_time(SD_Op_t op, uint32_t start)
+{
+    SD_Timing_t *t = &SD_Timing[op];
+    DWORD us = (sd_cycles() - start) / (SystemCoreClock / 1000000U);
+    UINT k = us ? 31U - __CLZ(us) : 0U; // floor(log2(us))
+
+    if (k >= SD_HIST_BUCKETS) k = SD_HIST_BUCKETS - 1;
+    t->hist[k]++;
+    t->count++;
+    t->total_us += us;
+    if (us > t->max_us) t->max_us = us;
+}
+#else
+#define sd_cycles()         0U
+#define sd_timing_init()    ((void)0)
+#define sd_time(op, start)  ((void)(start))
+#endif
+
+/**
+  * @brief  Clears the latency histograms and wait counters, e.g. before
+  *         qualifying a card. The operation counters keep running, since
+  *         the logger measures from them.
+  */
+void SD_ResetTiming(void)
+{
+    memset(SD_Timing, 0, sizeof(SD_Timing));
+    SD_Stats.busy_waits = 0;
+    SD_Stats.busy_polls = 0;
+    SD_Stats.token_polls = 0;
+}
 
 /*-----------------------------------------------------------------------*/
 /* Low-Level SPI Transfer Functions                                      */
@@ -80,21 +283,166 @@ static BYTE spi_rcvr_byte(void)
 }
 
 /**
-  * @brief Waits for the card to transition from busy to ready.
+  * @brief Waits for the card to transition from busy to ready, polling
+  *        back to back so the wait ends with the card's busy time.
   */
 static BYTE spi_wait_ready(void)
 {
     BYTE d;
-    UINT tmr = 5000; // 500ms timeout at 1ms resolution
+    uint32_t tick = HAL_GetTick();
+    uint32_t t0 = sd_cycles();
 
-    do {
-        d = spi_rcvr_byte();
-        if (d == 0xFF) return d;
-        HAL_Delay(1);
-    } while (--tmr);
+    d = spi_rcvr_byte();
+    if (d != 0xFF) {
+        SD_Stats.busy_waits++;
+        do {
+            SD_Stats.busy_polls++;
+            d = spi_rcvr_byte();
+        } while (d != 0xFF && (HAL_GetTick() - tick) < SD_READY_TIMEOUT);
+    }
+    sd_time(SD_OP_WAIT_READY, t0);
     return d;
 }
 
+#if SD_CRC
+/**
+  * @brief Switches SPI1 between byte frames and, for data blocks written,
+  *        16-bit frames with the CRC unit on. The F4 SPI only computes a
+  *        CRC16 over 16-bit frames, so blocks go out with each byte pair
+  *        swapped in memory (sd_copy_block) and the HAL sends the CRC after
+  *        the last frame. Blocks read stay in byte frames: the unit would
+  *        also send its CRC after the 0xFF frames, which the card, still
+  *        sending, can take for a command.
+  */
+static void spi_block_mode(uint8_t on)
+{
+    SPI_TypeDef *spi = hspi1.Instance;
+    uint32_t size = on ? (DMA_SxCR_PSIZE_0 | DMA_SxCR_MSIZE_0) : 0U;
+
+    __HAL_SPI_DISABLE(&hspi1);
+    __HAL_SPI_CLEAR_OVRFLAG(&hspi1);    // Frames clocked in by the last transmit
+    spi->CR1 &= ~(SPI_CR1_DFF | SPI_CR1_CRCEN); // Clearing CRCEN resets the CRC
+    __HAL_SPI_CLEAR_CRCERRFLAG(&hspi1);
+    if (on) {
+        spi->CRCPR = SD_CRC16_POLY;
+        spi->CR1 |= SPI_CR1_DFF | SPI_CR1_CRCEN;
+    }
+    hspi1.Init.DataSize = on ? SPI_DATASIZE_16BIT : SPI_DATASIZE_8BIT;
+    hspi1.Init.CRCCalculation = on ? SPI_CRCCALCULATION_ENABLE : SPI_CRCCALCULATION_DISABLE;
+    hspi1.Init.CRCPolynomial = SD_CRC16_POLY;
+
+    // Both streams are idle between blocks, when the sizes may change
+    MODIFY_REG(hspi1.hdmatx->Instance->CR, DMA_SxCR_PSIZE | DMA_SxCR_MSIZE, size);
+    MODIFY_REG(hspi1.hdmarx->Instance->CR, DMA_SxCR_PSIZE | DMA_SxCR_MSIZE, size);
+    __HAL_SPI_ENABLE(&hspi1);
+}
+#endif
+
+/**
+  * @brief Starts moving a data block by DMA, after its data token: post_buf
+  *        out, or with receive set, the block and its CRC into post_buf
+  *        while 0xFF goes out.
+  */
+static DRESULT spi_block_start(uint8_t receive)
+{
+    HAL_StatusTypeDef st;
+
+    dma_done = 0;
+    dma_error = 0;
+    state_tick = HAL_GetTick();
+    if (receive) {
+        memset(post_buf, 0xFF, sizeof(post_buf));
+        st = HAL_SPI_TransmitReceive_DMA(&hspi1, post_buf, post_buf, sizeof(post_buf));
+        return st == HAL_OK ? RES_OK : RES_ERROR;
+    }
+#if SD_CRC
+    spi_block_mode(1);
+#endif
+    st = HAL_SPI_Transmit_DMA(&hspi1, post_buf, SD_BLOCK_FRAMES);
+    if (st == HAL_OK) return RES_OK;
+#if SD_CRC
+    spi_block_mode(0);
+#endif
+    return RES_ERROR;
+}
+
+/**
+  * @brief Waits for the block DMA to finish.
+  * @retval 1 if it finished without error.
+  */
+static uint8_t spi_block_wait(void)
+{
+    while (!dma_done) {
+        if ((HAL_GetTick() - state_tick) >= SD_DMA_TIMEOUT) {
+            HAL_SPI_DMAStop(&hspi1); // Completion lost
+            return 0;
+        }
+    }
+    return !dma_error;
+}
+
+/**
+  * @brief Ends a block write and returns to byte frames. Without the CRC
+  *        unit the two CRC bytes are clocked here: 0xFF out, ignored in.
+  */
+static void spi_block_end(void)
+{
+#if SD_CRC
+    spi_block_mode(0);
+#else
+    spi_rcvr_byte();
+    spi_rcvr_byte();
+#endif
+}
+
+/**
+  * @brief Copies a 512-byte block into post_buf to be written, swapping
+  *        each byte pair when 16-bit frames carry it.
+  */
+static void sd_copy_block(BYTE *dst, const BYTE *src)
+{
+#if SD_CRC
+    for (UINT i = 0; i < 512; i += 4) {
+        uint32_t w;
+        memcpy(&w, src + i, 4); // Either side may be unaligned
+        w = __REV16(w);
+        memcpy(dst + i, &w, 4);
+    }
+#else
+    memcpy(dst, src, 512);
+#endif
+}
+
+/**
+  * @brief Computes a command's CRC7 and end bit, the last byte of its frame.
+  */
+static BYTE sd_crc7(const BYTE *buf, UINT len)
+{
+    BYTE crc = 0;
+
+    while (len--) {
+        BYTE d = *buf++;
+        for (UINT i = 0; i < 8; i++) {
+            crc <<= 1;
+            if ((d ^ crc) & 0x80) crc ^= 0x09;
+            d <<= 1;
+        }
+    }
+    return (BYTE)((crc << 1) | 1);
+}
+
+/**
+  * @brief Computes the CRC16 of a data block or register read. Only blocks
+  *        written get theirs from the SPI CRC unit.
+  */
+static WORD sd_crc16(const BYTE *buf, UINT len)
+{
+    WORD crc = 0;
+
+    while (len--) crc = (WORD)((crc << 8) ^ sd_crc16_table[(crc >> 8) ^ *buf++]);
+    return crc;
+}
+
 /**
   * @brief Sends a command to the SD card.
   * @param cmd: Command byte.
@@ -104,24 +452,28 @@ static BYTE spi_wait_ready(void)
 static BYTE sd_send_cmd(BYTE cmd, DWORD arg)
 {
     BYTE n, res;
+    BYTE frame[6];
 
-    // Check for card readiness
-    if (cmd != CMD12 && spi_wait_ready() != 0xFF) return 0xFF;
+    sd_complete();      // Finish the operation in flight first
+    sd_stream_stop();   // and leave a raw write stream
 
-    SD_CS_LOW(); // Select the card
+    SD_CS_LOW(); // Select the card; busy only shows on DO while selected
 
-    // Send command packet
-    spi_xmit_byte(cmd);
-    spi_xmit_byte((BYTE)(arg >> 24));
-    spi_xmit_byte((BYTE)(arg >> 16));
-    spi_xmit_byte((BYTE)(arg >> 8));
-    spi_xmit_byte((BYTE)arg);
+    // Check for card readiness
+    if (cmd != CMD12 && spi_wait_ready() != 0xFF) {
+        SD_CS_HIGH();
+        return 0xFF;
+    }
 
-    // CRC (only mandatory for CMD0 and CMD8)
-    n = 0x01;
-    if (cmd == CMD0) n = 0x95;
-    if (cmd == CMD8) n = 0x87;
-    spi_xmit_byte(n);
+    // Send the command frame in one transfer. The CRC is needed for CMD0
+    // and CMD8, and for every command once CMD59 has turned checking on.
+    frame[0] = cmd;
+    frame[1] = (BYTE)(arg >> 24);
+    frame[2] = (BYTE)(arg >> 16);
+    frame[3] = (BYTE)(arg >> 8);
+    frame[4] = (BYTE)arg;
+    frame[5] = sd_crc7(frame, 5);
+    HAL_SPI_Transmit(&hspi1, frame, sizeof(frame), 100);
 
     // Receive command response (R1 is single byte, wait up to 10 trials)
     for (n = 10; n; n--) {
@@ -135,37 +487,138 @@ static BYTE sd_send_cmd(BYTE cmd, DWORD arg)
 }
 
 /**
-  * @brief Receives a data block from the SD card.
-  * @param buff: Pointer to the buffer to store data.
-  * @param btr: Number of bytes to receive (should be 512).
-  * @retval DRESULT: Operation result.
+  * @brief Repeats an initialisation command until the card leaves the idle
+  *        state: ACMD41 (cmd CMD41), or CMD1 for MMC. The tries go back to
+  *        back, each about 20 bytes at the init clock, so the card is seen
+  *        ready within half a millisecond of finishing.
+  * @retval 0 once ready, else the last R1.
   */
-static DRESULT sd_rcvr_datablock(BYTE *buff, UINT btr)
+static BYTE sd_wait_init(BYTE cmd, DWORD arg)
 {
-    BYTE token;
-    UINT tmr = 10000; // 1000ms timeout
+    uint32_t tick = HAL_GetTick();
+    BYTE res;
 
-    do {                            // Wait for data start token
-        token = spi_rcvr_byte();
-        HAL_Delay(1);
-    } while ((token == 0xFF) && --tmr);
+    do {
+        res = (cmd == CMD41) ? sd_send_cmd(CMD55, 0) : 1;
+        if (res <= 1) res = sd_send_cmd(cmd, arg);
+    } while (res == 1 && (HAL_GetTick() - tick) < SD_INIT_TIMEOUT);
+    return res;
+}
+
+/**
+  * @brief Sets the SPI1 clock, between transfers.
+  */
+static void spi_set_prescaler(uint32_t prescaler)
+{
+    hspi1.Instance->CR1 = (hspi1.Instance->CR1 & ~SPI_CR1_BR_Msk) | prescaler;
+}
 
-    if(token != DATA_START_BLOCK) return RES_ERROR;
+/**
+  * @brief Reads the CID and sector 0 at the clock just set. Both must come
+  *        with good CRCs, and the CID must match cid if one is given.
+  * @retval 1 if the bus works at this clock.
+  */
+static uint8_t sd_bus_test(const BYTE *cid)
+{
+    BYTE reg[16];
 
-    // Receive data packet (512 bytes)
-    HAL_SPI_Receive(&hspi1, buff, btr, HAL_MAX_DELAY);
+    if (sd_send_cmd(CMD10, 0) != 0 || sd_read_register(reg, 16) != RES_OK ||
+        reg[15] != sd_crc7(reg, 15) || (cid && memcmp(reg, cid, 16) != 0)) {
+        return 0;
+    }
+    // Address 0 is sector 0 whether the card takes byte or block addresses
+    return sd_send_cmd(CMD17, 0) == 0 && sd_read_register(post_buf, 512) == RES_OK;
+}
 
-    spi_rcvr_byte();                // Discard CRC
+/**
+  * @brief Takes the fastest clock up to 21 MHz that the bus test passes at.
+  *        The card is initialised, so the 400 kHz limit of identification
+  *        is over.
+  * @retval 1 with the clock set and its prescaler in *prescaler, 0 if none works.
+  */
+static uint8_t sd_select_clock(uint32_t *prescaler)
+{
+    for (UINT i = 0; i < sizeof(sd_prescalers) / sizeof(sd_prescalers[0]); i++) {
+        spi_set_prescaler(sd_prescalers[i]);
+        if (sd_bus_test(NULL)) {
+            *prescaler = sd_prescalers[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+  * @brief Switches the card to high speed (CMD6) and SPI1 to PCLK2/2, and
+  *        keeps it there only if the CID and the first SD_HS_TEST_BLOCKS
+  *        sectors all read back with good CRCs. Only reads: the card is
+  *        never written to test a clock. Call at /4.
+  * @param ty: Card type, for byte or block addresses.
+  * @retval 1 at /2, else 0 with the clock back at /4.
+  */
+static uint8_t sd_high_speed(BYTE ty)
+{
+    uint8_t ok;
+
+    // Switch status: function group 1 now on function 1
+    if (sd_send_cmd(CMD6, SD_SWITCH_HIGH_SPEED) != 0 || sd_read_register(post_buf, 64) != RES_OK ||
+        (post_buf[16] & 0x0F) != 1) {
+        return 0;
+    }
+
+    spi_set_prescaler(SPI_BAUDRATEPRESCALER_2);
+    ok = sd_bus_test(NULL); // CID and sector 0
+    for (DWORD lba = 1; ok && lba < SD_HS_TEST_BLOCKS; lba++) {
+        ok = sd_send_cmd(CMD17, (ty & 4) ? lba : lba * 512) == 0 && sd_read_register(post_buf, 512) == RES_OK;
+    }
+    SD_CS_HIGH();
     spi_rcvr_byte();
+    if (!ok) spi_set_prescaler(SPI_BAUDRATEPRESCALER_4);
+    return ok;
+}
 
+/**
+  * @brief Picks up a card initialised earlier in this power cycle, e.g. on
+  *        a remount after a write error. Such a card is still in SPI mode
+  *        at the clock chosen then; it is the same card if its OCR and CID
+  *        are unchanged, and needs nothing more. A card that has been out
+  *        of the socket ignores commands until CMD0.
+  * @retval 1 if SD_Card still describes the card.
+  */
+static uint8_t sd_resume(void)
+{
+    BYTE ocr[4];
+    uint8_t ok = 0;
+
+    spi_set_prescaler(SD_Card.prescaler);
+    if (sd_send_cmd(CMD58, 0) == 0) {
+        for (UINT n = 0; n < 4; n++) ocr[n] = spi_rcvr_byte();
+        ok = ((((DWORD)ocr[0] << 24) | ((DWORD)ocr[1] << 16) | ((DWORD)ocr[2] << 8) | ocr[3]) == SD_Card.ocr) &&
+             sd_bus_test(SD_Card.cid);
+    }
     SD_CS_HIGH();
-    spi_rcvr_byte();                // Idle clocks
+    spi_rcvr_byte();
+    return ok;
+}
 
-    return RES_OK;
+/**
+  * @brief Polls for a read data token, up to SD_POLL_BYTES bytes.
+  * @retval The token or error token, or 0xFF if the card has sent neither.
+  */
+static BYTE sd_poll_token(void)
+{
+    BYTE token;
+    UINT n = SD_POLL_BYTES;
+
+    do {
+        token = spi_rcvr_byte();
+        SD_Stats.token_polls++;
+    } while (token == 0xFF && --n);
+    return token;
 }
 
 /**
-  * @brief Sends a data block to the SD card.
+  * @brief Sends a data block to the SD card and waits for the DMA.
   * @param buff: Pointer to the buffer containing data.
   * @param token: Data token (WRITE_START_BLOCK or WRITE_MULTIPLE_BLOCK).
   * @retval DRESULT: Operation result.
@@ -173,25 +626,538 @@ static DRESULT sd_rcvr_datablock(BYTE *buff, UINT btr)
 static DRESULT sd_xmit_datablock(const BYTE *buff, BYTE token)
 {
     BYTE resp;
+    uint8_t ok;
 
+    if (token != STOP_TRAN) sd_copy_block(post_buf, buff);
     if (spi_wait_ready() != 0xFF) return RES_ERROR;
 
     spi_xmit_byte(token); // Send token
 
-    if (token != WRITE_MULTIPLE_BLOCK) {
-        // Send data packet (512 bytes)
-        HAL_SPI_Transmit(&hspi1, (uint8_t*)buff, 512, HAL_MAX_DELAY);
-
-        spi_xmit_byte(0xFF); // Dummy CRC
-        spi_xmit_byte(0xFF);
+    if (token != STOP_TRAN) {
+        // Send data packet (512 bytes) and its CRC
+        if (spi_block_start(0) != RES_OK) return RES_ERROR;
+        ok = spi_block_wait();
+        spi_block_end();
 
         resp = spi_rcvr_byte(); // Get data response
-        if ((resp & 0x1F) != 0x05) return RES_ERROR; // Check for acceptance
+        if (!ok || (resp & 0x1F) != 0x05) return RES_ERROR; // Check for acceptance
     }
 
     return RES_OK;
 }
 
+/*-----------------------------------------------------------------------*/
+/* Card Registers and Erase                                              */
+/*-----------------------------------------------------------------------*/
+
+/**
+  * @brief Reads the data block of an accepted CMD9/CMD10 (CSD, CID) or
+  *        ACMD13 (SD status) and deselects the card.
+  * @param len: 16, or 64 for the SD status, or 512 for the bus test.
+  * @retval RES_OK if the block came and its CRC16 matched.
+  */
+static DRESULT sd_read_register(BYTE *buf, UINT len)
+{
+    DRESULT res = RES_ERROR;
+    uint32_t tick = HAL_GetTick();
+    BYTE token;
+
+    do {
+        token = sd_poll_token();
+    } while (token == 0xFF && (HAL_GetTick() - tick) < SD_TOKEN_TIMEOUT);
+
+    if (token == DATA_START_BLOCK) {
+        memset(buf, 0xFF, len); // Clocked out while the block comes in
+        HAL_SPI_TransmitReceive(&hspi1, buf, buf, (uint16_t)len, SD_DMA_TIMEOUT);
+        WORD crc = (WORD)(spi_rcvr_byte() << 8);
+        crc |= spi_rcvr_byte();
+        if (crc == sd_crc16(buf, len)) res = RES_OK;
+    }
+    SD_CS_HIGH();
+    spi_rcvr_byte();
+    return res;
+}
+
+/**
+  * @brief Reads the CID and CSD into SD_Card, and works out the capacity and
+  *        erase block: the allocation unit from the SD status for SDv2 and
+  *        later, else the CSD's erase sector. What cannot be read is left 0.
+  */
+static void sd_read_card_info(void)
+{
+    BYTE *csd = SD_Card.csd;
+    BYTE status[64];
+
+    memset(&SD_Card, 0, sizeof(SD_Card));
+    SD_Card.type = CardType;
+
+    // Both registers end in their own CRC7, checked whether or not CMD59 is on
+    if (sd_send_cmd(CMD10, 0) != 0 || sd_read_register(SD_Card.cid, 16) != RES_OK ||
+        SD_Card.cid[15] != sd_crc7(SD_Card.cid, 15)) {
+        memset(SD_Card.cid, 0, 16);
+    }
+    if (sd_send_cmd(CMD9, 0) != 0 || sd_read_register(csd, 16) != RES_OK || csd[15] != sd_crc7(csd, 15)) {
+        memset(csd, 0, 16);
+        SD_CS_HIGH();
+        spi_rcvr_byte();
+        return;
+    }
+
+    if ((csd[0] >> 6) == 1) {
+        // CSD 2.0 (SDHC/SDXC): C_SIZE counts 512 KB, any sector run erases
+        DWORD c_size = ((DWORD)(csd[7] & 0x3F) << 16) | ((DWORD)csd[8] << 8) | csd[9];
+        SD_Card.sectors = (c_size + 1) << 10;
+        SD_Card.erase_blk_en = 1;
+    } else {
+        // CSD 1.0: (C_SIZE + 1) << (C_SIZE_MULT + 2) blocks of 2^READ_BL_LEN bytes
+        DWORD c_size = ((DWORD)(csd[6] & 0x03) << 10) | ((DWORD)csd[7] << 2) | (csd[8] >> 6);
+        UINT shift = (csd[5] & 0x0F) + (((csd[9] & 0x03) << 1) | (csd[10] >> 7)) + 2;
+        SD_Card.sectors = (c_size + 1) << (shift - 9);
+        SD_Card.erase_blk_en = (CardType != CARD_MMC) && (csd[10] & 0x40);
+    }
+
+    if (CardType == CARD_MMC) {
+        // (ERASE_GRP_SIZE + 1) * (ERASE_GRP_MULT + 1) write blocks
+        SD_Card.erase_sectors = (DWORD)(((csd[10] & 0x7C) >> 2) + 1) *
+                                ((((csd[11] & 0x03) << 3) | (csd[11] >> 5)) + 1);
+    } else {
+        // SECTOR_SIZE + 1 write blocks of 2^WRITE_BL_LEN bytes
+        UINT wbl = ((csd[12] & 0x03) << 2) | (csd[13] >> 6);
+        SD_Card.erase_sectors = (DWORD)((((csd[10] & 0x3F) << 1) | (csd[11] >> 7)) + 1) << (wbl > 9 ? wbl - 9 : 0);
+
+        // The allocation unit is what the card's flash really erases by
+        if ((CardType & 2) && sd_send_cmd(CMD55, 0) <= 1 && sd_send_cmd(CMD13, 0) == 0) { // ACMD13
+            spi_rcvr_byte(); // Second byte of R2
+            if (sd_read_register(status, 64) == RES_OK && (status[10] >> 4)) {
+                SD_Card.erase_sectors = 16UL << (status[10] >> 4); // AU_SIZE: 16 KB << n
+            }
+        }
+    }
+    SD_CS_HIGH();
+    spi_rcvr_byte();
+}
+
+/**
+  * @brief  Erases sectors start..end (CTRL_TRIM), so that writes there later
+  *         do not wait for the card to erase first. Without ERASE_BLK_EN
+  *         only whole erase blocks can go, so the range shrinks to those;
+  *         MMC is left alone. TRIM is a hint, so a range with nothing to
+  *         erase still returns RES_OK.
+  * @retval DRESULT: Operation result
+  */
+static DRESULT sd_trim(DWORD start, DWORD end)
+{
+    DWORD n = SD_Card.erase_sectors ? SD_Card.erase_sectors : 1;
+    DRESULT res = RES_ERROR;
+
+    if (end < start || end >= SD_Card.sectors) return RES_PARERR;
+    if (CardType == CARD_MMC) return RES_OK;
+    if (!SD_Card.erase_blk_en) {
+        DWORD first = (start + n - 1) / n;      // Erase blocks wholly inside
+        DWORD last = (end + 1) / n;
+        if (last <= first) return RES_OK;
+        start = first * n;
+        end = last * n - 1;
+    }
+#if SD_CACHE_SLOTS
+    SD_CacheDrop(start, end - start + 1); // Dirty or not, the data goes
+#endif
+
+    DWORD count = end - start + 1;
+    DWORD timeout = (count / n + 2) * SD_ERASE_TIMEOUT; // Erase blocks touched, at worst
+    if (!(CardType & 4)) { // Byte addresses for SDv1
+        start *= 512;
+        end *= 512;
+    }
+    if (sd_send_cmd(CMD32, start) == 0 && sd_send_cmd(CMD33, end) == 0 && sd_send_cmd(CMD38, 0) == 0) {
+        // The card holds DO low for the erase, longer than spi_wait_ready allows
+        uint32_t tick = HAL_GetTick();
+        BYTE d;
+        do {
+            d = spi_rcvr_byte();
+        } while (d != 0xFF && (HAL_GetTick() - tick) < timeout);
+        if (d == 0xFF) {
+            SD_Stats.trims++;
+            SD_Stats.trim_sectors += count;
+            res = RES_OK;
+        }
+    }
+    return res;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Posted Writes and Started Reads                                       */
+/*-----------------------------------------------------------------------*/
+
+/**
+  * @brief Starts a block write and returns while DMA sends the data.
+  *        CMD24 or CMD25 must already be accepted. The caller's buffer is
+  *        free on return.
+  * @param token: WRITE_START_BLOCK (CMD24) or WRITE_MULTIPLE_BLOCK (CMD25).
+  */
+static DRESULT sd_post_datablock(const BYTE *buff, BYTE token)
+{
+    sd_copy_block(post_buf, buff);
+
+    if (spi_wait_ready() != 0xFF) return RES_ERROR; // Also the gap after R1
+    spi_xmit_byte(token);
+
+    if (spi_block_start(0) != RES_OK) return RES_ERROR;
+    sd_state = SD_STATE_XMIT;
+    return RES_OK;
+}
+
+/**
+  * @brief Ends a started read after its last block or first failure.
+  */
+static void sd_read_end(void)
+{
+    sd_state = SD_STATE_IDLE;
+    if (read_multi) sd_send_cmd(CMD12, 0); // Stop transmission
+    SD_CS_HIGH();
+    spi_rcvr_byte();
+    read_result = read_count ? RES_ERROR : RES_OK;
+    sd_time(SD_OP_READ, read_cycles);
+}
+
+/**
+  * @brief Advances the operation in flight as far as it can go without
+  *        waiting: a busy card or missing token is polled SD_POLL_BYTES
+  *        times per call, and a block DMA is left running.
+  * @retval 1 when nothing is in flight and the card is ready.
+  */
+static uint8_t sd_step(void)
+{
+    BYTE resp;
+    UINT n;
+
+    if (sd_state == SD_STATE_TOKEN) {
+        resp = sd_poll_token();
+        if (resp == 0xFF && (HAL_GetTick() - state_tick) < SD_TOKEN_TIMEOUT) return 0;
+
+        if (resp == DATA_START_BLOCK && spi_block_start(1) == RES_OK) {
+            sd_state = SD_STATE_RECV;
+            return 0;
+        }
+        sd_time(SD_OP_RCVR_BLOCK, state_cycles);
+        sd_read_end();
+        return 1;
+    }
+
+    if (sd_state == SD_STATE_RECV) {
+        if (!dma_done) {
+            if ((HAL_GetTick() - state_tick) < SD_DMA_TIMEOUT) return 0;
+            HAL_SPI_DMAStop(&hspi1); // Completion lost
+            dma_error = 1;
+        }
+        sd_time(SD_OP_RCVR_BLOCK, state_cycles); // Token wait included
+#if SD_CRC
+        if ((WORD)((post_buf[512] << 8) | post_buf[513]) != sd_crc16(post_buf, 512)) dma_error = 1;
+#endif
+        if (dma_error) { // Includes a CRC mismatch
+            sd_read_end();
+            return 1;
+        }
+
+        memcpy(read_buff, post_buf, 512);
+        read_buff += 512;
+        if (--read_count) {
+            state_tick = HAL_GetTick();
+            state_cycles = sd_cycles();
+            sd_state = SD_STATE_TOKEN;
+            return 0;
+        }
+        sd_read_end();
+        return 1;
+    }
+
+    if (sd_state == SD_STATE_XMIT) {
+        if (!dma_done) {
+            if ((HAL_GetTick() - state_tick) < SD_DMA_TIMEOUT) return 0;
+            HAL_SPI_DMAStop(&hspi1); // Completion lost
+            dma_error = 1;
+        }
+        spi_block_end();
+        resp = spi_rcvr_byte(); // Get data response; 0x0B if the card saw a bad CRC
+        if (dma_error || (resp & 0x1F) != 0x05) post_error = 1;
+
+        if (!stream_open) { // A stream keeps the card selected
+            SD_CS_HIGH();
+            spi_rcvr_byte();
+        }
+        state_tick = HAL_GetTick();
+        state_cycles = sd_cycles();
+        sd_state = SD_STATE_BUSY;
+    }
+
+    if (sd_state == SD_STATE_BUSY) {
+        if (!stream_open) SD_CS_LOW();
+        n = SD_POLL_BYTES;
+        do {
+            resp = spi_rcvr_byte(); // DO is held low while the card programs
+        } while (resp != 0xFF && --n);
+        if (!stream_open) {
+            SD_CS_HIGH();
+            spi_rcvr_byte();
+        }
+        if (resp != 0xFF) {
+            if ((HAL_GetTick() - state_tick) < SD_BUSY_TIMEOUT) return 0;
+            post_error = 1;
+        }
+        sd_time(SD_OP_PROGRAM, state_cycles);
+        sd_state = SD_STATE_IDLE;
+    }
+
+    return 1;
+}
+
+/**
+  * @brief Steps the operation in flight until it finishes.
+  */
+static void sd_complete(void)
+{
+    while (!sd_step()) {
+    }
+}
+
+/**
+  * @brief Ends an open CMD25 stream with the stop token and waits for the
+  *        card to finish programming.
+  */
+static DRESULT sd_stream_stop(void)
+{
+    DRESULT res = RES_OK;
+
+    if (!stream_open) return RES_OK;
+    sd_complete();
+    stream_open = 0;
+
+    spi_xmit_byte(STOP_TRAN);
+    spi_rcvr_byte();                // One byte before busy shows on DO
+    if (spi_wait_ready() != 0xFF) res = RES_ERROR;
+
+    SD_CS_HIGH();
+    spi_rcvr_byte();
+    return res;
+}
+
+/**
+  * @brief  SPI DMA completion, forwarded from HAL_SPI_TxCpltCallback.
+  */
+void USER_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == hspi1.Instance) dma_done = 1;
+}
+
+/**
+  * @brief  SPI DMA completion of a received block, forwarded from
+  *         HAL_SPI_TxRxCpltCallback.
+  */
+void USER_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == hspi1.Instance) dma_done = 1;
+}
+
+/**
+  * @brief  SPI DMA error, forwarded from HAL_SPI_ErrorCallback.
+  */
+void USER_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance != hspi1.Instance) return;
+    dma_error = 1;
+    dma_done = 1;
+}
+
+/**
+  * @brief  Advances a posted write or started read; call from the main loop.
+  * @retval 1 when the card can take a new operation without blocking.
+  */
+uint8_t USER_Poll(void)
+{
+    return sd_step();
+}
+
+/**
+  * @brief  Starts reading count sectors into buff and returns once the card
+  *         has taken the command. USER_Poll receives the blocks as they
+  *         come; buff must stay valid until it returns 1. Call when USER_Poll
+  *         reports the card idle, or this first waits for it.
+  * @param  sector: Sector address (LBA)
+  * @retval DRESULT: RES_ERROR if the card refused the command
+  */
+DRESULT USER_ReadStart(BYTE *buff, DWORD sector, UINT count)
+{
+    if (Stat & STA_NOINIT) return RES_NOTRDY;
+    if (count == 0) return RES_PARERR;
+#if SD_CACHE_SLOTS && _USE_WRITE == 1
+    // The card must first hold what the cache has for these sectors
+    if (SD_CacheClean(sector, count) != RES_OK) return RES_ERROR;
+#endif
+    return sd_read_start(buff, sector, count);
+}
+
+/**
+  * @brief  USER_ReadStart without the cache.
+  */
+static DRESULT sd_read_start(BYTE *buff, DWORD sector, UINT count)
+{
+    read_cycles = sd_cycles();
+    SD_Stats.reads++;
+    SD_Stats.read_sectors += count;
+    if (!(CardType & 4)) sector *= 512; // Convert LBA to byte address for SDv1/MMC
+
+    read_multi = (count > 1);
+    if (sd_send_cmd(read_multi ? CMD18 : CMD17, sector) != 0) {
+        SD_CS_HIGH();
+        spi_rcvr_byte();
+        read_result = RES_ERROR;
+        sd_time(SD_OP_READ, read_cycles);
+        return RES_ERROR;
+    }
+
+    read_buff = buff;
+    read_count = count;
+    state_tick = HAL_GetTick();
+    state_cycles = sd_cycles();
+    sd_state = SD_STATE_TOKEN;
+    return RES_OK;
+}
+
+/**
+  * @brief  Result of the last read started with USER_ReadStart.
+  * @retval DRESULT: RES_NOTRDY while it is still in flight
+  */
+DRESULT USER_ReadResult(void)
+{
+    return (sd_state == SD_STATE_TOKEN || sd_state == SD_STATE_RECV) ? RES_NOTRDY : read_result;
+}
+
+#if SD_CACHE_SLOTS
+/**
+  * @brief  A started read stepped to the end, for filling cache slots.
+  */
+static DRESULT cache_card_read(BYTE *buff, DWORD lba)
+{
+    if (sd_read_start(buff, lba, 1) != RES_OK) return RES_ERROR;
+    sd_complete();
+    return read_result;
+}
+
+#if _USE_WRITE == 1
+/**
+  * @brief  A dirty slot written back, posted like any single sector.
+  */
+static DRESULT cache_card_write(const BYTE *buff, DWORD lba)
+{
+    uint32_t t0 = sd_cycles();
+    DRESULT res = sd_write(buff, lba, 1);
+
+    sd_time(SD_OP_WRITE, t0);
+    return res;
+}
+#endif
+
+static const SD_CacheCard_t cache_card = {
+    cache_card_read,
+#if _USE_WRITE == 1
+    cache_card_write,
+#endif
+};
+#endif
+
+/*-----------------------------------------------------------------------*/
+/* Raw Streaming Writes                                                  */
+/*-----------------------------------------------------------------------*/
+
+/**
+  * @brief  Writes one block of a sequential CMD25 stream, posted like a
+  *         single-block write. A block at the next LBA continues the open
+  *         stream. Any other LBA ends the stream and starts a new one, and so
+  *         does any other card command. For writes to space the file system
+  *         has already allocated, e.g. a file made with f_expand.
+  * @param  sector: Sector address (LBA)
+  * @param  erase_hint: Blocks the caller expects to write from sector on;
+  *         sent as ACMD23 so the card can pre-erase them (0: no hint)
+  * @retval DRESULT: Operation result
+  */
+DRESULT USER_StreamWrite(const BYTE *buff, DWORD sector, DWORD erase_hint)
+{
+    if (Stat & STA_NOINIT) return RES_NOTRDY;
+#if SD_CACHE_SLOTS
+    SD_CacheDrop(sector, 1); // Superseded, dirty or not
+#endif
+
+    uint32_t t0 = sd_cycles();
+    DRESULT res = sd_stream_write(buff, sector, erase_hint);
+    sd_time(SD_OP_STREAM, t0);
+    return res;
+}
+
+/**
+  * @brief  USER_StreamWrite without the timing.
+  */
+static DRESULT sd_stream_write(const BYTE *buff, DWORD sector, DWORD erase_hint)
+{
+    sd_complete();
+    if (post_error) {
+        post_error = 0;
+        sd_stream_stop();
+        return RES_ERROR;
+    }
+
+    if (!stream_open || sector != stream_next) {
+        if (sd_stream_stop() != RES_OK) return RES_ERROR;
+
+        if (erase_hint && CardType != CARD_MMC) {
+            if (erase_hint > 0x7FFFFF) erase_hint = 0x7FFFFF; // 23-bit count
+            if (sd_send_cmd(CMD55, 0) <= 1) sd_send_cmd(CMD23, erase_hint); // Only a hint
+        }
+        if (sd_send_cmd(CMD25, (CardType & 4) ? sector : sector * 512) != 0) {
+            SD_CS_HIGH();
+            spi_rcvr_byte();
+            return RES_ERROR;
+        }
+        stream_open = 1;
+        stream_next = sector;
+        SD_Stats.stream_starts++;
+    }
+
+    SD_Stats.writes++;
+    SD_Stats.write_sectors++;
+    if (sd_post_datablock(buff, WRITE_MULTIPLE_BLOCK) != RES_OK) {
+        sd_stream_stop();
+        return RES_ERROR;
+    }
+    stream_next++;
+    return RES_OK;
+}
+
+/**
+  * @brief  Waits until every streamed block is programmed. The stream stays
+  *         open, so the next block at the following LBA continues it.
+  * @retval DRESULT: RES_ERROR if any block since the last call failed
+  */
+DRESULT USER_StreamSync(void)
+{
+    sd_complete();
+    if (post_error) {
+        post_error = 0;
+        return RES_ERROR;
+    }
+    return RES_OK;
+}
+
+/**
+  * @brief  Finishes and closes the open stream, if any.
+  * @retval DRESULT: Operation result
+  */
+DRESULT USER_StreamStop(void)
+{
+    DRESULT res = USER_StreamSync();
+    if (sd_stream_stop() != RES_OK) res = RES_ERROR;
+    return res;
+}
+
 
 /*-----------------------------------------------------------------------*/
 /* Disk I/O Functions (FATFS Interface)                                  */
@@ -208,16 +1174,28 @@ DSTATUS USER_initialize (
 {
   /* USER CODE BEGIN INIT */
     BYTE n, ty, ocr[4];
-    DWORD tmr;
+    uint32_t prescaler = 0;
+    uint32_t start;
 
     if (pdrv) return STA_NOINIT; // Only support drive 0
+    sd_timing_init();
+    start = sd_cycles();
+#if SD_CACHE_SLOTS
+    SD_CacheInit(&cache_card);
+#endif
+
+    // 0. The card from the last initialisation, if it is still there
+    if (SD_Card.type && (SD_Card.ocr & 0x80000000UL) && sd_resume()) {
+        CardType = SD_Card.type;
+        Stat &= ~STA_NOINIT;
+        SD_Card.init_us = (sd_cycles() - start) / (SystemCoreClock / 1000000U);
+        return Stat;
+    }
 
     // ************************************************************
-    // 1. LOW SPEED INIT: Force SPI clock to the minimum speed (/256)
+    // 1. LOW SPEED INIT: identification runs at under 400 kHz
     // ************************************************************
-    // Clear the Baud Rate Control bits (BR[2:0]) and set Prescaler /256.
-    hspi1.Instance->CR1 &= (~SPI_CR1_BR_Msk);
-    hspi1.Instance->CR1 |= SPI_BAUDRATEPRESCALER_256;
+    spi_set_prescaler(SD_INIT_PRESCALER);
 
 
     // 2. Initial power-up sequence
@@ -227,6 +1205,7 @@ DSTATUS USER_initialize (
 
     // 3. CMD0: GO_IDLE_STATE
     ty = 0;
+    memset(ocr, 0, sizeof(ocr));
     if (sd_send_cmd(CMD0, 0) == 1) { // R1 response should be 0x01 (idle state)
         // 4. CMD8: SEND_IF_COND (for SDv2)
         if (sd_send_cmd(CMD8, 0x1AA) == 1) {
@@ -234,19 +1213,38 @@ DSTATUS USER_initialize (
             for (n = 0; n < 4; n++) ocr[n] = spi_rcvr_byte();
             if ((ocr[2] == 0x01) && (ocr[3] == 0xAA)) {
                 // Wait for READY state (ACMD41 with HCS set)
-                for (tmr = 1000; tmr; tmr--) {
-                    if (sd_send_cmd(CMD55, 0) <= 1 && sd_send_cmd(CMD41, 1UL << 30) == 0) break;
-                    HAL_Delay(1);
-                }
-                if (tmr && sd_send_cmd(CMD58, 0) == 0) { // Check CCS bit
-                    for (n = 0; n < 4; n++) ocr[n] = spi_rcvr_byte();
-                    ty = (ocr[0] & 0x40) ? 6 : 2; // SDHC/SDXC : SDv2
-                }
+                if (sd_wait_init(CMD41, 1UL << 30) == 0) ty = 2;
             }
+        } else if (sd_send_cmd(CMD55, 0) <= 1 && sd_send_cmd(CMD41, 0) <= 1) {
+            // SDv1 takes ACMD41, then stays idle until it has initialised
+            if (sd_wait_init(CMD41, 0) == 0) ty = 1;
         } else {
-            // SDv1 or MMC (simplified check)
-            if (sd_send_cmd(CMD55, 0) <= 1 && sd_send_cmd(CMD41, 0) == 0) ty = 1; // SDv1
-            else ty = 3; // MMCv3
+            // MMCv3 initialises on CMD1 instead
+            if (sd_wait_init(CMD1, 0) == 0) ty = 3;
+        }
+
+        // ************************************************************
+        // 5. CLOCK: as soon as the card is ready, to the fastest clock up
+        //    to 21 MHz it reads back cleanly at
+        // ************************************************************
+        if (ty && !sd_select_clock(&prescaler)) ty = 0;
+
+        // 6. OCR: power-up status and, on SDv2, the CCS bit
+        memset(ocr, 0, sizeof(ocr));
+        if (ty && sd_send_cmd(CMD58, 0) == 0) {
+            for (n = 0; n < 4; n++) ocr[n] = spi_rcvr_byte();
+            if (ty == 2 && (ocr[0] & 0x40)) ty = 6; // SDHC/SDXC
+        } else if (ty == 2) {
+            ty = 0; // Addressing unknown
+        }
+#if SD_CRC
+        // Have the card check command and data block CRCs from here on
+        if (ty && sd_send_cmd(CMD59, 1) != 0) ty = 0;
+#endif
+
+        // 7. HIGH SPEED: an SD card that reached /4 may go to /2 (42 MHz)
+        if (ty && ty != CARD_MMC && prescaler == SPI_BAUDRATEPRESCALER_4 && sd_high_speed(ty)) {
+            prescaler = SPI_BAUDRATEPRESCALER_2;
         }
     }
 
@@ -257,12 +1255,14 @@ DSTATUS USER_initialize (
     if (ty) {
         Stat &= ~STA_NOINIT; // Clear NOINIT flag on success
 
-        // ************************************************************
-        // 5. HIGH SPEED SWITCH: Switch to fast SPI clock (Prescaler /2)
-        // ************************************************************
-        // Restore the high-speed setting from MX_SPI1_Init for data transfer.
-        hspi1.Instance->CR1 &= (~SPI_CR1_BR_Msk); // Clear Baud Rate bits
-        hspi1.Instance->CR1 |= SPI_BAUDRATEPRESCALER_2; // Set Prescaler to /2
+        // 8. Capacity and erase block, for GET_SECTOR_COUNT and GET_BLOCK_SIZE;
+        //    the type, OCR and clock are kept for the next initialisation
+        sd_read_card_info();
+        SD_Card.ocr = ((DWORD)ocr[0] << 24) | ((DWORD)ocr[1] << 16) | ((DWORD)ocr[2] << 8) | ocr[3];
+        SD_Card.prescaler = prescaler;
+        SD_Card.init_us = (sd_cycles() - start) / (SystemCoreClock / 1000000U);
+    } else {
+        memset(&SD_Card, 0, sizeof(SD_Card));
     }
 
     return Stat;
@@ -300,28 +1300,15 @@ DRESULT USER_read (
 {
   /* USER CODE BEGIN READ */
     if (pdrv || (Stat & STA_NOINIT)) return RES_NOTRDY;
-    if (!(CardType & 4)) sector *= 512; // Convert LBA to byte address for SDv1/MMC
-
-    // Read multiple sectors
-    if (count > 1) {
-        if (sd_send_cmd(CMD18, sector) != 0) return RES_ERROR;
-        do {
-            if (sd_rcvr_datablock(buff, 512) != RES_OK) break;
-            buff += 512;
-        } while (--count);
-        sd_send_cmd(CMD12, 0); // Stop transmission
-    }
-    // Read single sector
-    else {
-        if (sd_send_cmd(CMD17, sector) == 0) {
-            sd_rcvr_datablock(buff, 512);
-        }
-    }
-
-    SD_CS_HIGH(); // Ensure deselect
-    spi_rcvr_byte();
+#if SD_CACHE_SLOTS
+    if (count == 1) return SD_CacheRead(buff, sector);
+#endif
 
-    return count ? RES_ERROR : RES_OK;
+    // The started read, stepped to the end
+    DRESULT res = USER_ReadStart(buff, sector, count);
+    if (res != RES_OK) return res;
+    sd_complete();
+    return read_result;
   /* USER CODE END READ */
 }
 
@@ -343,21 +1330,48 @@ DRESULT USER_write (
 {
   /* USER CODE BEGIN WRITE */
     if (pdrv || (Stat & STA_NOINIT)) return RES_NOTRDY;
+#if SD_CACHE_SLOTS
+    if (count == 1) return SD_CacheWrite(buff, sector);
+    SD_CacheUpdate(buff, sector, count);
+#endif
+
+    uint32_t t0 = sd_cycles();
+    DRESULT res = sd_write(buff, sector, count);
+    sd_time(SD_OP_WRITE, t0);
+    return res;
+  /* USER CODE END WRITE */
+}
+
+/**
+  * @brief  USER_write without the timing.
+  */
+static DRESULT sd_write(const BYTE *buff, DWORD sector, UINT count)
+{
+    sd_complete();
+    if (post_error) { // Surface a failed posted write to FatFs
+        post_error = 0;
+        return RES_ERROR;
+    }
+    SD_Stats.writes++;
+    SD_Stats.write_sectors += count;
     if (!(CardType & 4)) sector *= 512; // Convert LBA to byte address
 
-    // Write multiple sectors
+    // Write multiple sectors, telling SD cards how many to pre-erase
     if (count > 1) {
+        if (CardType != CARD_MMC && sd_send_cmd(CMD55, 0) <= 1) sd_send_cmd(CMD23, count);
         if (sd_send_cmd(CMD25, sector) != 0) return RES_ERROR;
         do {
             if (sd_xmit_datablock(buff, WRITE_MULTIPLE_BLOCK) != RES_OK) return RES_ERROR;
             buff += 512;
         } while (--count);
-        spi_xmit_byte(0xFD); // Stop token
+        // Stop token, once the card has programmed the last block; a busy
+        // card ignores it
+        if (sd_xmit_datablock(0, STOP_TRAN) != RES_OK) count = 1;
     }
-    // Write single sector
+    // Write single sector: posted, the card finishes it in the background
     else {
-        if (sd_send_cmd(CMD24, sector) == 0) {
-            sd_xmit_datablock(buff, WRITE_START_BLOCK);
+        if (sd_send_cmd(CMD24, sector) == 0 && sd_post_datablock(buff, WRITE_START_BLOCK) == RES_OK) {
+            return RES_OK; // Card stays selected until the DMA completes
         }
     }
 
@@ -365,7 +1379,6 @@ DRESULT USER_write (
     spi_rcvr_byte();
 
     return count ? RES_ERROR : RES_OK;
-  /* USER CODE END WRITE */
 }
 #endif /* _USE_WRITE == 1 */
 
@@ -391,15 +1404,33 @@ DRESULT USER_ioctl (
 
     switch (cmd) {
         case CTRL_SYNC: // Make sure that data has been written to the card
-            if (spi_wait_ready() == 0xFF) res = RES_OK;
+            SD_Stats.syncs++;
+#if SD_CACHE_SLOTS
+            if (SD_CacheClean(0, 0) != RES_OK) post_error = 1;
+#endif
+            sd_complete();
+            SD_CS_LOW();
+            if (spi_wait_ready() == 0xFF && !post_error) res = RES_OK;
+            post_error = 0;
             break;
         case GET_SECTOR_SIZE: // Returns 512
             *(WORD*)buff = 512;
             res = RES_OK;
             break;
-        case GET_BLOCK_SIZE: // Returns 1 (single block operation)
-            *(DWORD*)buff = 1;
-            res = RES_OK;
+        case GET_SECTOR_COUNT: // Capacity from the CSD
+            if (SD_Card.sectors) {
+                *(DWORD*)buff = SD_Card.sectors;
+                res = RES_OK;
+            }
+            break;
+        case GET_BLOCK_SIZE: // Erase block in sectors, for f_mkfs to align the data area to
+            if (SD_Card.erase_sectors) {
+                *(DWORD*)buff = SD_Card.erase_sectors;
+                res = RES_OK;
+            }
+            break;
+        case CTRL_TRIM: // Erase sectors buff[0]..buff[1], inclusive
+            res = sd_trim(((DWORD*)buff)[0], ((DWORD*)buff)[1]);
             break;
         default:
             res = RES_PARERR;
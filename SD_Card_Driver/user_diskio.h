@@ -29,10 +29,104 @@
 /* USER CODE BEGIN 0 */
 
 /* Includes ------------------------------------------------------------------*/
-/* Exported types ------------------------------------------------------------*/
+#include "main.h"
+
 /* Exported constants --------------------------------------------------------*/
+/* Time card operations with the DWT cycle counter (0: no timing code) */
+#ifndef SD_TIMING
+#define SD_TIMING 1
+#endif
+
+/* Have the card check CRCs (CMD59): CRC7 on commands, worked out in
+   software, and CRC16 on data blocks, from the SPI CRC unit on blocks
+   written and checked in software on blocks read (0: CRC off, as the card
+   starts) */
+#ifndef SD_CRC
+#define SD_CRC 1
+#endif
+
+/* Sector cache (sd_cache.c): 512-byte slots between FatFs and the card,
+   least recently used replaced; single-sector writes stay in it until
+   evicted or CTRL_SYNC (0: no cache) */
+#ifndef SD_CACHE_SLOTS
+#define SD_CACHE_SLOTS 4
+#endif
+
+/* Latency histogram buckets: bucket k counts times of 2^k to 2^(k+1)-1 us,
+   bucket 0 also takes times under 1 us and the last one everything longer */
+#define SD_HIST_BUCKETS 24
+
+/* Exported types ------------------------------------------------------------*/
+/** Card operation counters, for measuring what the file system costs */
+typedef struct {
+  DWORD reads;          /* Card reads: USER_ReadStart, or USER_read past the cache */
+  DWORD writes;         /* Card writes: USER_write past the cache, write-backs, USER_StreamWrite */
+  DWORD syncs;          /* CTRL_SYNC requests */
+  DWORD read_sectors;
+  DWORD write_sectors;
+  DWORD stream_starts;  /* CMD25 streams opened by USER_StreamWrite */
+  DWORD busy_waits;     /* spi_wait_ready calls that found the card busy */
+  DWORD busy_polls;     /* Bytes polled in those waits */
+  DWORD token_polls;    /* Bytes polled waiting for read data tokens */
+  DWORD cache_hits;     /* Single-sector reads and writes served by a slot */
+  DWORD cache_misses;
+  DWORD cache_evictions;  /* Slots taken for another sector */
+  DWORD cache_writebacks; /* Dirty slots written to the card */
+  DWORD trims;          /* CTRL_TRIM erases done */
+  DWORD trim_sectors;
+} SD_Stats_t;
+
+/** The card as it describes itself, read at initialisation; 0 where a
+    register could not be read. A later initialisation finding the same
+    card still initialised (same OCR and CID) keeps all of it */
+typedef struct {
+  BYTE type;            /* 1 SDv1, 2 SDv2, 3 MMC, 6 SDHC/SDXC */
+  BYTE erase_blk_en;    /* Any sector run can be erased, not only whole erase blocks */
+  DWORD sectors;        /* Capacity, from the CSD */
+  DWORD erase_sectors;  /* Erase block: the allocation unit on SDv2 and later */
+  DWORD ocr;            /* From CMD58 */
+  DWORD prescaler;      /* SPI1 SPI_BAUDRATEPRESCALER_x the bus test chose */
+  DWORD init_us;        /* Time the last initialisation took (SD_TIMING) */
+  BYTE csd[16];
+  BYTE cid[16];
+} SD_CardInfo_t;
+
+/** Timed card operations */
+typedef enum {
+  SD_OP_READ = 0,       /* USER_read, or USER_ReadStart to the last block */
+  SD_OP_WRITE,          /* Card writes; a single sector returns once posted */
+  SD_OP_STREAM,         /* USER_StreamWrite */
+  SD_OP_WAIT_READY,     /* spi_wait_ready */
+  SD_OP_RCVR_BLOCK,     /* One block read, token wait included */
+  SD_OP_PROGRAM,        /* Posted block, data response until seen ready */
+  SD_OP_COUNT
+} SD_Op_t;
+
+/** Latency of one operation type, in microseconds */
+typedef struct {
+  DWORD count;
+  DWORD max_us;
+  uint64_t total_us;
+  DWORD hist[SD_HIST_BUCKETS];
+} SD_Timing_t;
+
 /* Exported functions ------------------------------------------------------- */
 extern Diskio_drvTypeDef  USER_Driver;
+extern SD_Stats_t SD_Stats;
+extern SD_Timing_t SD_Timing[SD_OP_COUNT];
+extern SD_CardInfo_t SD_Card;
+
+void SD_ResetTiming(void);
+
+uint8_t USER_Poll(void);
+DRESULT USER_ReadStart(BYTE *buff, DWORD sector, UINT count);
+DRESULT USER_ReadResult(void);
+DRESULT USER_StreamWrite(const BYTE *buff, DWORD sector, DWORD erase_hint);
+DRESULT USER_StreamSync(void);
+DRESULT USER_StreamStop(void);
+void USER_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void USER_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void USER_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
 
 /* USER CODE END 0 */
 